@@ -0,0 +1,422 @@
+#include "bench_util.hpp"
+
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/deque.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// adversarial workloads: a search for the op sequences with the highest cost per op on the structures that
+// amortize around a threshold, the 3x balance of Deque, the shrink of a dynamic CircularBuffer at a quarter
+// full and the spread / gather of BlockyLinkedList at b + 1 / b - 1 elements per block.
+//
+// a workload is a container filled with m_initial elements and a short pattern of ops repeated until
+// g_ops ops are done. its cost is the number of element moves and copies per op, which is deterministic so
+// the search is not fooled by timing noise. random search picks the starting points, hill-climbing mutates
+// the best of them one op or the initial size at a time and keeps a mutation that costs no less. the worst
+// workloads found are then timed next to a plain queue as the reference.
+//
+// a workload that keeps growing pays for its growth, which is amortized and not what a threshold thrashes
+// on. the search is run twice: over every workload and over the steady ones only, whose size ends within
+// g_maxPattern of where it started.
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+constexpr auto g_ops        = 10'000uz;    // per evaluation
+constexpr auto g_maxInitial = 4'096uz;
+constexpr auto g_maxPattern = 12uz;
+constexpr auto g_samples    = 1'000uz;    // random workloads
+constexpr auto g_climbers   = 4uz;        // of the best random workloads, hill-climbed
+constexpr auto g_climbSteps = 500uz;      // per climber
+constexpr auto g_reported   = 3uz;
+constexpr auto g_blockSize  = 16uz;
+
+// counts every move and copy of an element
+struct Counted
+{
+    static inline std::size_t s_moves = 0;
+
+    std::uint64_t m_value = 0;
+
+    Counted() = default;
+
+    explicit Counted(std::uint64_t value)
+        : m_value{ value }
+    {
+    }
+
+    Counted(const Counted& other)
+        : m_value{ other.m_value }
+    {
+        ++s_moves;
+    }
+
+    Counted(Counted&& other) noexcept
+        : m_value{ other.m_value }
+    {
+        ++s_moves;
+    }
+
+    Counted& operator=(const Counted& other)
+    {
+        m_value = other.m_value;
+        ++s_moves;
+        return *this;
+    }
+
+    Counted& operator=(Counted&& other) noexcept
+    {
+        m_value = other.m_value;
+        ++s_moves;
+        return *this;
+    }
+};
+
+// an op of a target: a short code for the report and the op itself, a removal on an empty container is a
+// no-op that still counts as an op
+template <typename Container>
+struct Op
+{
+    std::string_view m_code;
+    void (*m_apply)(Container&, std::uint64_t);
+};
+
+struct DequeTarget
+{
+    using Container = dsa::Deque<Counted>;
+
+    static constexpr auto s_name   = std::string_view{ "Deque (balance at 3x)" };
+    static constexpr auto s_legend = std::string_view{ "+F/+B push_front/back, -F/-B pop_front/back" };
+
+    static constexpr auto s_ops = std::array<Op<Container>, 4>{ {
+        { "+F", [](Container& deque, std::uint64_t value) { deque.push_front(Counted{ value }); } },
+        { "+B", [](Container& deque, std::uint64_t value) { deque.push_back(Counted{ value }); } },
+        { "-F", [](Container& deque, std::uint64_t) {
+             if (not deque.empty()) {
+                 doNotOptimize(deque.pop_front().m_value);
+             }
+         } },
+        { "-B", [](Container& deque, std::uint64_t) {
+             if (not deque.empty()) {
+                 doNotOptimize(deque.pop_back().m_value);
+             }
+         } },
+    } };
+
+    static constexpr auto s_queue = std::array{ 1uz, 2uz };    // push_back, pop_front
+
+    static Container make() { return Container{}; }
+};
+
+struct CircularBufferTarget
+{
+    static constexpr auto s_policy = dsa::BufferPolicy{
+        .m_capacity = dsa::BufferCapacityPolicy::DynamicCapacity,
+        .m_store    = dsa::BufferStorePolicy::ThrowOnFull,
+    };
+
+    using Container = dsa::CircularBuffer<Counted, s_policy>;
+
+    static constexpr auto s_name   = std::string_view{ "CircularBuffer (shrink at a quarter full)" };
+    static constexpr auto s_legend = std::string_view{ "+F/+B push_front/back, -F/-B pop_front/back" };
+
+    static constexpr auto s_ops = std::array<Op<Container>, 4>{ {
+        { "+F", [](Container& buffer, std::uint64_t value) { buffer.push_front(Counted{ value }); } },
+        { "+B", [](Container& buffer, std::uint64_t value) { buffer.push_back(Counted{ value }); } },
+        { "-F", [](Container& buffer, std::uint64_t) {
+             if (buffer.size() > 0) {
+                 doNotOptimize(buffer.pop_front().m_value);
+             }
+         } },
+        { "-B", [](Container& buffer, std::uint64_t) {
+             if (buffer.size() > 0) {
+                 doNotOptimize(buffer.pop_back().m_value);
+             }
+         } },
+    } };
+
+    static constexpr auto s_queue = std::array{ 1uz, 2uz };
+
+    static Container make() { return Container{ 0 }; }
+};
+
+// the positions are relative to the size: the front, just past the first block, the middle and the back
+struct BlockyLinkedListTarget
+{
+    using Container = dsa::BlockyLinkedList<Counted>;
+
+    static constexpr auto s_name   = std::string_view{ "BlockyLinkedList (spread / gather at b +- 1)" };
+    static constexpr auto s_legend = std::string_view{
+        "+ insert, - remove at F front, b position b, M middle, B back"
+    };
+
+    static std::size_t last(const Container& list) { return list.size() == 0 ? 0 : list.size() - 1; }
+
+    static constexpr auto s_ops = std::array<Op<Container>, 8>{ {
+        { "+F", [](Container& list, std::uint64_t value) { list.insert(0, Counted{ value }); } },
+        { "+b", [](Container& list, std::uint64_t value) {
+             list.insert(std::min(g_blockSize, list.size()), Counted{ value });
+         } },
+        { "+M", [](Container& list, std::uint64_t value) {
+             list.insert(list.size() / 2, Counted{ value });
+         } },
+        { "+B", [](Container& list, std::uint64_t value) {
+             list.insert(list.size(), Counted{ value });
+         } },
+        { "-F", [](Container& list, std::uint64_t) {
+             if (list.size() > 0) {
+                 doNotOptimize(list.remove(0).m_value);
+             }
+         } },
+        { "-b", [](Container& list, std::uint64_t) {
+             if (list.size() > 0) {
+                 doNotOptimize(list.remove(std::min(g_blockSize, last(list))).m_value);
+             }
+         } },
+        { "-M", [](Container& list, std::uint64_t) {
+             if (list.size() > 0) {
+                 doNotOptimize(list.remove(list.size() / 2).m_value);
+             }
+         } },
+        { "-B", [](Container& list, std::uint64_t) {
+             if (list.size() > 0) {
+                 doNotOptimize(list.remove(last(list)).m_value);
+             }
+         } },
+    } };
+
+    static constexpr auto s_queue = std::array{ 3uz, 4uz };    // insert at the back, remove at the front
+
+    static Container make() { return Container{ g_blockSize }; }
+};
+
+struct Workload
+{
+    std::size_t              m_initial = 0;
+    std::vector<std::size_t> m_pattern;            // indices into the ops of the target
+    double                   m_moves   = 0;        // per op
+    bool                     m_steady  = false;
+};
+
+// the shortest period of the pattern in its smallest rotation: [+B -F +B -F] and [-F +B] are the same
+// workload for the report
+std::vector<std::size_t> canonical(const std::vector<std::size_t>& pattern)
+{
+    auto size   = pattern.size();
+    auto period = size;
+    for (auto p = 1uz; p < size; ++p) {
+        auto repeats = size % p == 0;
+        for (auto i = p; repeats and i < size; ++i) {
+            repeats = pattern[i] == pattern[i - p];
+        }
+        if (repeats) {
+            period = p;
+            break;
+        }
+    }
+
+    auto end  = pattern.begin() + static_cast<std::ptrdiff_t>(period);
+    auto best = std::vector<std::size_t>(pattern.begin(), end);
+    auto next = best;
+    for (auto r = 1uz; r < period; ++r) {
+        std::ranges::rotate(next, next.begin() + 1);
+        best = std::min(best, next);
+    }
+    return best;
+}
+
+template <typename Target>
+typename Target::Container prepare(const Workload& workload)
+{
+    auto container = Target::make();
+    for (auto i = 0uz; i < workload.m_initial; ++i) {
+        Target::s_ops[Target::s_queue[0]].m_apply(container, i);
+    }
+    return container;
+}
+
+template <typename Target>
+void run(typename Target::Container& container, const Workload& workload)
+{
+    for (auto i = 0uz, p = 0uz; i < g_ops; ++i, p = p + 1 == workload.m_pattern.size() ? 0 : p + 1) {
+        Target::s_ops[workload.m_pattern[p]].m_apply(container, i);
+    }
+}
+
+template <typename Target>
+void evaluate(Workload& workload)
+{
+    auto container   = prepare<Target>(workload);
+    Counted::s_moves = 0;
+    run<Target>(container, workload);
+
+    workload.m_moves  = static_cast<double>(Counted::s_moves) / static_cast<double>(g_ops);
+    workload.m_steady = container.size() <= workload.m_initial + g_maxPattern;
+}
+
+template <typename Target>
+Workload randomWorkload()
+{
+    auto& rng     = bench_util::rng();
+    auto  initial = std::uniform_int_distribution<std::size_t>{ 0, g_maxInitial };
+    auto  length  = std::uniform_int_distribution<std::size_t>{ 1, g_maxPattern };
+    auto  op      = std::uniform_int_distribution<std::size_t>{ 0, Target::s_ops.size() - 1 };
+
+    auto pattern = std::vector<std::size_t>(length(rng));
+    for (auto& index : pattern) {
+        index = op(rng);
+    }
+    return Workload{ .m_initial = initial(rng), .m_pattern = std::move(pattern) };
+}
+
+// one op replaced, inserted or erased, or the initial size nudged by one or scaled by two: the thresholds
+// sit at exact sizes so the small steps matter as much as the large ones
+template <typename Target>
+Workload mutate(Workload workload)
+{
+    auto& rng     = bench_util::rng();
+    auto& pattern = workload.m_pattern;
+    auto& initial = workload.m_initial;
+
+    auto pick = [&](std::size_t count) { return std::uniform_int_distribution{ 0uz, count - 1 }(rng); };
+    auto op   = [&] { return pick(Target::s_ops.size()); };
+    auto at   = [&](std::size_t count) { return pattern.begin() + static_cast<std::ptrdiff_t>(pick(count)); };
+
+    switch (pick(5)) {
+    case 0: *at(pattern.size()) = op(); break;
+    case 1: {
+        if (pattern.size() < g_maxPattern) {
+            pattern.insert(at(pattern.size() + 1), op());
+        }
+        break;
+    }
+    case 2: {
+        if (pattern.size() > 1) {
+            pattern.erase(at(pattern.size()));
+        }
+        break;
+    }
+    case 3: initial = pick(2) == 0 ? initial + 1 : initial - (initial > 0 ? 1 : 0); break;
+    case 4: initial = pick(2) == 0 ? std::min(2 * initial + 1, g_maxInitial) : initial / 2; break;
+    }
+    return workload;
+}
+
+template <typename Target>
+std::string describe(const Workload& workload)
+{
+    auto codes = std::string{};
+    for (auto index : workload.m_pattern) {
+        codes += codes.empty() ? "" : " ";
+        codes += Target::s_ops[index].m_code;
+    }
+    return fmt::format("n={:<4} [{}]", workload.m_initial, codes);
+}
+
+// the time and the moves of one workload, the moves are counted in the last of the timed runs
+template <typename Target>
+void measureWorkload(std::string_view name, const Workload& workload)
+{
+    auto setup = [&] { return prepare<Target>(workload); };
+    auto time  = measureBest(5, setup, [&](typename Target::Container& container) {
+        Counted::s_moves = 0;
+        run<Target>(container, workload);
+        doNotOptimize(container);
+    });
+
+    auto moves = static_cast<double>(Counted::s_moves) / static_cast<double>(g_ops);
+    report(name, g_ops, time);
+    fmt::println("{:<50} {:>12.2f} moves/op", "", moves);
+}
+
+// the worst workloads of the sampled ones and of the hill-climbs from the best of them, one per pattern
+template <typename Target>
+std::vector<Workload> worstOf(const std::vector<Workload>& sampled, bool steady)
+{
+    auto byCost  = [](const Workload& lhs, const Workload& rhs) { return lhs.m_moves > rhs.m_moves; };
+    auto allowed = [&](const Workload& workload) { return not steady or workload.m_steady; };
+
+    auto found = std::vector<Workload>{};
+    std::ranges::copy_if(sampled, std::back_inserter(found), allowed);
+    std::ranges::sort(found, byCost);
+
+    // plateaus are common (a run of ops that does nothing), accepting equal cost lets the climb cross them
+    auto climbed = std::vector<Workload>{};
+    for (auto c = 0uz; c < std::min(g_climbers, found.size()); ++c) {
+        auto best = found[c];
+        for (auto step = 0uz; step < g_climbSteps; ++step) {
+            auto next = mutate<Target>(best);
+            evaluate<Target>(next);
+            if (allowed(next) and next.m_moves >= best.m_moves) {
+                best = std::move(next);
+            }
+        }
+        climbed.push_back(std::move(best));
+    }
+    climbed.insert(climbed.end(), found.begin(), found.end());
+    std::ranges::stable_sort(climbed, byCost);
+
+    auto worst    = std::vector<Workload>{};
+    auto patterns = std::vector<std::vector<std::size_t>>{};
+    for (const auto& workload : climbed) {
+        auto pattern = canonical(workload.m_pattern);
+        if (worst.size() < g_reported and std::ranges::find(patterns, pattern) == patterns.end()) {
+            worst.push_back(workload);
+            patterns.push_back(std::move(pattern));
+        }
+    }
+    return worst;
+}
+
+template <typename Target>
+void search()
+{
+    bench_util::header(Target::s_name);
+    fmt::println("{}", Target::s_legend);
+    fmt::println(
+        "{} random workloads, {} hill-climbing steps from the best {}, {} ops each",
+        g_samples,
+        g_climbSteps,
+        g_climbers,
+        g_ops
+    );
+
+    auto sampled = std::vector<Workload>{};
+    for (auto i = 0uz; i < g_samples; ++i) {
+        auto workload = randomWorkload<Target>();
+        evaluate<Target>(workload);
+        sampled.push_back(std::move(workload));
+    }
+
+    auto queue = Workload{
+        .m_initial = 1'000,
+        .m_pattern = { Target::s_queue.begin(), Target::s_queue.end() },
+    };
+    measureWorkload<Target>(fmt::format("queue: {}", describe<Target>(queue)), queue);
+
+    for (auto steady : { false, true }) {
+        for (const auto& workload : worstOf<Target>(sampled, steady)) {
+            auto name = fmt::format("{}: {}", steady ? "steady" : "any", describe<Target>(workload));
+            measureWorkload<Target>(name, workload);
+        }
+    }
+}
+
+int main()
+{
+    search<DequeTarget>();
+    search<CircularBufferTarget>();
+    search<BlockyLinkedListTarget>();
+}
@@ -0,0 +1,106 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/batch.hpp>
+#include <dsa/blocky_linked_list.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Op = dsa::BatchOp<int>;
+
+// 3:1 inserts to removes at uniformly random positions, no position is removed twice
+std::vector<Op> makeBatch(std::size_t size, std::size_t count)
+{
+    auto& rng     = bench_util::rng();
+    auto  dist    = std::uniform_int_distribution<std::size_t>{ 0, size - 1 };
+    auto  coin    = std::uniform_int_distribution{ 0, 3 };
+    auto  removed = std::vector<bool>(size, false);
+
+    auto ops = std::vector<Op>{};
+    for (auto i = 0uz; i < count; ++i) {
+        auto pos = dist(rng);
+        if (coin(rng) == 0 and not removed[pos]) {
+            removed[pos] = true;
+            ops.push_back(Op::remove(pos));
+        } else {
+            ops.push_back(Op::insert(pos, static_cast<int>(i)));
+        }
+    }
+    return ops;
+}
+
+// the batch applied one op at a time: sorted by position and applied back to front so the positions of the
+// ops not applied yet stay valid
+template <typename Container>
+void applyOneByOne(Container& container, std::vector<Op>& ops)
+{
+    std::ranges::stable_sort(ops, std::ranges::greater{}, &Op::m_position);
+    for (auto& op : ops) {
+        if (op.isInsert()) {
+            container.insert(op.m_position, std::move(*op.m_value));
+        } else {
+            doNotOptimize(container.remove(op.m_position));
+        }
+    }
+}
+
+template <typename Container>
+void bench(std::string_view name, std::size_t size, std::size_t count, auto make)
+{
+    auto batch = makeBatch(size, count);
+    auto setup = [&] { return std::pair{ make(size), batch }; };
+
+    auto label = [&](std::string_view how) { return fmt::format("{} {}", name, how); };
+
+    // the one by one run is skipped when it would take too long
+    if (size * count <= 1'000'000'000uz) {
+        report(label("one by one"), count, measureBest(3, setup, [](auto& state) {
+            auto& [container, ops] = state;
+            applyOneByOne(container, ops);
+            doNotOptimize(container);
+        }));
+    }
+    report(label("apply_batch"), count, measureBest(3, setup, [](auto& state) {
+        auto& [container, ops] = state;
+        container.apply_batch(ops);
+        doNotOptimize(container);
+    }));
+}
+
+int main()
+{
+    auto arrayList = [](std::size_t size) {
+        auto list = dsa::ArrayList<int>{};
+        list.reserve(2 * size);
+        for (auto i = 0uz; i < size; ++i) {
+            list.push_back(static_cast<int>(i));
+        }
+        return list;
+    };
+
+    auto blockyList = [](std::size_t size) {
+        auto list = dsa::BlockyLinkedList<int>{ 64 };
+        for (auto i = 0uz; i < size; ++i) {
+            list.push_back(static_cast<int>(i));
+        }
+        return list;
+    };
+
+    for (auto size : { 100'000uz, 1'000'000uz }) {
+        for (auto count : { 100uz, 1'000uz, 10'000uz, 100'000uz }) {
+            bench_util::header(fmt::format("{} elements, batch of {} ops", size, count));
+            bench<dsa::ArrayList<int>>("ArrayList", size, count, arrayList);
+            bench<dsa::BlockyLinkedList<int>>("BlockyLinkedList (b = 64)", size, count, blockyList);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string_view>
+
+namespace bench_util
+{
+    using Clock    = std::chrono::steady_clock;
+    using Duration = std::chrono::duration<double, std::nano>;
+
+    // prevent the compiler from optimizing away a value that is otherwise unused
+    template <typename T>
+    inline void doNotOptimize(T&& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename Fn>
+    Duration measure(Fn&& fn)
+    {
+        auto start = Clock::now();
+        fn();
+        return Clock::now() - start;
+    }
+
+    // best of n runs, setup is called before each run and is not measured
+    template <typename Setup, typename Fn>
+    Duration measureBest(std::size_t runs, Setup&& setup, Fn&& fn)
+    {
+        auto best = Duration::max();
+        for (auto i = 0uz; i < runs; ++i) {
+            auto&& state = setup();
+            auto   time  = measure([&] { fn(state); });
+            best         = std::min(best, time);
+        }
+        return best;
+    }
+
+    inline void header(std::string_view title)
+    {
+        fmt::println("\n{:-^90}", fmt::format(" {} ", title));
+    }
+
+    inline void report(std::string_view name, std::size_t ops, Duration time)
+    {
+        auto ms   = time.count() / 1e6;
+        auto nsop = ops == 0 ? 0.0 : time.count() / static_cast<double>(ops);
+        fmt::println("{:<50} {:>12.3f} ms {:>12.2f} ns/op", name, ms, nsop);
+    }
+
+    inline void reportBandwidth(std::string_view name, std::size_t bytes, Duration time)
+    {
+        auto ms   = time.count() / 1e6;
+        auto gbps = time.count() == 0 ? 0.0 : static_cast<double>(bytes) / time.count();    // bytes/ns = GB/s
+        fmt::println("{:<50} {:>12.3f} ms {:>12.2f} GB/s", name, ms, gbps);
+    }
+
+    inline std::mt19937& rng()
+    {
+        static std::mt19937 mt{ 42 };    // fixed seed so runs are comparable
+        return mt;
+    }
+}
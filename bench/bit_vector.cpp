@@ -0,0 +1,79 @@
+#include "bench_util.hpp"
+
+#include <dsa/bit_vector.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measure;
+using bench_util::report;
+
+// usage: bench_bit_vector [bits]
+int main(int argc, char** argv)
+{
+    auto size    = argc > 1 ? std::stoull(argv[1]) : 1'000'000'000uz;
+    auto queries = 10'000'000uz;
+
+    for (auto density : { 0.01, 0.5 }) {
+        bench_util::header(fmt::format("bits: {}, density: {}", size, density));
+
+        auto bits    = dsa::BitVector{ size };
+        auto runDist = std::uniform_int_distribution<std::size_t>{ 1, 4096 };
+        auto coin    = std::uniform_real_distribution<double>{ 0.0, 1.0 };
+
+        // alternating runs of ones and zeros using the bulk operation
+        auto fill = measure([&] {
+            for (auto pos = 0uz; pos < size;) {
+                auto run = std::min(size - pos, runDist(bench_util::rng()));
+                if (coin(bench_util::rng()) < density) {
+                    bits.setRange(pos, pos + run);
+                }
+                pos += run;
+            }
+        });
+        report("setRange", size / 2048, fill);
+
+        auto build = measure([&] { bits.buildIndex(); });
+        report("buildIndex", size, build);
+
+        auto count = measure([&] { doNotOptimize(dsa::popcountWords(bits.words())); });
+        report("popcountWords (whole vector)", bits.words().size(), count);
+
+        auto posDist = std::uniform_int_distribution<std::size_t>{ 0, size };
+        auto rankPos = std::vector<std::size_t>(queries);
+        for (auto& pos : rankPos) {
+            pos = posDist(bench_util::rng());
+        }
+
+        auto rank = measure([&] {
+            for (auto pos : rankPos) {
+                doNotOptimize(bits.rank1(pos));
+            }
+        });
+        report("rank1", queries, rank);
+
+        auto ones = bits.count();
+        if (ones == 0) {
+            continue;
+        }
+
+        auto kDist   = std::uniform_int_distribution<std::size_t>{ 0, ones - 1 };
+        auto selectK = std::vector<std::size_t>(queries);
+        for (auto& k : selectK) {
+            k = kDist(bench_util::rng());
+        }
+
+        auto select = measure([&] {
+            for (auto k : selectK) {
+                doNotOptimize(bits.select1(k));
+            }
+        });
+        report("select1", queries, select);
+    }
+}
@@ -0,0 +1,111 @@
+#include "bench_util.hpp"
+
+#include <dsa/blocky_linked_list.hpp>
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Value = std::uint64_t;
+
+constexpr auto g_size = 100'000uz;
+constexpr auto g_ops  = 20'000uz;    // locate walks the blocks, O(n / b) per op
+
+std::vector<std::size_t> makePositions(std::size_t count, std::size_t size)
+{
+    auto& rng  = bench_util::rng();
+    auto  dist = std::uniform_int_distribution<std::size_t>{ 0, size - 1 };
+
+    auto positions = std::vector<std::size_t>(count);
+    for (auto& pos : positions) {
+        pos = dist(rng);
+    }
+    return positions;
+}
+
+template <typename List>
+List makeList(auto make)
+{
+    auto list = make();
+    for (auto i = 0uz; i < g_size; ++i) {
+        list.push_back(Value{ i });
+    }
+    return list;
+}
+
+template <typename List>
+void bench(std::string_view name, auto make)
+{
+    auto positions = makePositions(g_ops, g_size);
+    auto label     = [&](std::string_view what) { return fmt::format("{} {}", what, name); };
+
+    report(label("push_back"), g_size, measureBest(3, make, [](List& list) {
+        for (auto i = 0uz; i < g_size; ++i) {
+            list.push_back(Value{ i });
+        }
+        doNotOptimize(list);
+    }));
+
+    auto filled = [&] { return makeList<List>(make); };
+
+    report(label("at"), g_ops, measureBest(3, filled, [&](List& list) {
+        auto sum = Value{ 0 };
+        for (auto pos : positions) {
+            sum += list.at(pos);
+        }
+        doNotOptimize(sum);
+    }));
+
+    report(label("insert"), g_ops, measureBest(3, filled, [&](List& list) {
+        for (auto pos : positions) {
+            list.insert(pos, Value{ pos });
+        }
+        doNotOptimize(list);
+    }));
+
+    report(label("remove"), g_ops / 2, measureBest(3, filled, [&](List& list) {
+        auto sum = Value{ 0 };
+        for (auto i = 0uz; i < g_ops / 2; ++i) {
+            sum += list.remove(positions[i] / 2);
+        }
+        doNotOptimize(sum);
+    }));
+
+    report(label("segments"), g_size, measureBest(3, filled, [](List& list) {
+        auto sum = Value{ 0 };
+        for (auto segment : list.segments()) {
+            for (auto value : segment) {
+                sum += value;
+            }
+        }
+        doNotOptimize(sum);
+    }));
+}
+
+template <std::size_t B>
+void compare()
+{
+    bench_util::header(fmt::format("b = {} ({} elements)", B, g_size));
+
+    bench<dsa::BlockyLinkedList<Value>>("(runtime b)", [] { return dsa::BlockyLinkedList<Value>{ B }; });
+    bench<dsa::StaticBlockyLinkedList<Value, B>>("(static b)", [] {
+        return dsa::StaticBlockyLinkedList<Value, B>{};
+    });
+}
+
+int main()
+{
+    // b + 1 a power of two (masked ring index) and one more (compared ring index)
+    compare<15>();
+    compare<63>();
+    compare<64>();
+    compare<255>();
+}
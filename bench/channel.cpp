@@ -0,0 +1,151 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/channel.hpp>
+#include <dsa/circular_buffer.hpp>
+
+#include <fmt/core.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+// the baseline: a bounded CircularBuffer behind a mutex, the threads block on condition variables
+class BlockingQueue
+{
+public:
+    BlockingQueue(std::size_t capacity)
+        : m_buffer{ capacity }
+    {
+    }
+
+    void push(std::uint64_t value)
+    {
+        auto lock = std::unique_lock{ m_mutex };
+        m_notFull.wait(lock, [&] { return m_buffer.size() < m_buffer.capacity(); });
+        m_buffer.push_back(auto{ value });
+        lock.unlock();
+        m_notEmpty.notify_one();
+    }
+
+    std::optional<std::uint64_t> pop()
+    {
+        auto lock = std::unique_lock{ m_mutex };
+        m_notEmpty.wait(lock, [&] { return m_buffer.size() > 0 or m_closed; });
+        auto value = m_buffer.try_pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return value;
+    }
+
+    void close()
+    {
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            m_closed  = true;
+        }
+        m_notEmpty.notify_all();
+    }
+
+private:
+    static constexpr auto s_policy = dsa::BufferPolicy{ .m_store = dsa::BufferStorePolicy::ThrowOnFull };
+
+    std::mutex                                   m_mutex;
+    std::condition_variable                      m_notFull;
+    std::condition_variable                      m_notEmpty;
+    dsa::CircularBuffer<std::uint64_t, s_policy> m_buffer;
+    bool                                         m_closed = false;
+};
+
+using Channel = dsa::Channel<std::uint64_t>;
+
+constexpr auto g_messages = 4'000'000uz;
+
+dsa::Task produce(Channel& channel)
+{
+    for (auto i = 0uz; i < g_messages; ++i) {
+        co_await channel.send(auto{ i });
+    }
+    channel.close();
+}
+
+dsa::Task consume(Channel& channel, std::uint64_t& sum)
+{
+    while (auto value = co_await channel.receive()) {
+        sum += *value;
+    }
+}
+
+dsa::Task consumeBatches(Channel& channel, std::size_t max, std::uint64_t& sum)
+{
+    auto batch = dsa::ArrayList<std::uint64_t>{};
+    batch.reserve(max);
+    while (co_await channel.receiveBatch(batch, max)) {
+        for (auto value : batch) {
+            sum += value;
+        }
+        batch.clear();
+    }
+}
+
+void channel(std::size_t capacity, bool batched)
+{
+    auto resumes = 0uz;
+    auto time    = measureBest(3, [] { return 0; }, [&](int) {
+        auto executor = dsa::Executor{};
+        auto channel  = Channel{ executor, capacity };
+        auto sum      = std::uint64_t{ 0 };
+
+        executor.spawn(produce(channel));
+        if (batched) {
+            executor.spawn(consumeBatches(channel, capacity, sum));
+        } else {
+            executor.spawn(consume(channel, sum));
+        }
+        resumes = executor.run();
+        doNotOptimize(sum);
+    });
+
+    report(batched ? "Channel, receiveBatch (1 thread)" : "Channel, receive (1 thread)", g_messages, time);
+    auto perResume = static_cast<double>(g_messages) / static_cast<double>(resumes);
+    fmt::println("    {} resumes, {:.2f} messages per resume", resumes, perResume);
+}
+
+void blockingQueue(std::size_t capacity)
+{
+    auto time = measureBest(3, [] { return 0; }, [&](int) {
+        auto queue = BlockingQueue{ capacity };
+        auto sum   = std::uint64_t{ 0 };
+
+        auto consumer = std::jthread{ [&] {
+            while (auto value = queue.pop()) {
+                sum += *value;
+            }
+        } };
+        for (auto i = 0uz; i < g_messages; ++i) {
+            queue.push(i);
+        }
+        queue.close();
+        consumer.join();
+        doNotOptimize(sum);
+    });
+
+    report("mutex + condition_variable (2 threads)", g_messages, time);
+}
+
+int main()
+{
+    for (auto capacity : { 16uz, 256uz, 4096uz }) {
+        bench_util::header(fmt::format("{} messages, capacity {}", g_messages, capacity));
+        channel(capacity, false);
+        channel(capacity, true);
+        blockingQueue(capacity);
+    }
+}
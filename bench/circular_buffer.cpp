@@ -0,0 +1,110 @@
+#include "bench_util.hpp"
+
+#include <dsa/circular_buffer.hpp>
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using dsa::BufferCapacityPolicy;
+using dsa::BufferPolicy;
+using dsa::BufferStorePolicy;
+
+using Value = std::uint64_t;
+
+constexpr auto g_ops = 50'000'000uz;
+
+// a queue at steady state: one push_back and one pop_front per op
+template <typename Buffer>
+void queue(std::string_view name, Buffer buffer)
+{
+    for (auto i = 0uz; i < buffer.capacity() / 2; ++i) {
+        buffer.push_back(Value{ i });
+    }
+
+    auto none = [] { return 0; };
+    report(name, g_ops, measureBest(5, none, [&](int) {
+        auto sum = Value{ 0 };
+        for (auto i = 0uz; i < g_ops; ++i) {
+            buffer.push_back(Value{ i });
+            sum += buffer.pop_front();
+        }
+        doNotOptimize(sum);
+    }));
+}
+
+// a full ReplaceOnFull buffer as a sliding window: every push_back overwrites the oldest element
+template <typename Buffer>
+void window(std::string_view name, Buffer buffer)
+{
+    for (auto i = 0uz; i < buffer.capacity(); ++i) {
+        buffer.push_back(Value{ i });
+    }
+
+    auto none = [] { return 0; };
+    report(name, g_ops, measureBest(5, none, [&](int) {
+        for (auto i = 0uz; i < g_ops; ++i) {
+            buffer.push_back(Value{ i });
+        }
+        doNotOptimize(buffer);
+    }));
+}
+
+// push_front then pop_back, the mirror of the queue
+template <typename Buffer>
+void stack(std::string_view name, Buffer buffer)
+{
+    auto none = [] { return 0; };
+    report(name, g_ops, measureBest(5, none, [&](int) {
+        auto sum = Value{ 0 };
+        for (auto i = 0uz; i < g_ops; ++i) {
+            buffer.push_front(Value{ i });
+            buffer.push_front(Value{ i });
+            sum += buffer.pop_back();
+            sum += buffer.pop_back();
+        }
+        doNotOptimize(sum);
+    }));
+}
+
+template <BufferPolicy Policy>
+void compare(std::string_view policyName, std::size_t capacity)
+{
+    bench_util::header(fmt::format("{}, capacity {}", policyName, capacity));
+
+    auto runtime = [&] { return dsa::CircularBuffer<Value>{ capacity, Policy }; };
+    auto fixed   = [&] { return dsa::CircularBuffer<Value, Policy>{ capacity }; };
+
+    queue("push_back + pop_front (runtime policy)", runtime());
+    queue("push_back + pop_front (static policy)", fixed());
+    stack("push_front + pop_back (runtime policy)", runtime());
+    stack("push_front + pop_back (static policy)", fixed());
+
+    if constexpr (Policy.m_store == BufferStorePolicy::ReplaceOnFull
+                  and Policy.m_capacity == BufferCapacityPolicy::FixedCapacity) {
+        window("push_back on full (runtime policy)", runtime());
+        window("push_back on full (static policy)", fixed());
+    }
+}
+
+int main()
+{
+    using enum BufferCapacityPolicy;
+    using enum BufferStorePolicy;
+
+    constexpr auto replace = BufferPolicy{ FixedCapacity, ReplaceOnFull };
+    constexpr auto thrower = BufferPolicy{ FixedCapacity, ThrowOnFull };
+    constexpr auto dynamic = BufferPolicy{ DynamicCapacity, ThrowOnFull };
+
+    for (auto capacity : { 64uz, 4096uz }) {
+        compare<replace>("FixedCapacity + ReplaceOnFull", capacity);
+        compare<thrower>("FixedCapacity + ThrowOnFull", capacity);
+        compare<dynamic>("DynamicCapacity + ThrowOnFull", capacity);
+    }
+}
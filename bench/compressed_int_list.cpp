@@ -0,0 +1,111 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/compressed_int_list.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string_view>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+using bench_util::reportBandwidth;
+
+using Value = std::uint64_t;
+
+// sorted ids with uniformly random gaps in [0, maxGap], or uniformly random values if maxGap is 0
+dsa::ArrayList<Value> makeValues(std::size_t count, Value maxGap)
+{
+    auto values = dsa::ArrayList<Value>{};
+    values.reserve(count);
+
+    auto gap   = std::uniform_int_distribution<Value>{ 0, maxGap };
+    auto any   = std::uniform_int_distribution<Value>{};
+    auto value = Value{ 0 };
+    for (auto i = 0uz; i < count; ++i) {
+        value = maxGap == 0 ? any(bench_util::rng()) : value + gap(bench_util::rng());
+        values.push_back(auto{ value });
+    }
+    return values;
+}
+
+void bench(std::string_view name, const dsa::ArrayList<Value>& values)
+{
+    auto none  = [] { return 0; };
+    auto bytes = values.size() * sizeof(Value);    // decoded bytes
+    auto out   = dsa::ArrayList<Value>(values.size());
+    auto span  = std::span{ out.data(), out.size() };
+
+    auto list = dsa::CompressedIntList{ std::from_range, values };
+
+    bench_util::header(fmt::format("{}, {} values", name, values.size()));
+    auto perValue = static_cast<double>(list.bytes()) / static_cast<double>(values.size());
+    fmt::println("{:<50} {:>12.3f} bytes/value", "CompressedIntList", perValue);
+
+    report("push_back (encode)", values.size(), measureBest(3, none, [&](int) {
+        auto encoded = dsa::CompressedIntList{};
+        for (auto value : values) {
+            encoded.push_back(value);
+        }
+        doNotOptimize(encoded);
+    }));
+
+    reportBandwidth("ArrayList copy (baseline)", bytes, measureBest(5, none, [&](int) {
+        std::copy_n(values.data(), values.size(), out.data());
+        doNotOptimize(out);
+    }));
+    reportBandwidth("decode", bytes, measureBest(5, none, [&](int) {
+        list.decode(span);
+        doNotOptimize(out);
+    }));
+    reportBandwidth("forEach (sum)", bytes, measureBest(5, none, [&](int) {
+        auto sum = Value{ 0 };
+        list.forEach([&](Value value) { sum += value; });
+        doNotOptimize(sum);
+    }));
+
+    // only meaningful on sorted values
+    if (not std::is_sorted(values.begin(), values.end())) {
+        return;
+    }
+
+    constexpr auto probes = 1'000'000uz;
+
+    auto dist    = std::uniform_int_distribution<Value>{ values.at(0), values.at(values.size() - 1) };
+    auto targets = dsa::ArrayList<Value>{};
+    for (auto i = 0uz; i < probes; ++i) {
+        targets.push_back(dist(bench_util::rng()));
+    }
+
+    report("std::lower_bound on ArrayList", probes, measureBest(3, none, [&](int) {
+        auto sum = 0uz;
+        for (auto target : targets) {
+            auto found  = std::lower_bound(values.begin(), values.end(), target);
+            sum        += static_cast<std::size_t>(found - values.begin());
+        }
+        doNotOptimize(sum);
+    }));
+    report("lowerBound (skip table + one block)", probes, measureBest(3, none, [&](int) {
+        auto sum = 0uz;
+        for (auto target : targets) {
+            sum += list.lowerBound(target);
+        }
+        doNotOptimize(sum);
+    }));
+}
+
+int main()
+{
+    constexpr auto count = 32uz << 20;    // 256MB uncompressed
+
+    bench("sorted, gaps in [0, 16]", makeValues(count, 16));
+    bench("sorted, gaps in [0, 1000]", makeValues(count, 1'000));
+    bench("sorted, gaps in [0, 2^20]", makeValues(count, 1 << 20));
+    bench("random 64-bit values", makeValues(count / 4, 0));
+}
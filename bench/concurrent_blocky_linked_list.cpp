@@ -0,0 +1,137 @@
+#include "bench_util.hpp"
+
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/concurrent_blocky_linked_list.hpp>
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+// the baseline: a BlockyLinkedList behind one mutex
+class LockedList
+{
+public:
+    LockedList(std::size_t blockSize)
+        : m_list{ blockSize }
+    {
+    }
+
+    void insert(std::size_t pos, std::uint64_t value)
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        m_list.insert(pos, std::move(value));
+    }
+
+    std::uint64_t remove(std::size_t pos)
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        return m_list.remove(pos);
+    }
+
+    std::uint64_t at(std::size_t pos) const
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        return m_list.at(pos);
+    }
+
+    void push_back(std::uint64_t value) { m_list.push_back(std::move(value)); }
+
+private:
+    mutable std::mutex                   m_mutex;
+    dsa::BlockyLinkedList<std::uint64_t> m_list;
+};
+
+class ConcurrentList
+{
+public:
+    ConcurrentList(std::size_t blockSize)
+        : m_list{ blockSize }
+    {
+    }
+
+    void          insert(std::size_t pos, std::uint64_t value) { m_list.insert(pos, std::move(value)); }
+    std::uint64_t remove(std::size_t pos) { return m_list.remove(pos); }
+    std::uint64_t at(std::size_t pos) const { return m_list.at(pos); }
+    void          push_back(std::uint64_t value) { m_list.push_back(std::move(value)); }
+
+    auto stats() const { return m_list.stats(); }
+
+private:
+    dsa::ConcurrentBlockyLinkedList<std::uint64_t> m_list;
+};
+
+constexpr auto g_size      = 100'000uz;
+constexpr auto g_blockSize = 64uz;
+constexpr auto g_ops       = 200'000uz;
+
+// the ops are split between the threads, the writes alternate between a remove and an insert so the size
+// stays around g_size. the positions are below g_size - threads: a thread removes at most one value more
+// than it inserted, a position is always valid
+template <typename List>
+void mixed(std::string_view name, std::size_t threads, std::size_t readPercent)
+{
+    auto setup = [] {
+        auto list = std::make_unique<List>(g_blockSize);
+        for (auto i = 0uz; i < g_size; ++i) {
+            list->push_back(i);
+        }
+        return list;
+    };
+
+    auto last = std::unique_ptr<List>{};
+    auto time = measureBest(3, setup, [&](std::unique_ptr<List>& list) {
+        auto workers = std::vector<std::jthread>{};
+        for (auto t = 0uz; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                auto rng   = std::mt19937_64{ t };
+                auto range = g_size - threads;
+                auto write = false;
+                auto sum   = std::uint64_t{ 0 };
+                for (auto i = 0uz; i < g_ops / threads; ++i) {
+                    if (rng() % 100 < readPercent) {
+                        sum += list->at(rng() % range);
+                    } else if ((write = not write)) {
+                        sum += list->remove(rng() % range);
+                    } else {
+                        list->insert(rng() % range, i);
+                    }
+                }
+                doNotOptimize(sum);
+            });
+        }
+        workers.clear();
+        last = std::move(list);
+    });
+
+    report(fmt::format("{} ({:>2} threads)", name, threads), g_ops, time);
+    if constexpr (requires { last->stats(); }) {
+        auto [optimistic, retries, locked] = last->stats();
+        fmt::println("{:<50} {:>9} optimistic {:>9} retries {:>9} locked", "", optimistic, retries, locked);
+    }
+}
+
+int main()
+{
+    fmt::println("hardware threads: {}", std::thread::hardware_concurrency());
+
+    for (auto readPercent : { 90uz, 50uz }) {
+        bench_util::header(
+            fmt::format("{} ops on {} elements, block {}, {}% reads", g_ops, g_size, g_blockSize, readPercent)
+        );
+        for (auto threads : { 1uz, 2uz, 4uz, 8uz, 16uz }) {
+            mixed<ConcurrentList>("ConcurrentBlockyLinkedList", threads, readPercent);
+            mixed<LockedList>("mutex + BlockyLinkedList", threads, readPercent);
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include "bench_util.hpp"
+
+#include <dsa/circular_buffer.hpp>
+#include <dsa/concurrent_overwrite_ring.hpp>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+struct Event
+{
+    std::uint64_t m_timestamp;
+    std::uint32_t m_thread;
+    std::uint32_t m_event;
+    std::uint64_t m_args[2];
+};
+
+// the baseline: a ReplaceOnFull CircularBuffer behind a mutex
+class LockedRing
+{
+public:
+    LockedRing(std::size_t capacity)
+        : m_buffer{ capacity }
+    {
+    }
+
+    bool push_back(const Event& event)
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        m_buffer.push_back(auto{ event });
+        return true;
+    }
+
+    template <typename Fn>
+    std::size_t snapshot(Fn&& fn) const
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        for (const auto& event : m_buffer) {
+            fn(0, event);
+        }
+        return m_buffer.size();
+    }
+
+private:
+    mutable std::mutex         m_mutex;
+    dsa::CircularBuffer<Event> m_buffer;
+};
+
+constexpr auto g_capacity = 1uz << 16;
+constexpr auto g_events   = 4'000'000uz;    // in total, split between the writers
+
+// all writers log as fast as they can, optionally with a reader taking snapshots in a loop
+template <typename Ring>
+void logging(std::string_view name, std::size_t writers, bool withReader)
+{
+    auto perWriter = g_events / writers;
+    auto dropped   = std::uint64_t{ 0 };
+
+    auto setup = [] { return 0; };
+    auto time  = measureBest(3, setup, [&](int) {
+        auto ring = Ring{ g_capacity };
+        auto done = std::atomic<bool>{ false };
+
+        auto reader = std::jthread{ [&] {
+            auto seen = 0uz;
+            while (withReader and not done.load(std::memory_order_relaxed)) {
+                seen += ring.snapshot([](std::uint64_t, const Event& event) { doNotOptimize(event); });
+            }
+            doNotOptimize(seen);
+        } };
+
+        {
+            auto threads = std::vector<std::jthread>{};
+            for (auto w = 0uz; w < writers; ++w) {
+                threads.emplace_back([&, w] {
+                    for (auto i = 0uz; i < perWriter; ++i) {
+                        auto event = Event{ i, static_cast<std::uint32_t>(w), 7, { i, w } };
+                        ring.push_back(event);
+                    }
+                });
+            }
+        }
+
+        done = true;
+        if constexpr (requires { ring.dropped(); }) {
+            dropped = ring.dropped();
+        }
+    });
+
+    auto label = fmt::format("{} ({} writers{})", name, writers, withReader ? ", reader" : "");
+    report(label, perWriter * writers, time);
+    if (dropped > 0) {
+        auto percent = 100.0 * static_cast<double>(dropped) / g_events;
+        fmt::println("    {} writes dropped ({:.4f}%)", dropped, percent);
+    }
+}
+
+int main()
+{
+    fmt::println("hardware threads: {}", std::thread::hardware_concurrency());
+
+    for (auto withReader : { false, true }) {
+        auto reader = withReader ? ", reader snapshotting" : "";
+        bench_util::header(fmt::format("{} events, capacity {}{}", g_events, g_capacity, reader));
+        for (auto writers : { 1uz, 2uz, 4uz, 8uz, 16uz, 32uz }) {
+            logging<dsa::ConcurrentOverwriteRing<Event>>("ConcurrentOverwriteRing", writers, withReader);
+            logging<LockedRing>("mutex + CircularBuffer", writers, withReader);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/rootish_array.hpp>
+
+#include <fmt/core.h>
+
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+using bench_util::measureBest;
+using bench_util::reportBandwidth;
+
+// same layout as std::int64_t but with a user-provided copy constructor so it's not trivially copyable,
+// this forces the element by element copy
+struct Boxed
+{
+    std::int64_t m_value = 0;
+
+    Boxed(std::int64_t value)
+        : m_value{ value }
+    {
+    }
+
+    Boxed(const Boxed& other)
+        : m_value{ other.m_value }
+    {
+    }
+
+    Boxed(Boxed&&)                 = default;
+    Boxed& operator=(const Boxed&) = default;
+    Boxed& operator=(Boxed&&)      = default;
+};
+
+template <typename Container>
+Container makeContainer(std::size_t count)
+{
+    if constexpr (std::same_as<Container, dsa::CircularBuffer<typename Container::value_type>>) {
+        // push past the capacity so the ring is wrapped around
+        auto container = Container{ count };
+        for (auto i = 0uz; i < count + count / 2; ++i) {
+            container.push_back(static_cast<std::int64_t>(i));
+        }
+        return container;
+    } else {
+        auto container = Container{};
+        for (auto i = 0uz; i < count; ++i) {
+            container.push_back(static_cast<std::int64_t>(i));
+        }
+        return container;
+    }
+}
+
+template <typename Container>
+void bench(std::string_view name, std::size_t count)
+{
+    auto source = makeContainer<Container>(count);
+    auto bytes  = source.size() * sizeof(std::int64_t);
+
+    auto construct = measureBest(
+        5,
+        [] { return std::optional<Container>{}; },
+        [&](std::optional<Container>& copy) { copy.emplace(source); }
+    );
+    reportBandwidth(fmt::format("{} copy construct", name), bytes, construct);
+
+    auto assign = measureBest(
+        5, [] { return Container{}; }, [&](Container& copy) { copy = source; }
+    );
+    reportBandwidth(fmt::format("{} copy assign", name), bytes, assign);
+}
+
+int main()
+{
+    // 100MB of 64-bit elements
+    constexpr auto count = 100'000'000uz / sizeof(std::int64_t);
+
+    bench_util::header("ArrayList, 100MB");
+    bench<dsa::ArrayList<std::int64_t>>("int64_t (memcpy)", count);
+    bench<dsa::ArrayList<Boxed>>("Boxed (per element)", count);
+
+    bench_util::header("CircularBuffer, 100MB, wrapped around");
+    bench<dsa::CircularBuffer<std::int64_t>>("int64_t (memcpy)", count);
+    bench<dsa::CircularBuffer<Boxed>>("Boxed (per element)", count);
+
+    bench_util::header("RootishArray, 100MB");
+    bench<dsa::RootishArray<std::int64_t>>("int64_t (memcpy)", count);
+    bench<dsa::RootishArray<Boxed>>("Boxed (per element)", count);
+}
@@ -0,0 +1,75 @@
+#include "bench_util.hpp"
+
+#include <dsa/fenwick_tree.hpp>
+
+#include <fmt/core.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Tree   = dsa::FenwickTree<std::int64_t>;
+using Update = std::pair<std::size_t, std::int64_t>;
+
+std::vector<Update> makeUpdates(std::size_t size, std::size_t count)
+{
+    auto posDist   = std::uniform_int_distribution<std::size_t>{ 0, size - 1 };
+    auto valueDist = std::uniform_int_distribution<std::int64_t>{ -100, 100 };
+
+    auto updates = std::vector<Update>(count);
+    for (auto& [pos, value] : updates) {
+        pos   = posDist(bench_util::rng());
+        value = valueDist(bench_util::rng());
+    }
+    return updates;
+}
+
+int main()
+{
+    for (auto size : { 1'000'000uz, 10'000'000uz }) {
+        auto counters = std::vector<std::int64_t>(size, 1);
+
+        bench_util::header(fmt::format("build, size: {}", size));
+        auto build = measureBest(3, [] { return 0; }, [&](int) { doNotOptimize(Tree{ counters }); });
+        report("FenwickTree build", size, build);
+
+        for (auto batch : { 1'000uz, 100'000uz, 1'000'000uz, 10'000'000uz }) {
+            bench_util::header(fmt::format("batched updates, size: {}, batch: {}", size, batch));
+
+            auto updates = makeUpdates(size, batch);
+
+            auto single = measureBest(
+                3,
+                [&] { return Tree{ counters }; },
+                [&](Tree& tree) {
+                    for (auto [pos, value] : updates) {
+                        tree.update(pos, value);
+                    }
+                }
+            );
+            report("update one by one", batch, single);
+
+            auto batched = measureBest(
+                3, [&] { return Tree{ counters }; }, [&](Tree& tree) { tree.updateBatch(updates); }
+            );
+            report("updateBatch", batch, batched);
+
+            auto tree    = Tree{ counters };
+            auto queries = measureBest(
+                3,
+                [] { return 0; },
+                [&](int) {
+                    for (auto [pos, _] : updates) {
+                        doNotOptimize(tree.prefix(pos));
+                    }
+                }
+            );
+            report("prefix query", batch, queries);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/gap_buffer.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+// editor-like workload: the cursor drifts by a small random amount then a few inserts/removes are done there
+struct Edit
+{
+    std::size_t m_pos;
+    bool        m_insert;
+};
+
+std::vector<Edit> makeEdits(std::size_t initial, std::size_t count, int drift)
+{
+    auto& rng  = bench_util::rng();
+    auto  dist = std::uniform_int_distribution{ -drift, drift };
+    auto  coin = std::uniform_int_distribution{ 0, 3 };
+
+    auto edits = std::vector<Edit>{};
+    auto size  = initial;
+    auto pos   = initial / 2;
+
+    for (auto i = 0uz; i < count; ++i) {
+        auto next = static_cast<std::ptrdiff_t>(pos) + dist(rng);
+        auto last = static_cast<std::ptrdiff_t>(size);
+        pos       = static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(next, 0, last));
+
+        auto insert = coin(rng) != 0 or size == 0 or pos == size;    // 3:1 insert to remove
+        edits.push_back({ pos, insert });
+        size = insert ? size + 1 : size - 1;
+    }
+
+    return edits;
+}
+
+template <typename Container>
+Container makeContainer(std::size_t initial)
+{
+    auto container = Container{};
+    for (auto i = 0uz; i < initial; ++i) {
+        container.push_back(static_cast<int>(i));
+    }
+    return container;
+}
+
+template <typename Container>
+void run(std::string_view name, std::size_t initial, const std::vector<Edit>& edits)
+{
+    auto time = measureBest(
+        3,
+        [&] { return makeContainer<Container>(initial); },
+        [&](Container& container) {
+            for (auto [pos, insert] : edits) {
+                if (insert) {
+                    container.insert(pos, static_cast<int>(pos));
+                } else {
+                    doNotOptimize(container.remove(pos));
+                }
+            }
+        }
+    );
+    report(name, edits.size(), time);
+}
+
+int main()
+{
+    constexpr auto edits = 100'000uz;
+
+    for (auto initial : { 10'000uz, 100'000uz, 1'000'000uz }) {
+        for (auto drift : { 0, 16, 1024 }) {
+            bench_util::header(fmt::format("initial: {}, edits: {}, drift: ±{}", initial, edits, drift));
+
+            auto ops = makeEdits(initial, edits, drift);
+            run<dsa::GapBuffer<int>>("GapBuffer", initial, ops);
+            run<dsa::ArrayList<int>>("ArrayList", initial, ops);
+            run<dsa::BlockyLinkedList<int>>("BlockyLinkedList", initial, ops);
+        }
+    }
+}
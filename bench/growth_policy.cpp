@@ -0,0 +1,148 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/growth_policy.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using dsa::GrowthFactor;
+using dsa::GrowthPolicy;
+
+using Value = std::uint64_t;
+
+constexpr auto g_pushes = 10'000'000uz;
+constexpr auto g_cycles = 20uz;    // of the sawtooth queue
+
+// the reallocations of a container seen from the outside: a reallocation is a change of the capacity, it
+// relocates the elements present at that moment and briefly holds both the old and the new buffer
+struct Stats
+{
+    std::size_t m_reallocations = 0;
+    std::size_t m_relocated     = 0;
+    std::size_t m_peakBytes     = 0;
+
+    template <typename Container>
+    void step(const Container& container, std::size_t& capacity, std::size_t sizeBefore)
+    {
+        if (container.capacity() != capacity) {
+            m_reallocations += 1;
+            m_relocated     += std::min(sizeBefore, container.size());
+            m_peakBytes      = std::max(m_peakBytes, (capacity + container.capacity()) * sizeof(Value));
+            capacity         = container.capacity();
+        }
+    }
+
+    void print() const
+    {
+        auto mib = static_cast<double>(m_peakBytes) / (1024.0 * 1024.0);
+        fmt::println(
+            "{:<50} {:>12} reallocs {:>12} moved {:>9.1f} MiB peak", "", m_reallocations, m_relocated, mib
+        );
+    }
+};
+
+// push_back only: the cost of growing
+template <GrowthPolicy Growth>
+void pushBack(std::string_view name)
+{
+    auto none = [] { return 0; };
+    report(name, g_pushes, measureBest(3, none, [](int) {
+        auto list = dsa::ArrayList<Value, Growth>{};
+        for (auto i = 0uz; i < g_pushes; ++i) {
+            list.push_back(Value{ i });
+        }
+        doNotOptimize(list);
+    }));
+
+    auto stats    = Stats{};
+    auto list     = dsa::ArrayList<Value, Growth>{};
+    auto capacity = list.capacity();
+    for (auto i = 0uz; i < g_pushes; ++i) {
+        auto size = list.size();
+        list.push_back(Value{ i });
+        stats.step(list, capacity, size);
+    }
+    stats.print();
+}
+
+// a queue that fills up to g_pushes / g_cycles elements then drains completely, g_cycles times: the cost of
+// growing and shrinking
+template <GrowthPolicy Growth>
+void sawtooth(std::string_view name)
+{
+    constexpr auto policy = dsa::BufferPolicy{
+        .m_capacity = dsa::BufferCapacityPolicy::DynamicCapacity,
+        .m_store    = dsa::BufferStorePolicy::ThrowOnFull,
+        .m_growth   = Growth,
+    };
+    constexpr auto peak = g_pushes / g_cycles;
+
+    auto run = [](auto& buffer, auto&& onStep) {
+        auto sum = Value{ 0 };
+        for (auto cycle = 0uz; cycle < g_cycles; ++cycle) {
+            for (auto i = 0uz; i < peak; ++i) {
+                auto size = buffer.size();
+                buffer.push_back(Value{ i });
+                onStep(size);
+            }
+            for (auto i = 0uz; i < peak; ++i) {
+                auto size  = buffer.size();
+                sum       += buffer.pop_front();
+                onStep(size);
+            }
+        }
+        return sum;
+    };
+
+    auto none = [] { return 0; };
+    report(name, 2 * g_pushes, measureBest(3, none, [&](int) {
+        auto buffer = dsa::CircularBuffer<Value, policy>{ 0 };
+        doNotOptimize(run(buffer, [](std::size_t) { }));
+    }));
+
+    auto stats    = Stats{};
+    auto buffer   = dsa::CircularBuffer<Value, policy>{ 0 };
+    auto capacity = buffer.capacity();
+    run(buffer, [&](std::size_t size) { stats.step(buffer, capacity, size); });
+    stats.print();
+}
+
+int main()
+{
+    using enum GrowthFactor;
+
+    constexpr auto double_    = GrowthPolicy{ .m_factor = Double };
+    constexpr auto oneAndHalf = GrowthPolicy{ .m_factor = OneAndHalf };
+    constexpr auto increment  = GrowthPolicy{ .m_factor = FixedIncrement, .m_increment = 65536 };
+    constexpr auto sizeClass  = GrowthPolicy{ .m_factor = SizeClass };
+
+    bench_util::header(fmt::format("ArrayList<uint64_t> push_back x {}", g_pushes));
+    pushBack<double_>("2x");
+    pushBack<oneAndHalf>("1.5x");
+    pushBack<increment>("+65536");
+    pushBack<sizeClass>("1.5x size class");
+
+    auto peak = g_pushes / g_cycles;
+    bench_util::header(fmt::format("CircularBuffer<uint64_t> sawtooth {} x {}", g_cycles, peak));
+    auto shrinking = [](GrowthPolicy policy, std::uint8_t divisor) {
+        policy.m_shrinkDivisor = divisor;
+        return policy;
+    };
+    sawtooth<shrinking(double_, 0)>("2x, never shrink");
+    sawtooth<shrinking(double_, 3)>("2x, halve at 1/3");
+    sawtooth<shrinking(double_, 4)>("2x, halve at 1/4 (default)");
+    sawtooth<shrinking(double_, 8)>("2x, halve at 1/8");
+    sawtooth<shrinking(oneAndHalf, 4)>("1.5x, halve at 1/4");
+    sawtooth<shrinking(increment, 4)>("+65536, halve at 1/4");
+    sawtooth<shrinking(sizeClass, 4)>("1.5x size class, halve at 1/4");
+}
@@ -0,0 +1,214 @@
+#include "bench_util.hpp"
+
+#include <dsa/lru_cache.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Key   = std::uint64_t;
+using Value = std::uint64_t;
+
+// the textbook LRU: a std::list in recency order and a std::unordered_map of iterators into it
+class StdLru
+{
+public:
+    StdLru(std::size_t capacity)
+        : m_capacity{ capacity }
+    {
+        m_map.reserve(capacity);
+    }
+
+    Value* get(const Key& key)
+    {
+        auto it = m_map.find(key);
+        if (it == m_map.end()) {
+            return nullptr;
+        }
+        m_list.splice(m_list.begin(), m_list, it->second);
+        return &it->second->second;
+    }
+
+    void put(Key key, Value value)
+    {
+        if (auto it = m_map.find(key); it != m_map.end()) {
+            it->second->second = value;
+            m_list.splice(m_list.begin(), m_list, it->second);
+            return;
+        }
+        if (m_list.size() == m_capacity) {
+            m_map.erase(m_list.back().first);
+            m_list.pop_back();
+        }
+        m_list.emplace_front(key, value);
+        m_map[key] = m_list.begin();
+    }
+
+private:
+    using List = std::list<std::pair<Key, Value>>;
+
+    std::size_t                             m_capacity;
+    List                                    m_list;
+    std::unordered_map<Key, List::iterator> m_map;
+};
+
+std::vector<Key> makeKeys(std::size_t count, Key max)
+{
+    auto dist = std::uniform_int_distribution<Key>{ 0, max };
+    auto keys = std::vector<Key>(count);
+    for (auto& key : keys) {
+        key = dist(bench_util::rng());
+    }
+    return keys;
+}
+
+// every lookup hits, the time is dominated by the index probe and the recency update
+template <typename Cache>
+void hits(std::string_view name, std::size_t capacity, const std::vector<Key>& lookups)
+{
+    auto setup = [&] {
+        auto cache = Cache{ capacity };
+        for (auto key = Key{ 0 }; key < capacity; ++key) {
+            cache.put(key, key);
+        }
+        return cache;
+    };
+
+    auto time = measureBest(3, setup, [&](Cache& cache) {
+        auto sum = Value{ 0 };
+        for (auto key : lookups) {
+            sum += *cache.get(key);
+        }
+        doNotOptimize(sum);
+    });
+
+    report(name, lookups.size(), time);
+}
+
+// keys drawn from twice the capacity: about half of the lookups miss and are followed by a put that evicts
+template <typename Cache>
+void mixed(std::string_view name, std::size_t capacity, const std::vector<Key>& lookups)
+{
+    auto setup = [&] { return Cache{ capacity }; };
+    auto time  = measureBest(3, setup, [&](Cache& cache) {
+        auto sum = Value{ 0 };
+        for (auto key : lookups) {
+            if (auto* value = cache.get(key); value != nullptr) {
+                sum += *value;
+            } else {
+                cache.put(key, key);
+            }
+        }
+        doNotOptimize(sum);
+    });
+
+    report(name, lookups.size(), time);
+}
+
+// aggregate throughput of hits from several threads, reported per operation of all threads combined
+template <typename Sharded>
+void concurrentHits(std::string_view name, std::size_t capacity, std::size_t threads, std::size_t shards)
+{
+    constexpr auto perThread = 2'000'000uz;
+
+    auto cache = Sharded{ capacity, shards };
+    for (auto key = Key{ 0 }; key < capacity; ++key) {
+        cache.put(key, key);
+    }
+
+    // each shard holds a bit more than its share, every key stays resident
+    auto keys = std::vector<std::vector<Key>>{};
+    for (auto i = 0uz; i < threads; ++i) {
+        keys.push_back(makeKeys(perThread, capacity / 2));
+    }
+
+    auto setup = [] { return 0; };
+    auto time  = measureBest(3, setup, [&](int) {
+        auto workers = std::vector<std::jthread>{};
+        for (auto i = 0uz; i < threads; ++i) {
+            workers.emplace_back([&, i] {
+                auto sum = Value{ 0 };
+                for (auto key : keys[i]) {
+                    sum += cache.get(key).value_or(0);
+                }
+                doNotOptimize(sum);
+            });
+        }
+    });
+
+    report(fmt::format("{} ({} threads, {} shards)", name, threads, shards), perThread * threads, time);
+}
+
+// a global mutex around the whole cache, what ShardedCache with one shard amounts to
+class LockedStdLru
+{
+public:
+    LockedStdLru(std::size_t capacity, std::size_t)
+        : m_cache{ capacity }
+    {
+    }
+
+    std::optional<Value> get(const Key& key)
+    {
+        auto lock  = std::scoped_lock{ m_mutex };
+        auto value = m_cache.get(key);
+        return value == nullptr ? std::nullopt : std::optional{ *value };
+    }
+
+    void put(Key key, Value value)
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        m_cache.put(key, value);
+    }
+
+private:
+    std::mutex m_mutex;
+    StdLru     m_cache;
+};
+
+using Lru   = dsa::LruCache<Key, Value>;
+using Clock = dsa::ClockCache<Key, Value>;
+
+int main()
+{
+    constexpr auto count = 10'000'000uz;
+
+    for (auto capacity : { 1'000uz, 100'000uz, 4'000'000uz }) {
+        auto resident = makeKeys(count, capacity - 1);
+        auto twice    = makeKeys(count, capacity * 2 - 1);
+
+        bench_util::header(fmt::format("hit path, capacity {}", capacity));
+        hits<Lru>("LruCache", capacity, resident);
+        hits<Clock>("ClockCache", capacity, resident);
+        hits<StdLru>("std::list + std::unordered_map", capacity, resident);
+
+        bench_util::header(fmt::format("get or put, keys in 2x capacity {}", capacity));
+        mixed<Lru>("LruCache", capacity, twice);
+        mixed<Clock>("ClockCache", capacity, twice);
+        mixed<StdLru>("std::list + std::unordered_map", capacity, twice);
+    }
+
+    auto hardware = std::max(std::thread::hardware_concurrency(), 1u);
+
+    bench_util::header("concurrent hit path, capacity 100000");
+    for (auto threads = 1uz; threads <= hardware; threads *= 2) {
+        concurrentHits<dsa::ShardedCache<Lru>>("ShardedCache<LruCache>", 100'000, threads, threads * 4);
+        concurrentHits<dsa::ShardedCache<Clock>>("ShardedCache<ClockCache>", 100'000, threads, threads * 4);
+        concurrentHits<LockedStdLru>("mutex + std LRU", 100'000, threads, 1);
+    }
+}
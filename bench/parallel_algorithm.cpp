@@ -0,0 +1,140 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/parallel_algorithm.hpp>
+#include <dsa/rootish_array.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <thread>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Value = std::uint32_t;
+
+constexpr auto g_size = 100'000'000uz;
+
+// 1, 2, 4, ... up to every hardware thread, and the hardware thread count itself
+dsa::ArrayList<std::size_t> threadCounts()
+{
+    auto hardware = std::max(1uz, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    auto counts   = dsa::ArrayList<std::size_t>{};
+    for (auto threads = 1uz; threads < hardware; threads *= 2) {
+        counts.push_back(auto{ threads });
+    }
+    counts.push_back(auto{ hardware });
+    return counts;
+}
+
+// runs of equal values a few elements long so unique has something to remove
+dsa::ArrayList<Value> makeInput()
+{
+    auto list = dsa::ArrayList<Value>{};
+    list.reserve(g_size);
+
+    auto dist = std::uniform_int_distribution<Value>{ 0, 3 };
+    for (auto i = 0uz; i < g_size; ++i) {
+        list.push_back(static_cast<Value>(i / 4 * 2 + dist(bench_util::rng()) / 3));
+    }
+    return list;
+}
+
+template <typename Fn>
+void run(std::string_view name, Fn&& fn)
+{
+    auto setup = [] { return 0; };
+    report(name, g_size, measureBest(3, setup, [&](int) { fn(); }));
+}
+
+int main()
+{
+    fmt::println("hardware threads: {}", std::thread::hardware_concurrency());
+
+    auto input  = makeInput();
+    auto output = dsa::ArrayList<Value>(g_size);
+    auto counts = threadCounts();
+
+    auto isEven = [](Value value) { return value % 2 == 0; };
+
+    bench_util::header(fmt::format("inclusive_scan, {} x uint32_t", g_size));
+    run("std::inclusive_scan", [&] { std::inclusive_scan(input.begin(), input.end(), output.begin()); });
+    for (auto threads : counts) {
+        run(fmt::format("dsa::parallel_inclusive_scan ({:>2} threads)", threads), [&] {
+            dsa::parallel_inclusive_scan(input, output, std::plus<>{}, threads);
+        });
+    }
+
+    bench_util::header(fmt::format("exclusive_scan, {} x uint32_t", g_size));
+    run("std::exclusive_scan", [&] { std::exclusive_scan(input.begin(), input.end(), output.begin(), 0u); });
+    for (auto threads : counts) {
+        run(fmt::format("dsa::parallel_exclusive_scan ({:>2} threads)", threads), [&] {
+            dsa::parallel_exclusive_scan(input, output, 0u, std::plus<>{}, threads);
+        });
+    }
+
+    bench_util::header(fmt::format("copy_if (about half), {} x uint32_t", g_size));
+    run("std::copy_if", [&] {
+        doNotOptimize(std::copy_if(input.begin(), input.end(), output.begin(), isEven));
+    });
+    for (auto threads : counts) {
+        run(fmt::format("dsa::parallel_copy_if ({:>2} threads)", threads), [&] {
+            doNotOptimize(dsa::parallel_copy_if(input, output, isEven, threads));
+        });
+    }
+
+    bench_util::header(fmt::format("unique_copy, {} x uint32_t", g_size));
+    run("std::unique_copy", [&] {
+        doNotOptimize(std::unique_copy(input.begin(), input.end(), output.begin()));
+    });
+    for (auto threads : counts) {
+        run(fmt::format("dsa::parallel_unique_copy ({:>2} threads)", threads), [&] {
+            doNotOptimize(dsa::parallel_unique_copy(input, output, std::ranges::equal_to{}, threads));
+        });
+    }
+
+    bench_util::header(fmt::format("stable_partition (out of place), {} x uint32_t", g_size));
+    auto falses = dsa::ArrayList<Value>(g_size);
+    run("std::partition_copy", [&] {
+        auto first = input.begin();
+        doNotOptimize(std::partition_copy(first, input.end(), output.begin(), falses.begin(), isEven));
+    });
+    for (auto threads : counts) {
+        run(fmt::format("dsa::parallel_stable_partition ({:>2} threads)", threads), [&] {
+            doNotOptimize(dsa::parallel_stable_partition(input, output, isEven, threads));
+        });
+    }
+
+    // in place: the input is copied before every run, not measured
+    bench_util::header(fmt::format("partition (in place), {} x uint32_t", g_size));
+    auto partition = [&](std::string_view name, auto&& fn) {
+        auto setup = [&] { return auto{ input }; };
+        report(name, g_size, measureBest(3, setup, [&](dsa::ArrayList<Value>& list) { fn(list); }));
+    };
+    partition("std::partition", [&](auto& list) {
+        doNotOptimize(std::partition(list.begin(), list.end(), isEven));
+    });
+    for (auto threads : counts) {
+        partition(fmt::format("dsa::parallel_partition ({:>2} threads)", threads), [&](auto& list) {
+            doNotOptimize(dsa::parallel_partition(list, isEven, threads));
+        });
+    }
+
+    // a segmented input: one contiguous run per block
+    auto rootish = dsa::RootishArray<Value>{ std::from_range, input };
+    bench_util::header(fmt::format("inclusive_scan from a RootishArray, {} x uint32_t", g_size));
+    run("std::inclusive_scan", [&] { std::inclusive_scan(rootish.begin(), rootish.end(), output.begin()); });
+    for (auto threads : counts) {
+        run(fmt::format("dsa::parallel_inclusive_scan ({:>2} threads)", threads), [&] {
+            dsa::parallel_inclusive_scan(rootish, output, std::plus<>{}, threads);
+        });
+    }
+}
@@ -0,0 +1,96 @@
+#include "bench_util.hpp"
+
+#include <dsa/circular_buffer.hpp>
+#include <dsa/persistent_ring.hpp>
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include <unistd.h>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+namespace fs = std::filesystem;
+
+// a typical flight recorder entry: timestamp, event id, and a few arguments
+struct Record
+{
+    std::uint64_t m_timestamp;
+    std::uint32_t m_event;
+    std::uint32_t m_thread;
+    std::uint64_t m_args[2];
+};
+
+using Ring = dsa::PersistentRing<Record>;
+
+constexpr auto g_capacity = 1uz << 20;    // 32MB of records
+
+fs::path ringPath()
+{
+    return fs::temp_directory_path() / fmt::format("dsa-bench-ring-{}", ::getpid());
+}
+
+Record makeRecord(std::size_t i)
+{
+    return { i, static_cast<std::uint32_t>(i % 97), 1, { i * 3, i * 7 } };
+}
+
+// syncEvery == 0 never syncs
+void append(std::string_view name, std::size_t count, std::size_t syncEvery)
+{
+    auto path  = ringPath();
+    auto setup = [&] {
+        fs::remove(path);
+        return Ring{ path, g_capacity };
+    };
+
+    auto time = measureBest(3, setup, [&](Ring& ring) {
+        for (auto i = 0uz; i < count; ++i) {
+            ring.push_back(makeRecord(i));
+            if (syncEvery != 0 and i % syncEvery == syncEvery - 1) {
+                ring.sync();
+            }
+        }
+        doNotOptimize(ring);
+    });
+
+    report(name, count, time);
+    fs::remove(path);
+}
+
+void appendInMemory(std::string_view name, std::size_t count)
+{
+    auto setup = [] { return dsa::CircularBuffer<Record>{ g_capacity }; };
+    auto time  = measureBest(3, setup, [&](dsa::CircularBuffer<Record>& buffer) {
+        for (auto i = 0uz; i < count; ++i) {
+            buffer.push_back(makeRecord(i));
+        }
+        doNotOptimize(buffer);
+    });
+
+    report(name, count, time);
+}
+
+int main()
+{
+    fmt::println("ring file in {} (a tmpfs makes msync nearly free)", fs::temp_directory_path().string());
+
+    // wraps around the ring several times, ReplaceOnFull in the steady state
+    constexpr auto count = g_capacity * 4;
+
+    bench_util::header(fmt::format("append {} records of {} bytes", count, sizeof(Record)));
+    appendInMemory("CircularBuffer (in memory)", count);
+    append("PersistentRing (no msync)", count, 0);
+    append("PersistentRing (msync every 65536 records)", count, 65'536);
+    append("PersistentRing (msync every 1024 records)", count, 1'024);
+
+    // msync is a syscall that flushes the whole mapping, per record it dominates everything
+    bench_util::header("append 20000 records, msync after each");
+    append("PersistentRing (msync every record)", 20'000, 1);
+}
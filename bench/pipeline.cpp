@@ -0,0 +1,103 @@
+#include "bench_util.hpp"
+
+#include <dsa/pipeline.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+using bench_util::Clock;
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+namespace rr = std::ranges;
+namespace rv = std::views;
+
+// an item remembers when it entered the pipeline, the sink measures the latency
+struct Item
+{
+    std::uint64_t     m_value;
+    Clock::time_point m_created;
+
+    explicit Item(std::uint64_t value)
+        : m_value{ value }
+        , m_created{ Clock::now() }
+    {
+    }
+};
+
+constexpr auto g_items    = 2'000'000uz;
+constexpr auto g_capacity = 1024uz;
+
+// a few ns of work per item and stage, a stage should not be all handoff
+std::uint64_t mix(std::uint64_t value)
+{
+    for (auto i = 0; i < 4; ++i) {
+        value ^= value >> 31;
+        value *= 0x9e37'79b9'7f4a'7c15ull;
+    }
+    return value;
+}
+
+// the latencies are the ones of the last run
+void sweep(std::size_t batch)
+{
+    auto latencies = std::vector<double>{};
+    auto waits     = std::uint64_t{ 0 };
+
+    auto setup = [] { return 0; };
+    auto time  = measureBest(3, setup, [&](int) {
+        auto step = [](Item item) {
+            item.m_value = mix(item.m_value);
+            return item;
+        };
+
+        auto pipeline = dsa::Pipeline<Item>{ { .m_capacity = g_capacity, .m_batch = batch } }
+                            .stage("1", step)
+                            .stage("2", step)
+                            .stage("3", step);
+
+        latencies.clear();
+        latencies.reserve(g_items);
+        auto sum   = std::uint64_t{ 0 };
+        auto stats = pipeline.run(rv::iota(0uz, g_items), [&](Item item) {
+            sum += item.m_value;
+            auto latency = std::chrono::duration<double, std::micro>{ Clock::now() - item.m_created };
+            latencies.push_back(latency.count());
+        });
+        doNotOptimize(sum);
+
+        waits = 0;
+        for (const auto& stage : stats.m_stages) {
+            waits += stage.m_inputWaits + stage.m_outputWaits;
+        }
+    });
+
+    rr::sort(latencies);
+    auto mean = 0.0;
+    for (auto latency : latencies) {
+        mean += latency / static_cast<double>(latencies.size());
+    }
+    auto p99 = latencies[latencies.size() * 99 / 100];
+
+    report(fmt::format("batch {:>4}", batch), g_items, time);
+    fmt::println("{:<50} {:>12.1f} us mean {:>9.1f} us p99 {:>9} waits", "", mean, p99, waits);
+}
+
+int main()
+{
+    fmt::println("hardware threads: {}", std::thread::hardware_concurrency());
+
+    auto title = fmt::format("{} items, ring capacity {}, source + 3 stages + sink", g_items, g_capacity);
+    bench_util::header(title);
+    for (auto batch : { 1uz, 4uz, 16uz, 64uz, 256uz, 1024uz }) {
+        sweep(batch);
+    }
+}
@@ -0,0 +1,70 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/radix_sort.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string_view>
+
+using bench_util::measureBest;
+using bench_util::report;
+
+template <typename T>
+dsa::ArrayList<T> makeList(std::size_t size)
+{
+    auto list = dsa::ArrayList<T>{};
+    list.reserve(size);
+
+    for (auto i = 0uz; i < size; ++i) {
+        if constexpr (std::floating_point<T>) {
+            list.push_back(std::normal_distribution<T>{ 0, 1e6 }(bench_util::rng()));
+        } else {
+            list.push_back(static_cast<T>(std::uniform_int_distribution<std::uint64_t>{}(bench_util::rng())));
+        }
+    }
+    return list;
+}
+
+template <typename T>
+void bench(std::string_view name, std::size_t size)
+{
+    bench_util::header(fmt::format("{}, size: {}", name, size));
+
+    auto source = makeList<T>(size);
+    auto setup  = [&] { return auto{ source }; };
+
+    auto run = [&](std::string_view label, auto&& sort) {
+        report(label, size, measureBest(3, setup, [&](dsa::ArrayList<T>& list) { sort(list); }));
+    };
+
+    run("std::sort", [](auto& list) { std::sort(list.begin(), list.end()); });
+    run("std::stable_sort", [](auto& list) { std::stable_sort(list.begin(), list.end()); });
+    run("dsa::radix_sort<8>", [](auto& list) { dsa::radix_sort<8>(list); });
+    run("dsa::radix_sort<11>", [](auto& list) { dsa::radix_sort<11>(list); });
+    run("dsa::radix_sort<16>", [](auto& list) { dsa::radix_sort<16>(list); });
+
+    // the scratch is allocated once and reused by every run
+    auto scratch = dsa::RawBuffer<T>{ size };
+    run("dsa::radix_sort<11> (reused scratch)", [&](auto& list) {
+        dsa::radix_sort<11>(list, std::identity{}, scratch);
+    });
+
+    run("dsa::parallel_radix_sort<8>", [](auto& list) { dsa::parallel_radix_sort<8>(list); });
+    run("dsa::parallel_radix_sort<11>", [](auto& list) { dsa::parallel_radix_sort<11>(list); });
+}
+
+int main()
+{
+    for (auto size : { 1'000'000uz, 10'000'000uz, 50'000'000uz }) {
+        bench<std::uint32_t>("uint32_t", size);
+        bench<std::int64_t>("int64_t", size);
+        bench<double>("double", size);
+    }
+
+    // narrow keys need a single pass with 16-bit digits
+    bench<std::uint16_t>("uint16_t", 10'000'000uz);
+}
@@ -0,0 +1,98 @@
+#include "bench_util.hpp"
+
+#include <dsa/segment_tree.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Tree = dsa::SegmentTree<std::int64_t, dsa::Sum<std::int64_t>, dsa::RangeAdd<std::int64_t>>;
+
+struct RangeUpdate
+{
+    std::size_t  m_first;
+    std::size_t  m_last;
+    std::int64_t m_value;
+};
+
+std::vector<RangeUpdate> makeUpdates(std::size_t size, std::size_t count, std::size_t maxLength)
+{
+    auto posDist   = std::uniform_int_distribution<std::size_t>{ 0, size - 1 };
+    auto lenDist   = std::uniform_int_distribution<std::size_t>{ 1, maxLength };
+    auto valueDist = std::uniform_int_distribution<std::int64_t>{ -100, 100 };
+
+    auto updates = std::vector<RangeUpdate>(count);
+    for (auto& [first, last, value] : updates) {
+        first = posDist(bench_util::rng());
+        last  = std::min(size, first + lenDist(bench_util::rng()));
+        value = valueDist(bench_util::rng());
+    }
+    return updates;
+}
+
+int main()
+{
+    constexpr auto batch = 100'000uz;
+
+    for (auto size : { 1'000'000uz, 10'000'000uz }) {
+        auto counters = std::vector<std::int64_t>(size, 1);
+
+        bench_util::header(fmt::format("build, size: {}", size));
+        auto build = measureBest(3, [] { return 0; }, [&](int) { doNotOptimize(Tree{ counters }); });
+        report("SegmentTree build", size, build);
+
+        for (auto maxLength : { 16uz, 4096uz, size }) {
+            bench_util::header(fmt::format("size: {}, batch: {}, max range: {}", size, batch, maxLength));
+
+            auto updates = makeUpdates(size, batch, maxLength);
+
+            auto lazy = measureBest(
+                3,
+                [&] { return Tree{ counters }; },
+                [&](Tree& tree) {
+                    for (auto [first, last, value] : updates) {
+                        tree.update(first, last, value);
+                    }
+                }
+            );
+            report("SegmentTree range update", batch, lazy);
+
+            // the naive loop is too slow to be measured on long ranges
+            if (maxLength <= 4096) {
+                auto naive = measureBest(
+                    1,
+                    [&] { return counters; },
+                    [&](std::vector<std::int64_t>& values) {
+                        for (auto [first, last, value] : updates) {
+                            for (auto i = first; i < last; ++i) {
+                                values[i] += value;
+                            }
+                        }
+                        doNotOptimize(values.data());
+                    }
+                );
+                report("naive loop range update", batch, naive);
+            }
+
+            auto tree    = Tree{ counters };
+            auto queries = measureBest(
+                3,
+                [] { return 0; },
+                [&](int) {
+                    for (auto [first, last, _] : updates) {
+                        doNotOptimize(tree.query(first, last));
+                    }
+                }
+            );
+            report("SegmentTree range query", batch, queries);
+        }
+    }
+}
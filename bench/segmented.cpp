@@ -0,0 +1,121 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/segmented.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string_view>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::reportBandwidth;
+
+namespace seg = dsa::segmented;
+
+template <typename Container>
+void bench(std::string_view name, Container& container)
+{
+    using T = typename Container::value_type;
+
+    auto bytes  = container.size() * sizeof(T);
+    auto none   = [] { return 0; };
+    auto absent = T{ -1 };    // never present, find has to scan everything
+    auto out    = dsa::ArrayList<T>{};
+    for (auto i = 0uz; i < container.size(); ++i) {
+        out.push_back(T{});
+    }
+
+    bench_util::header(fmt::format("{}, {} MB", name, bytes / 1'000'000));
+
+    auto run = [&](std::string_view label, auto&& fn) {
+        reportBandwidth(label, bytes, measureBest(5, none, [&](int) { fn(); }));
+    };
+
+    run("std::for_each (iterator)", [&] {
+        auto sum = T{};
+        std::for_each(container.begin(), container.end(), [&](T value) { sum ^= value; });
+        doNotOptimize(sum);
+    });
+    run("segmented::for_each", [&] {
+        auto sum = T{};
+        seg::for_each(container, [&](T value) { sum ^= value; });
+        doNotOptimize(sum);
+    });
+
+    run("std::accumulate (iterator)", [&] {
+        doNotOptimize(std::accumulate(container.begin(), container.end(), std::int64_t{}));
+    });
+    run("segmented::accumulate", [&] { doNotOptimize(seg::accumulate(container, std::int64_t{})); });
+
+    run("std::find (iterator)", [&] {
+        doNotOptimize(std::find(container.begin(), container.end(), absent));
+    });
+    run("segmented::find", [&] { doNotOptimize(seg::find(container, absent)); });
+
+    run("std::copy (iterator)", [&] {
+        doNotOptimize(std::copy(container.begin(), container.end(), out.data()));
+    });
+    run("segmented::copy (to pointer)", [&] { doNotOptimize(seg::copy(container, out.data())); });
+    run("segmented::copy (from ArrayList)", [&] { doNotOptimize(seg::copy(out, container)); });
+
+    run("std::fill (iterator)", [&] {
+        std::fill(container.begin(), container.end(), T{ 1 });
+        doNotOptimize(container);
+    });
+    run("segmented::fill", [&] {
+        seg::fill(container, T{ 2 });
+        doNotOptimize(container);
+    });
+}
+
+template <typename Container>
+Container makeContainer(std::size_t size)
+{
+    using T = typename Container::value_type;
+
+    auto dist      = std::uniform_int_distribution<int>{ 0, 1000 };
+    auto container = [&] {
+        if constexpr (std::same_as<Container, dsa::CircularBuffer<T>>) {
+            return Container{ size };
+        } else if constexpr (std::same_as<Container, dsa::BlockyLinkedList<T>>) {
+            return Container{ 1024 };
+        } else {
+            return Container{};
+        }
+    }();
+
+    // push a bit more than the capacity so the circular buffer wraps around
+    auto count = std::same_as<Container, dsa::CircularBuffer<T>> ? size + size / 3 : size;
+    for (auto i = 0uz; i < count; ++i) {
+        container.push_back(static_cast<T>(dist(bench_util::rng())));
+    }
+    return container;
+}
+
+int main()
+{
+    // 16M elements, 64MB of 32-bit values
+    constexpr auto size = 16uz << 20;
+
+    auto buffer = makeContainer<dsa::CircularBuffer<std::int32_t>>(size);
+    bench("CircularBuffer<int32_t>", buffer);
+
+    auto array = makeContainer<dsa::RootishArray<std::int32_t>>(size);
+    bench("RootishArray<int32_t>", array);
+
+    // the iterator of BlockyLinkedList locates every element from the head, so keep it small
+    auto list = makeContainer<dsa::BlockyLinkedList<std::int32_t>>(size / 64);
+    bench("BlockyLinkedList<int32_t> (b = 1024)", list);
+
+    // cache resident, 64KB
+    auto small = makeContainer<dsa::RootishArray<std::int32_t>>(16384);
+    bench("RootishArray<int32_t> (L2)", small);
+}
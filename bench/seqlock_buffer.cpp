@@ -0,0 +1,117 @@
+#include "bench_util.hpp"
+
+#include <dsa/circular_buffer.hpp>
+#include <dsa/seqlock_buffer.hpp>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+struct Sample
+{
+    std::uint64_t m_timestamp;
+    std::uint64_t m_values[3];
+};
+
+// the baseline: a ReplaceOnFull CircularBuffer behind a mutex, a snapshot copies under the lock
+class LockedBuffer
+{
+public:
+    LockedBuffer(std::size_t capacity)
+        : m_buffer{ capacity }
+    {
+    }
+
+    void push_back(const Sample& sample)
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        m_buffer.push_back(auto{ sample });
+    }
+
+    std::size_t snapshot(std::span<Sample> out) const
+    {
+        auto lock  = std::scoped_lock{ m_mutex };
+        auto count = std::min(out.size(), m_buffer.size());
+        for (auto i = 0uz; i < count; ++i) {
+            out[i] = m_buffer.at(m_buffer.size() - count + i);
+        }
+        return count;
+    }
+
+    std::uint64_t retries() const { return 0; }
+
+private:
+    mutable std::mutex          m_mutex;
+    dsa::CircularBuffer<Sample> m_buffer;
+};
+
+constexpr auto g_capacity = 4096uz;
+constexpr auto g_writes   = 10'000'000uz;
+
+// the writer pushes as fast as it can while the readers snapshot the latest values in a loop
+template <typename Buffer>
+void writer(std::string_view name, std::size_t readers, std::size_t window)
+{
+    auto snapshots = std::uint64_t{ 0 };
+    auto retries   = std::uint64_t{ 0 };
+
+    auto setup = [] { return 0; };
+    auto time  = measureBest(3, setup, [&](int) {
+        auto buffer = Buffer{ g_capacity };
+        auto done   = std::atomic<bool>{ false };
+        auto count  = std::atomic<std::uint64_t>{ 0 };
+
+        auto threads = std::vector<std::jthread>{};
+        for (auto r = 0uz; r < readers; ++r) {
+            threads.emplace_back([&] {
+                auto out   = std::vector<Sample>(window);
+                auto local = 0uz;
+                while (not done.load(std::memory_order_relaxed)) {
+                    doNotOptimize(buffer.snapshot(out));
+                    ++local;
+                }
+                count += local;
+            });
+        }
+
+        for (auto i = 0uz; i < g_writes; ++i) {
+            buffer.push_back(Sample{ i, { i, i + 1, i + 2 } });
+        }
+        done = true;
+        threads.clear();
+
+        snapshots = count.load();
+        retries   = buffer.retries();
+    });
+
+    report(fmt::format("{} ({} readers)", name, readers), g_writes, time);
+    if (readers > 0) {
+        fmt::println("{:<50} {:>12} snapshots {:>9} retries", "", snapshots, retries);
+    }
+}
+
+int main()
+{
+    fmt::println("hardware threads: {}", std::thread::hardware_concurrency());
+
+    for (auto window : { 64uz, 1024uz }) {
+        bench_util::header(
+            fmt::format("{} writes, capacity {}, snapshots of {}", g_writes, g_capacity, window)
+        );
+        for (auto readers : { 0uz, 1uz, 2uz, 4uz }) {
+            writer<dsa::SeqlockBuffer<Sample>>("SeqlockBuffer", readers, window);
+            writer<LockedBuffer>("mutex + CircularBuffer", readers, window);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/simd.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string_view>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::reportBandwidth;
+
+namespace simd = dsa::simd;
+
+std::string_view toString(simd::Isa isa)
+{
+    switch (isa) {
+    case simd::Isa::Scalar: return "scalar";
+    case simd::Isa::Sse2: return "sse2";
+    case simd::Isa::Avx2: return "avx2";
+    }
+    return "";
+}
+
+template <typename T, typename Container>
+void bench(std::string_view name, const Container& container)
+{
+    auto bytes  = container.size() * sizeof(T);
+    auto none   = [] { return 0; };
+    auto absent = T{ -1 };    // never present, find has to scan everything
+
+    bench_util::header(fmt::format("{}, {} MB", name, bytes / 1'000'000));
+
+    auto run = [&](std::string_view label, auto&& fn) {
+        reportBandwidth(label, bytes, measureBest(5, none, [&](int) { fn(); }));
+    };
+
+    run("std::find (iterator)", [&] {
+        doNotOptimize(std::find(container.begin(), container.end(), absent));
+    });
+    run("std::count (iterator)", [&] {
+        doNotOptimize(std::count(container.begin(), container.end(), absent));
+    });
+    run("std::minmax_element (iterator)", [&] {
+        doNotOptimize(std::minmax_element(container.begin(), container.end()));
+    });
+    run("std::accumulate (iterator)", [&] {
+        doNotOptimize(std::accumulate(container.begin(), container.end(), simd::Accumulator<T>{}));
+    });
+
+    for (auto isa : { simd::Isa::Scalar, simd::Isa::Sse2, simd::Isa::Avx2 }) {
+        if (isa > simd::detectIsa()) {
+            continue;
+        }
+        simd::setIsa(isa);
+
+        auto name = toString(isa);
+        run(fmt::format("simd::find ({})", name), [&] { doNotOptimize(simd::find(container, absent)); });
+        run(fmt::format("simd::count ({})", name), [&] { doNotOptimize(simd::count(container, absent)); });
+        run(fmt::format("simd::minmax ({})", name), [&] { doNotOptimize(simd::minmax(container)); });
+        run(fmt::format("simd::sum ({})", name), [&] { doNotOptimize(simd::sum(container)); });
+    }
+
+    simd::setIsa(simd::detectIsa());
+}
+
+template <typename T, typename Container>
+Container makeContainer(std::size_t size)
+{
+    auto dist      = std::uniform_int_distribution<int>{ 0, 1000 };
+    auto container = [&] {
+        if constexpr (std::same_as<Container, dsa::CircularBuffer<T>>) {
+            return Container{ size };
+        } else {
+            return Container{};
+        }
+    }();
+
+    // push a bit more than the capacity so the circular buffer wraps around
+    auto count = std::same_as<Container, dsa::CircularBuffer<T>> ? size + size / 3 : size;
+    for (auto i = 0uz; i < count; ++i) {
+        container.push_back(static_cast<T>(dist(bench_util::rng())));
+    }
+    return container;
+}
+
+int main()
+{
+    // 16M elements, 64MB of 32-bit values: bigger than the caches so this measures memory bandwidth
+    constexpr auto size = 16uz << 20;
+
+    using Int32List = dsa::ArrayList<std::int32_t>;
+
+    bench<std::int32_t>("ArrayList<int32_t>", makeContainer<std::int32_t, Int32List>(size));
+    bench<float>("ArrayList<float>", makeContainer<float, dsa::ArrayList<float>>(size));
+    bench<std::int32_t>(
+        "CircularBuffer<int32_t>", makeContainer<std::int32_t, dsa::CircularBuffer<std::int32_t>>(size)
+    );
+    bench<float>("RootishArray<float>", makeContainer<float, dsa::RootishArray<float>>(size));
+
+    // cache resident, 64KB
+    bench<std::int32_t>("ArrayList<int32_t> (L2)", makeContainer<std::int32_t, Int32List>(16384));
+}
@@ -0,0 +1,106 @@
+#include "bench_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/sort.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using bench_util::measureBest;
+using bench_util::report;
+
+using Value = std::int64_t;
+
+enum class Input
+{
+    Sorted,
+    Reversed,
+    Random,
+    Duplicates,
+};
+
+std::string_view toString(Input input)
+{
+    switch (input) {
+    case Input::Sorted: return "sorted";
+    case Input::Reversed: return "reversed";
+    case Input::Random: return "random";
+    case Input::Duplicates: return "many duplicates";
+    }
+    return "";
+}
+
+std::vector<Value> makeInput(Input input, std::size_t size)
+{
+    auto random = std::uniform_int_distribution<Value>{};
+    auto dups   = std::uniform_int_distribution<Value>{ 0, 15 };
+
+    auto values = std::vector<Value>(size);
+    for (auto i = 0uz; i < size; ++i) {
+        switch (input) {
+        case Input::Sorted: values[i] = static_cast<Value>(i); break;
+        case Input::Reversed: values[i] = static_cast<Value>(size - i); break;
+        case Input::Random: values[i] = random(bench_util::rng()); break;
+        case Input::Duplicates: values[i] = dups(bench_util::rng()); break;
+        }
+    }
+    return values;
+}
+
+template <typename Container>
+Container makeContainer(const std::vector<Value>& values)
+{
+    if constexpr (std::same_as<Container, dsa::CircularBuffer<Value>>) {
+        auto buffer = Container{ values.size() };
+        for (auto value : values) {
+            buffer.push_back(auto{ value });
+        }
+        return buffer;
+    } else {
+        auto container = Container{};
+        for (auto value : values) {
+            container.push_back(auto{ value });
+        }
+        return container;
+    }
+}
+
+template <typename Container>
+void bench(std::string_view name, std::size_t size, bool withStd)
+{
+    for (auto input : { Input::Sorted, Input::Reversed, Input::Random, Input::Duplicates }) {
+        bench_util::header(fmt::format("{}, {}, size: {}", name, toString(input), size));
+
+        auto values = makeInput(input, size);
+        auto setup  = [&] { return makeContainer<Container>(values); };
+
+        auto run = [&](std::string_view label, auto&& sort) {
+            report(label, size, measureBest(3, setup, [&](Container& container) { sort(container); }));
+        };
+
+        if (withStd) {
+            run("std::sort", [](auto& c) { std::sort(c.begin(), c.end()); });
+            run("std::stable_sort", [](auto& c) { std::stable_sort(c.begin(), c.end()); });
+        }
+        run("dsa::pdq_sort", [](auto& c) { dsa::pdq_sort(c); });
+        run("dsa::merge_sort", [](auto& c) { dsa::merge_sort(c); });
+        run("dsa::parallel_merge_sort", [](auto& c) { dsa::parallel_merge_sort(c); });
+    }
+}
+
+int main()
+{
+    bench<dsa::ArrayList<Value>>("ArrayList", 1'000'000, true);
+    bench<dsa::ArrayList<Value>>("ArrayList", 10'000'000, true);
+
+    // iterator dereference is much more expensive on these, std algorithms are shown for reference
+    bench<dsa::RootishArray<Value>>("RootishArray", 1'000'000, true);
+    bench<dsa::CircularBuffer<Value>>("CircularBuffer", 1'000'000, true);
+}
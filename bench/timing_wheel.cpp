@@ -0,0 +1,207 @@
+#include "bench_util.hpp"
+
+#include <dsa/timing_wheel.hpp>
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using bench_util::doNotOptimize;
+using bench_util::measureBest;
+using bench_util::report;
+
+using Tick = std::uint64_t;
+
+// binary min-heap on the deadline with a position index so a timer can be cancelled in O(log n). ids are not
+// reused so a stale id is never confused with a newer timer
+class HeapTimers
+{
+public:
+    using TimerId = std::size_t;
+
+    TimerId schedule(Tick deadline, int payload)
+    {
+        auto id = m_position.size();
+        m_position.push_back(0);
+
+        m_heap.push_back({ deadline, id, payload });
+        m_position[id] = m_heap.size() - 1;
+        siftUp(m_heap.size() - 1);
+        return id;
+    }
+
+    bool cancel(TimerId id)
+    {
+        auto pos = m_position[id];
+        if (pos == s_none) {
+            return false;
+        }
+        removeAt(pos);
+        return true;
+    }
+
+    template <typename Fn>
+    std::size_t advance(Tick now, Fn&& fn)
+    {
+        auto fired = 0uz;
+        while (not m_heap.empty() and m_heap.front().m_deadline <= now) {
+            auto payload = m_heap.front().m_payload;
+            removeAt(0);
+            fn(std::move(payload));
+            ++fired;
+        }
+        return fired;
+    }
+
+private:
+    static constexpr std::size_t s_none = static_cast<std::size_t>(-1);
+
+    struct Entry
+    {
+        Tick    m_deadline;
+        TimerId m_id;
+        int     m_payload;
+    };
+
+    std::vector<Entry>       m_heap;
+    std::vector<std::size_t> m_position;
+
+    void removeAt(std::size_t pos)
+    {
+        auto id = m_heap[pos].m_id;
+        swapAt(pos, m_heap.size() - 1);
+        m_heap.pop_back();
+        if (pos < m_heap.size()) {
+            siftDown(pos);
+            siftUp(pos);
+        }
+        m_position[id] = s_none;
+    }
+
+    void swapAt(std::size_t a, std::size_t b)
+    {
+        std::swap(m_heap[a], m_heap[b]);
+        m_position[m_heap[a].m_id] = a;
+        m_position[m_heap[b].m_id] = b;
+    }
+
+    void siftUp(std::size_t pos)
+    {
+        while (pos > 0 and m_heap[pos].m_deadline < m_heap[(pos - 1) / 2].m_deadline) {
+            swapAt(pos, (pos - 1) / 2);
+            pos = (pos - 1) / 2;
+        }
+    }
+
+    void siftDown(std::size_t pos)
+    {
+        while (true) {
+            auto smallest = pos;
+            for (auto child : { 2 * pos + 1, 2 * pos + 2 }) {
+                if (child < m_heap.size() and m_heap[child].m_deadline < m_heap[smallest].m_deadline) {
+                    smallest = child;
+                }
+            }
+            if (smallest == pos) {
+                return;
+            }
+            swapAt(pos, smallest);
+            pos = smallest;
+        }
+    }
+};
+
+std::vector<Tick> makeDelays(std::size_t count, Tick min, Tick max)
+{
+    auto dist   = std::uniform_int_distribution<Tick>{ min, max };
+    auto delays = std::vector<Tick>(count);
+    for (auto& delay : delays) {
+        delay = dist(bench_util::rng());
+    }
+    return delays;
+}
+
+// schedule everything, cancel most of it (the common fate of a timeout), then run the clock to the end
+template <typename Timers>
+void scheduleCancelAdvance(std::string_view name, const std::vector<Tick>& delays, std::size_t cancelPercent)
+{
+    auto setup = [] { return Timers{}; };
+    auto time  = measureBest(3, setup, [&](Timers& timers) {
+        auto ids = std::vector<decltype(timers.schedule(0, 0))>{};
+        ids.reserve(delays.size());
+
+        for (auto i = 0uz; i < delays.size(); ++i) {
+            ids.push_back(timers.schedule(delays[i], static_cast<int>(i)));
+        }
+        for (auto i = 0uz; i < delays.size(); ++i) {
+            if (i % 100 < cancelPercent) {
+                timers.cancel(ids[i]);
+            }
+        }
+
+        auto sum = 0ll;
+        timers.advance(Tick{ 1 } << 40, [&](int&& value) { sum += value; });
+        doNotOptimize(sum);
+    });
+
+    report(name, delays.size(), time);
+}
+
+// steady state: every tick a batch of timers is scheduled and most of the previous batches are cancelled
+template <typename Timers>
+void churn(std::string_view name, const std::vector<Tick>& delays, std::size_t perTick)
+{
+    auto setup = [] { return Timers{}; };
+    auto time  = measureBest(3, setup, [&](Timers& timers) {
+        auto ids = std::vector<decltype(timers.schedule(0, 0))>{};
+        ids.reserve(delays.size());
+
+        auto now = Tick{ 0 };
+        auto sum = 0ll;
+
+        for (auto i = 0uz; i < delays.size(); ++i) {
+            ids.push_back(timers.schedule(now + delays[i], static_cast<int>(i)));
+
+            // the timer scheduled perTick * 4 operations ago completed before its timeout
+            if (i >= perTick * 4 and i % 8 != 0) {
+                timers.cancel(ids[i - perTick * 4]);
+            }
+            if (i % perTick == perTick - 1) {
+                timers.advance(++now, [&](int&& value) { sum += value; });
+            }
+        }
+        doNotOptimize(sum);
+    });
+
+    report(name, delays.size(), time);
+}
+
+using Wheel = dsa::TimingWheel<int>;
+
+int main()
+{
+    constexpr auto count = 1'000'000uz;
+
+    for (auto [min, max] : { std::pair<Tick, Tick>{ 1, 1'000 }, std::pair<Tick, Tick>{ 1'000, 1'000'000 } }) {
+        auto delays = makeDelays(count, min, max);
+
+        bench_util::header(fmt::format("schedule/cancel/advance, 1M timers, delay in [{}, {}]", min, max));
+        for (auto percent : { 0uz, 90uz }) {
+            auto wheelName = fmt::format("TimingWheel (cancel {}%)", percent);
+            auto heapName  = fmt::format("binary heap (cancel {}%)", percent);
+            scheduleCancelAdvance<Wheel>(wheelName, delays, percent);
+            scheduleCancelAdvance<HeapTimers>(heapName, delays, percent);
+        }
+
+        bench_util::header(fmt::format("churn, 1M timers, delay in [{}, {}]", min, max));
+        for (auto perTick : { 16uz, 1024uz }) {
+            churn<Wheel>(fmt::format("TimingWheel ({} per tick)", perTick), delays, perTick);
+            churn<HeapTimers>(fmt::format("binary heap ({} per tick)", perTick), delays, perTick);
+        }
+    }
+}
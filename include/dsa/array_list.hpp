@@ -1,12 +1,22 @@
 #pragma once
 
 // NOTE: ArrayList implementation based on reference 1
+//
+//       the growth of the capacity (and whether it shrinks on removal) is given by the GrowthPolicy template
+//       argument, see dsa/growth_policy.hpp. the default doubles and never shrinks.
 
 #include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
 #include <utility>
 
+#include "dsa/batch.hpp"
+#include "dsa/common.hpp"
+#include "dsa/error.hpp"
+#include "dsa/growth_policy.hpp"
 #include "dsa/raw_buffer.hpp"
 
 namespace dsa
@@ -14,7 +24,7 @@ namespace dsa
     template <typename T>
     concept ArrayElement = std::movable<T> or std::copyable<T>;
 
-    template <ArrayElement T>
+    template <ArrayElement T, GrowthPolicy Growth = GrowthPolicy{}>
     class ArrayList
     {
     public:
@@ -22,12 +32,18 @@ namespace dsa
 
         using value_type = Element;    // STL compliance
 
+        static_assert(Growth.isValid(), "Invalid growth policy");
+
         ArrayList() = default;
         ~ArrayList() { clear(); }
 
         explicit ArrayList(std::size_t count)
             requires std::default_initializable<T>;
 
+        // the storage is allocated once when the size of the range is known
+        template <ContainerCompatibleRange<T> R>
+        ArrayList(std::from_range_t, R&& range);
+
         ArrayList(ArrayList&& other) noexcept;
         ArrayList& operator=(ArrayList&& other) noexcept;
 
@@ -45,6 +61,19 @@ namespace dsa
         T& push_back(T&& value) { return insert(m_size, std::move(value)); }
         T  pop_back() { return remove(m_size - 1); }
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&> try_insert(std::size_t pos, T&& element);
+        Result<T&> try_push_back(T&& value) { return insert(m_size, std::move(value)); }
+
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
+        // apply every insert and remove of the batch (see dsa/batch.hpp) in one pass over the list, each
+        // element is moved at most once. the ops are reordered and the inserted values are moved from.
+        // in place when the capacity is enough and the moves can't throw, else into a new buffer which is
+        // discarded if a move throws
+        void apply_batch(std::span<BatchOp<T>> ops);
+
         // reallocation will happen in order to fit
         void fit();
 
@@ -56,7 +85,15 @@ namespace dsa
         auto&& at(this auto&& self, std::size_t pos)
         {
             if (pos >= self.m_size) {
-                throw std::out_of_range{ "Cannot access element at position greater than or equal to size" };
+                fail<std::out_of_range>("Cannot access element at position greater than or equal to size");
+            }
+            return self.m_buffer.at(pos);
+        }
+
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.m_size) {
+                return std::unexpected{ Error::OutOfRange };
             }
             return self.m_buffer.at(pos);
         }
@@ -82,12 +119,21 @@ namespace dsa
             std::size_t count;
         };
 
+        // the elements [m_begin, m_end) of a batch that all move to [m_target, m_target + m_end - m_begin)
+        struct BatchRun
+        {
+            std::size_t m_begin;
+            std::size_t m_end;
+            std::size_t m_target;
+        };
+
         RawBuffer<T> m_buffer = {};
         std::size_t  m_size   = 0;
 
         ShiftResult shiftRight(std::size_t begin, std::size_t count);
         void        destroyAndShiftLeft(std::size_t begin, std::size_t end);
-        void        grow();
+        void        grow(std::size_t required);
+        void        shrink();
     };
 }
 
@@ -97,8 +143,8 @@ namespace dsa
 
 namespace dsa
 {
-    template <ArrayElement T>
-    ArrayList<T>::ArrayList(std::size_t count)
+    template <ArrayElement T, GrowthPolicy Growth>
+    ArrayList<T, Growth>::ArrayList(std::size_t count)
         requires std::default_initializable<T>
         : m_buffer{ count }
         , m_size{ count }
@@ -108,15 +154,22 @@ namespace dsa
         }
     }
 
-    template <ArrayElement T>
-    ArrayList<T>::ArrayList(ArrayList&& other) noexcept
+    template <ArrayElement T, GrowthPolicy Growth>
+    template <ContainerCompatibleRange<T> R>
+    ArrayList<T, Growth>::ArrayList(std::from_range_t, R&& range)
+    {
+        append_range(std::forward<R>(range));
+    }
+
+    template <ArrayElement T, GrowthPolicy Growth>
+    ArrayList<T, Growth>::ArrayList(ArrayList&& other) noexcept
         : m_buffer{ std::exchange(other.m_buffer, {}) }
         , m_size{ std::exchange(other.m_size, 0) }
     {
     }
 
-    template <ArrayElement T>
-    ArrayList<T>& ArrayList<T>::operator=(ArrayList&& other) noexcept
+    template <ArrayElement T, GrowthPolicy Growth>
+    ArrayList<T, Growth>& ArrayList<T, Growth>::operator=(ArrayList&& other) noexcept
     {
         if (this == &other) {
             return *this;
@@ -130,19 +183,17 @@ namespace dsa
         return *this;
     }
 
-    template <ArrayElement T>
-    ArrayList<T>::ArrayList(const ArrayList& other)
+    template <ArrayElement T, GrowthPolicy Growth>
+    ArrayList<T, Growth>::ArrayList(const ArrayList& other)
         requires std::copyable<T>
         : m_buffer{ other.m_buffer.size() }
         , m_size{ other.m_size }
     {
-        for (std::size_t i = 0; i < m_size; ++i) {
-            m_buffer.construct(i, auto{ other.m_buffer.at(i) });
-        }
+        m_buffer.constructRange(0, other.m_buffer.data(), m_size);
     }
 
-    template <ArrayElement T>
-    ArrayList<T>& ArrayList<T>::operator=(const ArrayList& other)
+    template <ArrayElement T, GrowthPolicy Growth>
+    ArrayList<T, Growth>& ArrayList<T, Growth>::operator=(const ArrayList& other)
         requires std::copyable<T>
     {
         if (this == &other) {
@@ -154,40 +205,34 @@ namespace dsa
         m_buffer = RawBuffer<T>{ other.m_buffer.size() };    // destroy the old buffer and create a new one
         m_size   = other.m_size;
 
-        for (std::size_t i = 0; i < m_size; ++i) {
-            m_buffer.construct(i, other.m_buffer.at(i));
-        }
+        m_buffer.constructRange(0, other.m_buffer.data(), m_size);
 
         return *this;
     }
 
-    template <ArrayElement T>
-    void ArrayList<T>::swap(ArrayList& other) noexcept
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::swap(ArrayList& other) noexcept
     {
         std::swap(m_buffer, other.m_buffer);
         std::swap(m_size, other.m_size);
     }
 
-    template <ArrayElement T>
-    void ArrayList<T>::clear() noexcept
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::clear() noexcept
     {
-        for (std::size_t i = 0; i < m_size; ++i) {
-            m_buffer.destroy(i);
-        }
+        m_buffer.destroyRange(0, m_size);
         m_size = 0;
     }
 
-    template <ArrayElement T>
-    T& ArrayList<T>::insert(std::size_t pos, T&& element)
+    template <ArrayElement T, GrowthPolicy Growth>
+    T& ArrayList<T, Growth>::insert(std::size_t pos, T&& element)
     {
         if (pos > m_size) {
-            throw std::out_of_range{
-                std::format("Cannot insert at position greater than size ({} > {})", pos, m_size)
-            };
+            fail<std::out_of_range>("Cannot insert at position greater than size ({} > {})", pos, m_size);
         }
 
         if (m_size == capacity()) {
-            grow();
+            grow(m_size + 1);
         }
 
         if (pos < m_size) {
@@ -195,26 +240,204 @@ namespace dsa
             ++m_size;
             return m_buffer.at(begin) = std::move(element);
         } else {
+            // counted only once constructed, a throwing move leaves the size as it was
+            auto& value = m_buffer.construct(pos, std::move(element));
             ++m_size;
-            return m_buffer.construct(pos, std::move(element));
+            return value;
         }
     }
 
-    template <ArrayElement T>
-    T ArrayList<T>::remove(std::size_t pos)
+    template <ArrayElement T, GrowthPolicy Growth>
+    Result<T&> ArrayList<T, Growth>::try_insert(std::size_t pos, T&& element)
+    {
+        if (pos > m_size) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insert(pos, std::move(element));
+    }
+
+    template <ArrayElement T, GrowthPolicy Growth>
+    T ArrayList<T, Growth>::remove(std::size_t pos)
     {
         if (pos >= m_size) {
-            throw std::out_of_range{ "Cannot remove at position greater than or equal to size" };
+            fail<std::out_of_range>("Cannot remove at position greater than or equal to size");
         }
 
         auto value = std::move(m_buffer.at(pos));
         destroyAndShiftLeft(pos, pos + 1);
         --m_size;
+
+        if (Growth.shouldShrink(m_size, capacity())) {
+            shrink();
+        }
+
         return value;
     }
 
-    template <ArrayElement T>
-    void ArrayList<T>::fit()
+    template <ArrayElement T, GrowthPolicy Growth>
+    template <ContainerCompatibleRange<T> R>
+    void ArrayList<T, Growth>::append_range(R&& range)
+    {
+        if constexpr (KnownSizeRange<R>) {
+            auto count = rangeSize(range);
+            if (m_size + count > capacity()) {
+                grow(m_size + count);
+            }
+
+            if constexpr (TriviallyCopyableRangeOf<R, T>) {
+                m_buffer.constructRange(m_size, std::ranges::data(range), count);
+                m_size += count;
+                return;
+            }
+        }
+
+        for (auto&& value : range) {
+            if (m_size == capacity()) {
+                grow(m_size + 1);
+            }
+            m_buffer.construct(m_size, std::forward<decltype(value)>(value));
+            ++m_size;
+        }
+    }
+
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::apply_batch(std::span<BatchOp<T>> ops)
+    {
+        if (ops.empty()) {
+            return;
+        }
+
+        auto order = ArrayList<BatchOp<T>*>{};
+        order.reserve(ops.size());
+        for (auto& op : ops) {
+            order.push_back(&op);
+        }
+
+        auto sorted  = std::span{ order.data(), order.size() };
+        auto newSize = sortBatch(sorted, m_size);
+
+        // a throwing move in place would leave slots past the old size constructed and a scrambled list
+        constexpr auto inPlace = std::is_nothrow_move_constructible_v<T>
+                             and std::is_nothrow_move_assignable_v<T>;
+
+        if (newSize > capacity() or not inPlace) {
+            auto buffer = RawBuffer<T>{
+                newSize > capacity() ? Growth.grow(capacity(), newSize, sizeof(T)) : capacity()
+            };
+
+            // the elements and the inserted values in their final order, so [0, to) is what to destroy
+            auto to   = 0uz;
+            auto fill = [&] {
+                auto next = 0uz;
+                for (auto* op : sorted) {
+                    for (; next < op->m_position; ++next) {
+                        buffer.construct(to, std::move(m_buffer.at(next)));
+                        ++to;
+                    }
+                    if (op->isInsert()) {
+                        buffer.construct(to, std::move(*op->m_value));
+                        ++to;
+                    } else {
+                        next = op->m_position + 1;
+                    }
+                }
+                for (; next < m_size; ++next) {
+                    buffer.construct(to, std::move(m_buffer.at(next)));
+                    ++to;
+                }
+            };
+
+#if defined(__cpp_exceptions)
+            try {
+                fill();
+            } catch (...) {
+                buffer.destroyRange(0, to);
+                throw;
+            }
+#else
+            fill();
+#endif
+
+            m_buffer.destroyRange(0, m_size);
+            m_buffer = std::move(buffer);
+            m_size   = newSize;
+            return;
+        }
+
+        // the elements between two consecutive positions of the batch move by the same amount. next is the
+        // first element not visited yet and shifted is where it ends up
+        auto runs    = ArrayList<BatchRun>{};
+        auto next    = 0uz;
+        auto shifted = 0uz;
+
+        runs.reserve(ops.size() + 1);
+        for (auto* op : sorted) {
+            if (op->m_position > next) {
+                runs.push_back(BatchRun{ next, op->m_position, shifted });
+            }
+
+            shifted += op->m_position - next;
+            if (op->isInsert()) {
+                next = op->m_position;
+                ++shifted;
+            } else {
+                next = op->m_position + 1;
+            }
+        }
+        if (m_size > next) {
+            runs.push_back(BatchRun{ next, m_size, shifted });
+        }
+
+        // runs moving left are moved from left to right and runs moving right from right to left, this way
+        // the slot an element moves to is already vacated or holds a removed element
+        auto* data = m_buffer.data();
+        for (auto [begin, end, target] : runs) {
+            if (target < begin) {
+                std::move(data + begin, data + end, data + target);
+            }
+        }
+
+        for (auto [begin, end, target] : runs | std::views::reverse) {
+            if (target <= begin) {
+                continue;
+            }
+
+            // the last elements may land past the old size, onto slots that are not constructed yet
+            auto count = end - begin;
+            auto fresh = target + count > m_size ? std::min(count, target + count - m_size) : 0uz;
+            for (auto from = end; from > end - fresh; --from) {
+                m_buffer.construct(target + (from - 1 - begin), std::move(m_buffer.at(from - 1)));
+            }
+            std::move_backward(data + begin, data + end - fresh, data + target + count - fresh);
+        }
+
+        // the inserted values fill the slots left between the runs, slots before the old size are assigned to
+        auto from = 0uz;
+        auto to   = 0uz;
+        for (auto* op : sorted) {
+            to += op->m_position - from;
+            if (not op->isInsert()) {
+                from = op->m_position + 1;
+                continue;
+            }
+
+            from = op->m_position;
+            if (to < m_size) {
+                m_buffer.at(to) = std::move(*op->m_value);
+            } else {
+                m_buffer.construct(to, std::move(*op->m_value));
+            }
+            ++to;
+        }
+
+        if (newSize < m_size) {
+            m_buffer.destroyRange(newSize, m_size - newSize);
+        }
+        m_size = newSize;
+    }
+
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::fit()
     {
         RawBuffer<T> newBuffer{ m_size };
         for (auto i = 0uz; i < m_size; ++i) {
@@ -224,8 +447,8 @@ namespace dsa
         m_buffer = std::move(newBuffer);
     }
 
-    template <ArrayElement T>
-    void ArrayList<T>::reserve(std::size_t count)
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::reserve(std::size_t count)
     {
         if (count > capacity()) {
             RawBuffer<T> newBuffer{ count };
@@ -239,17 +462,17 @@ namespace dsa
 
     // the elements between [begin, begin + count) will be shifted to the right by count positions.
     // the gap then returned and in a moved-from state ready to be moved-to (moved assignment).
-    template <ArrayElement T>
-    ArrayList<T>::ShiftResult ArrayList<T>::shiftRight(std::size_t begin, std::size_t count)
+    template <ArrayElement T, GrowthPolicy Growth>
+    ArrayList<T, Growth>::ShiftResult ArrayList<T, Growth>::shiftRight(std::size_t begin, std::size_t count)
     {
         assert(count > 0 && "Cannot shift right by 0");
 
         if (begin > m_size) {
-            throw std::out_of_range{ "Cannot shift right at position greater than size" };
+            fail<std::out_of_range>("Cannot shift right at position greater than size");
         }
 
         if (m_size + count > capacity()) {
-            throw std::out_of_range{ "Cannot shift right, not enough capacity" };
+            fail<std::out_of_range>("Cannot shift right, not enough capacity");
         }
 
         auto placementEnd = m_size + count;
@@ -272,13 +495,13 @@ namespace dsa
 
     // the elements between [begin, end) will be destroyed.
     // the rest of the elements then will be shifted to the left filling the gap.
-    template <ArrayElement T>
-    void ArrayList<T>::destroyAndShiftLeft(std::size_t begin, std::size_t end)
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::destroyAndShiftLeft(std::size_t begin, std::size_t end)
     {
         assert(begin < end && "Begin pointer must be less than end pointer");
 
         if (end > m_size) {
-            throw std::out_of_range{ "Cannot destroy and shift left at position greater than size" };
+            fail<std::out_of_range>("Cannot destroy and shift left at position greater than size");
         }
 
         // instead of directly destroying the [begin, end) elements, we will reassign the elements from
@@ -296,11 +519,25 @@ namespace dsa
         }
     };
 
-    template <ArrayElement T>
-    void ArrayList<T>::grow()
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::grow(std::size_t required)
+    {
+        reserve(Growth.grow(capacity(), required, sizeof(T)));
+    }
+
+    template <ArrayElement T, GrowthPolicy Growth>
+    void ArrayList<T, Growth>::shrink()
     {
-        // 2 * growth factor
-        auto newSize = capacity() == 0 ? 1 : 2 * capacity();
-        reserve(newSize);
+        auto newCapacity = Growth.shrink(capacity(), sizeof(T));
+        if (newCapacity >= capacity()) {
+            return;
+        }
+
+        auto newBuffer = newCapacity == 0 ? RawBuffer<T>{} : RawBuffer<T>{ newCapacity };
+        for (auto i = 0uz; i < m_size; ++i) {
+            newBuffer.construct(i, std::move(m_buffer.at(i)));
+            m_buffer.destroy(i);
+        }
+        m_buffer = std::move(newBuffer);
     }
 }
@@ -0,0 +1,77 @@
+#pragma once
+
+// NOTE: a batch of inserts and removes applied to a sequence container at once (apply_batch). every position
+//       refers to the container before the batch: an insert at pos puts its value before the element that was
+//       at pos (or at the end if pos is the size), and a remove at pos removes the element that was at pos.
+//       inserts at the same position keep their order in the batch, a position can be removed only once.
+
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace dsa
+{
+    template <typename T>
+    struct BatchOp
+    {
+        std::size_t      m_position;
+        std::optional<T> m_value;    // the inserted value, empty for a remove
+
+        static BatchOp insert(std::size_t pos, T&& value) { return { pos, std::move(value) }; }
+        static BatchOp remove(std::size_t pos) { return { pos, std::nullopt }; }
+
+        bool isInsert() const noexcept { return m_value.has_value(); }
+    };
+
+    // sort the ops by position (inserts before the remove at the same position) and check them against a
+    // container of the given size. returns the size of the container after the batch is applied
+    template <typename T>
+    std::size_t sortBatch(std::span<BatchOp<T>*> ops, std::size_t size);
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <typename T>
+    std::size_t sortBatch(std::span<BatchOp<T>*> ops, std::size_t size)
+    {
+        auto key = [](const BatchOp<T>* op) { return std::pair{ op->m_position, not op->isInsert() }; };
+        std::ranges::stable_sort(ops, {}, key);
+
+        auto inserts = 0uz;
+        auto removes = 0uz;
+
+        for (auto i = 0uz; i < ops.size(); ++i) {
+            auto pos = ops[i]->m_position;
+
+            if (ops[i]->isInsert()) {
+                if (pos > size) {
+                    fail<std::out_of_range>(
+                        "Cannot insert at position greater than size ({} > {})", pos, size
+                    );
+                }
+                ++inserts;
+                continue;
+            }
+
+            if (pos >= size) {
+                fail<std::out_of_range>(
+                    "Cannot remove at position out of range: pos {} on size {}", pos, size
+                );
+            }
+            if (i > 0 and not ops[i - 1]->isInsert() and ops[i - 1]->m_position == pos) {
+                fail<std::invalid_argument>("Position {} is removed more than once", pos);
+            }
+            ++removes;
+        }
+
+        return size + inserts - removes;
+    }
+}
@@ -0,0 +1,401 @@
+#pragma once
+
+// NOTE: BitVector with constant time rank and logarithmic time select. the rank index is two-level:
+//       - superblocks of 2^16 bits store the absolute number of ones before them (64-bit),
+//       - blocks of 512 bits (8 words) store the number of ones relative to their superblock (16-bit),
+//       which is about 3.2% of space overhead. select samples the block of every 8192-th one and binary
+//       searches the blocks between two samples.
+//
+//       the index is built by the constructors and clear(). set, setRange and push_back only mark it stale so
+//       a batch of modifications costs one rebuild: call buildIndex() after them, rank/select/count on a
+//       stale index throw std::logic_error. the queries are const and never write, so a built vector can be
+//       read from many threads like the other containers.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+#include "dsa/simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__BMI2__)
+#    include <immintrin.h>
+#endif
+
+namespace dsa
+{
+    // number of set bits in the words. spans of at least s_popcountVectorWords words use an AVX2 nibble
+    // lookup (Mula) when the cpu has it and dsa::simd::activeIsa() allows it, shorter ones are not worth the
+    // call into a kernel that can't be inlined
+    inline constexpr std::size_t s_popcountVectorWords = 32;
+
+    std::size_t popcountWords(std::span<const std::uint64_t> words) noexcept;
+
+    class BitVector
+    {
+    public:
+        using Word = std::uint64_t;
+
+        static constexpr std::size_t s_wordBits       = 64;
+        static constexpr std::size_t s_blockWords     = 8;
+        static constexpr std::size_t s_blockBits      = s_blockWords * s_wordBits;
+        static constexpr std::size_t s_superblockBits = 1 << 16;
+        static constexpr std::size_t s_selectSample   = 8192;
+
+        BitVector() = default;
+
+        explicit BitVector(std::size_t size, bool value = false);
+
+        void clear() noexcept;
+
+        void push_back(bool value);
+
+        bool at(std::size_t pos) const;
+        void set(std::size_t pos, bool value = true);
+        void clear(std::size_t pos) { set(pos, false); }
+
+        // bulk operation on [first, last), whole words are written at once
+        void setRange(std::size_t first, std::size_t last, bool value = true);
+        void clearRange(std::size_t first, std::size_t last) { setRange(first, last, false); }
+
+        // number of ones in [0, pos), the queries need an up to date index
+        std::size_t rank1(std::size_t pos) const;
+        std::size_t rank0(std::size_t pos) const { return pos - rank1(pos); }
+
+        // position of the k-th one (0-based)
+        std::size_t select1(std::size_t k) const;
+
+        // number of ones
+        std::size_t count() const;
+
+        // (re)build the rank/select index after modifications
+        void buildIndex();
+
+        bool isIndexed() const noexcept { return m_indexed; }
+
+        std::size_t size() const noexcept { return m_size; }
+
+        // bits past size() in the last word are always zero
+        std::span<const Word> words() const noexcept { return { m_words.data(), m_words.size() }; }
+
+    private:
+        ArrayList<Word> m_words = {};
+        std::size_t     m_size  = 0;
+
+        // rank/select index, has one sentinel entry at the end of superblocks and blocks. an empty vector may
+        // have an empty index
+        ArrayList<std::uint64_t> m_superblocks = {};
+        ArrayList<std::uint16_t> m_blocks      = {};
+        ArrayList<std::uint64_t> m_samples     = {};
+        bool                     m_indexed     = true;
+
+        static std::size_t selectInWord(Word word, std::size_t k) noexcept;
+
+        std::size_t blockRank(std::size_t block) const noexcept;
+        std::size_t blockCount() const noexcept;
+
+        void checkIndex() const;
+
+        void checkPosition(std::size_t pos) const;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    inline BitVector::BitVector(std::size_t size, bool value)
+        : m_words{ (size + s_wordBits - 1) / s_wordBits }
+        , m_size{ size }
+    {
+        if (value) {
+            setRange(0, size, true);
+        }
+        buildIndex();
+    }
+
+    inline void BitVector::clear() noexcept
+    {
+        m_words.clear();
+        m_superblocks.clear();
+        m_blocks.clear();
+        m_samples.clear();
+        m_size    = 0;
+        m_indexed = true;
+    }
+
+    inline void BitVector::push_back(bool value)
+    {
+        if (m_size % s_wordBits == 0) {
+            m_words.push_back(0);
+        }
+        ++m_size;
+        set(m_size - 1, value);
+    }
+
+    inline bool BitVector::at(std::size_t pos) const
+    {
+        checkPosition(pos);
+        return (m_words.data()[pos / s_wordBits] >> (pos % s_wordBits)) & 1;
+    }
+
+    inline void BitVector::set(std::size_t pos, bool value)
+    {
+        checkPosition(pos);
+
+        auto& word = m_words.data()[pos / s_wordBits];
+        auto  mask = Word{ 1 } << (pos % s_wordBits);
+
+        word      = value ? (word | mask) : (word & ~mask);
+        m_indexed = false;
+    }
+
+    inline void BitVector::setRange(std::size_t first, std::size_t last, bool value)
+    {
+        if (first > last or last > m_size) {
+            fail<std::out_of_range>("Range is out of range: [{}, {}) on size {}", first, last, m_size);
+        }
+
+        if (first == last) {
+            return;
+        }
+
+        auto* words     = m_words.data();
+        auto  firstWord = first / s_wordBits;
+        auto  lastWord  = (last - 1) / s_wordBits;
+
+        // mask of the bits in [first % 64, 64) and [0, (last - 1) % 64]
+        auto headMask = ~Word{ 0 } << (first % s_wordBits);
+        auto tailMask = ~Word{ 0 } >> (s_wordBits - 1 - (last - 1) % s_wordBits);
+
+        auto apply = [&](Word& word, Word mask) { word = value ? (word | mask) : (word & ~mask); };
+
+        if (firstWord == lastWord) {
+            apply(words[firstWord], headMask & tailMask);
+        } else {
+            apply(words[firstWord], headMask);
+            std::fill(words + firstWord + 1, words + lastWord, value ? ~Word{ 0 } : Word{ 0 });
+            apply(words[lastWord], tailMask);
+        }
+
+        m_indexed = false;
+    }
+
+    inline std::size_t BitVector::rank1(std::size_t pos) const
+    {
+        if (pos > m_size) {
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, m_size);
+        }
+
+        checkIndex();
+
+        if (pos == 0) {
+            return 0;
+        }
+
+        auto  block = pos / s_blockBits;
+        auto  word  = pos / s_wordBits;
+        auto* words = m_words.data();
+
+        auto rank = blockRank(block);
+        for (auto w = block * s_blockWords; w < word; ++w) {
+            rank += static_cast<std::size_t>(std::popcount(words[w]));
+        }
+        if (auto rem = pos % s_wordBits; rem != 0) {
+            rank += static_cast<std::size_t>(std::popcount(words[word] & ((Word{ 1 } << rem) - 1)));
+        }
+
+        return rank;
+    }
+
+    inline std::size_t BitVector::select1(std::size_t k) const
+    {
+        checkIndex();
+
+        if (k >= count()) {
+            fail<std::out_of_range>("Cannot select the {}-th one, there are only {}", k, count());
+        }
+
+        auto sample = k / s_selectSample;
+        auto lo     = static_cast<std::size_t>(m_samples.at(sample));
+        auto hi     = sample + 1 < m_samples.size() ? static_cast<std::size_t>(m_samples.at(sample + 1))
+                                                    : blockCount() - 1;
+
+        // find the last block in [lo, hi] whose rank is <= k
+        while (lo < hi) {
+            auto mid = lo + (hi - lo + 1) / 2;
+            if (blockRank(mid) <= k) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+
+        auto  remaining = k - blockRank(lo);
+        auto* words     = m_words.data();
+        auto  lastWord  = std::min((lo + 1) * s_blockWords, m_words.size());
+
+        for (auto w = lo * s_blockWords; w < lastWord; ++w) {
+            auto ones = static_cast<std::size_t>(std::popcount(words[w]));
+            if (remaining < ones) {
+                return w * s_wordBits + selectInWord(words[w], remaining);
+            }
+            remaining -= ones;
+        }
+
+        // unreachable as long as the index is consistent with the words
+        fail<std::logic_error>("BitVector index is corrupted");
+    }
+
+    inline std::size_t BitVector::count() const
+    {
+        checkIndex();
+        return m_size == 0 ? 0 : blockRank(blockCount());
+    }
+
+    inline void BitVector::buildIndex()
+    {
+        auto numBlocks = blockCount();
+
+        m_superblocks.clear();
+        m_blocks.clear();
+        m_samples.clear();
+
+        m_superblocks.reserve(numBlocks * s_blockBits / s_superblockBits + 1);
+        m_blocks.reserve(numBlocks + 1);
+
+        constexpr auto blocksPerSuperblock = s_superblockBits / s_blockBits;
+
+        auto total      = 0uz;
+        auto nextSample = 0uz;
+
+        // the extra iteration adds the sentinel entries
+        for (auto block = 0uz; block <= numBlocks; ++block) {
+            if (block % blocksPerSuperblock == 0) {
+                m_superblocks.push_back(static_cast<std::uint64_t>(total));
+            }
+            m_blocks.push_back(static_cast<std::uint16_t>(total - m_superblocks.back()));
+
+            if (block == numBlocks) {
+                break;
+            }
+
+            auto first = block * s_blockWords;
+            auto count = std::min(s_blockWords, m_words.size() - first);
+            total      += popcountWords({ m_words.data() + first, count });
+
+            for (; nextSample < total; nextSample += s_selectSample) {
+                m_samples.push_back(static_cast<std::uint64_t>(block));
+            }
+        }
+
+        m_indexed = true;
+    }
+
+#if DSA_SIMD_X86
+    namespace simd::kernel
+    {
+        // the words in [0, count / 4 * 4)
+        DSA_SIMD_TARGET("avx2")
+        inline std::size_t popcountAvx2(const std::uint64_t* words, std::size_t count) noexcept
+        {
+            // clang-format off
+            const auto lookup = _mm256_setr_epi8(
+                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+            );
+            // clang-format on
+            const auto lowMask = _mm256_set1_epi8(0x0f);
+            const auto zero    = _mm256_setzero_si256();
+
+            auto acc = _mm256_setzero_si256();
+            for (auto i = 0uz; i + 4 <= count; i += 4) {
+                auto vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+                auto lo  = _mm256_and_si256(vec, lowMask);
+                auto hi  = _mm256_and_si256(_mm256_srli_epi16(vec, 4), lowMask);
+                auto cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+                acc      = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, zero));
+            }
+
+            auto total  = static_cast<std::size_t>(_mm256_extract_epi64(acc, 0));
+            total      += static_cast<std::size_t>(_mm256_extract_epi64(acc, 1));
+            total      += static_cast<std::size_t>(_mm256_extract_epi64(acc, 2));
+            total      += static_cast<std::size_t>(_mm256_extract_epi64(acc, 3));
+            return total;
+        }
+    }
+#endif
+
+    inline std::size_t popcountWords(std::span<const std::uint64_t> words) noexcept
+    {
+        auto count = 0uz;
+        auto i     = 0uz;
+
+#if DSA_SIMD_X86
+        if (words.size() >= s_popcountVectorWords and simd::activeIsa() == simd::Isa::Avx2) {
+            i     = words.size() / 4 * 4;
+            count = simd::kernel::popcountAvx2(words.data(), i);
+        }
+#endif
+
+        for (; i < words.size(); ++i) {
+            count += static_cast<std::size_t>(std::popcount(words[i]));
+        }
+
+        return count;
+    }
+
+    inline std::size_t BitVector::selectInWord(Word word, std::size_t k) noexcept
+    {
+#if defined(__BMI2__)
+        return static_cast<std::size_t>(std::countr_zero(_pdep_u64(Word{ 1 } << k, word)));
+#else
+        // skip whole bytes first then clear the lowest set bits
+        auto shift = 0uz;
+        auto ones  = static_cast<std::size_t>(std::popcount(word & 0xff));
+        while (k >= ones) {
+            k     -= ones;
+            word >>= 8;
+            shift += 8;
+            ones   = static_cast<std::size_t>(std::popcount(word & 0xff));
+        }
+        for (; k > 0; --k) {
+            word &= word - 1;
+        }
+        return shift + static_cast<std::size_t>(std::countr_zero(word));
+#endif
+    }
+
+    inline std::size_t BitVector::blockRank(std::size_t block) const noexcept
+    {
+        constexpr auto blocksPerSuperblock = s_superblockBits / s_blockBits;
+
+        auto super = m_superblocks.data()[block / blocksPerSuperblock];
+        auto local = m_blocks.data()[block];
+        return static_cast<std::size_t>(super) + local;
+    }
+
+    inline std::size_t BitVector::blockCount() const noexcept
+    {
+        return (m_words.size() + s_blockWords - 1) / s_blockWords;
+    }
+
+    inline void BitVector::checkIndex() const
+    {
+        if (not m_indexed) {
+            fail<std::logic_error>("BitVector index is stale, call buildIndex() after modifying it");
+        }
+    }
+
+    inline void BitVector::checkPosition(std::size_t pos) const
+    {
+        if (pos >= m_size) {
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, m_size);
+        }
+    }
+}
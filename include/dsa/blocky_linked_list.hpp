@@ -1,14 +1,29 @@
 #pragma once
 
 // NOTE: BlockyLinkedList implementation based on reference 2 (SEList)
-
+//
+//       the block size b is either given at runtime (the default) or fixed at compile time as the second
+//       template parameter, StaticBlockyLinkedList<T, B> is BlockyLinkedList<T, B>. a static block size is
+//       not stored and the blocks are BlockyLinkedListBlock: rings of b + 1 elements inline in the node
+//       instead of heap-backed CircularBuffers, so a node is a single allocation and the b - 1 / b + 1 bounds
+//       of locate, shift, spread and gather are constants. the ring index wraps with a mask when b + 1 is a
+//       power of two (b = 2^k - 1) and with a compare otherwise.
+
+#include "dsa/array_list.hpp"
+#include "dsa/batch.hpp"
 #include "dsa/circular_buffer.hpp"
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
 
+#include <bit>
+#include <cassert>
 #include <concepts>
 #include <csignal>
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -19,16 +34,88 @@ namespace dsa
     template <typename T>
     concept BlockyLinkedListElement = CircularBufferElement<T>;
 
-    template <BlockyLinkedListElement T>
+    // a ring of Capacity elements stored inline, the block of a BlockyLinkedList with a static block size
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    class BlockyLinkedListBlock
+    {
+    public:
+        using Element = T;
+
+        using value_type = Element;    // STL compliance
+
+        BlockyLinkedListBlock() noexcept { }
+        ~BlockyLinkedListBlock() { clear(); }
+
+        BlockyLinkedListBlock(const BlockyLinkedListBlock&)            = delete;
+        BlockyLinkedListBlock& operator=(const BlockyLinkedListBlock&) = delete;
+        BlockyLinkedListBlock(BlockyLinkedListBlock&&)                 = delete;
+        BlockyLinkedListBlock& operator=(BlockyLinkedListBlock&&)      = delete;
+
+        void clear() noexcept;
+
+        // the elements on the shorter side of pos are shifted
+        T& insert(std::size_t pos, T&& value);
+        T  remove(std::size_t pos);
+
+        T& push_front(T&& value);
+        T& push_back(T&& value);
+        T  pop_front();
+        T  pop_back();
+
+        auto&& at(this auto&& self, std::size_t pos);
+
+        // the elements as at most two contiguous spans in order, like CircularBuffer::segments
+        auto segments(this auto&& self) noexcept;
+
+        std::size_t                  size() const noexcept { return m_size; }
+        static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+    private:
+        union
+        {
+            T m_elements[Capacity];
+        };
+
+        std::size_t m_head = 0;
+        std::size_t m_size = 0;
+
+        // index is less than 2 * Capacity
+        static constexpr std::size_t wrap(std::size_t index) noexcept
+        {
+            if constexpr (std::has_single_bit(Capacity)) {
+                return index & (Capacity - 1);
+            } else {
+                return index >= Capacity ? index - Capacity : index;
+            }
+        }
+
+        auto&& slot(this auto&& self, std::size_t pos) noexcept
+        {
+            return self.m_elements[wrap(self.m_head + pos)];
+        }
+    };
+
+    // a BlockSize of 0 means the block size is given at runtime
+    template <BlockyLinkedListElement T, std::size_t BlockSize = 0>
     struct BlockyLinkedListLink
     {
-        using Block = CircularBuffer<T>;
+        using Block = std::conditional_t<
+            BlockSize == 0,
+            CircularBuffer<T>,
+            BlockyLinkedListBlock<T, BlockSize + 1>>;
 
         std::unique_ptr<BlockyLinkedListLink> m_next  = nullptr;
         BlockyLinkedListLink*                 m_prev  = nullptr;
         Block                                 m_block = {};
 
+        BlockyLinkedListLink([[maybe_unused]] std::size_t capacity)
+            requires (BlockSize != 0)
+        {
+            assert(capacity == Block::capacity());
+        }
+
         BlockyLinkedListLink(std::size_t capacity)
+            requires (BlockSize == 0)
             : m_block{
                 capacity,
                 BufferPolicy{
@@ -45,7 +132,7 @@ namespace dsa
         BlockyLinkedListLink& operator=(BlockyLinkedListLink&&)      = delete;
     };
 
-    template <BlockyLinkedListElement T>
+    template <BlockyLinkedListElement T, std::size_t BlockSize = 0>
     class BlockyLinkedList
     {
     public:
@@ -62,16 +149,28 @@ namespace dsa
         friend class BlockIterator<true>;
 
         using Element = T;
-        using Node    = BlockyLinkedListLink<T>;
+        using Node    = BlockyLinkedListLink<T, BlockSize>;
 
         using value_type = Element;    // STL compliance
 
         static constexpr std::size_t s_minimumBlockSize = 3;
+        static constexpr bool        s_staticBlockSize  = BlockSize != 0;
+
+        static_assert(not s_staticBlockSize or BlockSize >= s_minimumBlockSize, "Block size is too small");
 
         BlockyLinkedList() = default;
         ~BlockyLinkedList() { clear(); }
 
-        BlockyLinkedList(std::size_t blockSize);
+        BlockyLinkedList(std::size_t blockSize)
+            requires (not s_staticBlockSize);
+
+        template <ContainerCompatibleRange<T> R>
+        BlockyLinkedList(std::from_range_t, R&& range, std::size_t blockSize = s_minimumBlockSize)
+            requires (not s_staticBlockSize);
+
+        template <ContainerCompatibleRange<T> R>
+        BlockyLinkedList(std::from_range_t, R&& range)
+            requires (s_staticBlockSize);
 
         BlockyLinkedList(BlockyLinkedList&& other) noexcept;
         BlockyLinkedList& operator=(BlockyLinkedList&& other) noexcept;
@@ -92,12 +191,37 @@ namespace dsa
         T  pop_front();
         T  pop_back();
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&>       try_insert(std::size_t pos, T&& element);
+        Result<T&>       try_push_back(T&& element) { return push_back(std::move(element)); }
+        std::optional<T> try_pop_front();
+
+        // the blocks are filled to full (b + 1 elements) one after another
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
+        // apply every insert and remove of the batch (see dsa/batch.hpp) in one pass: the blocks from the one
+        // holding the first position onward are rebuilt with b elements each and replace the old ones, each
+        // element is moved at most once. the ops are reordered and the inserted values are moved from. if a
+        // move or an allocation throws the new blocks are discarded and the list keeps its size
+        void apply_batch(std::span<BatchOp<T>> ops);
+
         auto&& at(this auto&& self, std::size_t pos);
         auto&& front(this auto&& self);
         auto&& back(this auto&& self);
 
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>;
+
         std::size_t size() const noexcept { return m_size; }
-        std::size_t blockSize() const noexcept { return m_blockSize; }
+
+        std::size_t blockSize() const noexcept
+        {
+            if constexpr (s_staticBlockSize) {
+                return BlockSize;
+            } else {
+                return m_blockSize;
+            }
+        }
 
         auto begin(this auto&& self) noexcept;
         auto end(this auto&& self) noexcept;
@@ -108,7 +232,10 @@ namespace dsa
         BlockIterator<true> head() const { return { m_head.get() }; }
         BlockIterator<true> tail() const { return { m_tail }; }
 
-        auto blocks() const { return std::ranges::subrange{ head(), tail()++ }; }
+        auto blocks() const { return std::ranges::subrange{ head(), BlockIterator<true>{} }; }
+
+        // the two ring segments of every block in order
+        auto segments(this auto&& self);
 
         bool isInList(Node& node)
         {
@@ -141,10 +268,26 @@ namespace dsa
             Gather,       // after b steps not found any block containing more than b - 1 elements
         };
 
-        std::unique_ptr<Node> m_head      = nullptr;
-        Node*                 m_tail      = nullptr;
-        std::size_t           m_size      = 0;
-        std::size_t           m_blockSize = s_minimumBlockSize;
+        // a static block size is not stored
+        struct NoBlockSize
+        {
+        };
+
+        using BlockSizeStorage = std::conditional_t<s_staticBlockSize, NoBlockSize, std::size_t>;
+
+        std::unique_ptr<Node>                  m_head      = nullptr;
+        Node*                                  m_tail      = nullptr;
+        std::size_t                            m_size      = 0;
+        [[no_unique_address]] BlockSizeStorage m_blockSize = initialBlockSize();
+
+        static constexpr BlockSizeStorage initialBlockSize() noexcept
+        {
+            if constexpr (s_staticBlockSize) {
+                return {};
+            } else {
+                return s_minimumBlockSize;
+            }
+        }
 
         ElementLocation locate(std::size_t pos) const;
         Node&           insertNodeAfter(Node& node);
@@ -153,6 +296,7 @@ namespace dsa
         Node&           initHead();
         void            spread(Node& from, Node& until);
         void            gather(Node& node);
+        void            refillBack(T&& element);
 
 #ifndef NDEBUG
         std::size_t canReach(Node& left, Node& right) const
@@ -185,29 +329,199 @@ namespace dsa
         std::pair<Node&, InsertScenario> determineInsertScenario(Node& node);
         std::pair<Node&, RemoveScenario> determineRemoveScenario(Node& node);
     };
+
+    template <BlockyLinkedListElement T, std::size_t B>
+    using StaticBlockyLinkedList = BlockyLinkedList<T, B>;
 }
 
 // -----------------------------------------------------------------------------
 // implementation detail
 // -----------------------------------------------------------------------------
 
-#include <format>
-#include <stdexcept>
+#include <algorithm>
+#include <array>
 
 namespace dsa
 {
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    void BlockyLinkedListBlock<T, Capacity>::clear() noexcept
+    {
+        if constexpr (not std::is_trivially_destructible_v<T>) {
+            for (auto i = 0uz; i < m_size; ++i) {
+                std::destroy_at(&slot(i));
+            }
+        }
+        m_head = 0;
+        m_size = 0;
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    T& BlockyLinkedListBlock<T, Capacity>::insert(std::size_t pos, T&& value)
+    {
+        if (pos > m_size) {
+            fail<std::out_of_range>(
+                "Cannot insert at position greater than size; pos: {}, size: {}", pos, m_size
+            );
+        }
+        if (m_size == Capacity) {
+            fail<std::out_of_range>("Block is full");
+        }
+
+        if (pos == m_size) {
+            return push_back(std::move(value));
+        } else if (pos == 0) {
+            return push_front(std::move(value));
+        }
+
+        if (pos < m_size / 2) {
+            // [0, pos) one to the left
+            m_head = wrap(m_head + Capacity - 1);
+            std::construct_at(&slot(0), std::move(slot(1)));
+            for (auto i = 1uz; i < pos; ++i) {
+                slot(i) = std::move(slot(i + 1));
+            }
+        } else {
+            // [pos, size) one to the right
+            std::construct_at(&slot(m_size), std::move(slot(m_size - 1)));
+            for (auto i = m_size - 1; i > pos; --i) {
+                slot(i) = std::move(slot(i - 1));
+            }
+        }
+
+        ++m_size;
+        return slot(pos) = std::move(value);
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    T BlockyLinkedListBlock<T, Capacity>::remove(std::size_t pos)
+    {
+        if (pos >= m_size) {
+            fail<std::out_of_range>(
+                "Cannot remove at position greater than or equal to size; pos: {}, size: {}", pos, m_size
+            );
+        }
+
+        auto value = std::move(slot(pos));
+
+        if (pos < m_size / 2) {
+            // [0, pos) one to the right
+            for (auto i = pos; i > 0; --i) {
+                slot(i) = std::move(slot(i - 1));
+            }
+            std::destroy_at(&slot(0));
+            m_head = wrap(m_head + 1);
+        } else {
+            // (pos, size) one to the left
+            for (auto i = pos; i + 1 < m_size; ++i) {
+                slot(i) = std::move(slot(i + 1));
+            }
+            std::destroy_at(&slot(m_size - 1));
+        }
+
+        --m_size;
+        return value;
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    T& BlockyLinkedListBlock<T, Capacity>::push_front(T&& value)
+    {
+        if (m_size == Capacity) {
+            fail<std::out_of_range>("Block is full");
+        }
+
+        m_head = wrap(m_head + Capacity - 1);
+        ++m_size;
+        return *std::construct_at(&slot(0), std::move(value));
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    T& BlockyLinkedListBlock<T, Capacity>::push_back(T&& value)
+    {
+        if (m_size == Capacity) {
+            fail<std::out_of_range>("Block is full");
+        }
+
+        ++m_size;
+        return *std::construct_at(&slot(m_size - 1), std::move(value));
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    T BlockyLinkedListBlock<T, Capacity>::pop_front()
+    {
+        if (m_size == 0) {
+            fail<std::out_of_range>("Block is empty");
+        }
+
+        auto value = std::move(slot(0));
+        std::destroy_at(&slot(0));
+        m_head = wrap(m_head + 1);
+        --m_size;
+        return value;
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    T BlockyLinkedListBlock<T, Capacity>::pop_back()
+    {
+        if (m_size == 0) {
+            fail<std::out_of_range>("Block is empty");
+        }
+
+        auto value = std::move(slot(m_size - 1));
+        std::destroy_at(&slot(m_size - 1));
+        --m_size;
+        return value;
+    }
+
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    auto&& BlockyLinkedListBlock<T, Capacity>::at(this auto&& self, std::size_t pos)
+    {
+        if (pos >= self.m_size) {
+            fail<std::out_of_range>("Index is out of range: index {} on size {}", pos, self.m_size);
+        }
+        return self.slot(pos);
+    }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::BlockyLinkedList(std::size_t blockSize)
+    template <BlockyLinkedListElement T, std::size_t Capacity>
+    auto BlockyLinkedListBlock<T, Capacity>::segments(this auto&& self) noexcept
+    {
+        using Element = std::remove_reference_t<decltype(self.m_elements[0])>;
+        using Segment = std::span<Element>;
+
+        auto* data  = self.m_elements;
+        auto  first = std::min(self.m_size, Capacity - self.m_head);
+
+        return std::array{ Segment{ data + self.m_head, first }, Segment{ data, self.m_size - first } };
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::BlockyLinkedList(std::size_t blockSize)
+        requires (not s_staticBlockSize)
         : m_blockSize{ blockSize }
     {
         if (blockSize < s_minimumBlockSize) {
-            throw std::invalid_argument{ std::format("Block size must be at least {}", s_minimumBlockSize) };
+            fail<std::invalid_argument>("Block size must be at least {}", s_minimumBlockSize);
         }
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::BlockyLinkedList(BlockyLinkedList&& other) noexcept
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    template <ContainerCompatibleRange<T> R>
+    BlockyLinkedList<T, BlockSize>::BlockyLinkedList(std::from_range_t, R&& range, std::size_t blockSize)
+        requires (not s_staticBlockSize)
+        : BlockyLinkedList{ blockSize }
+    {
+        append_range(std::forward<R>(range));
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    template <ContainerCompatibleRange<T> R>
+    BlockyLinkedList<T, BlockSize>::BlockyLinkedList(std::from_range_t, R&& range)
+        requires (s_staticBlockSize)
+    {
+        append_range(std::forward<R>(range));
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::BlockyLinkedList(BlockyLinkedList&& other) noexcept
         : m_head{ std::exchange(other.m_head, nullptr) }
         , m_tail{ std::exchange(other.m_tail, nullptr) }
         , m_size{ std::exchange(other.m_size, 0) }
@@ -215,8 +529,9 @@ namespace dsa
     {
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>& BlockyLinkedList<T>::operator=(BlockyLinkedList&& other) noexcept
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>&
+    BlockyLinkedList<T, BlockSize>::operator=(BlockyLinkedList&& other) noexcept
     {
         if (this == &other) {
             return *this;
@@ -231,8 +546,8 @@ namespace dsa
         return *this;
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::BlockyLinkedList(const BlockyLinkedList& other)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::BlockyLinkedList(const BlockyLinkedList& other)
         requires std::copyable<T>
         : m_blockSize{ other.m_blockSize }
     {
@@ -242,8 +557,8 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>& BlockyLinkedList<T>::operator=(const BlockyLinkedList& other)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>& BlockyLinkedList<T, BlockSize>::operator=(const BlockyLinkedList& other)
         requires std::copyable<T>
     {
         if (this == &other) {
@@ -255,10 +570,12 @@ namespace dsa
         for (auto element : other) {
             push_back(std::move(element));
         }
+
+        return *this;
     }
 
-    template <BlockyLinkedListElement T>
-    void BlockyLinkedList<T>::swap(BlockyLinkedList& other) noexcept
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::swap(BlockyLinkedList& other) noexcept
     {
         std::swap(m_head, other.m_head);
         std::swap(m_tail, other.m_tail);
@@ -266,8 +583,8 @@ namespace dsa
         std::swap(m_blockSize, other.m_blockSize);
     }
 
-    template <BlockyLinkedListElement T>
-    void BlockyLinkedList<T>::clear() noexcept
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::clear() noexcept
     {
         for (auto current = std::move(m_head); current != nullptr;) {
             current = std::move(current->m_next);
@@ -277,8 +594,8 @@ namespace dsa
         m_size = 0;
     }
 
-    template <BlockyLinkedListElement T>
-    T& BlockyLinkedList<T>::insert(std::size_t pos, T&& element)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    T& BlockyLinkedList<T, BlockSize>::insert(std::size_t pos, T&& element)
     {
         if (pos == m_size || (m_size == 0 && pos == 0)) {
             return push_back(std::move(element));
@@ -316,8 +633,8 @@ namespace dsa
         return node.m_block.insert(offset, std::move(element));
     }
 
-    template <BlockyLinkedListElement T>
-    T BlockyLinkedList<T>::remove(std::size_t pos)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    T BlockyLinkedList<T, BlockSize>::remove(std::size_t pos)
     {
         auto [node, offset]    = locate(pos);
         auto [rnode, scenario] = determineRemoveScenario(node);
@@ -331,7 +648,7 @@ namespace dsa
 
         Node* current = &node;
 
-        while (current->m_block.size() < m_blockSize - 1 && current->m_next != nullptr) {
+        while (current->m_block.size() < blockSize() - 1 && current->m_next != nullptr) {
             Node* next = current->m_next.get();
             current->m_block.push_back(std::move(next->m_block.pop_front()));
             current = current->m_next.get();
@@ -344,14 +661,14 @@ namespace dsa
         return value;
     }
 
-    template <BlockyLinkedListElement T>
-    T& BlockyLinkedList<T>::push_front(T&& element)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    T& BlockyLinkedList<T, BlockSize>::push_front(T&& element)
     {
         return insert(0, std::move(element));
     }
 
-    template <BlockyLinkedListElement T>
-    T& BlockyLinkedList<T>::push_back(T&& element)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    T& BlockyLinkedList<T, BlockSize>::push_back(T&& element)
     {
         if (m_head == nullptr) {
             auto& head = initHead();
@@ -359,7 +676,7 @@ namespace dsa
             return head.m_block.push_back(std::move(element));
         }
 
-        if (m_tail->m_block.size() == m_blockSize + 1) {
+        if (m_tail->m_block.size() == blockSize() + 1) {
             auto& newTail = insertNodeAfter(*m_tail);
             ++m_size;
             return newTail.m_block.push_back(std::move(element));
@@ -369,56 +686,198 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    T BlockyLinkedList<T>::pop_front()
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    template <ContainerCompatibleRange<T> R>
+    void BlockyLinkedList<T, BlockSize>::append_range(R&& range)
+    {
+        auto first = std::ranges::begin(range);
+        auto last  = std::ranges::end(range);
+
+        while (first != last) {
+            if (m_tail == nullptr) {
+                initHead();
+            } else if (m_tail->m_block.size() == blockSize() + 1) {
+                insertNodeAfter(*m_tail);
+            }
+
+            auto& block = m_tail->m_block;
+            for (auto room = blockSize() + 1 - block.size(); room > 0 and first != last; --room, ++first) {
+                block.push_back(T(*first));
+                ++m_size;
+            }
+        }
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::apply_batch(std::span<BatchOp<T>> ops)
+    {
+        if (ops.empty()) {
+            return;
+        }
+
+        auto order = ArrayList<BatchOp<T>*>{};
+        order.reserve(ops.size());
+        for (auto& op : ops) {
+            order.push_back(&op);
+        }
+
+        auto sorted  = std::span{ order.data(), order.size() };
+        auto newSize = sortBatch(sorted, m_size);
+
+        // the blocks before the one holding the first position are left as they are
+        auto  first = sorted.front()->m_position;
+        auto  pos   = 0uz;
+        Node* node  = m_head.get();
+
+        while (node != nullptr and pos + node->m_block.size() <= first) {
+            pos  += node->m_block.size();
+            node  = node->m_next.get();
+        }
+
+        // the new blocks are built on the side and replace the old ones only once they are complete, a
+        // throwing move or allocation frees them with rebuilt and leaves the old blocks in the list
+        auto rebuilt        = BlockyLinkedList{};
+        rebuilt.m_blockSize = m_blockSize;
+
+        auto prefix = pos;
+        auto next   = 0uz;    // into sorted
+        for (auto* current = node; current != nullptr; current = current->m_next.get()) {
+            for (auto segment : current->m_block.segments()) {
+                for (auto& value : segment) {
+                    auto removed = false;
+                    for (; next < sorted.size() and sorted[next]->m_position == pos; ++next) {
+                        if (sorted[next]->isInsert()) {
+                            rebuilt.refillBack(std::move(*sorted[next]->m_value));
+                        } else {
+                            removed = true;
+                        }
+                    }
+
+                    if (not removed) {
+                        rebuilt.refillBack(std::move(value));
+                    }
+                    ++pos;
+                }
+            }
+        }
+
+        // the rest are inserts at the end of the list
+        for (; next < sorted.size(); ++next) {
+            rebuilt.refillBack(std::move(*sorted[next]->m_value));
+        }
+
+        // splice the new blocks in place of the old ones from node onward
+        auto* prev = node == nullptr ? m_tail : node->m_prev;
+        auto& link = prev == nullptr ? m_head : prev->m_next;
+        auto  old  = std::move(link);
+
+        if (rebuilt.m_head != nullptr) {
+            rebuilt.m_head->m_prev = prev;
+            link                   = std::move(rebuilt.m_head);
+            m_tail                 = std::exchange(rebuilt.m_tail, nullptr);
+        } else {
+            m_tail = prev;
+        }
+        m_size = prefix + std::exchange(rebuilt.m_size, 0);
+
+        while (old != nullptr) {
+            old = std::move(old->m_next);
+        }
+
+        assert(m_size == newSize and "batch should end with the size computed from the ops");
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    T BlockyLinkedList<T, BlockSize>::pop_front()
     {
         return remove(0);
     }
 
-    template <BlockyLinkedListElement T>
-    T BlockyLinkedList<T>::pop_back()
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    T BlockyLinkedList<T, BlockSize>::pop_back()
     {
         return remove(m_size - 1);
     }
 
-    template <BlockyLinkedListElement T>
-    auto&& BlockyLinkedList<T>::at(this auto&& self, std::size_t pos)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    Result<T&> BlockyLinkedList<T, BlockSize>::try_insert(std::size_t pos, T&& element)
+    {
+        if (pos > m_size) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insert(pos, std::move(element));
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    std::optional<T> BlockyLinkedList<T, BlockSize>::try_pop_front()
+    {
+        if (m_size == 0) {
+            return std::nullopt;
+        }
+        return remove(0);
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto&& BlockyLinkedList<T, BlockSize>::at(this auto&& self, std::size_t pos)
+    {
+        auto [node, offset] = self.locate(pos);
+        return node.m_block.at(offset);
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto BlockyLinkedList<T, BlockSize>::try_at(this auto&& self, std::size_t pos)
+        -> Result<ElementRef<decltype(self), T>>
     {
+        if (pos >= self.m_size) {
+            return std::unexpected{ Error::OutOfRange };
+        }
         auto [node, offset] = self.locate(pos);
         return node.m_block.at(offset);
     }
 
-    template <BlockyLinkedListElement T>
-    auto&& BlockyLinkedList<T>::front(this auto&& self)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto&& BlockyLinkedList<T, BlockSize>::front(this auto&& self)
     {
         return self.at(0);
     }
 
-    template <BlockyLinkedListElement T>
-    auto&& BlockyLinkedList<T>::back(this auto&& self)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto&& BlockyLinkedList<T, BlockSize>::back(this auto&& self)
     {
         return self.at(self.m_size - 1);
     }
 
-    template <BlockyLinkedListElement T>
-    auto BlockyLinkedList<T>::begin(this auto&& self) noexcept
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto BlockyLinkedList<T, BlockSize>::begin(this auto&& self) noexcept
     {
         return makeIter<Iterator, decltype(self)>(&self, 0uz);
     }
 
-    template <BlockyLinkedListElement T>
-    auto BlockyLinkedList<T>::end(this auto&& self) noexcept
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto BlockyLinkedList<T, BlockSize>::end(this auto&& self) noexcept
     {
         return makeIter<Iterator, decltype(self)>(&self, self.size());
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::ElementLocation BlockyLinkedList<T>::locate(std::size_t pos) const
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    auto BlockyLinkedList<T, BlockSize>::segments(this auto&& self)
+    {
+        constexpr auto isConst = std::is_const_v<std::remove_reference_t<decltype(self)>>;
+
+        auto blocks = std::ranges::subrange{
+            BlockIterator<isConst>{ self.m_head.get() },
+            BlockIterator<isConst>{},
+        };
+        return std::move(blocks) | std::views::transform([](auto& block) { return block.segments(); })
+             | std::views::join;
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::ElementLocation
+    BlockyLinkedList<T, BlockSize>::locate(std::size_t pos) const
     {
         if (pos >= m_size) {
-            throw std::out_of_range{
-                std::format("Position is out of range: pos {} on size {}", pos, m_size)
-            };
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, m_size);
         }
 
         if (pos <= m_size / 2) {
@@ -432,7 +891,7 @@ namespace dsa
                 assert(current != nullptr && "current node must not be null");
             }
 
-            if (pos >= m_blockSize + 1) {
+            if (pos >= blockSize() + 1) {
                 std::raise(SIGTRAP);
             }
 
@@ -447,7 +906,7 @@ namespace dsa
                 assert(current != nullptr && "current node must not be null");
             }
 
-            if ((pos - idx) >= m_blockSize + 1) {
+            if ((pos - idx) >= blockSize() + 1) {
                 std::raise(SIGTRAP);
             }
 
@@ -455,13 +914,13 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::Node& BlockyLinkedList<T>::insertNodeAfter(Node& node)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::Node& BlockyLinkedList<T, BlockSize>::insertNodeAfter(Node& node)
     {
         auto* prev = &node;
         auto  next = std::move(prev->m_next);
 
-        auto newNode = std::make_unique<Node>(m_blockSize + 1);
+        auto newNode = std::make_unique<Node>(blockSize() + 1);
         if (next != nullptr) {
             next->m_prev = newNode.get();
         }
@@ -478,13 +937,13 @@ namespace dsa
         return *prev->m_next;
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::Node& BlockyLinkedList<T>::insertNodeBefore(Node& node)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::Node& BlockyLinkedList<T, BlockSize>::insertNodeBefore(Node& node)
     {
         Node* prev = node.m_prev;
         auto  next = std::move(&node == m_head.get() ? m_head : prev->m_next);
 
-        auto newNode = std::make_unique<Node>(m_blockSize + 1);
+        auto newNode = std::make_unique<Node>(blockSize() + 1);
         if (next != nullptr) {
             next->m_prev = newNode.get();
         }
@@ -501,8 +960,8 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    void BlockyLinkedList<T>::removeNode(Node& node)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::removeNode(Node& node)
     {
         if (&node == m_head.get()) {
             m_head = std::move(node.m_next);
@@ -524,19 +983,19 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    BlockyLinkedList<T>::Node& BlockyLinkedList<T>::initHead()
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    BlockyLinkedList<T, BlockSize>::Node& BlockyLinkedList<T, BlockSize>::initHead()
     {
-        m_head = std::make_unique<Node>(m_blockSize + 1);
+        m_head = std::make_unique<Node>(blockSize() + 1);
         m_tail = m_head.get();
         return *m_head;
     }
 
-    template <BlockyLinkedListElement T>
-    void BlockyLinkedList<T>::spread(Node& from, Node& until)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::spread(Node& from, Node& until)
     {
         Node* node = &from;
-        for (auto i = 0uz; i < m_blockSize; ++i) {
+        for (auto i = 0uz; i < blockSize(); ++i) {
             node = node->m_next.get();
         }
         assert(node == &until);
@@ -550,7 +1009,7 @@ namespace dsa
 
         for (Node* current = &newNode; current != &from; current = current->m_prev) {
             assert(current != nullptr && "node should not be null");
-            while (current->m_block.size() < m_blockSize) {
+            while (current->m_block.size() < blockSize()) {
                 Node* prev = current->m_prev;
                 assert(prev != nullptr && "node should not be null");
                 current->m_block.push_front(std::move(prev->m_block.pop_back()));
@@ -558,12 +1017,12 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    void BlockyLinkedList<T>::gather(Node& node)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::gather(Node& node)
     {
         Node* current = &node;
-        for (auto i = 0uz; i < m_blockSize - 1; ++i) {
-            while (current->m_block.size() < m_blockSize) {
+        for (auto i = 0uz; i < blockSize() - 1; ++i) {
+            while (current->m_block.size() < blockSize()) {
                 Node* next = current->m_next.get();
                 current->m_block.push_back(std::move(next->m_block.pop_front()));
             }
@@ -572,14 +1031,31 @@ namespace dsa
         removeNode(*current);
     }
 
-    template <BlockyLinkedListElement T>
-    std::pair<typename BlockyLinkedList<T>::Node&, typename BlockyLinkedList<T>::InsertScenario>
-    BlockyLinkedList<T>::determineInsertScenario(Node& node)
+    // unlike push_back the blocks are filled to b elements only, so both inserts and removes have room
+    // after a batch rebuilt the list
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    void BlockyLinkedList<T, BlockSize>::refillBack(T&& element)
+    {
+        if (m_tail == nullptr) {
+            initHead();
+        } else if (m_tail->m_block.size() >= blockSize()) {
+            insertNodeAfter(*m_tail);
+        }
+
+        m_tail->m_block.push_back(std::move(element));
+        ++m_size;
+    }
+
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    std::pair<
+        typename BlockyLinkedList<T, BlockSize>::Node&,
+        typename BlockyLinkedList<T, BlockSize>::InsertScenario>
+    BlockyLinkedList<T, BlockSize>::determineInsertScenario(Node& node)
     {
         std::size_t steps   = 0;
         Node*       current = &node;
 
-        while (steps < m_blockSize && current != nullptr && current->m_block.size() == m_blockSize + 1) {
+        while (steps < blockSize() && current != nullptr && current->m_block.size() == blockSize() + 1) {
             current = current->m_next.get();
             ++steps;
         }
@@ -587,7 +1063,7 @@ namespace dsa
         if (current == nullptr) {
             insertNodeAfter(*m_tail);
             return { *m_tail, InsertScenario::EndOfList };
-        } else if (steps == m_blockSize) {
+        } else if (steps == blockSize()) {
             assert(current != nullptr && "node should not be null");
             assert(canReachRight(node, *current));
             return { *current, InsertScenario::Spread };
@@ -598,30 +1074,32 @@ namespace dsa
         }
     }
 
-    template <BlockyLinkedListElement T>
-    std::pair<typename BlockyLinkedList<T>::Node&, typename BlockyLinkedList<T>::RemoveScenario>
-    BlockyLinkedList<T>::determineRemoveScenario(Node& node)
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
+    std::pair<
+        typename BlockyLinkedList<T, BlockSize>::Node&,
+        typename BlockyLinkedList<T, BlockSize>::RemoveScenario>
+    BlockyLinkedList<T, BlockSize>::determineRemoveScenario(Node& node)
     {
         std::size_t steps   = 0;
         Node*       current = &node;
 
-        while (steps < m_blockSize && current != nullptr && current->m_block.size() == m_blockSize - 1) {
+        while (steps < blockSize() && current != nullptr && current->m_block.size() == blockSize() - 1) {
             current = current->m_next.get();
             ++steps;
         }
 
         if (current == nullptr) {
             return { *m_tail, RemoveScenario::EndOfList };
-        } else if (steps == m_blockSize) {
+        } else if (steps == blockSize()) {
             return { *current, RemoveScenario::Gather };
         } else {
             return { *current, RemoveScenario::Shift };
         }
     }
 
-    template <BlockyLinkedListElement T>
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
     template <bool IsConst>
-    class BlockyLinkedList<T>::Iterator
+    class BlockyLinkedList<T, BlockSize>::Iterator
     {
     public:
         // STL compatibility
@@ -691,7 +1169,7 @@ namespace dsa
         reference operator*() const
         {
             if (m_list == nullptr || m_pos == m_list->size()) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
             return m_list->at(m_pos);
         };
@@ -699,7 +1177,7 @@ namespace dsa
         pointer operator->() const
         {
             if (m_list == nullptr || m_pos == m_list->size()) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
 
             return &m_list->at(m_pos);
@@ -710,9 +1188,9 @@ namespace dsa
         std::size_t m_pos  = 0;
     };
 
-    template <BlockyLinkedListElement T>
+    template <BlockyLinkedListElement T, std::size_t BlockSize>
     template <bool IsConst>
-    class BlockyLinkedList<T>::BlockIterator
+    class BlockyLinkedList<T, BlockSize>::BlockIterator
     {
     public:
         // STL compatibility
@@ -767,6 +1245,7 @@ namespace dsa
                 auto i = static_cast<std::size_t>(n);
                 while (i-- > 0 && (m_current = m_current->m_next.get())) { }
             }
+            return *this;
         }
 
         BlockIterator& operator--()
@@ -790,12 +1269,13 @@ namespace dsa
                 auto i = static_cast<std::size_t>(n);
                 while (i-- > 0 && (m_current = m_current->m_prev)) { }
             }
+            return *this;
         }
 
         reference operator*() const
         {
             if (m_current == nullptr) {
-                throw std::out_of_range{ "BlockIterator is out of range" };
+                fail<std::out_of_range>("BlockIterator is out of range");
             }
 
             return m_current->m_block;
@@ -804,7 +1284,7 @@ namespace dsa
         pointer operator->() const
         {
             if (m_current == nullptr) {
-                throw std::out_of_range{ "BlockIterator is out of range" };
+                fail<std::out_of_range>("BlockIterator is out of range");
             }
 
             return &m_current->m_block;
@@ -0,0 +1,464 @@
+#pragma once
+
+// NOTE: Channel is a bounded queue between coroutines on top of a fixed capacity CircularBuffer. co_await
+//       send(value) suspends the sender while the buffer is full and co_await receive() suspends the receiver
+//       while it is empty, the thread is never blocked. a value sent while a receiver waits is handed to it
+//       directly, and a receiver that makes room moves the value of the first waiting sender into the buffer.
+//       the coroutines woken up this way are resumed later through the scheduler of the channel, in the order
+//       they started to wait.
+//
+//       close() makes every later send fail with Error::Closed, the senders still waiting too (their values
+//       are dropped). receivers get the values left in the buffer, then std::nullopt.
+//
+//       everything here is single-threaded: a channel and the coroutines using it run on one thread. Executor
+//       is the minimal scheduler for that, a FIFO of ready coroutines resumed by run(). it owns the Tasks
+//       spawned on it and destroys the ones still suspended when it is destroyed, so an Executor has to
+//       outlive the channels its tasks wait on.
+
+#include "dsa/array_list.hpp"
+#include "dsa/circular_buffer.hpp"
+#include "dsa/error.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace dsa
+{
+    class Executor;
+
+    // a fire-and-forget coroutine, it starts once spawned on an Executor
+    class [[nodiscard]] Task
+    {
+    public:
+        struct promise_type;
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        struct promise_type
+        {
+            Executor*   m_executor = nullptr;
+            std::size_t m_slot     = 0;    // the index of the task in the executor
+
+            ~promise_type();
+
+            Task get_return_object() noexcept { return Task{ Handle::from_promise(*this) }; }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_never  final_suspend() noexcept { return {}; }
+
+            void return_void() noexcept { }
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+
+        Task(Task&& other) noexcept
+            : m_handle{ std::exchange(other.m_handle, nullptr) }
+        {
+        }
+
+        Task& operator=(Task&&) = delete;
+
+        ~Task()
+        {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+    private:
+        friend class Executor;
+
+        explicit Task(Handle handle) noexcept
+            : m_handle{ handle }
+        {
+        }
+
+        Handle m_handle;
+    };
+
+    class Executor
+    {
+    public:
+        Executor() = default;
+        ~Executor();
+
+        Executor(Executor&&)            = delete;
+        Executor& operator=(Executor&&) = delete;
+
+        // the task starts on the next run()
+        void spawn(Task task);
+
+        void schedule(std::coroutine_handle<> handle) { m_ready.push_back(std::move(handle)); }
+
+        // resume the ready coroutines until there is none left, returns the number of resumes
+        std::size_t run();
+
+        // resume the first ready coroutine, returns false if there is none
+        bool runOne();
+
+        // the number of spawned tasks that have not finished, running or suspended
+        std::size_t pending() const noexcept { return m_tasks.size(); }
+
+    private:
+        friend Task::promise_type;
+
+        static constexpr auto s_readyPolicy = BufferPolicy{
+            .m_capacity = BufferCapacityPolicy::DynamicCapacity,
+            .m_store    = BufferStorePolicy::ThrowOnFull,
+        };
+
+        CircularBuffer<std::coroutine_handle<>, s_readyPolicy> m_ready = {};
+        ArrayList<Task::Handle>                                m_tasks = {};
+
+        void forget(std::size_t slot) noexcept;
+    };
+
+    template <typename S>
+    concept Scheduler = requires (S& scheduler, std::coroutine_handle<> handle) {
+        { scheduler.schedule(handle) };
+    };
+
+    template <typename T, Scheduler S = Executor>
+    class Channel
+    {
+    public:
+        class SendAwaiter;
+        class ReceiveAwaiter;
+        class BatchAwaiter;
+
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        Channel(S& scheduler, std::size_t capacity);
+
+        // the awaiters point into the channel
+        Channel(Channel&&)            = delete;
+        Channel& operator=(Channel&&) = delete;
+
+        // co_await returns Result<void>, Error::Closed if the channel is closed before the value is taken
+        SendAwaiter send(T&& value) { return { *this, std::move(value) }; }
+
+        // co_await returns the value, std::nullopt once the channel is closed and drained
+        ReceiveAwaiter receive() { return { *this }; }
+
+        // co_await appends between 1 and max values to out and returns how many, 0 once the channel is
+        // closed and drained. max must not be 0
+        BatchAwaiter receiveBatch(ArrayList<T>& out, std::size_t max) { return { *this, out, max }; }
+
+        // the same without suspending: a send fails with Error::Full where it would suspend
+        Result<void>     try_send(T&& value);
+        std::optional<T> try_receive();
+
+        // wake up every waiting coroutine, later sends fail and receives only drain the buffer
+        void close();
+
+        bool        isClosed() const noexcept { return m_closed; }
+        std::size_t size() const noexcept { return m_buffer.size(); }
+        std::size_t capacity() const noexcept { return m_buffer.capacity(); }
+
+    private:
+        // a waiting receive or batch receive, it lives in the awaiter of the suspended coroutine
+        struct Receiver
+        {
+            std::coroutine_handle<> m_handle = {};
+            Receiver*               m_next   = nullptr;
+            std::optional<T>*       m_value  = nullptr;    // receive
+            ArrayList<T>*           m_batch  = nullptr;    // batch receive
+        };
+
+        // intrusive FIFO of the waiters
+        template <typename W>
+        struct WaitQueue
+        {
+            W* m_head = nullptr;
+            W* m_tail = nullptr;
+
+            bool empty() const noexcept { return m_head == nullptr; }
+
+            void push(W* waiter) noexcept
+            {
+                waiter->m_next = nullptr;
+                (m_tail ? m_tail->m_next : m_head) = waiter;
+                m_tail = waiter;
+            }
+
+            W* pop() noexcept
+            {
+                auto waiter = std::exchange(m_head, m_head->m_next);
+                if (m_head == nullptr) {
+                    m_tail = nullptr;
+                }
+                return waiter;
+            }
+        };
+
+        static constexpr auto s_policy = BufferPolicy{
+            .m_capacity = BufferCapacityPolicy::FixedCapacity,
+            .m_store    = BufferStorePolicy::ThrowOnFull,
+        };
+
+        S&                          m_scheduler;
+        CircularBuffer<T, s_policy> m_buffer;
+        WaitQueue<SendAwaiter>      m_senders   = {};
+        WaitQueue<Receiver>         m_receivers = {};
+        bool                        m_closed    = false;
+
+        // pop the front of the buffer, the first waiting sender fills the room it leaves
+        T take();
+
+        // move up to max - out.size() values from the buffer to out
+        void drain(ArrayList<T>& out, std::size_t max);
+    };
+
+    template <typename T, Scheduler S>
+    class [[nodiscard]] Channel<T, S>::SendAwaiter
+    {
+    public:
+        SendAwaiter(Channel& channel, T&& value)
+            : m_channel{ channel }
+            , m_value{ std::move(value) }
+        {
+        }
+
+        bool await_ready()
+        {
+            m_result = m_channel.try_send(std::move(m_value));
+            return m_result.has_value() or m_result.error() != Error::Full;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            m_handle = handle;
+            m_channel.m_senders.push(this);
+        }
+
+        Result<void> await_resume() noexcept { return m_result; }
+
+    private:
+        friend Channel;
+        friend WaitQueue<SendAwaiter>;
+
+        Channel&                m_channel;
+        T                       m_value;
+        Result<void>            m_result = {};
+        std::coroutine_handle<> m_handle = {};
+        SendAwaiter*            m_next   = nullptr;
+    };
+
+    template <typename T, Scheduler S>
+    class [[nodiscard]] Channel<T, S>::ReceiveAwaiter
+    {
+    public:
+        ReceiveAwaiter(Channel& channel)
+            : m_channel{ channel }
+        {
+        }
+
+        bool await_ready()
+        {
+            m_value = m_channel.try_receive();
+            return m_value.has_value() or m_channel.m_closed;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            m_receiver = { .m_handle = handle, .m_value = &m_value };
+            m_channel.m_receivers.push(&m_receiver);
+        }
+
+        std::optional<T> await_resume() noexcept { return std::move(m_value); }
+
+    private:
+        Channel&         m_channel;
+        std::optional<T> m_value    = std::nullopt;
+        Receiver         m_receiver = {};
+    };
+
+    template <typename T, Scheduler S>
+    class [[nodiscard]] Channel<T, S>::BatchAwaiter
+    {
+    public:
+        BatchAwaiter(Channel& channel, ArrayList<T>& out, std::size_t max)
+            : m_channel{ channel }
+            , m_out{ out }
+            , m_start{ out.size() }
+            , m_max{ m_start + max }
+        {
+            assert(max > 0 and "a batch receive takes at least one value");
+        }
+
+        bool await_ready()
+        {
+            m_channel.drain(m_out, m_max);
+            return m_out.size() > m_start or m_channel.m_closed;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            m_receiver = { .m_handle = handle, .m_batch = &m_out };
+            m_channel.m_receivers.push(&m_receiver);
+        }
+
+        // the first value is handed over, the senders may have filled the buffer since
+        std::size_t await_resume()
+        {
+            m_channel.drain(m_out, m_max);
+            return m_out.size() - m_start;
+        }
+
+    private:
+        Channel&      m_channel;
+        ArrayList<T>& m_out;
+        std::size_t   m_start;
+        std::size_t   m_max;
+        Receiver      m_receiver = {};
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    inline Task::promise_type::~promise_type()
+    {
+        if (m_executor != nullptr) {
+            m_executor->forget(m_slot);
+        }
+    }
+
+    inline Executor::~Executor()
+    {
+        // a suspended task removes itself from m_tasks when destroyed
+        while (m_tasks.size() > 0) {
+            m_tasks.back().destroy();
+        }
+    }
+
+    inline void Executor::spawn(Task task)
+    {
+        auto handle = std::exchange(task.m_handle, nullptr);
+
+        handle.promise().m_executor = this;
+        handle.promise().m_slot     = m_tasks.size();
+
+        m_tasks.push_back(auto{ handle });
+        schedule(handle);
+    }
+
+    inline std::size_t Executor::run()
+    {
+        auto count = 0uz;
+        while (runOne()) {
+            ++count;
+        }
+        return count;
+    }
+
+    inline bool Executor::runOne()
+    {
+        auto handle = m_ready.try_pop_front();
+        if (not handle) {
+            return false;
+        }
+        handle->resume();
+        return true;
+    }
+
+    inline void Executor::forget(std::size_t slot) noexcept
+    {
+        auto last = m_tasks.pop_back();
+        if (slot < m_tasks.size()) {
+            last.promise().m_slot = slot;
+            m_tasks.at(slot)      = last;
+        }
+    }
+
+    template <typename T, Scheduler S>
+    Channel<T, S>::Channel(S& scheduler, std::size_t capacity)
+        : m_scheduler{ scheduler }
+        , m_buffer{ capacity }
+    {
+        if (capacity == 0) {
+            fail<std::invalid_argument>("Channel capacity must be at least 1");
+        }
+    }
+
+    template <typename T, Scheduler S>
+    Result<void> Channel<T, S>::try_send(T&& value)
+    {
+        if (m_closed) {
+            return std::unexpected{ Error::Closed };
+        }
+
+        // a receiver only waits on an empty buffer
+        if (not m_receivers.empty()) {
+            auto receiver = m_receivers.pop();
+            if (receiver->m_value != nullptr) {
+                receiver->m_value->emplace(std::move(value));
+            } else {
+                receiver->m_batch->push_back(std::move(value));
+            }
+            m_scheduler.schedule(receiver->m_handle);
+            return {};
+        }
+
+        if (auto pushed = m_buffer.try_push_back(std::move(value)); not pushed) {
+            return std::unexpected{ pushed.error() };
+        }
+        return {};
+    }
+
+    template <typename T, Scheduler S>
+    std::optional<T> Channel<T, S>::try_receive()
+    {
+        if (m_buffer.size() == 0) {
+            return std::nullopt;
+        }
+        return take();
+    }
+
+    template <typename T, Scheduler S>
+    void Channel<T, S>::close()
+    {
+        m_closed = true;
+
+        while (not m_receivers.empty()) {
+            m_scheduler.schedule(m_receivers.pop()->m_handle);
+        }
+        while (not m_senders.empty()) {
+            auto sender      = m_senders.pop();
+            sender->m_result = std::unexpected{ Error::Closed };
+            m_scheduler.schedule(sender->m_handle);
+        }
+    }
+
+    template <typename T, Scheduler S>
+    T Channel<T, S>::take()
+    {
+        auto value = m_buffer.pop_front();
+
+        // a sender only waits on a full buffer
+        if (not m_senders.empty()) {
+            auto sender = m_senders.pop();
+            m_buffer.push_back(std::move(sender->m_value));
+            sender->m_result = {};
+            m_scheduler.schedule(sender->m_handle);
+        }
+
+        return value;
+    }
+
+    template <typename T, Scheduler S>
+    void Channel<T, S>::drain(ArrayList<T>& out, std::size_t max)
+    {
+        while (out.size() < max and m_buffer.size() > 0) {
+            out.push_back(take());
+        }
+    }
+}
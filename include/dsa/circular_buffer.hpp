@@ -1,15 +1,26 @@
 #pragma once
 
 // NOTE: CircularArray implementation based on reference 1 and reference 2 (ArrayQueue)
+//
+//       the policy is either chosen at runtime (the default, RuntimeBufferPolicy) or fixed at compile time by
+//       giving a BufferPolicy value as the second template parameter, e.g.
+//       CircularBuffer<int, BufferPolicy{ .m_store = BufferStorePolicy::ThrowOnFull }>. a static policy takes
+//       no storage and lets the compiler drop the branches and throw paths of the other policies.
 
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
+#include "dsa/growth_policy.hpp"
 #include "dsa/raw_buffer.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <limits>
 #include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 namespace dsa
@@ -20,7 +31,7 @@ namespace dsa
     enum class BufferCapacityPolicy
     {
         FixedCapacity,
-        DynamicCapacity,    // will double the capacity when full and halve when less than 1/4 full
+        DynamicCapacity,    // grows when full and shrinks as given by BufferPolicy::m_growth
     };
 
     enum class BufferStorePolicy
@@ -46,14 +57,27 @@ namespace dsa
     {
         BufferCapacityPolicy m_capacity = BufferCapacityPolicy::FixedCapacity;
         BufferStorePolicy    m_store    = BufferStorePolicy::ReplaceOnFull;
+
+        // DynamicCapacity only, by default doubles when full and halves when a quarter full
+        GrowthPolicy m_growth = { .m_shrinkDivisor = 4 };
+
+        friend bool operator==(const BufferPolicy&, const BufferPolicy&) = default;
     };
 
-    template <CircularBufferElement T>
+    // the policy of the buffer is given to the constructor and can be changed with setPolicy
+    struct RuntimeBufferPolicy
+    {
+    };
+
+    template <typename P>
+    concept CircularBufferPolicy = std::same_as<P, RuntimeBufferPolicy> or std::same_as<P, BufferPolicy>;
+
+    template <CircularBufferElement T, auto Policy = RuntimeBufferPolicy{}>
     class CircularBuffer
     {
     public:
         template <bool IsConst>
-        class [[nodiscard]] Iterator;    // forward iterator
+        class [[nodiscard]] Iterator;    // random access iterator
 
         friend class Iterator<false>;
         friend class Iterator<true>;
@@ -61,10 +85,39 @@ namespace dsa
         using Element    = T;
         using value_type = Element;    // STL compliance
 
+        using PolicyType = std::remove_cvref_t<decltype(Policy)>;
+
+        static_assert(CircularBufferPolicy<PolicyType>);
+
+        static constexpr bool s_staticPolicy = std::same_as<PolicyType, BufferPolicy>;
+
+        static_assert(
+            [] {
+                if constexpr (s_staticPolicy) {
+                    return Policy.m_growth.isValid();
+                } else {
+                    return true;
+                }
+            }(),
+            "Invalid growth policy"
+        );
+
         CircularBuffer() = default;
         ~CircularBuffer() { clear(); };
 
-        CircularBuffer(std::size_t capacity, BufferPolicy policy = {});
+        CircularBuffer(std::size_t capacity, BufferPolicy policy = {})
+            requires (not s_staticPolicy);
+        CircularBuffer(std::size_t capacity)
+            requires s_staticPolicy;
+
+        // the capacity is the size of the range. a range with unknown size is collected with dynamic capacity
+        // first, then shrunk to fit if the policy has a fixed capacity
+        template <ContainerCompatibleRange<T> R>
+        CircularBuffer(std::from_range_t, R&& range, BufferPolicy policy = {})
+            requires (not s_staticPolicy);
+        template <ContainerCompatibleRange<T> R>
+        CircularBuffer(std::from_range_t, R&& range)
+            requires s_staticPolicy;
 
         CircularBuffer(CircularBuffer&& other) noexcept;
         CircularBuffer& operator=(CircularBuffer&& other) noexcept;
@@ -79,12 +132,20 @@ namespace dsa
 
         void resize(std::size_t newCapacity, BufferResizePolicy policy = BufferResizePolicy::DiscardOld);
 
-        BufferPolicy getPolicy() const noexcept { return m_policy; };
+        BufferPolicy getPolicy() const noexcept
+        {
+            if constexpr (s_staticPolicy) {
+                return Policy;
+            } else {
+                return m_policy;
+            }
+        };
 
         void setPolicy(
             std::optional<BufferCapacityPolicy> storagePolicy,
             std::optional<BufferStorePolicy>    storePolicy
-        ) noexcept;
+        ) noexcept
+            requires (not s_staticPolicy);
 
         T& insert(std::size_t pos, T&& value, BufferInsertPolicy policy = BufferInsertPolicy::DiscardHead);
         T  remove(std::size_t pos);
@@ -95,10 +156,24 @@ namespace dsa
         T  pop_front();
         T  pop_back();
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp. a push fails with
+        // Error::Full where the throwing one throws: on a full ThrowOnFull buffer or a zero fixed capacity
+        Result<T&> try_insert(
+            std::size_t        pos,
+            T&&                value,
+            BufferInsertPolicy policy = BufferInsertPolicy::DiscardHead
+        );
+        Result<T&>       try_push_back(T&& value);
+        std::optional<T> try_pop_front();
+
+        // same as push_back on each element, the capacity grows at most once when the range is sized
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
         CircularBuffer& linearize() noexcept;
 
         // copied buffer will have the policy set using the parameter if it is not std::nullopt else it will
-        // have the same policy as the original buffer
+        // have the same policy as the original buffer. a static policy can't be changed
         [[nodiscard]] CircularBuffer linearizeCopy(std::optional<BufferPolicy> policy) const noexcept
             requires std::copyable<T>;
 
@@ -107,9 +182,13 @@ namespace dsa
 
         auto*  data(this auto&& self) noexcept { return self.m_buffer.data(); }
         auto&& at(this auto&& self, std::size_t pos);
+        auto   try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>;
         auto&& front(this auto&& self) { return self.at(0); };
         auto&& back(this auto&& self);
 
+        // the elements as at most two contiguous spans in order: [head, capacity) then [0, tail)
+        auto segments(this auto&& self) noexcept;
+
         auto begin(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, 0uz); }
         auto end(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, npos); }
 
@@ -119,10 +198,39 @@ namespace dsa
     private:
         static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
 
-        RawBuffer<T> m_buffer = {};
-        std::size_t  m_head   = 0;
-        std::size_t  m_tail   = npos;
-        BufferPolicy m_policy = {};
+        // a static policy is not stored
+        struct NoPolicy
+        {
+        };
+
+        using PolicyStorage = std::conditional_t<s_staticPolicy, NoPolicy, BufferPolicy>;
+
+        RawBuffer<T>                        m_buffer = {};
+        std::size_t                         m_head   = 0;
+        std::size_t                         m_tail   = npos;
+        [[no_unique_address]] PolicyStorage m_policy = {};
+
+        template <ContainerCompatibleRange<T> R>
+        void initFromRange(R&& range);
+
+        // constants with a static policy, so the branches of the other policies are dropped
+        bool hasDynamicCapacity() const noexcept
+        {
+            return getPolicy().m_capacity == BufferCapacityPolicy::DynamicCapacity;
+        }
+
+        bool throwsOnFull() const noexcept { return getPolicy().m_store == BufferStorePolicy::ThrowOnFull; }
+
+        // whether a push would throw: nothing to grow, replace or discard
+        bool rejectsPush() const noexcept
+        {
+            return not hasDynamicCapacity() and (capacity() == 0 or (m_tail == npos and throwsOnFull()));
+        }
+
+        std::size_t grownCapacity(std::size_t required) const
+        {
+            return getPolicy().m_growth.grow(capacity(), required, sizeof(T));
+        }
 
         std::size_t increment(std::size_t& index);
         std::size_t decrement(std::size_t& index);
@@ -135,30 +243,66 @@ namespace dsa
 
 namespace dsa
 {
-    template <CircularBufferElement T>
-    CircularBuffer<T>::CircularBuffer(std::size_t capacity, BufferPolicy policy)
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>::CircularBuffer(std::size_t capacity, BufferPolicy policy)
+        requires (not s_staticPolicy)
         : m_buffer{ capacity }
         , m_head{ 0 }
         , m_tail{ capacity == 0 ? npos : 0 }
         , m_policy{ policy }
     {
+        if (not policy.m_growth.isValid()) {
+            fail<std::invalid_argument>("Invalid growth policy");
+        }
     }
 
-    template <CircularBufferElement T>
-    CircularBuffer<T>::CircularBuffer(const CircularBuffer& other)
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>::CircularBuffer(std::size_t capacity)
+        requires (s_staticPolicy)
+        : m_buffer{ capacity }
+        , m_head{ 0 }
+        , m_tail{ capacity == 0 ? npos : 0 }
+    {
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    template <ContainerCompatibleRange<T> R>
+    CircularBuffer<T, Policy>::CircularBuffer(std::from_range_t, R&& range, BufferPolicy policy)
+        requires (not s_staticPolicy)
+        : m_policy{ policy }
+    {
+        if (not policy.m_growth.isValid()) {
+            fail<std::invalid_argument>("Invalid growth policy");
+        }
+        initFromRange(std::forward<R>(range));
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    template <ContainerCompatibleRange<T> R>
+    CircularBuffer<T, Policy>::CircularBuffer(std::from_range_t, R&& range)
+        requires (s_staticPolicy)
+    {
+        initFromRange(std::forward<R>(range));
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>::CircularBuffer(const CircularBuffer& other)
         requires std::copyable<T>
         : m_buffer{ other.m_buffer.size() }
         , m_head{ other.m_head }
         , m_tail{ other.m_tail }
         , m_policy{ other.m_policy }
     {
-        for (auto i = 0uz; i < size(); ++i) {
-            m_buffer.construct(i, auto{ other.m_buffer.at(i) });
-        }
+        // the elements keep their slots, so the ring is copied as its two contiguous runs
+        auto count = size();
+        auto first = std::min(count, capacity() - m_head);
+
+        m_buffer.constructRange(m_head, other.m_buffer.data() + m_head, first);
+        m_buffer.constructRange(0, other.m_buffer.data(), count - first);
     }
 
-    template <CircularBufferElement T>
-    CircularBuffer<T>& CircularBuffer<T>::operator=(const CircularBuffer& other)
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>& CircularBuffer<T, Policy>::operator=(const CircularBuffer& other)
         requires std::copyable<T>
     {
         if (this == &other) {
@@ -167,12 +311,13 @@ namespace dsa
 
         clear();
 
-        swap(CircularBuffer{ other });    // copy-and-swap idiom
+        auto copy = CircularBuffer{ other };    // copy-and-swap idiom
+        swap(copy);
         return *this;
     }
 
-    template <CircularBufferElement T>
-    CircularBuffer<T>::CircularBuffer(CircularBuffer&& other) noexcept
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>::CircularBuffer(CircularBuffer&& other) noexcept
         : m_buffer{ std::exchange(other.m_buffer, {}) }
         , m_head{ std::exchange(other.m_head, 0) }
         , m_tail{ std::exchange(other.m_tail, npos) }
@@ -180,8 +325,8 @@ namespace dsa
     {
     }
 
-    template <CircularBufferElement T>
-    CircularBuffer<T>& CircularBuffer<T>::operator=(CircularBuffer&& other) noexcept
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>& CircularBuffer<T, Policy>::operator=(CircularBuffer&& other) noexcept
     {
         if (this == &other) {
             return *this;
@@ -197,8 +342,8 @@ namespace dsa
         return *this;
     }
 
-    template <CircularBufferElement T>
-    void CircularBuffer<T>::swap(CircularBuffer& other) noexcept
+    template <CircularBufferElement T, auto Policy>
+    void CircularBuffer<T, Policy>::swap(CircularBuffer& other) noexcept
     {
         std::swap(m_buffer, other.m_buffer);
         std::swap(m_head, other.m_head);
@@ -206,26 +351,29 @@ namespace dsa
         std::swap(m_policy, other.m_policy);
     }
 
-    template <CircularBufferElement T>
-    void CircularBuffer<T>::clear() noexcept
+    template <CircularBufferElement T, auto Policy>
+    void CircularBuffer<T, Policy>::clear() noexcept
     {
-        for (auto i = 0uz; i < size(); ++i) {
-            m_buffer.destroy((m_head + i) % capacity());
-        }
+        auto count = size();
+        auto first = std::min(count, capacity() - m_head);
+
+        m_buffer.destroyRange(m_head, first);
+        m_buffer.destroyRange(0, count - first);
 
         m_head = 0;
-        m_tail = 0;
+        m_tail = capacity() == 0 ? npos : 0;
     }
 
     // TODO: add condition when
     // - size < capacity && size < newCapacity
     // - size < capacity && size > newCpacity
-    template <CircularBufferElement T>
-    void CircularBuffer<T>::resize(std::size_t newCapacity, BufferResizePolicy policy)
+    template <CircularBufferElement T, auto Policy>
+    void CircularBuffer<T, Policy>::resize(std::size_t newCapacity, BufferResizePolicy policy)
     {
         if (newCapacity == 0) {
             clear();
-            m_tail = npos;
+            m_buffer = RawBuffer<T>{};
+            m_tail   = npos;
             return;
         }
 
@@ -246,7 +394,7 @@ namespace dsa
             for (auto i = 0uz; i < size(); ++i) {
                 auto idx = (m_head + i) % capacity();
                 buffer.construct(i, std::move(m_buffer.at(idx)));
-                m_buffer.destroy(i);
+                m_buffer.destroy(idx);
             }
 
             m_tail   = m_tail == npos ? capacity() : (m_tail + capacity() - m_head) % capacity();
@@ -282,14 +430,15 @@ namespace dsa
 
         m_buffer = std::move(buffer);
         m_head   = 0;
-        m_tail   = count <= newCapacity ? count : npos;
+        m_tail   = count < newCapacity ? count : npos;
     }
 
-    template <CircularBufferElement T>
-    void CircularBuffer<T>::setPolicy(
+    template <CircularBufferElement T, auto Policy>
+    void CircularBuffer<T, Policy>::setPolicy(
         std::optional<BufferCapacityPolicy> storagePolicy,
         std::optional<BufferStorePolicy>    storePolicy
     ) noexcept
+        requires (not s_staticPolicy)
     {
         if (storagePolicy.has_value()) {
             m_policy.m_capacity = storagePolicy.value();
@@ -300,22 +449,22 @@ namespace dsa
         }
     }
 
-    template <CircularBufferElement T>
-    T& CircularBuffer<T>::insert(std::size_t pos, T&& value, BufferInsertPolicy policy)
+    template <CircularBufferElement T, auto Policy>
+    T& CircularBuffer<T, Policy>::insert(std::size_t pos, T&& value, BufferInsertPolicy policy)
     {
         if (capacity() == 0) {
-            if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity) {
-                resize(1, BufferResizePolicy::DiscardOld);
+            if (hasDynamicCapacity()) {
+                resize(grownCapacity(1), BufferResizePolicy::DiscardOld);
             } else {
-                throw std::logic_error{ "Can't push to a buffer with zero capacity" };
+                fail<std::logic_error>("Can't push to a buffer with zero capacity");
             }
         }
 
         if (m_tail == npos) {
-            if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity) {
-                resize(capacity() * 2, BufferResizePolicy::DiscardOld);
-            } else if (m_policy.m_store == BufferStorePolicy::ThrowOnFull) {
-                throw std::out_of_range{ "Buffer is full" };
+            if (hasDynamicCapacity()) {
+                resize(grownCapacity(capacity() + 1), BufferResizePolicy::DiscardOld);
+            } else if (throwsOnFull()) {
+                fail<std::out_of_range>("Buffer is full");
             }
         }
 
@@ -355,13 +504,13 @@ namespace dsa
         return *element;
     }
 
-    template <CircularBufferElement T>
-    T CircularBuffer<T>::remove(std::size_t pos)
+    template <CircularBufferElement T, auto Policy>
+    T CircularBuffer<T, Policy>::remove(std::size_t pos)
     {
         if (pos >= size()) {
-            throw std::out_of_range{ std::format(
+            fail<std::out_of_range>(
                 "Cannot remove at position greater than or equal to size; pos: {}, size: {}", pos, size()
-            ) };
+            );
         }
 
         const auto count   = size() - pos - 1;
@@ -381,29 +530,29 @@ namespace dsa
         }
         decrement(m_tail);
 
-        if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity and size() == capacity() / 4) {
-            resize(capacity() / 2, BufferResizePolicy::DiscardOld);
+        if (hasDynamicCapacity() and getPolicy().m_growth.shouldShrink(size(), capacity())) {
+            resize(getPolicy().m_growth.shrink(capacity(), sizeof(T)), BufferResizePolicy::DiscardOld);
         }
 
         return value;
     }
 
-    template <CircularBufferElement T>
-    T& CircularBuffer<T>::push_front(T&& value)
+    template <CircularBufferElement T, auto Policy>
+    T& CircularBuffer<T, Policy>::push_front(T&& value)
     {
         if (capacity() == 0) {
-            if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity) {
-                resize(1, BufferResizePolicy::DiscardOld);
+            if (hasDynamicCapacity()) {
+                resize(grownCapacity(1), BufferResizePolicy::DiscardOld);
             } else {
-                throw std::logic_error{ "Can't push to a buffer with zero capacity" };
+                fail<std::logic_error>("Can't push to a buffer with zero capacity");
             }
         }
 
         if (m_tail == npos) {
-            if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity) {
-                resize(capacity() * 2, BufferResizePolicy::DiscardOld);
-            } else if (m_policy.m_store == BufferStorePolicy::ThrowOnFull) {
-                throw std::out_of_range{ "Buffer is full" };
+            if (hasDynamicCapacity()) {
+                resize(grownCapacity(capacity() + 1), BufferResizePolicy::DiscardOld);
+            } else if (throwsOnFull()) {
+                fail<std::out_of_range>("Buffer is full");
             }
         }
 
@@ -424,22 +573,22 @@ namespace dsa
     }
 
     // snake-case to be able to use std functions like std::back_inserter
-    template <CircularBufferElement T>
-    T& CircularBuffer<T>::push_back(T&& value)
+    template <CircularBufferElement T, auto Policy>
+    T& CircularBuffer<T, Policy>::push_back(T&& value)
     {
         if (capacity() == 0) {
-            if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity) {
-                resize(1, BufferResizePolicy::DiscardOld);
+            if (hasDynamicCapacity()) {
+                resize(grownCapacity(1), BufferResizePolicy::DiscardOld);
             } else {
-                throw std::logic_error{ "Can't push to a buffer with zero capacity" };
+                fail<std::logic_error>("Can't push to a buffer with zero capacity");
             }
         }
 
         if (m_tail == npos) {
-            if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity) {
-                resize(capacity() * 2, BufferResizePolicy::DiscardOld);
-            } else if (m_policy.m_store == BufferStorePolicy::ThrowOnFull) {
-                throw std::out_of_range{ "Buffer is full" };
+            if (hasDynamicCapacity()) {
+                resize(grownCapacity(capacity() + 1), BufferResizePolicy::DiscardOld);
+            } else if (throwsOnFull()) {
+                fail<std::out_of_range>("Buffer is full");
             }
         }
 
@@ -461,11 +610,11 @@ namespace dsa
         return m_buffer.at(current);
     }
 
-    template <CircularBufferElement T>
-    T CircularBuffer<T>::pop_front()
+    template <CircularBufferElement T, auto Policy>
+    T CircularBuffer<T, Policy>::pop_front()
     {
         if (size() == 0) {
-            throw std::out_of_range{ "Buffer is empty" };
+            fail<std::out_of_range>("Buffer is empty");
         }
 
         auto value = std::move(m_buffer.at(m_head));
@@ -476,19 +625,19 @@ namespace dsa
         }
         increment(m_head);
 
-        if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity and size() == capacity() / 4) {
-            resize(capacity() / 2, BufferResizePolicy::DiscardOld);
+        if (hasDynamicCapacity() and getPolicy().m_growth.shouldShrink(size(), capacity())) {
+            resize(getPolicy().m_growth.shrink(capacity(), sizeof(T)), BufferResizePolicy::DiscardOld);
         }
 
         return value;
     }
 
-    template <CircularBufferElement T>
-    T CircularBuffer<T>::pop_back()
+    template <CircularBufferElement T, auto Policy>
+    T CircularBuffer<T, Policy>::pop_back()
     {
         // TODO: implement
         if (size() == 0) {
-            throw std::out_of_range{ "Buffer is empty" };
+            fail<std::out_of_range>("Buffer is empty");
         }
 
         auto index = m_tail == npos ? (m_head == 0 ? capacity() - 1 : m_head - 1)
@@ -499,15 +648,93 @@ namespace dsa
 
         m_tail = index;
 
-        if (m_policy.m_capacity == BufferCapacityPolicy::DynamicCapacity and size() == capacity() / 4) {
-            resize(capacity() / 2, BufferResizePolicy::DiscardOld);
+        if (hasDynamicCapacity() and getPolicy().m_growth.shouldShrink(size(), capacity())) {
+            resize(getPolicy().m_growth.shrink(capacity(), sizeof(T)), BufferResizePolicy::DiscardOld);
         }
 
         return value;
     }
 
-    template <CircularBufferElement T>
-    CircularBuffer<T>& CircularBuffer<T>::linearize() noexcept
+    template <CircularBufferElement T, auto Policy>
+    Result<T&> CircularBuffer<T, Policy>::try_insert(std::size_t pos, T&& value, BufferInsertPolicy policy)
+    {
+        if (pos > size()) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        if (rejectsPush()) {
+            return std::unexpected{ Error::Full };
+        }
+        return insert(pos, std::move(value), policy);
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    Result<T&> CircularBuffer<T, Policy>::try_push_back(T&& value)
+    {
+        if (rejectsPush()) {
+            return std::unexpected{ Error::Full };
+        }
+        return push_back(std::move(value));
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    std::optional<T> CircularBuffer<T, Policy>::try_pop_front()
+    {
+        if (size() == 0) {
+            return std::nullopt;
+        }
+        return pop_front();
+    }
+
+    // a range with unknown size grows the buffer as needed whatever the policy is, then the buffer is shrunk
+    // to fit if the policy has a fixed capacity
+    template <CircularBufferElement T, auto Policy>
+    template <ContainerCompatibleRange<T> R>
+    void CircularBuffer<T, Policy>::initFromRange(R&& range)
+    {
+        if constexpr (KnownSizeRange<R>) {
+            resize(rangeSize(range));
+            append_range(std::forward<R>(range));
+        } else {
+            for (auto&& value : range) {
+                if (m_tail == npos) {
+                    resize(grownCapacity(capacity() + 1));
+                }
+                push_back(T(std::forward<decltype(value)>(value)));
+            }
+
+            if (not hasDynamicCapacity()) {
+                resize(size());
+            }
+        }
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    template <ContainerCompatibleRange<T> R>
+    void CircularBuffer<T, Policy>::append_range(R&& range)
+    {
+        if constexpr (KnownSizeRange<R>) {
+            auto count = size() + rangeSize(range);
+            if (hasDynamicCapacity() and count > capacity()) {
+                resize(grownCapacity(count), BufferResizePolicy::DiscardOld);
+            }
+        }
+
+        for (auto&& value : range) {
+            if (m_tail == npos) {
+                // full (or zero capacity): grow, replace or throw depending on the policy
+                push_back(T(std::forward<decltype(value)>(value)));
+                continue;
+            }
+
+            m_buffer.construct(m_tail, std::forward<decltype(value)>(value));
+            if (increment(m_tail) == m_head) {
+                m_tail = npos;
+            }
+        }
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy>& CircularBuffer<T, Policy>::linearize() noexcept
     {
         if (m_head == 0 && m_tail == npos) {
             return *this;
@@ -521,15 +748,26 @@ namespace dsa
         return *this;
     }
 
-    template <CircularBufferElement T>
-    CircularBuffer<T> CircularBuffer<T>::linearizeCopy(std::optional<BufferPolicy> policy) const noexcept
+    template <CircularBufferElement T, auto Policy>
+    CircularBuffer<T, Policy> CircularBuffer<T, Policy>::linearizeCopy(
+        std::optional<BufferPolicy> policy
+    ) const noexcept
         requires std::copyable<T>
     {
-        CircularBuffer result{ capacity(), policy.value_or(m_policy) };
+        auto result = [&] {
+            if constexpr (s_staticPolicy) {
+                assert(policy.value_or(Policy) == Policy and "a static policy can't be changed");
+                return CircularBuffer{ capacity() };
+            } else {
+                return CircularBuffer{ capacity(), policy.value_or(m_policy) };
+            }
+        }();
 
-        std::rotate_copy(
-            m_buffer.data(), m_buffer.data() + m_head, m_buffer.data() + capacity(), result.m_buffer.data()
-        );
+        auto count = size();
+        auto first = std::min(count, capacity() - m_head);
+
+        result.m_buffer.constructRange(0, m_buffer.data() + m_head, first);
+        result.m_buffer.constructRange(first, m_buffer.data(), count - first);
 
         result.m_tail = m_tail != npos ? (m_tail + capacity() - m_head) % capacity() : npos;
         result.m_head = 0;
@@ -537,36 +775,66 @@ namespace dsa
         return result;
     }
 
-    template <CircularBufferElement T>
-    std::size_t CircularBuffer<T>::size() const noexcept
+    template <CircularBufferElement T, auto Policy>
+    std::size_t CircularBuffer<T, Policy>::size() const noexcept
     {
-        return m_tail == npos ? capacity() : (m_tail + capacity() - m_head) % capacity();
+        if (m_tail == npos) {
+            return capacity();
+        }
+
+        // no modulo, size() is called on every push and pop
+        return m_tail >= m_head ? m_tail - m_head : m_tail + capacity() - m_head;
     }
 
-    template <CircularBufferElement T>
-    auto&& CircularBuffer<T>::at(this auto&& self, std::size_t pos)
+    template <CircularBufferElement T, auto Policy>
+    auto&& CircularBuffer<T, Policy>::at(this auto&& self, std::size_t pos)
     {
         if (pos >= self.size()) {
-            throw std::out_of_range{
-                std::format("Index is out of range: index {} on size {}", pos, self.size())
-            };
+            fail<std::out_of_range>("Index is out of range: index {} on size {}", pos, self.size());
         }
 
         auto realpos = (self.m_head + pos) % self.capacity();
         return self.m_buffer.at(realpos);
     }
 
-    template <CircularBufferElement T>
-    auto&& CircularBuffer<T>::back(this auto&& self)
+    template <CircularBufferElement T, auto Policy>
+    auto CircularBuffer<T, Policy>::try_at(this auto&& self, std::size_t pos)
+        -> Result<ElementRef<decltype(self), T>>
+    {
+        if (pos >= self.size()) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return self.m_buffer.at((self.m_head + pos) % self.capacity());
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    auto&& CircularBuffer<T, Policy>::back(this auto&& self)
     {
         if (self.size() == 0) {
-            throw std::out_of_range{ "Buffer is empty" };
+            fail<std::out_of_range>("Buffer is empty");
         }
         return self.at(self.size() - 1);
     }
 
-    template <CircularBufferElement T>
-    std::size_t CircularBuffer<T>::increment(std::size_t& index)
+    template <CircularBufferElement T, auto Policy>
+    auto CircularBuffer<T, Policy>::segments(this auto&& self) noexcept
+    {
+        using Element = std::remove_reference_t<decltype(self.m_buffer.at(0))>;
+        using Segment = std::span<Element>;
+
+        if (self.capacity() == 0) {
+            return std::array<Segment, 2>{};
+        }
+
+        auto* data  = self.m_buffer.data();
+        auto  count = self.size();
+        auto  first = std::min(count, self.capacity() - self.m_head);
+
+        return std::array{ Segment{ data + self.m_head, first }, Segment{ data, count - first } };
+    }
+
+    template <CircularBufferElement T, auto Policy>
+    std::size_t CircularBuffer<T, Policy>::increment(std::size_t& index)
     {
         if (++index == capacity()) {
             index = 0;
@@ -574,8 +842,8 @@ namespace dsa
         return index;
     }
 
-    template <CircularBufferElement T>
-    std::size_t CircularBuffer<T>::decrement(std::size_t& index)
+    template <CircularBufferElement T, auto Policy>
+    std::size_t CircularBuffer<T, Policy>::decrement(std::size_t& index)
     {
         if (index-- == 0) {
             index = capacity() - 1;
@@ -583,9 +851,9 @@ namespace dsa
         return index;
     }
 
-    template <CircularBufferElement T>
+    template <CircularBufferElement T, auto Policy>
     template <bool IsConst>
-    class CircularBuffer<T>::Iterator
+    class CircularBuffer<T, Policy>::Iterator
     {
     public:
         // STL compatibility
@@ -605,7 +873,7 @@ namespace dsa
 
         Iterator(BufferPtr buffer, std::size_t current) noexcept
             : m_buffer{ buffer }
-            , m_index{ current }
+            , m_index{ current < buffer->size() ? current : CircularBuffer::npos }    // empty: begin == end
             , m_size{ buffer->size() }
         {
         }
@@ -664,7 +932,7 @@ namespace dsa
         reference operator*() const
         {
             if (m_buffer == nullptr || m_index == CircularBuffer::npos) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
             return m_buffer->at(m_index);
         };
@@ -672,7 +940,7 @@ namespace dsa
         pointer operator->() const
         {
             if (m_buffer == nullptr || m_index == CircularBuffer::npos) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
 
             return &m_buffer->at(m_index);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
+#include <ranges>
 #include <type_traits>
 #include <utility>
 
@@ -11,6 +13,27 @@ namespace dsa
         { t.size() } -> std::same_as<R>;
     };
 
+    // a range whose elements can construct a T (container-compatible-range in the standard)
+    template <typename R, typename T>
+    concept ContainerCompatibleRange = std::ranges::input_range<R>
+                                   and std::constructible_from<T, std::ranges::range_reference_t<R>>;
+
+    // the number of elements can be known up front without consuming the range
+    template <typename R>
+    concept KnownSizeRange = std::ranges::sized_range<R> or std::ranges::forward_range<R>;
+
+    template <KnownSizeRange R>
+    std::size_t rangeSize(R&& range)
+    {
+        return static_cast<std::size_t>(std::ranges::distance(range));
+    }
+
+    // a range that can be copied to a contiguous storage of T with a single memcpy
+    template <typename R, typename T>
+    concept TriviallyCopyableRangeOf = std::ranges::contiguous_range<R> and std::ranges::sized_range<R>
+                                   and std::same_as<std::ranges::range_value_t<R>, T>
+                                   and std::is_trivially_copyable_v<T>;
+
     template <typename T, typename U>
     concept Dereferencable = requires(T t) {
         { *t } -> std::same_as<U&>;
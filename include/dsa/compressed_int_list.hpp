@@ -0,0 +1,338 @@
+#pragma once
+
+// NOTE: CompressedIntList is an append-only list of 64-bit integers stored in blocks of 128 values. a block
+//       keeps its first value in the skip table and the deltas between consecutive values bit-packed with
+//       the width of the largest delta, so 128 deltas take exactly 2 * width words. a block whose values
+//       are not non-decreasing zigzag encodes its deltas, which costs one bit per value.
+//
+//       the skip table has one entry per block (first value, word offset, width), so seeking to a block is
+//       O(1) and finding the block of a value in a sorted list is a binary search over the first values.
+//       at() decodes the whole block of the position. the last, partially filled, block is kept uncompressed
+//       and is packed once it is full.
+//
+//       decoding unpacks a whole block with a kernel specialized for its width (the shifts and masks are
+//       constants, so the compiler unrolls and vectorizes it) and then takes the prefix sum of the deltas.
+
+#include "dsa/array_list.hpp"
+#include "dsa/common.hpp"
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+
+namespace dsa
+{
+    class CompressedIntList
+    {
+    public:
+        using Value      = std::uint64_t;
+        using value_type = Value;    // STL compliance
+
+        static constexpr std::size_t s_blockSize = 128;
+
+        CompressedIntList() = default;
+
+        template <ContainerCompatibleRange<Value> R>
+        CompressedIntList(std::from_range_t, R&& range)
+        {
+            append_range(std::forward<R>(range));
+        }
+
+        void clear() noexcept;
+
+        // snake-case to be able to use std functions like std::back_inserter
+        void push_back(Value value);
+
+        template <ContainerCompatibleRange<Value> R>
+        void append_range(R&& range)
+        {
+            for (auto&& value : range) {
+                push_back(static_cast<Value>(value));
+            }
+        }
+
+        Value at(std::size_t pos) const;
+
+        // the values of the block at index, out must have room for s_blockSize values. returns the number of
+        // values written
+        std::size_t decodeBlock(std::size_t block, std::span<Value> out) const;
+
+        // all values in order, out must have room for size() values
+        void decode(std::span<Value> out) const;
+
+        // call fn(value) on every value in order
+        template <typename Fn>
+            requires std::invocable<Fn&, Value>
+        void forEach(Fn&& fn) const;
+
+        // position of the first value not less than value, or size() if there is none. the list must be
+        // sorted
+        std::size_t lowerBound(Value value) const;
+
+        std::size_t size() const noexcept { return m_blocks.size() * s_blockSize + m_tailSize; }
+        bool        empty() const noexcept { return size() == 0; }
+
+        // number of blocks, the uncompressed tail block included
+        std::size_t blockCount() const noexcept { return m_blocks.size() + (m_tailSize > 0 ? 1 : 0); }
+
+        // bytes used by the packed words, the skip table, and the tail block
+        std::size_t bytes() const noexcept
+        {
+            return m_words.size() * sizeof(Word) + m_blocks.size() * sizeof(Block) + sizeof(m_tail);
+        }
+
+    private:
+        using Word = std::uint64_t;
+
+        struct Block
+        {
+            Value         m_first;
+            std::uint64_t m_offset;    // into m_words
+            std::uint8_t  m_width;     // bits per delta
+            bool          m_zigzag;    // the deltas are zigzag encoded (the block is not sorted)
+        };
+
+        using Unpacker = void (*)(const Word*, Value*) noexcept;
+
+        ArrayList<Word>                m_words    = {};
+        ArrayList<Block>               m_blocks   = {};
+        std::array<Value, s_blockSize> m_tail     = {};
+        std::size_t                    m_tailSize = 0;
+
+        void packTail();
+
+        // decode the closed block into out
+        void decodeClosed(const Block& block, Value* out) const noexcept;
+
+        template <std::size_t Width>
+        static void unpack(const Word* in, Value* out) noexcept;
+
+        static Unpacker unpacker(std::size_t width) noexcept;
+
+        static Value zigzag(Value delta) noexcept
+        {
+            return (delta << 1) ^ static_cast<Value>(static_cast<std::int64_t>(delta) >> 63);
+        }
+
+        static Value unzigzag(Value value) noexcept { return (value >> 1) ^ (~(value & 1) + 1); }
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    inline void CompressedIntList::clear() noexcept
+    {
+        m_words.clear();
+        m_blocks.clear();
+        m_tailSize = 0;
+    }
+
+    inline void CompressedIntList::push_back(Value value)
+    {
+        m_tail[m_tailSize++] = value;
+        if (m_tailSize == s_blockSize) {
+            packTail();
+        }
+    }
+
+    inline CompressedIntList::Value CompressedIntList::at(std::size_t pos) const
+    {
+        if (pos >= size()) {
+            fail<std::out_of_range>("Index is out of range: index {} on size {}", pos, size());
+        }
+
+        auto index  = pos / s_blockSize;
+        auto offset = pos % s_blockSize;
+        if (index == m_blocks.size()) {
+            return m_tail[offset];
+        }
+
+        auto values = std::array<Value, s_blockSize>{};
+        decodeClosed(m_blocks.data()[index], values.data());
+        return values[offset];
+    }
+
+    inline std::size_t CompressedIntList::decodeBlock(std::size_t block, std::span<Value> out) const
+    {
+        if (block >= blockCount()) {
+            fail<std::out_of_range>("Block is out of range: block {} of {} blocks", block, blockCount());
+        }
+
+        if (out.size() < s_blockSize) {
+            fail<std::invalid_argument>("Output has room for {} values only", out.size());
+        }
+
+        if (block == m_blocks.size()) {
+            std::copy_n(m_tail.data(), m_tailSize, out.data());
+            return m_tailSize;
+        }
+
+        decodeClosed(m_blocks.data()[block], out.data());
+        return s_blockSize;
+    }
+
+    inline void CompressedIntList::decode(std::span<Value> out) const
+    {
+        if (out.size() < size()) {
+            fail<std::invalid_argument>("Output has room for {} values, the list has {}", out.size(), size());
+        }
+
+        auto* current = out.data();
+        for (const auto& block : m_blocks) {
+            decodeClosed(block, current);
+            current += s_blockSize;
+        }
+        std::copy_n(m_tail.data(), m_tailSize, current);
+    }
+
+    template <typename Fn>
+        requires std::invocable<Fn&, CompressedIntList::Value>
+    void CompressedIntList::forEach(Fn&& fn) const
+    {
+        auto values = std::array<Value, s_blockSize>{};
+        for (const auto& block : m_blocks) {
+            decodeClosed(block, values.data());
+            for (auto value : values) {
+                std::invoke(fn, value);
+            }
+        }
+        for (auto i = 0uz; i < m_tailSize; ++i) {
+            std::invoke(fn, m_tail[i]);
+        }
+    }
+
+    inline std::size_t CompressedIntList::lowerBound(Value value) const
+    {
+        // the answer is in the last block whose first value is less than value, or it is the first value of
+        // the block after it
+        auto blocks = std::span{ m_blocks.data(), m_blocks.size() };
+        auto next   = std::ranges::lower_bound(blocks, value, {}, &Block::m_first);
+        auto index  = static_cast<std::size_t>(next - blocks.begin());
+
+        if (index > 0) {
+            auto values = std::array<Value, s_blockSize>{};
+            decodeClosed(blocks[index - 1], values.data());
+
+            auto found    = std::ranges::lower_bound(values, value);
+            auto position = static_cast<std::size_t>(found - values.begin());
+            if (position < s_blockSize) {
+                return (index - 1) * s_blockSize + position;
+            }
+        }
+
+        if (index < blocks.size()) {
+            return index * s_blockSize;
+        }
+
+        auto* tail = m_tail.data();
+        return blocks.size() * s_blockSize
+             + static_cast<std::size_t>(std::ranges::lower_bound(tail, tail + m_tailSize, value) - tail);
+    }
+
+    inline void CompressedIntList::packTail()
+    {
+        auto sorted = std::ranges::is_sorted(m_tail);
+
+        auto deltas = std::array<Value, s_blockSize>{};
+        auto bits   = Value{ 0 };
+        for (auto i = 1uz; i < s_blockSize; ++i) {
+            auto delta = m_tail[i] - m_tail[i - 1];
+            deltas[i]  = sorted ? delta : zigzag(delta);
+            bits      |= deltas[i];
+        }
+
+        auto width  = static_cast<std::size_t>(std::bit_width(bits));
+        auto offset = m_words.size();
+        for (auto i = 0uz; i < 2 * width; ++i) {
+            m_words.push_back(Word{ 0 });
+        }
+
+        auto* words = m_words.data() + offset;
+        for (auto i = 0uz; i < s_blockSize and width > 0; ++i) {
+            auto bit   = i * width;
+            auto word  = bit / 64;
+            auto shift = bit % 64;
+
+            words[word] |= deltas[i] << shift;
+            if (shift + width > 64) {
+                words[word + 1] |= deltas[i] >> (64 - shift);
+            }
+        }
+
+        m_blocks.push_back(Block{
+            .m_first  = m_tail[0],
+            .m_offset = offset,
+            .m_width  = static_cast<std::uint8_t>(width),
+            .m_zigzag = not sorted,
+        });
+        m_tailSize = 0;
+    }
+
+    inline void CompressedIntList::decodeClosed(const Block& block, Value* out) const noexcept
+    {
+        unpacker(block.m_width)(m_words.data() + block.m_offset, out);
+
+        if (block.m_zigzag) {
+            for (auto i = 0uz; i < s_blockSize; ++i) {
+                out[i] = unzigzag(out[i]);
+            }
+        }
+
+        // the first delta is always zero
+        out[0] = block.m_first;
+        for (auto i = 1uz; i < s_blockSize; ++i) {
+            out[i] += out[i - 1];
+        }
+    }
+
+    template <std::size_t Width>
+    void CompressedIntList::unpack(const Word* in, Value* out) noexcept
+    {
+        if constexpr (Width == 0) {
+            std::fill_n(out, s_blockSize, Value{ 0 });
+        } else {
+            constexpr auto mask = Width == 64 ? ~Value{ 0 } : (Value{ 1 } << Width) - 1;
+
+            // 64 values fill exactly Width words, within a group every shift is a constant once unrolled
+            for (auto group = 0uz; group < s_blockSize / 64; ++group) {
+                const auto* words  = in + group * Width;
+                auto*       values = out + group * 64;
+
+#if defined(__GNUC__)
+#    pragma GCC unroll 64
+#endif
+                for (auto i = 0uz; i < 64; ++i) {
+                    auto bit   = i * Width;
+                    auto word  = bit / 64;
+                    auto shift = bit % 64;
+
+                    auto value = words[word] >> shift;
+                    if (shift + Width > 64) {
+                        value |= words[word + 1] << (64 - shift);
+                    }
+                    values[i] = value & mask;
+                }
+            }
+        }
+    }
+
+    inline CompressedIntList::Unpacker CompressedIntList::unpacker(std::size_t width) noexcept
+    {
+        static constexpr auto table = []<std::size_t... Widths>(std::index_sequence<Widths...>) {
+            return std::array<Unpacker, sizeof...(Widths)>{ &unpack<Widths>... };
+        }(std::make_index_sequence<65>{});
+
+        return table[width];
+    }
+}
@@ -0,0 +1,626 @@
+#pragma once
+
+// NOTE: ConcurrentBlockyLinkedList is a BlockyLinkedList (reference 2, SEList) that many threads can edit at
+//       once. every node has its own mutex, there is no lock over the whole list.
+//
+//       a writer walks from a sentinel head node with hand-over-hand locking (lock the next node, then unlock
+//       the current one) to the node holding the position, so writers keep the order in which they entered
+//       the list and can't overtake each other: the operations are linearized in that order. the node found
+//       and the nodes the operation touches are then locked in list order as one chain: the b + 1 nodes of a
+//       shift or a spread, the b nodes of a gather and their predecessor. writers working on distant parts of
+//       the list run in parallel. the walk is always from the head, a position near the end costs a walk over
+//       the whole list.
+//
+//       readers are optimistic: every node has a version that is odd while a writer modifies it. a reader
+//       walks the list without locking, reading the atomic size and next pointer of each node and recording
+//       the versions it saw, then locks only the node holding the position and checks that none of the
+//       versions on its path changed before copying the element. a conflict makes it retry, after
+//       s_optimisticRetries it walks with hand-over-hand locking like a writer. at() returns a copy: a
+//       reference would not outlive the lock.
+//
+//       the nodes removed by a gather are kept in a pool and reused instead of being freed while the list
+//       lives, so the pointers an optimistic reader follows always point to a node, and the versions keep
+//       increasing across reuse. a reused node is locked in another order relative to the others than before,
+//       which the lock order check of ThreadSanitizer reports: run it with TSAN_OPTIONS=detect_deadlocks=0.
+
+#include "dsa/array_list.hpp"
+#include "dsa/blocky_linked_list.hpp"
+#include "dsa/circular_buffer.hpp"
+#include "dsa/error.hpp"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace dsa
+{
+    template <BlockyLinkedListElement T>
+    class ConcurrentBlockyLinkedList
+    {
+    public:
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        static constexpr std::size_t s_minimumBlockSize  = 3;
+        static constexpr int         s_optimisticRetries = 4;
+
+        struct Stats
+        {
+            std::uint64_t m_optimisticReads;    // reads validated without locking the path
+            std::uint64_t m_retries;            // optimistic reads that conflicted with a writer
+            std::uint64_t m_lockedReads;        // reads that fell back to hand-over-hand locking
+        };
+
+        explicit ConcurrentBlockyLinkedList(std::size_t blockSize = s_minimumBlockSize);
+
+        ConcurrentBlockyLinkedList(ConcurrentBlockyLinkedList&&)            = delete;
+        ConcurrentBlockyLinkedList& operator=(ConcurrentBlockyLinkedList&&) = delete;
+
+        // pos is checked against the size the list has when the operation reaches it
+        void insert(std::size_t pos, T&& element);
+        T    remove(std::size_t pos);
+        void push_back(T&& element);
+
+        T at(std::size_t pos) const
+            requires std::copyable<T>;
+
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<void> try_insert(std::size_t pos, T&& element);
+        Result<T>    try_remove(std::size_t pos);
+        Result<T>    try_at(std::size_t pos) const
+            requires std::copyable<T>;
+
+        // a consistent copy of the whole list, walked with hand-over-hand locking
+        ArrayList<T> snapshot() const
+            requires std::copyable<T>;
+
+        // approximate while writers run
+        std::size_t size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+        std::size_t blockSize() const noexcept { return m_blockSize; }
+
+        Stats stats() const noexcept;
+
+    private:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        // the fields a walk reads share a cache line, the mutexes of two nodes don't
+        struct alignas(64) Node
+        {
+            mutable std::mutex         m_mutex;
+            std::atomic<std::uint64_t> m_version = 0;          // odd while a writer modifies the node
+            std::atomic<std::size_t>   m_size    = 0;          // m_block.size() for the optimistic readers
+            std::atomic<Node*>         m_next    = nullptr;    // the pool owns the nodes
+            CircularBuffer<T>          m_block;
+
+            explicit Node(std::size_t capacity)
+                : m_block{
+                    capacity,
+                    BufferPolicy{
+                        .m_capacity = BufferCapacityPolicy::FixedCapacity,
+                        .m_store    = BufferStorePolicy::ThrowOnFull,
+                    },
+                }
+            {
+            }
+        };
+
+        // the nodes an operation holds, locked in list order and unlocked together. once write() is called
+        // every node of the chain is in write mode (odd version) until the chain is released
+        class LockedChain
+        {
+        public:
+            explicit LockedChain(std::size_t capacity) { m_nodes.reserve(capacity); }
+            ~LockedChain();
+
+            void lock(Node* node);
+            void adopt(Node* node);    // already locked
+            void releaseFront();
+            void write();
+
+            Node*       at(std::size_t pos) const { return m_nodes.at(pos); }
+            Node*       back() const { return m_nodes.back(); }
+            std::size_t size() const noexcept { return m_nodes.size(); }
+
+        private:
+            ArrayList<Node*> m_nodes;
+            bool             m_writing = false;
+        };
+
+        struct Visit
+        {
+            const Node*   m_node;
+            std::uint64_t m_version;
+        };
+
+        std::size_t              m_blockSize;
+        Node*                    m_sentinel = nullptr;
+        std::atomic<std::size_t> m_size     = 0;
+
+        mutable std::mutex               m_poolMutex;
+        ArrayList<std::unique_ptr<Node>> m_nodes;    // every node ever allocated
+        ArrayList<Node*>                 m_free;
+
+        mutable std::atomic<std::uint64_t> m_optimisticReads = 0;
+        mutable std::atomic<std::uint64_t> m_retries         = 0;
+        mutable std::atomic<std::uint64_t> m_lockedReads     = 0;
+
+        // hand-over-hand from the sentinel, on success the chain holds the node holding pos and its
+        // predecessor, and the offset in the node is returned. an insert may also find the end of the last
+        // node (pos == size, or npos for the end), or the sentinel alone when the list is empty
+        std::optional<std::size_t> locate(std::size_t pos, bool insert, LockedChain& chain) const;
+
+        // nullopt if a writer got in the way
+        std::optional<Result<T>> optimisticAt(std::size_t pos) const;
+        Result<T>                lockedAt(std::size_t pos) const;
+
+        Result<void> insertAt(std::size_t pos, T& element);
+
+        Node* allocateNode();
+        void  retireNode(Node* node);
+
+        static void beginWrite(Node& node) noexcept;
+        static void endWrite(Node& node) noexcept;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <BlockyLinkedListElement T>
+    ConcurrentBlockyLinkedList<T>::ConcurrentBlockyLinkedList(std::size_t blockSize)
+        : m_blockSize{ blockSize }
+    {
+        if (blockSize < s_minimumBlockSize) {
+            fail<std::invalid_argument>("Block size must be at least {}", s_minimumBlockSize);
+        }
+        m_sentinel = allocateNode();
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::insert(std::size_t pos, T&& element)
+    {
+        if (not try_insert(pos, std::move(element))) {
+            fail<std::out_of_range>("Cannot insert at position greater than size ({} > {})", pos, size());
+        }
+    }
+
+    template <BlockyLinkedListElement T>
+    T ConcurrentBlockyLinkedList<T>::remove(std::size_t pos)
+    {
+        auto value = try_remove(pos);
+        if (not value) {
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, size());
+        }
+        return std::move(*value);
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::push_back(T&& element)
+    {
+        [[maybe_unused]] auto inserted = insertAt(npos, element);
+        assert(inserted.has_value() and "the end is always a valid position");
+    }
+
+    template <BlockyLinkedListElement T>
+    T ConcurrentBlockyLinkedList<T>::at(std::size_t pos) const
+        requires std::copyable<T>
+    {
+        auto value = try_at(pos);
+        if (not value) {
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, size());
+        }
+        return std::move(*value);
+    }
+
+    template <BlockyLinkedListElement T>
+    Result<void> ConcurrentBlockyLinkedList<T>::try_insert(std::size_t pos, T&& element)
+    {
+        if (pos == npos) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insertAt(pos, element);
+    }
+
+    template <BlockyLinkedListElement T>
+    Result<T> ConcurrentBlockyLinkedList<T>::try_remove(std::size_t pos)
+    {
+        auto retired = std::array<Node*, 2>{};
+        auto value   = std::optional<T>{};
+        {
+            auto chain  = LockedChain{ m_blockSize + 2 };
+            auto offset = locate(pos, false, chain);
+            if (not offset) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+
+            auto* prev = chain.at(0);
+            auto  b    = m_blockSize;
+
+            // u and the following nodes with b - 1 elements, at most b of them: chain[1 + i] is u + i
+            while (chain.size() - 1 < b and chain.back()->m_block.size() == b - 1) {
+                auto* next = chain.back()->m_next.load(std::memory_order_relaxed);
+                if (next == nullptr) {
+                    break;
+                }
+                chain.lock(next);
+            }
+
+            auto node  = [&](std::size_t i) { return chain.at(1 + i); };
+            auto count = chain.size() - 1;
+
+            chain.write();
+
+            auto gather = count == b and node(b - 1)->m_block.size() == b - 1
+                      and node(b - 1)->m_next.load(std::memory_order_relaxed) != nullptr;
+            if (gather) {
+                for (auto i = 0uz; i < b - 1; ++i) {
+                    while (node(i)->m_block.size() < b) {
+                        node(i)->m_block.push_back(node(i + 1)->m_block.pop_front());
+                    }
+                }
+                auto* empty = node(b - 1);
+                auto* after = empty->m_next.load(std::memory_order_relaxed);
+                node(b - 2)->m_next.store(after, std::memory_order_release);
+                empty->m_next.store(nullptr, std::memory_order_release);
+                retired[0] = empty;
+                count      = b - 1;
+            }
+
+            value.emplace(node(0)->m_block.remove(*offset));
+
+            // the nodes with b - 1 elements borrow from the next one, up to the one with more
+            auto i = 0uz;
+            while (node(i)->m_block.size() < b - 1 and node(i)->m_next.load(std::memory_order_relaxed)) {
+                assert(i + 1 < count and "the borrowing chain should be locked");
+                node(i)->m_block.push_back(node(i + 1)->m_block.pop_front());
+                ++i;
+            }
+
+            if (node(i)->m_block.size() == 0) {
+                auto* before = i == 0 ? prev : node(i - 1);
+                before->m_next.store(nullptr, std::memory_order_release);
+                retired[1] = node(i);
+            }
+        }
+
+        for (auto* node : retired) {
+            if (node != nullptr) {
+                retireNode(node);
+            }
+        }
+
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return std::move(*value);
+    }
+
+    template <BlockyLinkedListElement T>
+    Result<T> ConcurrentBlockyLinkedList<T>::try_at(std::size_t pos) const
+        requires std::copyable<T>
+    {
+        for (auto attempt = 0; attempt < s_optimisticRetries; ++attempt) {
+            if (auto value = optimisticAt(pos)) {
+                m_optimisticReads.fetch_add(1, std::memory_order_relaxed);
+                return std::move(*value);
+            }
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_lockedReads.fetch_add(1, std::memory_order_relaxed);
+        return lockedAt(pos);
+    }
+
+    template <BlockyLinkedListElement T>
+    ArrayList<T> ConcurrentBlockyLinkedList<T>::snapshot() const
+        requires std::copyable<T>
+    {
+        auto values = ArrayList<T>{};
+
+        const Node* node = m_sentinel;
+        node->m_mutex.lock();
+        while (auto* next = node->m_next.load(std::memory_order_relaxed)) {
+            next->m_mutex.lock();
+            node->m_mutex.unlock();
+            node = next;
+            for (const auto& value : node->m_block) {
+                values.push_back(auto{ value });
+            }
+        }
+        node->m_mutex.unlock();
+
+        return values;
+    }
+
+    template <BlockyLinkedListElement T>
+    auto ConcurrentBlockyLinkedList<T>::stats() const noexcept -> Stats
+    {
+        return {
+            .m_optimisticReads = m_optimisticReads.load(std::memory_order_relaxed),
+            .m_retries         = m_retries.load(std::memory_order_relaxed),
+            .m_lockedReads     = m_lockedReads.load(std::memory_order_relaxed),
+        };
+    }
+
+    template <BlockyLinkedListElement T>
+    ConcurrentBlockyLinkedList<T>::LockedChain::~LockedChain()
+    {
+        for (auto* node : m_nodes) {
+            if (m_writing) {
+                endWrite(*node);
+            }
+            node->m_mutex.unlock();
+        }
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::LockedChain::lock(Node* node)
+    {
+        node->m_mutex.lock();
+        adopt(node);
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::LockedChain::adopt(Node* node)
+    {
+        if (m_writing) {
+            beginWrite(*node);
+        }
+        m_nodes.push_back(auto{ node });
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::LockedChain::releaseFront()
+    {
+        assert(not m_writing and "a node in write mode is released with the chain");
+        m_nodes.remove(0)->m_mutex.unlock();
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::LockedChain::write()
+    {
+        m_writing = true;
+        for (auto* node : m_nodes) {
+            beginWrite(*node);
+        }
+    }
+
+    template <BlockyLinkedListElement T>
+    std::optional<std::size_t> ConcurrentBlockyLinkedList<T>::locate(
+        std::size_t  pos,
+        bool         insert,
+        LockedChain& chain
+    ) const
+    {
+        auto* prev = m_sentinel;
+        prev->m_mutex.lock();
+
+        auto offset = pos;
+        while (true) {
+            auto* node = prev->m_next.load(std::memory_order_relaxed);
+            if (node == nullptr) {
+                // only the sentinel: an empty list
+                if (insert and (offset == 0 or pos == npos)) {
+                    chain.adopt(prev);
+                    return 0uz;
+                }
+                prev->m_mutex.unlock();
+                return std::nullopt;
+            }
+
+            node->m_mutex.lock();
+
+            auto size = node->m_block.size();
+            auto last = node->m_next.load(std::memory_order_relaxed) == nullptr;
+
+            if (offset < size or (insert and last and (offset == size or pos == npos))) {
+                chain.adopt(prev);
+                chain.adopt(node);
+                return pos == npos ? size : offset;
+            }
+            if (last) {
+                node->m_mutex.unlock();
+                prev->m_mutex.unlock();
+                return std::nullopt;
+            }
+
+            offset -= size;
+            prev->m_mutex.unlock();
+            prev = node;
+        }
+    }
+
+    template <BlockyLinkedListElement T>
+    auto ConcurrentBlockyLinkedList<T>::optimisticAt(std::size_t pos) const -> std::optional<Result<T>>
+    {
+        thread_local auto path = ArrayList<Visit>{};
+        path.clear();
+
+        auto unchanged = [&] {
+            for (auto [node, version] : path) {
+                if (node->m_version.load(std::memory_order_acquire) != version) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        const Node* node    = m_sentinel;
+        auto        version = node->m_version.load(std::memory_order_acquire);
+        if (version % 2 == 1) {
+            return std::nullopt;
+        }
+        path.push_back({ node, version });
+
+        auto offset = pos;
+        while (true) {
+            // acquire: a size or next pointer written by a writer comes with its odd version
+            auto* next = node->m_next.load(std::memory_order_acquire);
+            if (node->m_version.load(std::memory_order_acquire) != version) {
+                return std::nullopt;
+            }
+
+            if (next == nullptr) {
+                if (not unchanged()) {
+                    return std::nullopt;
+                }
+                return Result<T>{ std::unexpected{ Error::OutOfRange } };
+            }
+
+            auto nextVersion = next->m_version.load(std::memory_order_acquire);
+            auto size        = next->m_size.load(std::memory_order_acquire);
+            if (nextVersion % 2 == 1 or next->m_version.load(std::memory_order_acquire) != nextVersion) {
+                return std::nullopt;
+            }
+
+            path.push_back({ next, nextVersion });
+            node    = next;
+            version = nextVersion;
+
+            if (offset < size) {
+                break;
+            }
+            offset -= size;
+        }
+
+        // the node can't change while locked, the path is checked once more: the state it describes held at
+        // this point, the position of the element is the one the walk counted
+        auto lock = std::scoped_lock{ node->m_mutex };
+        if (not unchanged()) {
+            return std::nullopt;
+        }
+        return Result<T>{ node->m_block.at(offset) };
+    }
+
+    template <BlockyLinkedListElement T>
+    Result<T> ConcurrentBlockyLinkedList<T>::lockedAt(std::size_t pos) const
+    {
+        auto chain  = LockedChain{ 2 };
+        auto offset = locate(pos, false, chain);
+        if (not offset) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return chain.at(1)->m_block.at(*offset);
+    }
+
+    template <BlockyLinkedListElement T>
+    Result<void> ConcurrentBlockyLinkedList<T>::insertAt(std::size_t pos, T& element)
+    {
+        auto chain  = LockedChain{ m_blockSize + 2 };
+        auto offset = locate(pos, true, chain);
+        if (not offset) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+
+        auto b = m_blockSize;
+
+        if (chain.size() == 1) {
+            chain.write();
+            auto* first = allocateNode();
+            chain.lock(first);
+            first->m_block.push_back(std::move(element));
+            m_sentinel->m_next.store(first, std::memory_order_release);
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return {};
+        }
+
+        // the predecessor is only needed by a remove
+        chain.releaseFront();
+        auto* node = chain.at(0);
+
+        // appending to a full last node starts a new one, like BlockyLinkedList::push_back
+        if (*offset == b + 1) {
+            chain.write();
+            auto* next = allocateNode();
+            chain.lock(next);
+            next->m_block.push_back(std::move(element));
+            node->m_next.store(next, std::memory_order_release);
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return {};
+        }
+
+        // u and the following full nodes, at most b of them
+        while (chain.size() < b and chain.back()->m_block.size() == b + 1) {
+            auto* next = chain.back()->m_next.load(std::memory_order_relaxed);
+            if (next == nullptr) {
+                break;
+            }
+            chain.lock(next);
+        }
+
+        chain.write();
+
+        auto* back = chain.back();
+        if (back->m_block.size() == b + 1) {
+            auto* next  = allocateNode();
+            auto  after = back->m_next.load(std::memory_order_relaxed);
+
+            chain.lock(next);
+            next->m_next.store(after, std::memory_order_release);
+            back->m_next.store(next, std::memory_order_release);
+
+            if (after != nullptr) {
+                // spread: b full nodes, the new node after them, each is left with b elements
+                assert(chain.size() == b + 1);
+                for (auto i = chain.size() - 1; i > 0; --i) {
+                    while (chain.at(i)->m_block.size() < b) {
+                        chain.at(i)->m_block.push_front(chain.at(i - 1)->m_block.pop_back());
+                    }
+                }
+                node->m_block.insert(*offset, std::move(element));
+                m_size.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+        }
+
+        // shift: every node up to the last one of the chain, which has room, gives its last element away
+        for (auto i = chain.size() - 1; i > 0; --i) {
+            chain.at(i)->m_block.push_front(chain.at(i - 1)->m_block.pop_back());
+        }
+        node->m_block.insert(*offset, std::move(element));
+
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+
+    template <BlockyLinkedListElement T>
+    auto ConcurrentBlockyLinkedList<T>::allocateNode() -> Node*
+    {
+        auto lock = std::scoped_lock{ m_poolMutex };
+        if (m_free.size() > 0) {
+            return m_free.pop_back();
+        }
+        return m_nodes.push_back(std::make_unique<Node>(m_blockSize + 1)).get();
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::retireNode(Node* node)
+    {
+        auto lock = std::scoped_lock{ m_poolMutex };
+        m_free.push_back(auto{ node });
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::beginWrite(Node& node) noexcept
+    {
+        auto version = node.m_version.load(std::memory_order_relaxed);
+        node.m_version.store(version + 1, std::memory_order_relaxed);
+    }
+
+    template <BlockyLinkedListElement T>
+    void ConcurrentBlockyLinkedList<T>::endWrite(Node& node) noexcept
+    {
+        auto version = node.m_version.load(std::memory_order_relaxed);
+        node.m_size.store(node.m_block.size(), std::memory_order_release);
+        node.m_version.store(version + 1, std::memory_order_release);
+    }
+}
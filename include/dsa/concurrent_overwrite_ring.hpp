@@ -0,0 +1,197 @@
+#pragma once
+
+// NOTE: ConcurrentOverwriteRing is a multi-producer ring of trivially copyable values that overwrites the
+//       oldest entries, the concurrent counterpart of a CircularBuffer with BufferStorePolicy::ReplaceOnFull.
+//       it is meant for flight recorders: many threads log, a reader occasionally takes a snapshot.
+//
+//       a writer takes a ticket from a shared counter, the ticket picks the slot (ticket modulo the capacity,
+//       which is rounded up to a power of two). every slot has a sequence stamp: 2 * ticket + 1 while the
+//       value of that ticket is being written and 2 * ticket + 2 once it is complete, 0 if never written.
+//       a writer claims a slot with a CAS from an even (quiescent) stamp to its odd stamp, so at most one
+//       writer is ever inside a slot. a writer never waits: if the slot is held by another writer or already
+//       has a newer value, the write is dropped and counted, the entry would have been overwritten anyway.
+//
+//       readers never block writers. a reader copies the value between two loads of the stamp and keeps it
+//       only if both are the complete stamp of the ticket it expects, anything else is a torn slot (being
+//       written, overwritten, or dropped) and is skipped. the value is stored as atomic words so the racy
+//       copy is well-defined: the writer stores them with release and the reader loads them with acquire, so
+//       a reader that sees any word of a newer write also sees its odd stamp on the second check. no fences
+//       are needed, which keeps it clean under ThreadSanitizer.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    template <typename T>
+    concept ConcurrentRingElement = std::is_trivially_copyable_v<T> and std::is_default_constructible_v<T>;
+
+    template <ConcurrentRingElement T>
+    class ConcurrentOverwriteRing
+    {
+    public:
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        struct Entry
+        {
+            std::uint64_t m_sequence;    // the ticket of the write, the order of the writes
+            T             m_value;
+        };
+
+        // the capacity is rounded up to a power of two
+        explicit ConcurrentOverwriteRing(std::size_t capacity);
+
+        ConcurrentOverwriteRing(ConcurrentOverwriteRing&&)            = delete;
+        ConcurrentOverwriteRing& operator=(ConcurrentOverwriteRing&&) = delete;
+
+        // wait-free except for the retry of the claim when the stamp changes under it. returns false if the
+        // write was dropped
+        bool push_back(const T& value) noexcept;
+
+        // call fn(sequence, value) for every complete entry among the last capacity() writes in write order,
+        // returns the number of entries visited. torn slots are skipped
+        template <typename Fn>
+            requires std::invocable<Fn&, std::uint64_t, const T&>
+        std::size_t snapshot(Fn&& fn) const;
+
+        ArrayList<Entry> snapshot() const;
+
+        // number of writes ever started and number of writes dropped, both approximate while writers run
+        std::uint64_t written() const noexcept { return m_tail.load(std::memory_order_relaxed); }
+        std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+        std::size_t capacity() const noexcept { return m_mask + 1; }
+
+    private:
+        using Word = std::uint64_t;
+
+        static constexpr std::size_t s_words = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+        // a slot per cache line at least, neighbouring writers don't share lines
+        struct alignas(64) Slot
+        {
+            std::atomic<std::uint64_t>             m_stamp = 0;
+            std::array<std::atomic<Word>, s_words> m_words = {};
+        };
+
+        std::unique_ptr<Slot[]> m_slots = nullptr;
+        std::size_t             m_mask  = 0;
+
+        alignas(64) std::atomic<std::uint64_t> m_tail    = 0;
+        alignas(64) std::atomic<std::uint64_t> m_dropped = 0;
+
+        static std::uint64_t writing(std::uint64_t ticket) noexcept { return 2 * ticket + 1; }
+        static std::uint64_t complete(std::uint64_t ticket) noexcept { return 2 * ticket + 2; }
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <ConcurrentRingElement T>
+    ConcurrentOverwriteRing<T>::ConcurrentOverwriteRing(std::size_t capacity)
+    {
+        if (capacity == 0 or capacity > (std::size_t{ 1 } << 40)) {
+            fail<std::invalid_argument>("Invalid ring capacity: {}", capacity);
+        }
+
+        capacity = std::bit_ceil(capacity);
+        m_slots  = std::make_unique<Slot[]>(capacity);
+        m_mask   = capacity - 1;
+    }
+
+    template <ConcurrentRingElement T>
+    bool ConcurrentOverwriteRing<T>::push_back(const T& value) noexcept
+    {
+        auto ticket = m_tail.fetch_add(1, std::memory_order_relaxed);
+        auto& slot  = m_slots[ticket & m_mask];
+
+        auto stamp = slot.m_stamp.load(std::memory_order_relaxed);
+        while (true) {
+            // held by another writer, or a later ticket got there first
+            if (stamp % 2 == 1 or stamp > writing(ticket)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            auto claimed = slot.m_stamp.compare_exchange_weak(
+                stamp, writing(ticket), std::memory_order_acquire, std::memory_order_relaxed
+            );
+            if (claimed) {
+                break;
+            }
+        }
+
+        // release: a reader that loads any of these words also sees the claim when it checks the stamp again.
+        // free on x86, and unlike a fence it is understood by ThreadSanitizer
+        auto words = std::array<Word, s_words>{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (auto i = 0uz; i < s_words; ++i) {
+            slot.m_words[i].store(words[i], std::memory_order_release);
+        }
+
+        slot.m_stamp.store(complete(ticket), std::memory_order_release);
+        return true;
+    }
+
+    template <ConcurrentRingElement T>
+    template <typename Fn>
+        requires std::invocable<Fn&, std::uint64_t, const T&>
+    std::size_t ConcurrentOverwriteRing<T>::snapshot(Fn&& fn) const
+    {
+        auto tail  = m_tail.load(std::memory_order_acquire);
+        auto first = tail > capacity() ? tail - capacity() : 0;
+        auto count = 0uz;
+
+        for (auto ticket = first; ticket < tail; ++ticket) {
+            const auto& slot = m_slots[ticket & m_mask];
+
+            if (slot.m_stamp.load(std::memory_order_acquire) != complete(ticket)) {
+                continue;
+            }
+
+            auto words = std::array<Word, s_words>{};
+            // acquire: the stamp is checked again after the words are read
+            for (auto i = 0uz; i < s_words; ++i) {
+                words[i] = slot.m_words[i].load(std::memory_order_acquire);
+            }
+
+            if (slot.m_stamp.load(std::memory_order_relaxed) != complete(ticket)) {
+                continue;
+            }
+
+            auto value = T{};
+            std::memcpy(&value, words.data(), sizeof(T));
+            std::invoke(fn, ticket, std::as_const(value));
+            ++count;
+        }
+
+        return count;
+    }
+
+    template <ConcurrentRingElement T>
+    auto ConcurrentOverwriteRing<T>::snapshot() const -> ArrayList<Entry>
+    {
+        auto entries = ArrayList<Entry>{};
+        entries.reserve(capacity());
+        snapshot([&](std::uint64_t sequence, const T& value) {
+            entries.push_back(Entry{ sequence, value });
+        });
+        return entries;
+    }
+}
@@ -4,9 +4,11 @@
 
 #include "dsa/array_list.hpp"
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
 #include "dsa/stack.hpp"
 
 #include <concepts>
+#include <optional>
 
 namespace dsa
 {
@@ -41,6 +43,10 @@ namespace dsa
         {
         }
 
+        // the elements are appended to the back stack in one go then split between the stacks once
+        template <ContainerCompatibleRange<T> R>
+        Deque(std::from_range_t, R&& range);
+
         void swap(Deque& other) noexcept
             requires std::swappable<Container>;
 
@@ -51,6 +57,13 @@ namespace dsa
         T  pop_back();
         T  pop_front();
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&>       try_push_back(T&& value) { return push_back(std::move(value)); }
+        std::optional<T> try_pop_front();
+
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
         std::size_t size() const noexcept { return m_front.size() + m_back.size(); }
         bool        empty() const noexcept { return m_front.empty() and m_back.empty(); }
 
@@ -59,6 +72,14 @@ namespace dsa
 
         auto&& at(this auto&& self, std::size_t pos) noexcept;
 
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.size()) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
         auto underlying(this auto&& self) noexcept { return makePairRef(self.m_front, self.m_back); }
 
     private:
@@ -76,6 +97,13 @@ namespace dsa
 
 namespace dsa
 {
+    template <DequeElement T>
+    template <ContainerCompatibleRange<T> R>
+    Deque<T>::Deque(std::from_range_t, R&& range)
+    {
+        append_range(std::forward<R>(range));
+    }
+
     template <DequeElement T>
     void Deque<T>::swap(Deque& other) noexcept
         requires std::swappable<Container>
@@ -135,6 +163,23 @@ namespace dsa
         return element;
     }
 
+    template <DequeElement T>
+    std::optional<T> Deque<T>::try_pop_front()
+    {
+        if (empty()) {
+            return std::nullopt;
+        }
+        return pop_front();
+    }
+
+    template <DequeElement T>
+    template <ContainerCompatibleRange<T> R>
+    void Deque<T>::append_range(R&& range)
+    {
+        m_back.underlying().append_range(std::forward<R>(range));
+        balance();
+    }
+
     template <DequeElement T>
     auto&& Deque<T>::back(this auto&& self) noexcept
     {
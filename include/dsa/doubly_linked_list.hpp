@@ -3,9 +3,11 @@
 // NOTE: DoublyLinkedList implementation based on reference 1
 
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
 
 #include <concepts>
 #include <memory>
+#include <optional>
 
 namespace dsa
 {
@@ -38,6 +40,9 @@ namespace dsa
         DoublyLinkedList() = default;
         ~DoublyLinkedList() { clear(); }
 
+        template <ContainerCompatibleRange<T> R>
+        DoublyLinkedList(std::from_range_t, R&& range);
+
         DoublyLinkedList(DoublyLinkedList&& other) noexcept;
         DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept;
 
@@ -57,11 +62,27 @@ namespace dsa
         T  pop_front();
         T  pop_back();
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&>       try_insert(std::size_t pos, T&& element);
+        Result<T&>       try_push_back(T&& element) { return push_back(std::move(element)); }
+        std::optional<T> try_pop_front();
+
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
         auto&& at(this auto&& self, std::size_t pos);
         auto&& node(this auto&& self, std::size_t pos);
         auto&& front(this auto&& self);
         auto&& back(this auto&& self);
 
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.size()) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
         std::size_t size() const noexcept { return m_size; }
 
         auto begin(this auto&& self) noexcept
@@ -84,11 +105,17 @@ namespace dsa
 // implementation detail
 // -----------------------------------------------------------------------------
 
-#include <stdexcept>
 #include <utility>
 
 namespace dsa
 {
+    template <DoublyLinkedListElement T>
+    template <ContainerCompatibleRange<T> R>
+    DoublyLinkedList<T>::DoublyLinkedList(std::from_range_t, R&& range)
+    {
+        append_range(std::forward<R>(range));
+    }
+
     template <DoublyLinkedListElement T>
     DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList&& other) noexcept
         : m_head{ std::exchange(other.m_head, nullptr) }
@@ -156,7 +183,7 @@ namespace dsa
     T& DoublyLinkedList<T>::insert(std::size_t pos, T&& element)
     {
         if (pos > m_size) {
-            throw std::out_of_range{ "Position out of range" };
+            fail<std::out_of_range>("Position out of range");
         }
 
         if (pos == 0) {
@@ -183,7 +210,7 @@ namespace dsa
     T DoublyLinkedList<T>::remove(std::size_t pos)
     {
         if (pos >= m_size) {
-            throw std::out_of_range{ "Index out of bounds" };
+            fail<std::out_of_range>("Index out of bounds");
         }
 
         if (pos == 0) {
@@ -237,11 +264,20 @@ namespace dsa
         return m_tail->m_element;
     }
 
+    template <DoublyLinkedListElement T>
+    template <ContainerCompatibleRange<T> R>
+    void DoublyLinkedList<T>::append_range(R&& range)
+    {
+        for (auto&& value : range) {
+            push_back(T(std::forward<decltype(value)>(value)));
+        }
+    }
+
     template <DoublyLinkedListElement T>
     T DoublyLinkedList<T>::pop_front()
     {
         if (m_head == nullptr) {
-            throw std::out_of_range{ "List is empty" };
+            fail<std::out_of_range>("List is empty");
         }
 
         auto [element, next, _] = std::move(*m_head);
@@ -255,7 +291,7 @@ namespace dsa
     T DoublyLinkedList<T>::pop_back()
     {
         if (m_head == nullptr) {
-            throw std::out_of_range{ "List is empty" };
+            fail<std::out_of_range>("List is empty");
         } else if (m_size == 1) {
             return pop_front();
         }
@@ -269,6 +305,24 @@ namespace dsa
         return std::move(element);    // NRVO not working?
     }
 
+    template <DoublyLinkedListElement T>
+    Result<T&> DoublyLinkedList<T>::try_insert(std::size_t pos, T&& element)
+    {
+        if (pos > size()) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insert(pos, std::move(element));
+    }
+
+    template <DoublyLinkedListElement T>
+    std::optional<T> DoublyLinkedList<T>::try_pop_front()
+    {
+        if (size() == 0) {
+            return std::nullopt;
+        }
+        return pop_front();
+    }
+
     template <DoublyLinkedListElement T>
     auto&& DoublyLinkedList<T>::at(this auto&& self, std::size_t pos)
     {
@@ -279,9 +333,7 @@ namespace dsa
     auto&& DoublyLinkedList<T>::node(this auto&& self, std::size_t pos)
     {
         if (pos >= self.m_size) {
-            throw std::out_of_range{
-                std::format("Position is out of range: pos {} on size {}", pos, self.m_size)
-            };
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, self.m_size);
         }
 
         if (pos <= self.m_size / 2) {
@@ -303,7 +355,7 @@ namespace dsa
     auto&& DoublyLinkedList<T>::front(this auto&& self)
     {
         if (self.m_size == 0) {
-            throw std::out_of_range{ "LinkedList is empty" };
+            fail<std::out_of_range>("LinkedList is empty");
         }
         return deref<Node>(self.m_head).m_element;
     }
@@ -312,7 +364,7 @@ namespace dsa
     auto&& DoublyLinkedList<T>::back(this auto&& self)
     {
         if (self.m_size == 0) {
-            throw std::out_of_range{ "LinkedList is empty" };
+            fail<std::out_of_range>("LinkedList is empty");
         }
         return deref<Node>(self.m_tail).m_element;
     }
@@ -402,7 +454,7 @@ namespace dsa
         reference operator*() const
         {
             if (m_current == nullptr) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
 
             return m_current->m_element;
@@ -411,7 +463,7 @@ namespace dsa
         pointer operator->() const
         {
             if (m_current == nullptr) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
 
             return &m_current->m_element;
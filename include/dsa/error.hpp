@@ -0,0 +1,103 @@
+#pragma once
+
+// NOTE: every container reports a misuse (a position out of range, a push to a full buffer, a pop from an
+//       empty one) in two ways: the plain operation (at, insert, push_back, pop_front, ...) throws, and its
+//       try_ counterpart (try_at, try_insert, try_push_back, try_pop_front) returns a Result or an
+//       std::optional instead. the try_ functions never throw for a misuse, only T or the allocator may.
+//
+//       the plain operations throw through fail() and failSystem(): they are cold and never inlined, so the
+//       formatting of the message and the construction of the exception stay out of the hot paths. compiled
+//       with -fno-exceptions they print the message to stderr and abort instead, the try_ functions are then
+//       the only way to handle a misuse.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <expected>
+#include <format>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    enum class Error : std::uint8_t
+    {
+        OutOfRange,    // the position is not in the container
+        Full,          // the container can't hold one more element (a fixed capacity buffer)
+        Closed,        // the channel does not take values anymore
+    };
+
+    constexpr std::string_view toString(Error error) noexcept
+    {
+        switch (error) {
+        case Error::OutOfRange: return "out of range";
+        case Error::Full: return "full";
+        case Error::Closed: return "closed";
+        }
+        return "unknown";
+    }
+
+    // a reference to an element is returned as std::reference_wrapper
+    template <typename T>
+    using ResultValue = std::conditional_t<
+        std::is_reference_v<T>,
+        std::reference_wrapper<std::remove_reference_t<T>>,
+        T>;
+
+    // the result of a try_ function: a value, a reference to an element or the reason it failed
+    template <typename T>
+    using Result = std::expected<ResultValue<T>, Error>;
+
+    // the element reference of a container with the constness of Self, what try_at returns
+    template <typename Self, typename T>
+    using ElementRef = std::conditional_t<std::is_const_v<std::remove_reference_t<Self>>, const T&, T&>;
+
+    // throw Exception with the formatted message, or print it and abort without exceptions
+    template <typename Exception, typename... Args>
+    [[noreturn, gnu::cold, gnu::noinline]] void fail(std::format_string<Args...> fmt, Args&&... args);
+
+    // same as fail() for an errno value, as std::system_error
+    template <typename... Args>
+    [[noreturn, gnu::cold, gnu::noinline]] void failSystem(
+        int                         error,
+        std::format_string<Args...> fmt,
+        Args&&... args
+    );
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <typename Exception, typename... Args>
+    void fail(std::format_string<Args...> fmt, Args&&... args)
+    {
+        auto message = std::format(fmt, std::forward<Args>(args)...);
+#if defined(__cpp_exceptions)
+        throw Exception{ message };
+#else
+        std::fprintf(stderr, "dsa: %s\n", message.c_str());
+        std::abort();
+#endif
+    }
+
+    template <typename... Args>
+    void failSystem(int error, std::format_string<Args...> fmt, Args&&... args)
+    {
+        auto message = std::format(fmt, std::forward<Args>(args)...);
+#if defined(__cpp_exceptions)
+        throw std::system_error{ error, std::generic_category(), message };
+#else
+        auto reason = std::generic_category().message(error);
+        std::fprintf(stderr, "dsa: %s: %s\n", message.c_str(), reason.c_str());
+        std::abort();
+#endif
+    }
+}
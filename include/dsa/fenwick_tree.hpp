@@ -0,0 +1,206 @@
+#pragma once
+
+// NOTE: FenwickTree (binary indexed tree) over an ArrayList. the tree is 1-indexed internally: node i covers
+//       the elements (i - lowbit(i), i], stored at offset i - 1. the operation must be commutative.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+#include "dsa/monoid.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+
+namespace dsa
+{
+    template <typename T>
+    concept FenwickTreeElement = std::copyable<T> and std::default_initializable<T>;
+
+    template <FenwickTreeElement T, Monoid<T> Op = Sum<T>>
+    class FenwickTree
+    {
+    public:
+        using Element    = T;
+        using Operation  = Op;
+        using value_type = Element;    // STL compliance
+
+        FenwickTree() = default;
+
+        // all elements start as the identity
+        explicit FenwickTree(std::size_t size);
+
+        // O(n) build
+        template <std::ranges::forward_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+        explicit FenwickTree(R&& range);
+
+        // element at pos becomes op(element, value)
+        void update(std::size_t pos, const T& value);
+
+        // update with many (position, value) pairs. when the batch is large enough and the operation is
+        // invertible, the tree is flattened, updated, and rebuilt in O(n + k) instead of O(k log n)
+        template <std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, std::pair<std::size_t, T>>
+        void updateBatch(R&& updates);
+
+        // op over [0, count)
+        T prefix(std::size_t count) const;
+
+        // op over [first, last)
+        T query(std::size_t first, std::size_t last) const
+            requires Group<Op, T>;
+
+        T at(std::size_t pos) const
+            requires Group<Op, T>
+        {
+            return query(pos, pos + 1);
+        }
+
+        std::size_t size() const noexcept { return m_tree.size(); }
+
+    private:
+        [[no_unique_address]] Op m_op   = {};
+        ArrayList<T>             m_tree = {};
+
+        static std::size_t lowbit(std::size_t i) noexcept { return i & (~i + 1); }
+
+        // unchecked, i is 1-indexed
+        auto&& node(this auto&& self, std::size_t i) { return self.m_tree.data()[i - 1]; }
+
+        void build() noexcept;
+        void flatten() noexcept
+            requires Group<Op, T>;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <FenwickTreeElement T, Monoid<T> Op>
+    FenwickTree<T, Op>::FenwickTree(std::size_t size)
+    {
+        m_tree.reserve(size);
+        for (auto i = 0uz; i < size; ++i) {
+            m_tree.push_back(Op::identity());
+        }
+    }
+
+    template <FenwickTreeElement T, Monoid<T> Op>
+    template <std::ranges::forward_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    FenwickTree<T, Op>::FenwickTree(R&& range)
+    {
+        m_tree.reserve(static_cast<std::size_t>(std::ranges::distance(range)));
+        for (auto&& value : range) {
+            m_tree.push_back(static_cast<T>(value));
+        }
+        build();
+    }
+
+    template <FenwickTreeElement T, Monoid<T> Op>
+    void FenwickTree<T, Op>::update(std::size_t pos, const T& value)
+    {
+        if (pos >= size()) {
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, size());
+        }
+
+        for (auto i = pos + 1; i <= size(); i += lowbit(i)) {
+            node(i) = m_op(node(i), value);
+        }
+    }
+
+    template <FenwickTreeElement T, Monoid<T> Op>
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, std::pair<std::size_t, T>>
+    void FenwickTree<T, Op>::updateBatch(R&& updates)
+    {
+        // every position is checked before the first update so a bad batch leaves the tree untouched, a
+        // single pass range is collected first to be read twice
+        if constexpr (not std::ranges::forward_range<R>) {
+            auto collected = ArrayList<std::pair<std::size_t, T>>{};
+            for (auto&& entry : updates) {
+                collected.push_back(static_cast<std::pair<std::size_t, T>>(entry));
+            }
+            updateBatch(collected);
+        } else {
+            for (auto&& entry : updates) {
+                if (auto pos = static_cast<std::pair<std::size_t, T>>(entry).first; pos >= size()) {
+                    fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, size());
+                }
+            }
+
+            if constexpr (Group<Op, T> and std::ranges::sized_range<R>) {
+                auto count = static_cast<std::size_t>(std::ranges::size(updates));
+                if (count * static_cast<std::size_t>(std::bit_width(size())) > size()) {
+                    flatten();
+                    for (auto&& entry : updates) {
+                        auto [pos, value] = static_cast<std::pair<std::size_t, T>>(entry);
+                        m_tree.at(pos)    = m_op(m_tree.at(pos), value);
+                    }
+                    build();
+                    return;
+                }
+            }
+
+            for (auto&& entry : updates) {
+                auto [pos, value] = static_cast<std::pair<std::size_t, T>>(entry);
+                update(pos, value);
+            }
+        }
+    }
+
+    template <FenwickTreeElement T, Monoid<T> Op>
+    T FenwickTree<T, Op>::prefix(std::size_t count) const
+    {
+        if (count > size()) {
+            fail<std::out_of_range>("Count is out of range: count {} on size {}", count, size());
+        }
+
+        auto result = static_cast<T>(Op::identity());
+        for (auto i = count; i > 0; i -= lowbit(i)) {
+            result = m_op(result, node(i));
+        }
+        return result;
+    }
+
+    template <FenwickTreeElement T, Monoid<T> Op>
+    T FenwickTree<T, Op>::query(std::size_t first, std::size_t last) const
+        requires Group<Op, T>
+    {
+        if (first > last) {
+            fail<std::invalid_argument>("Invalid range: [{}, {})", first, last);
+        }
+        return m_op.inverse(prefix(last), prefix(first));
+    }
+
+    // each node pushes its value to its parent, the parent is always at a higher index so a single forward
+    // pass is enough
+    template <FenwickTreeElement T, Monoid<T> Op>
+    void FenwickTree<T, Op>::build() noexcept
+    {
+        for (auto i = 1uz; i <= size(); ++i) {
+            auto parent = i + lowbit(i);
+            if (parent <= size()) {
+                node(parent) = m_op(node(parent), node(i));
+            }
+        }
+    }
+
+    // inverse of build(): turn the tree back into the plain array
+    template <FenwickTreeElement T, Monoid<T> Op>
+    void FenwickTree<T, Op>::flatten() noexcept
+        requires Group<Op, T>
+    {
+        for (auto i = size(); i > 0; --i) {
+            auto parent = i + lowbit(i);
+            if (parent <= size()) {
+                node(parent) = m_op.inverse(node(parent), node(i));
+            }
+        }
+    }
+}
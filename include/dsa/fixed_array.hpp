@@ -1,9 +1,12 @@
 #pragma once
 
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
 
+#include <algorithm>
 #include <concepts>
 #include <memory>
+#include <ranges>
 #include <type_traits>
 
 namespace dsa
@@ -36,6 +39,16 @@ namespace dsa
         {
         }
 
+        // the range is traversed twice if it's not sized: once to count then once to copy
+        template <ContainerCompatibleRange<T> R>
+            requires KnownSizeRange<R> and std::default_initializable<T>
+                 and std::assignable_from<T&, std::ranges::range_reference_t<R>>
+        FixedArray(std::from_range_t, R&& range)
+            : FixedArray{ SizedTag{}, rangeSize(range) }
+        {
+            std::ranges::copy(range, m_data.get());
+        }
+
         static FixedArray sized(std::size_t size)
             requires std::default_initializable<T>
         {
@@ -45,6 +58,15 @@ namespace dsa
         auto*  data(this auto&& self) noexcept { return &self.at(0); }
         auto&& at(this auto&& self, std::size_t pos) noexcept { return deref<T>(self.m_data, pos); }
 
+        // at() is unchecked, this one is not, see dsa/error.hpp
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.m_size) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
         auto* begin(this auto&& self) { return &self.at(0); }
         auto* end(this auto&& self) { return &self.at(self.m_size); }
 
@@ -0,0 +1,534 @@
+#pragma once
+
+// NOTE: GapBuffer keeps a movable hole (the gap) inside a single buffer. elements before the gap live at
+//       [0, gapBegin) and elements after the gap live at [gapEnd, capacity). the gap is always located at the
+//       cursor, so insertion and removal at the cursor never shift the rest of the elements.
+
+#include "dsa/common.hpp"
+#include "dsa/error.hpp"
+#include "dsa/raw_buffer.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <utility>
+
+namespace dsa
+{
+    template <typename T>
+    concept GapBufferElement = std::movable<T> or std::copyable<T>;
+
+    template <GapBufferElement T>
+    class GapBuffer
+    {
+    public:
+        template <bool IsConst>
+        class [[nodiscard]] Iterator;    // random access iterator, skips the gap
+
+        friend class Iterator<false>;
+        friend class Iterator<true>;
+
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        GapBuffer() = default;
+        ~GapBuffer() { clear(); }
+
+        explicit GapBuffer(std::size_t capacity);
+
+        template <ContainerCompatibleRange<T> R>
+        GapBuffer(std::from_range_t, R&& range);
+
+        GapBuffer(GapBuffer&& other) noexcept;
+        GapBuffer& operator=(GapBuffer&& other) noexcept;
+
+        GapBuffer(const GapBuffer& other)
+            requires std::copyable<T>;
+        GapBuffer& operator=(const GapBuffer& other)
+            requires std::copyable<T>;
+
+        void swap(GapBuffer& other) noexcept;
+        void clear() noexcept;
+
+        // move the cursor (the gap) to pos, elements between the old and new cursor are moved across the gap
+        void        moveCursor(std::size_t pos);
+        std::size_t cursor() const noexcept { return m_gapBegin; }
+
+        // insert before the cursor, the cursor then points after the inserted element
+        T& insertAtCursor(T&& element);
+
+        // remove the element before the cursor (backspace) or after the cursor (delete)
+        T removeBeforeCursor();
+        T removeAfterCursor();
+
+        // these move the cursor to pos before doing the operation
+        T& insert(std::size_t pos, T&& element);
+        T  remove(std::size_t pos);
+
+        // snake-case to be able to use std functions like std::back_inserter
+        T& push_front(T&& element) { return insert(0, std::move(element)); }
+        T& push_back(T&& element) { return insert(size(), std::move(element)); }
+        T  pop_front() { return remove(0); }
+        T  pop_back() { return remove(size() - 1); }
+
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&>       try_insert(std::size_t pos, T&& element);
+        Result<T&>       try_push_back(T&& element) { return push_back(std::move(element)); }
+        std::optional<T> try_pop_front();
+
+        // moves the cursor to the end, the gap grows at most once when the size of the range is known
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
+        // reallocation will happen in order to fit
+        void fit();
+
+        // resize the capacity:
+        // if count > capacity() -> reallocate the buffer with the new capacity.
+        // else                  -> do nothing.
+        void reserve(std::size_t count);
+
+        auto&& at(this auto&& self, std::size_t pos);
+        auto&& front(this auto&& self) { return self.at(0); }
+        auto&& back(this auto&& self) { return self.at(self.size() - 1); }
+
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.size()) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
+        // contiguous elements before and after the gap
+        auto beforeGap(this auto&& self) noexcept;
+        auto afterGap(this auto&& self) noexcept;
+
+        std::size_t size() const noexcept { return capacity() - gapSize(); }
+        std::size_t capacity() const noexcept { return m_buffer.size(); }
+        std::size_t gapSize() const noexcept { return m_gapEnd - m_gapBegin; }
+
+        auto begin(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, 0uz); }
+        auto end(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, self.size()); }
+
+        Iterator<true> cbegin() const noexcept { return begin(); }
+        Iterator<true> cend() const noexcept { return end(); }
+
+    private:
+        RawBuffer<T> m_buffer   = {};
+        std::size_t  m_gapBegin = 0;
+        std::size_t  m_gapEnd   = 0;
+
+        std::size_t physical(std::size_t pos) const noexcept;
+
+        void relocate(std::size_t newCapacity);
+        void grow();
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <GapBufferElement T>
+    GapBuffer<T>::GapBuffer(std::size_t capacity)
+        : m_buffer{ capacity }
+        , m_gapBegin{ 0 }
+        , m_gapEnd{ capacity }
+    {
+    }
+
+    template <GapBufferElement T>
+    template <ContainerCompatibleRange<T> R>
+    GapBuffer<T>::GapBuffer(std::from_range_t, R&& range)
+    {
+        append_range(std::forward<R>(range));
+    }
+
+    template <GapBufferElement T>
+    GapBuffer<T>::GapBuffer(GapBuffer&& other) noexcept
+        : m_buffer{ std::exchange(other.m_buffer, {}) }
+        , m_gapBegin{ std::exchange(other.m_gapBegin, 0) }
+        , m_gapEnd{ std::exchange(other.m_gapEnd, 0) }
+    {
+    }
+
+    template <GapBufferElement T>
+    GapBuffer<T>& GapBuffer<T>::operator=(GapBuffer&& other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+
+        m_buffer   = std::exchange(other.m_buffer, {});
+        m_gapBegin = std::exchange(other.m_gapBegin, 0);
+        m_gapEnd   = std::exchange(other.m_gapEnd, 0);
+
+        return *this;
+    }
+
+    template <GapBufferElement T>
+    GapBuffer<T>::GapBuffer(const GapBuffer& other)
+        requires std::copyable<T>
+        : m_buffer{ other.capacity() }
+        , m_gapBegin{ other.m_gapBegin }
+        , m_gapEnd{ other.m_gapEnd }
+    {
+        // the gap is kept at the same place so the copy has the same cursor
+        for (auto i = 0uz; i < m_gapBegin; ++i) {
+            m_buffer.construct(i, auto{ other.m_buffer.at(i) });
+        }
+        for (auto i = m_gapEnd; i < capacity(); ++i) {
+            m_buffer.construct(i, auto{ other.m_buffer.at(i) });
+        }
+    }
+
+    template <GapBufferElement T>
+    GapBuffer<T>& GapBuffer<T>::operator=(const GapBuffer& other)
+        requires std::copyable<T>
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        auto copy = GapBuffer{ other };    // copy-and-swap idiom
+        swap(copy);
+
+        return *this;
+    }
+
+    template <GapBufferElement T>
+    void GapBuffer<T>::swap(GapBuffer& other) noexcept
+    {
+        std::swap(m_buffer, other.m_buffer);
+        std::swap(m_gapBegin, other.m_gapBegin);
+        std::swap(m_gapEnd, other.m_gapEnd);
+    }
+
+    template <GapBufferElement T>
+    void GapBuffer<T>::clear() noexcept
+    {
+        for (auto i = 0uz; i < m_gapBegin; ++i) {
+            m_buffer.destroy(i);
+        }
+        for (auto i = m_gapEnd; i < capacity(); ++i) {
+            m_buffer.destroy(i);
+        }
+
+        m_gapBegin = 0;
+        m_gapEnd   = capacity();
+    }
+
+    template <GapBufferElement T>
+    void GapBuffer<T>::moveCursor(std::size_t pos)
+    {
+        if (pos > size()) {
+            fail<std::out_of_range>(
+                "Cannot move cursor to position greater than size ({} > {})", pos, size()
+            );
+        }
+
+        // no gap means the elements are already contiguous, nothing to move
+        if (gapSize() == 0) {
+            m_gapBegin = pos;
+            m_gapEnd   = pos;
+            return;
+        }
+
+        // elements in [pos, gapBegin) are moved to the end of the gap
+        while (m_gapBegin > pos) {
+            --m_gapBegin;
+            --m_gapEnd;
+            m_buffer.construct(m_gapEnd, std::move(m_buffer.at(m_gapBegin)));
+            m_buffer.destroy(m_gapBegin);
+        }
+
+        // elements in [gapEnd, gapEnd + (pos - gapBegin)) are moved to the start of the gap
+        while (m_gapBegin < pos) {
+            m_buffer.construct(m_gapBegin, std::move(m_buffer.at(m_gapEnd)));
+            m_buffer.destroy(m_gapEnd);
+            ++m_gapBegin;
+            ++m_gapEnd;
+        }
+    }
+
+    template <GapBufferElement T>
+    T& GapBuffer<T>::insertAtCursor(T&& element)
+    {
+        if (gapSize() == 0) {
+            grow();
+        }
+
+        return m_buffer.construct(m_gapBegin++, std::move(element));
+    }
+
+    template <GapBufferElement T>
+    T GapBuffer<T>::removeBeforeCursor()
+    {
+        if (m_gapBegin == 0) {
+            fail<std::out_of_range>("Cannot remove before cursor, cursor is at the beginning");
+        }
+
+        --m_gapBegin;
+        auto value = std::move(m_buffer.at(m_gapBegin));
+        m_buffer.destroy(m_gapBegin);
+
+        return value;
+    }
+
+    template <GapBufferElement T>
+    T GapBuffer<T>::removeAfterCursor()
+    {
+        if (m_gapEnd == capacity()) {
+            fail<std::out_of_range>("Cannot remove after cursor, cursor is at the end");
+        }
+
+        auto value = std::move(m_buffer.at(m_gapEnd));
+        m_buffer.destroy(m_gapEnd);
+        ++m_gapEnd;
+
+        return value;
+    }
+
+    template <GapBufferElement T>
+    T& GapBuffer<T>::insert(std::size_t pos, T&& element)
+    {
+        if (pos > size()) {
+            fail<std::out_of_range>("Cannot insert at position greater than size ({} > {})", pos, size());
+        }
+
+        moveCursor(pos);
+        return insertAtCursor(std::move(element));
+    }
+
+    template <GapBufferElement T>
+    T GapBuffer<T>::remove(std::size_t pos)
+    {
+        if (pos >= size()) {
+            fail<std::out_of_range>(
+                "Cannot remove at position greater than or equal to size ({} >= {})", pos, size()
+            );
+        }
+
+        moveCursor(pos);
+        return removeAfterCursor();
+    }
+
+    template <GapBufferElement T>
+    void GapBuffer<T>::fit()
+    {
+        relocate(size());
+    }
+
+    template <GapBufferElement T>
+    template <ContainerCompatibleRange<T> R>
+    void GapBuffer<T>::append_range(R&& range)
+    {
+        moveCursor(size());
+
+        if constexpr (KnownSizeRange<R>) {
+            auto count = rangeSize(range);
+            if (count > gapSize()) {
+                reserve(std::max(size() + count, 2 * capacity()));
+            }
+
+            if constexpr (TriviallyCopyableRangeOf<R, T>) {
+                m_buffer.constructRange(m_gapBegin, std::ranges::data(range), count);
+                m_gapBegin += count;
+                return;
+            }
+        }
+
+        for (auto&& value : range) {
+            if (gapSize() == 0) {
+                grow();
+            }
+            m_buffer.construct(m_gapBegin++, std::forward<decltype(value)>(value));
+        }
+    }
+
+    template <GapBufferElement T>
+    void GapBuffer<T>::reserve(std::size_t count)
+    {
+        if (count > capacity()) {
+            relocate(count);
+        }
+    }
+
+    template <GapBufferElement T>
+    Result<T&> GapBuffer<T>::try_insert(std::size_t pos, T&& element)
+    {
+        if (pos > size()) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insert(pos, std::move(element));
+    }
+
+    template <GapBufferElement T>
+    std::optional<T> GapBuffer<T>::try_pop_front()
+    {
+        if (size() == 0) {
+            return std::nullopt;
+        }
+        return pop_front();
+    }
+
+    template <GapBufferElement T>
+    auto&& GapBuffer<T>::at(this auto&& self, std::size_t pos)
+    {
+        if (pos >= self.size()) {
+            fail<std::out_of_range>("Index is out of range: index {} on size {}", pos, self.size());
+        }
+        return self.m_buffer.at(self.physical(pos));
+    }
+
+    template <GapBufferElement T>
+    auto GapBuffer<T>::beforeGap(this auto&& self) noexcept
+    {
+        return std::span{ self.m_buffer.data(), self.m_gapBegin };
+    }
+
+    template <GapBufferElement T>
+    auto GapBuffer<T>::afterGap(this auto&& self) noexcept
+    {
+        return std::span{ self.m_buffer.data() + self.m_gapEnd, self.capacity() - self.m_gapEnd };
+    }
+
+    template <GapBufferElement T>
+    std::size_t GapBuffer<T>::physical(std::size_t pos) const noexcept
+    {
+        return pos < m_gapBegin ? pos : pos + gapSize();
+    }
+
+    // the elements before the gap keep their offset while the elements after the gap are moved to the end of
+    // the new buffer, so the gap absorbs all of the added capacity
+    template <GapBufferElement T>
+    void GapBuffer<T>::relocate(std::size_t newCapacity)
+    {
+        auto suffix = capacity() - m_gapEnd;
+
+        RawBuffer<T> buffer{ newCapacity };
+        for (auto i = 0uz; i < m_gapBegin; ++i) {
+            buffer.construct(i, std::move(m_buffer.at(i)));
+            m_buffer.destroy(i);
+        }
+        for (auto i = 0uz; i < suffix; ++i) {
+            buffer.construct(newCapacity - suffix + i, std::move(m_buffer.at(m_gapEnd + i)));
+            m_buffer.destroy(m_gapEnd + i);
+        }
+
+        m_buffer = std::move(buffer);
+        m_gapEnd = newCapacity - suffix;
+    }
+
+    template <GapBufferElement T>
+    void GapBuffer<T>::grow()
+    {
+        // 2 * growth factor
+        auto newSize = capacity() == 0 ? 1 : 2 * capacity();
+        relocate(newSize);
+    }
+
+    template <GapBufferElement T>
+    template <bool IsConst>
+    class GapBuffer<T>::Iterator
+    {
+    public:
+        // STL compatibility
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = typename GapBuffer::Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        using BufferPtr = std::conditional_t<IsConst, const GapBuffer*, GapBuffer*>;
+
+        Iterator() noexcept                      = default;
+        Iterator(const Iterator&)                = default;
+        Iterator& operator=(const Iterator&)     = default;
+        Iterator(Iterator&&) noexcept            = default;
+        Iterator& operator=(Iterator&&) noexcept = default;
+
+        Iterator(BufferPtr buffer, std::size_t pos) noexcept
+            : m_buffer{ buffer }
+            , m_pos{ pos }
+        {
+        }
+
+        // for const iterator construction from iterator
+        Iterator(Iterator<false>& other)
+            : m_buffer{ other.m_buffer }
+            , m_pos{ other.m_pos }
+        {
+        }
+
+        // just a pointer comparison
+        auto operator<=>(const Iterator&) const = default;
+
+        Iterator& operator+=(difference_type n)
+        {
+            // casted n possibly become very large if it was negative, but when it was added to m_pos, m_pos
+            // will wraparound anyway since it was unsigned
+            m_pos += static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) { return (*this) += -n; }
+
+        Iterator& operator++() { return (*this) += 1; }
+        Iterator& operator--() { return (*this) -= 1; }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --(*this);
+            return copy;
+        }
+
+        reference operator*() const
+        {
+            if (m_buffer == nullptr) {
+                fail<std::out_of_range>("Iterator is out of range");
+            }
+            return m_buffer->at(m_pos);
+        }
+
+        pointer operator->() const
+        {
+            if (m_buffer == nullptr) {
+                fail<std::out_of_range>("Iterator is out of range");
+            }
+            return &m_buffer->at(m_pos);
+        }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        friend Iterator operator+(const Iterator& lhs, difference_type n) { return auto{ lhs } += n; }
+        friend Iterator operator+(difference_type n, const Iterator& rhs) { return rhs + n; }
+        friend Iterator operator-(const Iterator& lhs, difference_type n) { return auto{ lhs } -= n; }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.m_pos) - static_cast<difference_type>(rhs.m_pos);
+        }
+
+    private:
+        BufferPtr   m_buffer = nullptr;
+        std::size_t m_pos    = 0;
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+// NOTE: GrowthPolicy decides the capacity a dynamic container grows to when it is full and whether it shrinks
+//       after it lost elements. it is a structural value so it can be a template argument (ArrayList) or a
+//       member of a policy (BufferPolicy of CircularBuffer).
+//
+//       - Double         : 2x, the fewest reallocations but a freed block can never be reused by the next one
+//                          (1 + 2 + ... + 2^(k - 1) < 2^k).
+//       - OneAndHalf     : 1.5x, more reallocations but after a few of them the blocks freed before add up to
+//                          the next request so the allocator can reuse the memory.
+//       - FixedIncrement : m_increment more elements each time, bounded waste but a quadratic number of
+//                          copies.
+//       - SizeClass      : 1.5x rounded up to a malloc size class (four classes per power of two, like the
+//                          bins of jemalloc and tcmalloc) so the slack of the allocation becomes capacity.
+//
+//       shrinking is a hysteresis: the capacity is halved when the size drops to capacity / m_shrinkDivisor
+//       (0 never shrinks). the divisor must be at least 3 so a halved container is not full again.
+//
+//       growth saturates at the largest count of elements whose size in bytes fits in std::size_t instead of
+//       wrapping around to a small capacity, a required count beyond it throws std::length_error.
+
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace dsa
+{
+    enum class GrowthFactor : std::uint8_t
+    {
+        Double,
+        OneAndHalf,
+        FixedIncrement,
+        SizeClass,
+    };
+
+    struct GrowthPolicy
+    {
+        GrowthFactor  m_factor        = GrowthFactor::Double;
+        std::uint8_t  m_shrinkDivisor = 0;     // 0: never shrink
+        std::uint32_t m_increment     = 64;    // elements, FixedIncrement only
+
+        friend bool operator==(const GrowthPolicy&, const GrowthPolicy&) = default;
+
+        constexpr bool isValid() const noexcept
+        {
+            return (m_shrinkDivisor == 0 or m_shrinkDivisor >= 3)
+               and (m_factor != GrowthFactor::FixedIncrement or m_increment > 0);
+        }
+
+        // the capacity to grow to from capacity so that at least required elements of elementSize bytes fit
+        constexpr std::size_t grow(std::size_t capacity, std::size_t required, std::size_t elementSize) const;
+
+        // whether a container should shrink now that its size dropped to size (checked after each removal)
+        constexpr bool shouldShrink(std::size_t size, std::size_t capacity) const noexcept
+        {
+            return m_shrinkDivisor != 0 and size == capacity / m_shrinkDivisor;
+        }
+
+        // the capacity to shrink to, never less than half the capacity
+        constexpr std::size_t shrink(std::size_t capacity, std::size_t elementSize) const noexcept;
+
+        // the smallest malloc size class in bytes that is at least bytes, bytes itself past the last class
+        static constexpr std::size_t sizeClass(std::size_t bytes) noexcept;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    constexpr std::size_t GrowthPolicy::grow(
+        std::size_t capacity,
+        std::size_t required,
+        std::size_t elementSize
+    ) const
+    {
+        auto limit = std::numeric_limits<std::size_t>::max() / std::max(elementSize, 1uz);
+        if (required > limit) {
+            fail<std::length_error>(
+                "Required capacity is too large: {} elements of {} bytes", required, elementSize
+            );
+        }
+
+        // capacity + extra without going past the limit
+        capacity   = std::min(capacity, limit);
+        auto grown = [&](std::size_t extra) { return extra > limit - capacity ? limit : capacity + extra; };
+        auto next  = 0uz;
+
+        switch (m_factor) {
+        case GrowthFactor::Double: next = capacity == 0 ? 1 : grown(capacity); break;
+        case GrowthFactor::OneAndHalf: next = grown(std::max(capacity / 2, 1uz)); break;
+        case GrowthFactor::FixedIncrement: next = grown(m_increment); break;
+        case GrowthFactor::SizeClass: {
+            auto wanted = std::max(required, grown(std::max(capacity / 2, 1uz)));
+            return sizeClass(wanted * elementSize) / elementSize;
+        }
+        }
+
+        return std::max(next, required);
+    }
+
+    constexpr std::size_t GrowthPolicy::shrink(std::size_t capacity, std::size_t elementSize) const noexcept
+    {
+        auto half = capacity / 2;
+        if (m_factor != GrowthFactor::SizeClass or half == 0) {
+            return half;
+        }
+
+        // the class of the half may be the capacity itself for tiny buffers, then don't shrink
+        auto rounded = sizeClass(half * elementSize) / elementSize;
+        return rounded < capacity ? rounded : capacity;
+    }
+
+    constexpr std::size_t GrowthPolicy::sizeClass(std::size_t bytes) noexcept
+    {
+        constexpr auto minimum = 16uz;
+        if (bytes <= minimum) {
+            return minimum;
+        }
+
+        // four classes per power of two: 2^k, 1.25 * 2^k, 1.5 * 2^k, 1.75 * 2^k
+        auto base = std::bit_floor(bytes - 1);
+        auto step = std::max(base / 4, minimum);
+        if (bytes > std::numeric_limits<std::size_t>::max() - (step - 1)) {
+            return bytes;
+        }
+        return (bytes + step - 1) / step * step;
+    }
+}
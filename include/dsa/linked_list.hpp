@@ -3,9 +3,11 @@
 // NOTE: LinkedList implementation based on reference 1
 
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
 
 #include <concepts>
 #include <memory>
+#include <optional>
 
 namespace dsa
 {
@@ -37,6 +39,9 @@ namespace dsa
         LinkedList() = default;
         ~LinkedList() { clear(); }
 
+        template <ContainerCompatibleRange<T> R>
+        LinkedList(std::from_range_t, R&& range);
+
         LinkedList(LinkedList&& other) noexcept;
         LinkedList& operator=(LinkedList&& other) noexcept;
 
@@ -56,11 +61,27 @@ namespace dsa
         T& push_back(T&& element);
         T  pop_front();
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&>       try_insert(std::size_t pos, T&& element);
+        Result<T&>       try_push_back(T&& element) { return push_back(std::move(element)); }
+        std::optional<T> try_pop_front();
+
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
         auto&& at(this auto&& self, std::size_t pos);
         auto&& node(this auto&& self, std::size_t pos);
         auto&& front(this auto&& self);
         auto&& back(this auto&& self);
 
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.size()) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
         auto begin(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(self.m_head.get()); }
         auto end(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(nullptr);}
 
@@ -80,11 +101,17 @@ namespace dsa
 // implementation detail
 // -----------------------------------------------------------------------------
 
-#include <stdexcept>
 #include <utility>
 
 namespace dsa
 {
+    template <LinkedListElement T>
+    template <ContainerCompatibleRange<T> R>
+    LinkedList<T>::LinkedList(std::from_range_t, R&& range)
+    {
+        append_range(std::forward<R>(range));
+    }
+
     template <LinkedListElement T>
     LinkedList<T>::LinkedList(LinkedList&& other) noexcept
         : m_head{ std::exchange(other.m_head, nullptr) }
@@ -153,7 +180,7 @@ namespace dsa
     T& LinkedList<T>::insert(std::size_t pos, T&& element)
     {
         if (pos > m_size) {
-            throw std::out_of_range{ "Position out of bounds" };
+            fail<std::out_of_range>("Position out of bounds");
         }
 
         if (pos == 0) {
@@ -176,7 +203,7 @@ namespace dsa
     T LinkedList<T>::remove(std::size_t pos)
     {
         if (pos >= m_size) {
-            throw std::out_of_range{ "Index out of bounds" };
+            fail<std::out_of_range>("Index out of bounds");
         }
 
         if (pos == 0) {
@@ -226,11 +253,20 @@ namespace dsa
         return m_tail->m_element;
     }
 
+    template <LinkedListElement T>
+    template <ContainerCompatibleRange<T> R>
+    void LinkedList<T>::append_range(R&& range)
+    {
+        for (auto&& value : range) {
+            push_back(T(std::forward<decltype(value)>(value)));
+        }
+    }
+
     template <LinkedListElement T>
     T LinkedList<T>::pop_front()
     {
         if (m_head == nullptr) {
-            throw std::out_of_range{ "List is empty" };
+            fail<std::out_of_range>("List is empty");
         }
 
         auto element = std::move(m_head->m_element);
@@ -239,6 +275,24 @@ namespace dsa
         return element;
     }
 
+    template <LinkedListElement T>
+    Result<T&> LinkedList<T>::try_insert(std::size_t pos, T&& element)
+    {
+        if (pos > size()) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insert(pos, std::move(element));
+    }
+
+    template <LinkedListElement T>
+    std::optional<T> LinkedList<T>::try_pop_front()
+    {
+        if (size() == 0) {
+            return std::nullopt;
+        }
+        return pop_front();
+    }
+
     template <LinkedListElement T>
     auto&& LinkedList<T>::at(this auto&& self, std::size_t pos)
     {
@@ -249,9 +303,7 @@ namespace dsa
     auto&& LinkedList<T>::node(this auto&& self, std::size_t pos)
     {
         if (pos >= self.m_size) {
-            throw std::out_of_range{
-                std::format("Position is out of range: pos {} on size {}", pos, self.m_size)
-            };
+            fail<std::out_of_range>("Position is out of range: pos {} on size {}", pos, self.m_size);
         }
 
         auto* current = self.m_head.get();
@@ -266,7 +318,7 @@ namespace dsa
     auto&& LinkedList<T>::front(this auto&& self)
     {
         if (self.m_size == 0) {
-            throw std::out_of_range{ "LinkedList is empty" };
+            fail<std::out_of_range>("LinkedList is empty");
         }
         return deref<Node>(self.m_head).m_element;
     }
@@ -275,7 +327,7 @@ namespace dsa
     auto&& LinkedList<T>::back(this auto&& self)
     {
         if (self.m_size == 0) {
-            throw std::out_of_range{ "LinkedList is empty" };
+            fail<std::out_of_range>("LinkedList is empty");
         }
         return deref<Node>(self.m_tail).m_element;
     }
@@ -337,7 +389,7 @@ namespace dsa
         reference operator*() const
         {
             if (m_current == nullptr) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
             return m_current->m_element;
         }
@@ -345,7 +397,7 @@ namespace dsa
         pointer operator->() const
         {
             if (m_current == nullptr) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
             return &m_current->m_element;
         }
@@ -0,0 +1,705 @@
+#pragma once
+
+// NOTE: fixed capacity key-value caches with O(1) get, put, and evict.
+//       - LruCache: evicts the least recently used entry. the entries are nodes of a pool linked into a
+//         circular doubly linked recency list (most recent first) by index, the pool is allocated up to the
+//         capacity and reused after that. a hit unlinks the node and links it at the front.
+//       - ClockCache: CLOCK (second chance) approximation of LRU. the entries are the frames of a
+//         CircularBuffer and a hit only sets the referenced bit of its frame. on a miss the hand sweeps the
+//         ring, clearing the referenced bits, until it finds an unreferenced frame to replace.
+//       - ShardedCache: thread-safe wrapper, the keys are split by hash into shards that each have a mutex
+//         and a cache of their own.
+//
+//       both caches find their entries with CacheIndex, an open addressing (linear probing) table from the
+//       hash of a key to the position of its entry. the table is sized once for the capacity and kept at most
+//       half full, deletion shifts the following entries back instead of leaving tombstones.
+
+#include "dsa/array_list.hpp"
+#include "dsa/circular_buffer.hpp"
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace dsa
+{
+    template <typename K, typename Hash>
+    concept CacheKey = std::movable<K> and std::equality_comparable<K>
+                   and requires(const Hash& hash, const K& key) {
+                           { hash(key) } -> std::convertible_to<std::size_t>;
+                       };
+
+    template <typename V>
+    concept CacheValue = std::movable<V>;
+
+    template <typename K, typename V>
+    struct CacheEntry
+    {
+        K m_key;
+        V m_value;
+    };
+
+    class CacheIndex
+    {
+    public:
+        using Position = std::uint32_t;
+
+        static constexpr Position s_none = std::numeric_limits<Position>::max();
+
+        CacheIndex() = default;
+        explicit CacheIndex(std::size_t capacity);
+
+        // position of the entry with the hash for which match(position) is true
+        template <typename Match>
+        Position find(std::size_t hash, Match&& match) const;
+
+        // the entry must not be in the table
+        void insert(std::size_t hash, Position position) noexcept;
+
+        // the entry must be in the table
+        void erase(std::size_t hash, Position position) noexcept;
+
+        void clear() noexcept;
+
+    private:
+        struct Slot
+        {
+            Position      m_position = s_none;
+            std::uint32_t m_hash     = 0;    // mixed hash, the home slot is m_hash & mask
+        };
+
+        ArrayList<Slot> m_slots = {};
+        std::size_t     m_mask  = 0;
+
+        // the low bits of std::hash are often the value itself, fibonacci hashing spreads them
+        static std::uint32_t mix(std::size_t hash) noexcept
+        {
+            auto mixed = static_cast<std::uint64_t>(hash) * 0x9e37'79b9'7f4a'7c15;
+            return static_cast<std::uint32_t>(mixed >> 32);
+        }
+
+        Slot& slot(std::size_t i) noexcept { return m_slots.data()[i & m_mask]; }
+        const Slot& slot(std::size_t i) const noexcept { return m_slots.data()[i & m_mask]; }
+    };
+
+    template <typename K, typename V, typename Hash = std::hash<K>>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    class LruCache
+    {
+    public:
+        using Key   = K;
+        using Value = V;
+        using Entry = CacheEntry<K, V>;
+
+        explicit LruCache(std::size_t capacity, Hash hash = {});
+
+        // marks the entry as the most recently used, nullptr if there is none
+        V* get(const K& key);
+
+        // doesn't change the recency
+        const V* peek(const K& key) const;
+        bool     contains(const K& key) const { return peek(key) != nullptr; }
+
+        // insert or assign, the entry becomes the most recently used. returns the evicted entry if the cache
+        // was full
+        std::optional<Entry> put(K key, V value);
+
+        bool erase(const K& key);
+        void clear() noexcept;
+
+        std::size_t size() const noexcept { return m_size; }
+        std::size_t capacity() const noexcept { return m_capacity; }
+
+        // the keys from the most to the least recently used
+        template <typename Fn>
+        void forEach(Fn&& fn) const;
+
+    private:
+        using Index = CacheIndex::Position;
+
+        static constexpr Index s_sentinel = 0;
+
+        struct Node
+        {
+            std::optional<Entry> m_entry = std::nullopt;    // empty for the sentinel and free nodes
+            std::size_t          m_hash  = 0;
+            Index                m_prev  = s_sentinel;
+            Index                m_next  = s_sentinel;
+        };
+
+        [[no_unique_address]] Hash m_hasher = {};
+
+        ArrayList<Node> m_nodes    = {};    // node 0 is the sentinel of the recency list
+        CacheIndex      m_index    = {};
+        std::size_t     m_capacity = 0;
+        std::size_t     m_size     = 0;
+        Index           m_free     = CacheIndex::s_none;
+
+        // unchecked access
+        Node&       node(Index index) noexcept { return m_nodes.data()[index]; }
+        const Node& node(Index index) const noexcept { return m_nodes.data()[index]; }
+
+        Index find(const K& key, std::size_t hash) const;
+
+        void unlink(Index index) noexcept;
+        void linkFront(Index index) noexcept;
+    };
+
+    template <typename K, typename V, typename Hash = std::hash<K>>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    class ClockCache
+    {
+    public:
+        using Key   = K;
+        using Value = V;
+        using Entry = CacheEntry<K, V>;
+
+        explicit ClockCache(std::size_t capacity, Hash hash = {});
+
+        // marks the entry as referenced, nullptr if there is none
+        V* get(const K& key);
+
+        // doesn't mark the entry as referenced
+        const V* peek(const K& key) const;
+        bool     contains(const K& key) const { return peek(key) != nullptr; }
+
+        // insert or assign. returns the evicted entry if the cache was full
+        std::optional<Entry> put(K key, V value);
+
+        bool erase(const K& key);
+        void clear() noexcept;
+
+        std::size_t size() const noexcept { return m_frames.size(); }
+        std::size_t capacity() const noexcept { return m_frames.capacity(); }
+
+    private:
+        using Position = CacheIndex::Position;
+
+        struct Frame
+        {
+            Entry       m_entry;
+            std::size_t m_hash       = 0;
+            bool        m_referenced = false;
+        };
+
+        [[no_unique_address]] Hash m_hasher = {};
+
+        // only pushed and popped at the back so the head stays at slot 0 and a position is a slot of data()
+        CircularBuffer<Frame> m_frames = {};
+        CacheIndex            m_index  = {};
+        Position              m_hand   = 0;
+
+        // unchecked access
+        Frame&       frame(Position pos) noexcept { return m_frames.data()[pos]; }
+        const Frame& frame(Position pos) const noexcept { return m_frames.data()[pos]; }
+
+        Position find(const K& key, std::size_t hash) const;
+    };
+
+    template <typename C>
+    concept ShardableCache = std::constructible_from<C, std::size_t>
+                         and requires(C& cache, const typename C::Key& key) {
+                                 { cache.get(key) } -> std::same_as<typename C::Value*>;
+                                 { cache.erase(key) } -> std::same_as<bool>;
+                                 { cache.size() } -> std::convertible_to<std::size_t>;
+                             };
+
+    template <ShardableCache Cache, typename Hash = std::hash<typename Cache::Key>>
+    class ShardedCache
+    {
+    public:
+        using Key   = typename Cache::Key;
+        using Value = typename Cache::Value;
+        using Entry = CacheEntry<Key, Value>;
+
+        // the capacity is split evenly between the shards, the first capacity % shards() shards hold one
+        // more entry so the total is exactly the capacity. the number of shards is rounded up to a power of
+        // two and defaults to the number of hardware threads
+        explicit ShardedCache(std::size_t capacity, std::size_t shards = 0);
+
+        // a copy of the value since the entry may be evicted as soon as the lock is released
+        std::optional<Value> get(const Key& key)
+            requires std::copyable<Value>;
+
+        // call fn with the value under the lock of its shard, returns false if there is no entry
+        template <typename Fn>
+            requires std::invocable<Fn&, Value&>
+        bool visit(const Key& key, Fn&& fn);
+
+        std::optional<Entry> put(Key key, Value value);
+        bool                 erase(const Key& key);
+
+        // locks every shard one after another, the result is not a snapshot
+        std::size_t size() const;
+        std::size_t shards() const noexcept { return m_shardCount; }
+        std::size_t capacity() const noexcept { return m_capacity; }
+
+    private:
+        struct alignas(64) Shard
+        {
+            mutable std::mutex   m_mutex;
+            std::optional<Cache> m_cache;    // the caches have no empty state, emplaced by the constructor
+        };
+
+        [[no_unique_address]] Hash m_hasher = {};
+
+        std::unique_ptr<Shard[]> m_shards     = nullptr;
+        std::size_t              m_shardCount = 0;
+        std::size_t              m_capacity   = 0;
+
+        // the upper bits, the lower bits pick the slot in the index of the shard
+        Shard& shard(const Key& key) const noexcept
+        {
+            auto hash = static_cast<std::uint64_t>(m_hasher(key)) * 0xff51'afd7'ed55'8ccd;
+            return m_shards[(hash >> 40) & (m_shardCount - 1)];
+        }
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    inline CacheIndex::CacheIndex(std::size_t capacity)
+    {
+        if (capacity >= s_none / 2) {
+            fail<std::invalid_argument>("Capacity is too large: {}", capacity);
+        }
+
+        m_slots = ArrayList<Slot>(std::bit_ceil(std::max(capacity * 2, 2uz)));
+        m_mask  = m_slots.size() - 1;
+    }
+
+    template <typename Match>
+    CacheIndex::Position CacheIndex::find(std::size_t hash, Match&& match) const
+    {
+        auto mixed = mix(hash);
+        for (auto i = static_cast<std::size_t>(mixed);; ++i) {
+            const auto& current = slot(i);
+            if (current.m_position == s_none) {
+                return s_none;
+            }
+            if (current.m_hash == mixed and match(current.m_position)) {
+                return current.m_position;
+            }
+        }
+    }
+
+    inline void CacheIndex::insert(std::size_t hash, Position position) noexcept
+    {
+        auto mixed = mix(hash);
+        auto i     = static_cast<std::size_t>(mixed);
+        while (slot(i).m_position != s_none) {
+            ++i;
+        }
+        slot(i) = { position, mixed };
+    }
+
+    inline void CacheIndex::erase(std::size_t hash, Position position) noexcept
+    {
+        auto i = static_cast<std::size_t>(mix(hash));
+        while (slot(i).m_position != position) {
+            ++i;
+        }
+
+        // backward shift: move back every following entry of the run that may live at the hole
+        for (auto j = i + 1;; ++j) {
+            auto& next = slot(j);
+            if (next.m_position == s_none) {
+                break;
+            }
+
+            // distance from the home slot of next to j and to the hole
+            auto home = static_cast<std::size_t>(next.m_hash);
+            if (((j - home) & m_mask) >= ((j - i) & m_mask)) {
+                slot(i) = next;
+                i       = j;
+            }
+        }
+
+        slot(i) = Slot{};
+    }
+
+    inline void CacheIndex::clear() noexcept
+    {
+        std::ranges::fill(m_slots, Slot{});
+    }
+}
+
+namespace dsa
+{
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    LruCache<K, V, Hash>::LruCache(std::size_t capacity, Hash hash)
+        : m_hasher{ std::move(hash) }
+        , m_index{ capacity }
+        , m_capacity{ capacity }
+    {
+        if (capacity == 0) {
+            fail<std::invalid_argument>("Cache capacity must be at least 1");
+        }
+
+        m_nodes.reserve(capacity + 1);
+        m_nodes.push_back(Node{});
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    V* LruCache<K, V, Hash>::get(const K& key)
+    {
+        auto index = find(key, m_hasher(key));
+        if (index == CacheIndex::s_none) {
+            return nullptr;
+        }
+
+        if (node(s_sentinel).m_next != index) {
+            unlink(index);
+            linkFront(index);
+        }
+        return &node(index).m_entry->m_value;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    const V* LruCache<K, V, Hash>::peek(const K& key) const
+    {
+        auto index = find(key, m_hasher(key));
+        return index == CacheIndex::s_none ? nullptr : &node(index).m_entry->m_value;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    auto LruCache<K, V, Hash>::put(K key, V value) -> std::optional<Entry>
+    {
+        auto hash  = static_cast<std::size_t>(m_hasher(key));
+        auto index = find(key, hash);
+
+        if (index != CacheIndex::s_none) {
+            node(index).m_entry->m_value = std::move(value);
+            unlink(index);
+            linkFront(index);
+            return std::nullopt;
+        }
+
+        auto evicted = std::optional<Entry>{};
+
+        if (m_size == m_capacity) {
+            // the least recently used node is reused for the new entry
+            index = node(s_sentinel).m_prev;
+            unlink(index);
+            m_index.erase(node(index).m_hash, index);
+            evicted = std::move(node(index).m_entry);
+            --m_size;
+        } else if (m_free != CacheIndex::s_none) {
+            index  = m_free;
+            m_free = node(index).m_next;
+        } else {
+            m_nodes.push_back(Node{});
+            index = static_cast<Index>(m_nodes.size() - 1);
+        }
+
+        auto& current   = node(index);
+        current.m_entry = Entry{ std::move(key), std::move(value) };
+        current.m_hash  = hash;
+
+        linkFront(index);
+        m_index.insert(hash, index);
+        ++m_size;
+
+        return evicted;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    bool LruCache<K, V, Hash>::erase(const K& key)
+    {
+        auto hash  = static_cast<std::size_t>(m_hasher(key));
+        auto index = find(key, hash);
+        if (index == CacheIndex::s_none) {
+            return false;
+        }
+
+        unlink(index);
+        m_index.erase(hash, index);
+
+        auto& current = node(index);
+        current.m_entry.reset();
+        current.m_next = m_free;
+
+        m_free = index;
+        --m_size;
+
+        return true;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    void LruCache<K, V, Hash>::clear() noexcept
+    {
+        while (m_nodes.size() > 1) {
+            m_nodes.pop_back();
+        }
+        node(s_sentinel).m_prev = node(s_sentinel).m_next = s_sentinel;
+
+        m_index.clear();
+        m_size = 0;
+        m_free = CacheIndex::s_none;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    template <typename Fn>
+    void LruCache<K, V, Hash>::forEach(Fn&& fn) const
+    {
+        for (auto index = node(s_sentinel).m_next; index != s_sentinel; index = node(index).m_next) {
+            const auto& entry = *node(index).m_entry;
+            std::invoke(fn, entry.m_key, entry.m_value);
+        }
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    auto LruCache<K, V, Hash>::find(const K& key, std::size_t hash) const -> Index
+    {
+        return m_index.find(hash, [&](Index index) { return node(index).m_entry->m_key == key; });
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    void LruCache<K, V, Hash>::unlink(Index index) noexcept
+    {
+        auto& current = node(index);
+
+        node(current.m_prev).m_next = current.m_next;
+        node(current.m_next).m_prev = current.m_prev;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    void LruCache<K, V, Hash>::linkFront(Index index) noexcept
+    {
+        auto first = node(s_sentinel).m_next;
+
+        node(index).m_prev      = s_sentinel;
+        node(index).m_next      = first;
+        node(first).m_prev      = index;
+        node(s_sentinel).m_next = index;
+    }
+}
+
+namespace dsa
+{
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    ClockCache<K, V, Hash>::ClockCache(std::size_t capacity, Hash hash)
+        : m_hasher{ std::move(hash) }
+        , m_frames{
+            capacity,
+            BufferPolicy{
+                .m_capacity = BufferCapacityPolicy::FixedCapacity,
+                .m_store    = BufferStorePolicy::ThrowOnFull,
+            },
+        }
+        , m_index{ capacity }
+    {
+        if (capacity == 0) {
+            fail<std::invalid_argument>("Cache capacity must be at least 1");
+        }
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    V* ClockCache<K, V, Hash>::get(const K& key)
+    {
+        auto pos = find(key, m_hasher(key));
+        if (pos == CacheIndex::s_none) {
+            return nullptr;
+        }
+
+        auto& current        = frame(pos);
+        current.m_referenced = true;
+        return &current.m_entry.m_value;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    const V* ClockCache<K, V, Hash>::peek(const K& key) const
+    {
+        auto pos = find(key, m_hasher(key));
+        return pos == CacheIndex::s_none ? nullptr : &frame(pos).m_entry.m_value;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    auto ClockCache<K, V, Hash>::put(K key, V value) -> std::optional<Entry>
+    {
+        auto hash = static_cast<std::size_t>(m_hasher(key));
+        auto pos  = find(key, hash);
+
+        if (pos != CacheIndex::s_none) {
+            frame(pos).m_entry.m_value = std::move(value);
+            frame(pos).m_referenced    = true;
+            return std::nullopt;
+        }
+
+        if (size() < capacity()) {
+            m_frames.push_back(Frame{ { std::move(key), std::move(value) }, hash, false });
+            m_index.insert(hash, static_cast<Position>(size() - 1));
+            return std::nullopt;
+        }
+
+        // every referenced frame gets a second chance, terminates within one sweep
+        while (frame(m_hand).m_referenced) {
+            frame(m_hand).m_referenced = false;
+            m_hand                     = static_cast<Position>((m_hand + 1) % capacity());
+        }
+
+        auto& victim  = frame(m_hand);
+        auto  evicted = std::optional<Entry>{ std::move(victim.m_entry) };
+
+        m_index.erase(victim.m_hash, m_hand);
+        victim = Frame{ { std::move(key), std::move(value) }, hash, false };
+        m_index.insert(hash, m_hand);
+
+        m_hand = static_cast<Position>((m_hand + 1) % capacity());
+        return evicted;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    bool ClockCache<K, V, Hash>::erase(const K& key)
+    {
+        auto hash = static_cast<std::size_t>(m_hasher(key));
+        auto pos  = find(key, hash);
+        if (pos == CacheIndex::s_none) {
+            return false;
+        }
+
+        // the last frame fills the hole so the frames stay contiguous from slot 0
+        auto last = static_cast<Position>(size() - 1);
+        m_index.erase(hash, pos);
+        if (pos != last) {
+            m_index.erase(frame(last).m_hash, last);
+            frame(pos) = m_frames.pop_back();
+            m_index.insert(frame(pos).m_hash, pos);
+        } else {
+            m_frames.pop_back();
+        }
+
+        if (m_hand >= size()) {
+            m_hand = 0;
+        }
+        return true;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    void ClockCache<K, V, Hash>::clear() noexcept
+    {
+        m_frames.clear();
+        m_index.clear();
+        m_hand = 0;
+    }
+
+    template <typename K, typename V, typename Hash>
+        requires CacheKey<K, Hash> and CacheValue<V>
+    auto ClockCache<K, V, Hash>::find(const K& key, std::size_t hash) const -> Position
+    {
+        return m_index.find(hash, [&](Position pos) { return frame(pos).m_entry.m_key == key; });
+    }
+}
+
+namespace dsa
+{
+    template <ShardableCache Cache, typename Hash>
+    ShardedCache<Cache, Hash>::ShardedCache(std::size_t capacity, std::size_t shards)
+    {
+        if (shards == 0) {
+            shards = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        m_shardCount = std::bit_ceil(shards);
+        if (capacity < m_shardCount) {
+            fail<std::invalid_argument>(
+                "Capacity {} is less than the number of shards {}", capacity, m_shardCount
+            );
+        }
+
+        auto perShard = capacity / m_shardCount;
+        auto extra    = capacity % m_shardCount;
+
+        m_capacity = capacity;
+        m_shards   = std::make_unique<Shard[]>(m_shardCount);
+        for (auto i = 0uz; i < m_shardCount; ++i) {
+            m_shards[i].m_cache.emplace(i < extra ? perShard + 1 : perShard);
+        }
+    }
+
+    template <ShardableCache Cache, typename Hash>
+    auto ShardedCache<Cache, Hash>::get(const Key& key) -> std::optional<Value>
+        requires std::copyable<Value>
+    {
+        auto& current = shard(key);
+        auto  lock    = std::scoped_lock{ current.m_mutex };
+
+        auto* value = current.m_cache->get(key);
+        return value == nullptr ? std::nullopt : std::optional<Value>{ *value };
+    }
+
+    template <ShardableCache Cache, typename Hash>
+    template <typename Fn>
+        requires std::invocable<Fn&, typename Cache::Value&>
+    bool ShardedCache<Cache, Hash>::visit(const Key& key, Fn&& fn)
+    {
+        auto& current = shard(key);
+        auto  lock    = std::scoped_lock{ current.m_mutex };
+
+        auto* value = current.m_cache->get(key);
+        if (value == nullptr) {
+            return false;
+        }
+        std::invoke(fn, *value);
+        return true;
+    }
+
+    template <ShardableCache Cache, typename Hash>
+    auto ShardedCache<Cache, Hash>::put(Key key, Value value) -> std::optional<Entry>
+    {
+        auto& current = shard(key);
+        auto  lock    = std::scoped_lock{ current.m_mutex };
+
+        return current.m_cache->put(std::move(key), std::move(value));
+    }
+
+    template <ShardableCache Cache, typename Hash>
+    bool ShardedCache<Cache, Hash>::erase(const Key& key)
+    {
+        auto& current = shard(key);
+        auto  lock    = std::scoped_lock{ current.m_mutex };
+
+        return current.m_cache->erase(key);
+    }
+
+    template <ShardableCache Cache, typename Hash>
+    std::size_t ShardedCache<Cache, Hash>::size() const
+    {
+        auto total = 0uz;
+        for (auto i = 0uz; i < m_shardCount; ++i) {
+            auto lock  = std::scoped_lock{ m_shards[i].m_mutex };
+            total     += m_shards[i].m_cache->size();
+        }
+        return total;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <concepts>
+#include <limits>
+
+namespace dsa
+{
+    // an associative binary operation with an identity element, e.g. sum with 0 or min with +inf
+    template <typename Op, typename T>
+    concept Monoid = requires(const Op op, const T& lhs, const T& rhs) {
+        { Op::identity() } -> std::convertible_to<T>;
+        { op(lhs, rhs) } -> std::convertible_to<T>;
+    };
+
+    // a monoid that can also undo the operation: inverse(op(a, b), b) == a
+    template <typename Op, typename T>
+    concept Group = Monoid<Op, T> and requires(const Op op, const T& lhs, const T& rhs) {
+        { op.inverse(lhs, rhs) } -> std::convertible_to<T>;
+    };
+
+    template <typename T>
+    struct Sum
+    {
+        static constexpr T identity() { return T{}; }
+
+        constexpr T operator()(const T& lhs, const T& rhs) const { return lhs + rhs; }
+        constexpr T inverse(const T& lhs, const T& rhs) const { return lhs - rhs; }
+    };
+
+    template <typename T>
+    struct Min
+    {
+        static constexpr T identity() { return std::numeric_limits<T>::max(); }
+
+        constexpr T operator()(const T& lhs, const T& rhs) const { return rhs < lhs ? rhs : lhs; }
+    };
+
+    template <typename T>
+    struct Max
+    {
+        static constexpr T identity() { return std::numeric_limits<T>::lowest(); }
+
+        constexpr T operator()(const T& lhs, const T& rhs) const { return lhs < rhs ? rhs : lhs; }
+    };
+}
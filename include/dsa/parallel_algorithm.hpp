@@ -0,0 +1,833 @@
+#pragma once
+
+// NOTE: parallel scans and compactions over segmented ranges (see dsa/segmented.hpp): ArrayList, FixedArray
+//       and RootishArray, for the input as well as for the output. the output is pre-sized: the algorithms
+//       assign to its elements and never grow it.
+//
+//       two-pass blocked: the input is split in one chunk per thread. in the first pass every thread reduces
+//       (scans) or counts (compactions) its chunk, the completion step of a barrier turns the per-chunk
+//       results into offsets on a single thread, and in the second pass every thread writes its chunk at its
+//       offset. the input is read twice and the output written once. a decoupled look-back scan reads the
+//       input once, but with one chunk per thread there is nothing to overlap the look-back with.
+//
+//       - parallel_inclusive_scan, parallel_exclusive_scan: op must be associative, the chunks are combined
+//         in a different grouping than a sequential left fold.
+//       - parallel_copy_if, parallel_unique_copy, parallel_stable_partition: the predicate is called twice
+//         per element, it must return the same result both times. they return the number of elements
+//         written (the number of true elements for the partition). if the output is too small nothing is
+//         written and it throws. with an output as large as the input the last chunk is not counted, a
+//         single thread reads the input once.
+//       - parallel_partition: in place and unstable. every thread partitions its chunk, then the false
+//         elements left of the partition point are swapped with the true elements right of it, the swaps
+//         split evenly between the threads. returns the partition point.
+//
+//       threads = 0 uses all hardware threads. below s_parallelSize elements per thread fewer threads are
+//       used, a single thread runs both passes itself.
+//
+//       op and pred may throw. a thread that throws still arrives at the barrier so the others don't hang,
+//       the combine step and the second pass are skipped once anything has thrown, and the first exception
+//       is rethrown on the calling thread after every thread is joined. the output is then left partially
+//       written (the range itself for parallel_partition). a failure to start a thread is handled the same
+//       way, the threads that were not started drop out of the barrier.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+#include "dsa/segmented.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    template <typename R>
+    using segment_element_t = std::remove_reference_t<std::ranges::range_reference_t<segment_t<R>>>;
+
+    template <typename In, typename Out>
+    concept ParallelCopyable = segmented_range<In>
+                           and std::ranges::sized_range<In>
+                           and std::copyable<std::ranges::range_value_t<In>>
+                           and output_segmented_range<Out, const std::ranges::range_value_t<In>&>
+                           and std::ranges::sized_range<Out>;
+
+    template <typename Op, typename T>
+    concept ScanOperation = std::convertible_to<std::invoke_result_t<Op&, T, const T&>, T>;
+
+    class ParallelAlgorithm
+    {
+    public:
+        // below this size per thread fewer threads are used
+        static constexpr std::size_t s_parallelSize = 1uz << 16;
+
+        template <typename In, typename Out, typename Op>
+        static void inclusiveScan(In& in, Out& out, Op& op, std::size_t threads);
+
+        template <typename In, typename Out, typename T, typename Op>
+        static void exclusiveScan(In& in, Out& out, T init, Op& op, std::size_t threads);
+
+        template <typename In, typename Out, typename Pred>
+        static std::size_t copyIf(In& in, Out& out, Pred& pred, std::size_t threads);
+
+        template <typename In, typename Out, typename Eq>
+        static std::size_t uniqueCopy(In& in, Out& out, Eq& eq, std::size_t threads);
+
+        template <typename In, typename Out, typename Pred>
+        static std::size_t stablePartition(In& in, Out& out, Pred& pred, std::size_t threads);
+
+        template <typename R, typename Pred>
+        static std::size_t partition(R& range, Pred& pred, std::size_t threads);
+
+    private:
+        // the non-empty segments of a range and the position of the first element of each
+        template <typename T>
+        struct Segments
+        {
+            ArrayList<std::span<T>> m_spans;
+            ArrayList<std::size_t>  m_starts;
+        };
+
+        // a position in the segments that moves one element at a time, the end is a valid position
+        template <typename T>
+        class Cursor
+        {
+        public:
+            Cursor(const Segments<T>& segments, std::size_t pos) noexcept;
+
+            T& operator*() const noexcept { return m_span[m_offset]; }
+
+            void next() noexcept;
+            void prev() noexcept;
+
+        private:
+            const Segments<T>* m_segments;
+            std::size_t        m_index;
+            std::span<T>       m_span;
+            std::size_t        m_offset;
+        };
+
+        template <typename R>
+        static Segments<segment_element_t<R>> segmentsOf(R& range);
+
+        // fn on every element of [begin, end), a plain loop over each contiguous part
+        template <typename T, typename Fn>
+        static void forEach(const Segments<T>& segments, std::size_t begin, std::size_t end, Fn&& fn);
+
+        // fn on the elements at the same position in both, a plain loop over each part contiguous in both
+        template <typename T, typename U, typename Fn>
+        static void forEachPair(
+            const Segments<T>& first,
+            const Segments<U>& second,
+            std::size_t        begin,
+            std::size_t        end,
+            Fn&&               fn
+        );
+
+        // the elements of [begin, end) if they are in one segment, else nullptr
+        template <typename T>
+        static T* contiguous(const Segments<T>& segments, std::size_t begin, std::size_t end) noexcept;
+
+        static std::size_t threadsFor(std::size_t size, std::size_t threads) noexcept;
+
+        // first(t, begin, end) -> barrier, combine() on one thread -> second(t, begin, end)
+        template <typename First, typename Combine, typename Second>
+        static void twoPass(
+            std::size_t size,
+            std::size_t threads,
+            First&&     first,
+            Combine&&   combine,
+            Second&&    second
+        );
+
+        template <typename Out>
+        static void checkRoom(Out& out, std::size_t count);
+    };
+
+    template <typename In, typename Out, typename Op = std::plus<>>
+        requires ParallelCopyable<In, Out> and ScanOperation<Op, std::ranges::range_value_t<In>>
+    void parallel_inclusive_scan(In&& in, Out&& out, Op op = {}, std::size_t threads = 0)
+    {
+        ParallelAlgorithm::inclusiveScan(in, out, op, threads);
+    }
+
+    template <typename In, typename Out, typename Op = std::plus<>>
+        requires ParallelCopyable<In, Out> and ScanOperation<Op, std::ranges::range_value_t<In>>
+    void parallel_exclusive_scan(
+        In&&                            in,
+        Out&&                           out,
+        std::ranges::range_value_t<In> init,
+        Op                              op      = {},
+        std::size_t                     threads = 0
+    )
+    {
+        ParallelAlgorithm::exclusiveScan(in, out, std::move(init), op, threads);
+    }
+
+    template <typename In, typename Out, typename Pred>
+        requires ParallelCopyable<In, Out>
+             and std::predicate<Pred&, const std::ranges::range_value_t<In>&>
+    std::size_t parallel_copy_if(In&& in, Out&& out, Pred pred, std::size_t threads = 0)
+    {
+        return ParallelAlgorithm::copyIf(in, out, pred, threads);
+    }
+
+    template <typename In, typename Out, typename Eq = std::ranges::equal_to>
+        requires ParallelCopyable<In, Out>
+             and std::equivalence_relation<Eq&, const std::ranges::range_value_t<In>&,
+                                           const std::ranges::range_value_t<In>&>
+    std::size_t parallel_unique_copy(In&& in, Out&& out, Eq eq = {}, std::size_t threads = 0)
+    {
+        return ParallelAlgorithm::uniqueCopy(in, out, eq, threads);
+    }
+
+    template <typename In, typename Out, typename Pred>
+        requires ParallelCopyable<In, Out>
+             and std::predicate<Pred&, const std::ranges::range_value_t<In>&>
+    std::size_t parallel_stable_partition(In&& in, Out&& out, Pred pred, std::size_t threads = 0)
+    {
+        return ParallelAlgorithm::stablePartition(in, out, pred, threads);
+    }
+
+    template <typename R, typename Pred>
+        requires segmented_range<R>
+             and std::ranges::sized_range<R>
+             and std::swappable<std::ranges::range_value_t<R>>
+             and std::predicate<Pred&, const std::ranges::range_value_t<R>&>
+    std::size_t parallel_partition(R&& range, Pred pred, std::size_t threads = 0)
+    {
+        return ParallelAlgorithm::partition(range, pred, threads);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <typename In, typename Out, typename Op>
+    void ParallelAlgorithm::inclusiveScan(In& in, Out& out, Op& op, std::size_t threads)
+    {
+        using T = std::ranges::range_value_t<In>;
+
+        auto size = static_cast<std::size_t>(std::ranges::size(in));
+        checkRoom(out, size);
+        if (size == 0) {
+            return;
+        }
+
+        threads = threadsFor(size, threads);
+
+        auto input  = segmentsOf(in);
+        auto output = segmentsOf(out);
+
+        // the reduction of every chunk but the last, then the carry into every chunk but the first
+        auto sums    = ArrayList<std::optional<T>>(threads);
+        auto carries = ArrayList<std::optional<T>>(threads);
+
+        auto reduce = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (t + 1 == threads) {
+                return;
+            }
+            auto sum = T{ *Cursor{ input, begin } };
+            forEach(input, begin + 1, end, [&](const T& value) {
+                sum = std::invoke(op, std::move(sum), value);
+            });
+            sums.at(t).emplace(std::move(sum));
+        };
+
+        auto combine = [&] {
+            for (auto t = 1uz; t < threads; ++t) {
+                auto& sum = *sums.at(t - 1);
+                carries.at(t).emplace(t == 1 ? sum : std::invoke(op, *carries.at(t - 1), sum));
+            }
+        };
+
+        auto write = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            auto acc = T{ *Cursor{ input, begin } };
+            if (t > 0) {
+                acc = std::invoke(op, *carries.at(t), acc);
+            }
+            *Cursor{ output, begin } = acc;
+
+            forEachPair(input, output, begin + 1, end, [&](const T& value, auto& slot) {
+                acc  = std::invoke(op, std::move(acc), value);
+                slot = acc;
+            });
+        };
+
+        twoPass(size, threads, reduce, combine, write);
+    }
+
+    template <typename In, typename Out, typename T, typename Op>
+    void ParallelAlgorithm::exclusiveScan(In& in, Out& out, T init, Op& op, std::size_t threads)
+    {
+        auto size = static_cast<std::size_t>(std::ranges::size(in));
+        checkRoom(out, size);
+        if (size == 0) {
+            return;
+        }
+
+        threads = threadsFor(size, threads);
+
+        auto input  = segmentsOf(in);
+        auto output = segmentsOf(out);
+
+        auto sums    = ArrayList<std::optional<T>>(threads);
+        auto carries = ArrayList<std::optional<T>>(threads);
+
+        auto reduce = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (t + 1 == threads) {
+                return;
+            }
+            auto sum = T{ *Cursor{ input, begin } };
+            forEach(input, begin + 1, end, [&](const T& value) {
+                sum = std::invoke(op, std::move(sum), value);
+            });
+            sums.at(t).emplace(std::move(sum));
+        };
+
+        auto combine = [&] {
+            carries.at(0).emplace(std::move(init));
+            for (auto t = 1uz; t < threads; ++t) {
+                carries.at(t).emplace(std::invoke(op, *carries.at(t - 1), *sums.at(t - 1)));
+            }
+        };
+
+        auto write = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            auto acc = std::move(*carries.at(t));
+
+            forEachPair(input, output, begin, end, [&](const T& value, auto& slot) {
+                slot = acc;
+                acc  = std::invoke(op, std::move(acc), value);
+            });
+        };
+
+        twoPass(size, threads, reduce, combine, write);
+    }
+
+    template <typename In, typename Out, typename Pred>
+    std::size_t ParallelAlgorithm::copyIf(In& in, Out& out, Pred& pred, std::size_t threads)
+    {
+        using T = std::ranges::range_value_t<In>;
+
+        auto size = static_cast<std::size_t>(std::ranges::size(in));
+        threads   = threadsFor(size, threads);
+
+        auto input   = segmentsOf(in);
+        auto output  = segmentsOf(out);
+        auto room    = static_cast<std::size_t>(std::ranges::size(out));
+        auto offsets = ArrayList<std::size_t>(threads + 1);
+        auto bounded = room >= size;
+
+        auto count = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (bounded and t + 1 == threads) {
+                return;
+            }
+            auto selected = 0uz;
+            forEach(input, begin, end, [&](const T& value) { selected += std::invoke(pred, value) ? 1 : 0; });
+            offsets.at(t + 1) = selected;
+        };
+
+        auto combine = [&] {
+            for (auto t = 0uz; t < threads; ++t) {
+                offsets.at(t + 1) += offsets.at(t);
+            }
+        };
+
+        auto write = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (not bounded and offsets.at(threads) > room) {
+                return;
+            }
+            auto cursor  = Cursor{ output, offsets.at(t) };
+            auto written = 0uz;
+            forEach(input, begin, end, [&](const T& value) {
+                if (std::invoke(pred, value)) {
+                    *cursor = value;
+                    cursor.next();
+                    ++written;
+                }
+            });
+            if (bounded and t + 1 == threads) {
+                offsets.at(threads) = offsets.at(t) + written;
+            }
+        };
+
+        twoPass(size, threads, count, combine, write);
+
+        checkRoom(out, offsets.at(threads));
+        return offsets.at(threads);
+    }
+
+    template <typename In, typename Out, typename Eq>
+    std::size_t ParallelAlgorithm::uniqueCopy(In& in, Out& out, Eq& eq, std::size_t threads)
+    {
+        using T = std::ranges::range_value_t<In>;
+
+        auto size = static_cast<std::size_t>(std::ranges::size(in));
+        threads   = threadsFor(size, threads);
+
+        auto input   = segmentsOf(in);
+        auto output  = segmentsOf(out);
+        auto room    = static_cast<std::size_t>(std::ranges::size(out));
+        auto offsets = ArrayList<std::size_t>(threads + 1);
+        auto bounded = room >= size;
+
+        // an element is kept if it differs from the one before, the first element of a chunk looks at the
+        // last element of the previous chunk
+        auto scan = [&](std::size_t begin, std::size_t end, auto&& keep) {
+            const T* prev = begin == 0 ? nullptr : &*Cursor{ input, begin - 1 };
+            forEach(input, begin, end, [&](const T& value) {
+                if (prev == nullptr or not std::invoke(eq, *prev, value)) {
+                    keep(value);
+                }
+                prev = &value;
+            });
+        };
+
+        auto count = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (bounded and t + 1 == threads) {
+                return;
+            }
+            auto kept = 0uz;
+            scan(begin, end, [&](const T&) { ++kept; });
+            offsets.at(t + 1) = kept;
+        };
+
+        auto combine = [&] {
+            for (auto t = 0uz; t < threads; ++t) {
+                offsets.at(t + 1) += offsets.at(t);
+            }
+        };
+
+        auto write = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (not bounded and offsets.at(threads) > room) {
+                return;
+            }
+            auto cursor  = Cursor{ output, offsets.at(t) };
+            auto written = 0uz;
+            scan(begin, end, [&](const T& value) {
+                *cursor = value;
+                cursor.next();
+                ++written;
+            });
+            if (bounded and t + 1 == threads) {
+                offsets.at(threads) = offsets.at(t) + written;
+            }
+        };
+
+        twoPass(size, threads, count, combine, write);
+
+        checkRoom(out, offsets.at(threads));
+        return offsets.at(threads);
+    }
+
+    template <typename In, typename Out, typename Pred>
+    std::size_t ParallelAlgorithm::stablePartition(In& in, Out& out, Pred& pred, std::size_t threads)
+    {
+        using T = std::ranges::range_value_t<In>;
+
+        auto size = static_cast<std::size_t>(std::ranges::size(in));
+        checkRoom(out, size);
+
+        threads = threadsFor(size, threads);
+
+        auto input  = segmentsOf(in);
+        auto output = segmentsOf(out);
+        auto trues  = ArrayList<std::size_t>(threads + 1);
+
+        auto count = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            auto selected = 0uz;
+            forEach(input, begin, end, [&](const T& value) { selected += std::invoke(pred, value) ? 1 : 0; });
+            trues.at(t + 1) = selected;
+        };
+
+        auto combine = [&] {
+            for (auto t = 0uz; t < threads; ++t) {
+                trues.at(t + 1) += trues.at(t);
+            }
+        };
+
+        // the false elements of the chunk follow every true element and the false elements before the chunk
+        auto write = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            auto first  = Cursor{ output, trues.at(t) };
+            auto second = Cursor{ output, trues.at(threads) + begin - trues.at(t) };
+            forEach(input, begin, end, [&](const T& value) {
+                auto& cursor = std::invoke(pred, value) ? first : second;
+                *cursor      = value;
+                cursor.next();
+            });
+        };
+
+        twoPass(size, threads, count, combine, write);
+        return trues.at(threads);
+    }
+
+    template <typename R, typename Pred>
+    std::size_t ParallelAlgorithm::partition(R& range, Pred& pred, std::size_t threads)
+    {
+        struct Run
+        {
+            std::size_t m_begin;
+            std::size_t m_end;
+        };
+
+        auto size = static_cast<std::size_t>(std::ranges::size(range));
+        threads   = threadsFor(size, threads);
+
+        auto elements = segmentsOf(range);
+        auto bounds   = ArrayList<std::size_t>(threads + 1);    // end of the true elements of every chunk
+        auto point    = 0uz;
+
+        // the misplaced elements: false ones before the partition point, true ones after it. each chunk has
+        // at most one run of each
+        auto left  = ArrayList<Run>{};
+        auto right = ArrayList<Run>{};
+        auto swaps = 0uz;
+
+        auto partitionChunk = [&](std::size_t t, std::size_t begin, std::size_t end) {
+            if (auto data = contiguous(elements, begin, end)) {
+                auto test    = [&](const auto& value) { return std::invoke(pred, value); };
+                auto mid     = std::partition(data, data + (end - begin), test);
+                bounds.at(t) = begin + static_cast<std::size_t>(mid - data);
+                return;
+            }
+
+            auto lo = begin;
+            auto hi = end;
+
+            auto front = Cursor{ elements, lo };
+            auto back  = Cursor{ elements, hi };
+            while (true) {
+                while (lo < hi and std::invoke(pred, std::as_const(*front))) {
+                    front.next();
+                    ++lo;
+                }
+                while (lo < hi) {
+                    back.prev();
+                    if (std::invoke(pred, std::as_const(*back))) {
+                        break;
+                    }
+                    --hi;
+                }
+                if (lo >= hi) {
+                    break;
+                }
+                std::ranges::swap(*front, *back);
+                front.next();
+                ++lo;
+                --hi;
+            }
+            bounds.at(t) = lo;
+        };
+
+        auto combine = [&] {
+            for (auto t = 0uz; t < threads; ++t) {
+                point += bounds.at(t) - t * size / threads;
+            }
+            for (auto t = 0uz; t < threads; ++t) {
+                auto begin = t * size / threads;
+                auto end   = (t + 1) * size / threads;
+                auto mid   = bounds.at(t);
+
+                if (auto lo = mid, hi = std::min(end, point); lo < hi) {
+                    left.push_back({ lo, hi });
+                    swaps += hi - lo;
+                }
+                if (auto lo = std::max(begin, point), hi = mid; lo < hi) {
+                    right.push_back({ lo, hi });
+                }
+            }
+        };
+
+        // the k-th misplaced false element is swapped with the k-th misplaced true element
+        auto exchange = [&](std::size_t t, std::size_t, std::size_t) {
+            auto first = t * swaps / threads;
+            auto last  = (t + 1) * swaps / threads;
+            if (first == last) {
+                return;
+            }
+
+            auto seek = [](const ArrayList<Run>& runs, std::size_t k) {
+                auto run = 0uz;
+                while (k >= runs.at(run).m_end - runs.at(run).m_begin) {
+                    k -= runs.at(run).m_end - runs.at(run).m_begin;
+                    ++run;
+                }
+                return std::pair{ run, runs.at(run).m_begin + k };
+            };
+
+            auto [leftRun, leftPos]   = seek(left, first);
+            auto [rightRun, rightPos] = seek(right, first);
+
+            auto falses = Cursor{ elements, leftPos };
+            auto truths = Cursor{ elements, rightPos };
+
+            for (auto k = first; k < last; ++k) {
+                std::ranges::swap(*falses, *truths);
+
+                if (++leftPos == left.at(leftRun).m_end and k + 1 < last) {
+                    leftPos = left.at(++leftRun).m_begin;
+                    falses  = Cursor{ elements, leftPos };
+                } else {
+                    falses.next();
+                }
+                if (++rightPos == right.at(rightRun).m_end and k + 1 < last) {
+                    rightPos = right.at(++rightRun).m_begin;
+                    truths   = Cursor{ elements, rightPos };
+                } else {
+                    truths.next();
+                }
+            }
+        };
+
+        twoPass(size, threads, partitionChunk, combine, exchange);
+        return point;
+    }
+
+    template <typename T>
+    ParallelAlgorithm::Cursor<T>::Cursor(const Segments<T>& segments, std::size_t pos) noexcept
+        : m_segments{ &segments }
+    {
+        // the last segment starting at or before pos, or past the end
+        const auto& starts = segments.m_starts;
+
+        auto found = std::ranges::upper_bound(starts, pos);
+        m_index    = static_cast<std::size_t>(found - starts.begin());
+        m_index    = m_index == 0 ? 0 : m_index - 1;
+
+        auto inside = m_index < segments.m_spans.size()
+                  and pos - starts.at(m_index) < segments.m_spans.at(m_index).size();
+        if (inside) {
+            m_span   = segments.m_spans.at(m_index);
+            m_offset = pos - starts.at(m_index);
+        } else {
+            m_index  = segments.m_spans.size();
+            m_span   = {};
+            m_offset = 0;
+        }
+    }
+
+    template <typename T>
+    void ParallelAlgorithm::Cursor<T>::next() noexcept
+    {
+        if (++m_offset < m_span.size()) {
+            return;
+        }
+        ++m_index;
+        m_offset = 0;
+        m_span   = m_index < m_segments->m_spans.size() ? m_segments->m_spans.at(m_index) : std::span<T>{};
+    }
+
+    template <typename T>
+    void ParallelAlgorithm::Cursor<T>::prev() noexcept
+    {
+        if (m_offset > 0) {
+            --m_offset;
+            return;
+        }
+        m_span   = m_segments->m_spans.at(--m_index);
+        m_offset = m_span.size() - 1;
+    }
+
+    template <typename R>
+    auto ParallelAlgorithm::segmentsOf(R& range) -> Segments<segment_element_t<R>>
+    {
+        auto segments = Segments<segment_element_t<R>>{};
+        auto start    = 0uz;
+
+        for (auto&& segment : dsa::segments(range)) {
+            auto span = std::span{ std::ranges::data(segment), std::ranges::size(segment) };
+            if (span.empty()) {
+                continue;
+            }
+            segments.m_spans.push_back(auto{ span });
+            segments.m_starts.push_back(auto{ start });
+            start += span.size();
+        }
+
+        return segments;
+    }
+
+    template <typename T, typename Fn>
+    void ParallelAlgorithm::forEach(const Segments<T>& segments, std::size_t begin, std::size_t end, Fn&& fn)
+    {
+        if (begin >= end) {
+            return;
+        }
+
+        auto found   = std::ranges::upper_bound(segments.m_starts, begin);
+        auto segment = static_cast<std::size_t>(found - segments.m_starts.begin()) - 1;
+        auto offset  = begin - segments.m_starts.at(segment);
+
+        for (auto left = end - begin; left > 0; ++segment, offset = 0) {
+            auto span  = segments.m_spans.at(segment);
+            auto count = std::min(left, span.size() - offset);
+            auto data  = span.data() + offset;
+
+            for (auto i = 0uz; i < count; ++i) {
+                fn(data[i]);
+            }
+            left -= count;
+        }
+    }
+
+    template <typename T, typename U, typename Fn>
+    void ParallelAlgorithm::forEachPair(
+        const Segments<T>& first,
+        const Segments<U>& second,
+        std::size_t        begin,
+        std::size_t        end,
+        Fn&&               fn
+    )
+    {
+        if (begin >= end) {
+            return;
+        }
+
+        auto locate = [&](const auto& segments) {
+            auto found   = std::ranges::upper_bound(segments.m_starts, begin);
+            auto segment = static_cast<std::size_t>(found - segments.m_starts.begin()) - 1;
+            return std::pair{ segment, begin - segments.m_starts.at(segment) };
+        };
+
+        auto [firstSegment, firstOffset]   = locate(first);
+        auto [secondSegment, secondOffset] = locate(second);
+
+        for (auto left = end - begin; left > 0;) {
+            auto firstSpan  = first.m_spans.at(firstSegment);
+            auto secondSpan = second.m_spans.at(secondSegment);
+
+            auto count = std::min({ left, firstSpan.size() - firstOffset, secondSpan.size() - secondOffset });
+            auto from  = firstSpan.data() + firstOffset;
+            auto to    = secondSpan.data() + secondOffset;
+
+            for (auto i = 0uz; i < count; ++i) {
+                fn(from[i], to[i]);
+            }
+            left -= count;
+
+            if ((firstOffset += count) == firstSpan.size()) {
+                ++firstSegment;
+                firstOffset = 0;
+            }
+            if ((secondOffset += count) == secondSpan.size()) {
+                ++secondSegment;
+                secondOffset = 0;
+            }
+        }
+    }
+
+    template <typename T>
+    T* ParallelAlgorithm::contiguous(const Segments<T>& segments, std::size_t begin, std::size_t end) noexcept
+    {
+        if (begin >= end) {
+            return nullptr;
+        }
+
+        auto found   = std::ranges::upper_bound(segments.m_starts, begin);
+        auto segment = static_cast<std::size_t>(found - segments.m_starts.begin()) - 1;
+        auto offset  = begin - segments.m_starts.at(segment);
+        auto span    = segments.m_spans.at(segment);
+
+        return end - begin <= span.size() - offset ? span.data() + offset : nullptr;
+    }
+
+    inline std::size_t ParallelAlgorithm::threadsFor(std::size_t size, std::size_t threads) noexcept
+    {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return std::max(1uz, std::min(threads, size / s_parallelSize));
+    }
+
+    template <typename First, typename Combine, typename Second>
+    void ParallelAlgorithm::twoPass(
+        std::size_t size,
+        std::size_t threads,
+        First&&     first,
+        Combine&&   combine,
+        Second&&    second
+    )
+    {
+        auto failed = std::atomic<bool>{ false };
+        auto error  = std::exception_ptr{};
+        auto mutex  = std::mutex{};
+
+        // an exception must not leave a thread (terminate) nor skip the barrier (the others would hang)
+        auto guarded = [&](auto&& fn) noexcept {
+#if defined(__cpp_exceptions)
+            try {
+                fn();
+            } catch (...) {
+                auto lock = std::scoped_lock{ mutex };
+                if (not error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+#else
+            fn();
+#endif
+        };
+
+        // the completion step runs after every thread arrived, it sees every failure of the first pass
+        auto complete = [&]() noexcept {
+            if (not failed.load(std::memory_order_relaxed)) {
+                guarded(combine);
+            }
+        };
+
+        auto chunk   = [&](std::size_t t) { return t * size / threads; };
+        auto barrier = std::barrier{ static_cast<std::ptrdiff_t>(threads), complete };
+
+        auto worker = [&](std::size_t t) {
+            guarded([&] { first(t, chunk(t), chunk(t + 1)); });
+            barrier.arrive_and_wait();
+            if (not failed.load(std::memory_order_relaxed)) {
+                guarded([&] { second(t, chunk(t), chunk(t + 1)); });
+            }
+        };
+
+        auto pool = ArrayList<std::jthread>{};
+        pool.reserve(threads - 1);
+        guarded([&] {
+            for (auto t = 1uz; t < threads; ++t) {
+                pool.push_back(std::jthread{ worker, t });
+            }
+        });
+
+        // a thread that could not be started sets failed, the ones never started (worker 0 included) drop out
+        // of the barrier so the started ones are not left waiting for them
+        if (pool.size() + 1 < threads) {
+            for (auto t = pool.size(); t < threads; ++t) {
+                barrier.arrive_and_drop();
+            }
+        } else {
+            worker(0);
+        }
+        pool.clear();
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    template <typename Out>
+    void ParallelAlgorithm::checkRoom(Out& out, std::size_t count)
+    {
+        if (auto room = static_cast<std::size_t>(std::ranges::size(out)); room < count) {
+            fail<std::invalid_argument>("Output is too small: {} < {}", room, count);
+        }
+    }
+}
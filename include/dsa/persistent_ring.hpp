@@ -0,0 +1,535 @@
+#pragma once
+
+// NOTE: PersistentRing is a circular buffer of trivially copyable records stored in a memory-mapped file, the
+//       interface follows CircularBuffer with a fixed capacity. the file starts with a header that holds the
+//       head and tail as monotonic counters (records ever removed and records ever appended), the slot of a
+//       record is its counter modulo the capacity.
+//
+//       every mutation writes the records first and publishes the counters after, so the ring can be
+//       reopened after the process is killed at any point: the records between head and tail are intact.
+//       with ReplaceOnFull the head is advanced before the oldest record is overwritten, a kill in between
+//       loses that record instead of exposing a torn one. the writes land in the page cache, sync() is only
+//       needed to survive a crash of the whole system. the magic of the header is written last when the file
+//       is created, a file without it is zero filled and is created again when it is opened.
+//
+//       POSIX only. a ring is owned by one process at a time and is not thread-safe.
+
+#include "dsa/circular_buffer.hpp"
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dsa
+{
+    template <typename T>
+    concept PersistentRecord = std::is_trivially_copyable_v<T> and not std::is_pointer_v<T>;
+
+    template <PersistentRecord T>
+    class PersistentRing
+    {
+    public:
+        template <bool IsConst>
+        class [[nodiscard]] Iterator;    // random access iterator
+
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        static constexpr std::uint64_t s_magic   = 0x676e'6952'6173'6400;    // "\0dsaRing"
+        static constexpr std::uint32_t s_version = 1;
+
+        // opens the ring in the file at path, creating the file if it doesn't exist. an existing file must
+        // have been created for records of the same size and with the same capacity
+        PersistentRing(
+            const std::filesystem::path& path,
+            std::size_t                  capacity,
+            BufferStorePolicy            store = BufferStorePolicy::ReplaceOnFull
+        );
+
+        ~PersistentRing() { close(); }
+
+        PersistentRing(PersistentRing&& other) noexcept;
+        PersistentRing& operator=(PersistentRing&& other) noexcept;
+
+        PersistentRing(const PersistentRing&)            = delete;
+        PersistentRing& operator=(const PersistentRing&) = delete;
+
+        void swap(PersistentRing& other) noexcept;
+        void clear() noexcept;
+
+        BufferStorePolicy getPolicy() const noexcept { return m_store; }
+        void              setPolicy(BufferStorePolicy store) noexcept { m_store = store; }
+
+        // snake-case to be able to use std functions like std::back_inserter
+        T& push_back(const T& value);
+        T  pop_front();
+        T  pop_back();
+
+        // the same operations returning the error instead of throwing, see dsa/error.hpp. a push fails with
+        // Error::Full on a full ring with ThrowOnFull
+        Result<T&>       try_push_back(const T& value);
+        std::optional<T> try_pop_front();
+
+        // flush the mapping to the file, blocks until the data is written
+        void sync();
+
+        std::size_t size() const noexcept { return static_cast<std::size_t>(tail() - head()); }
+        std::size_t capacity() const noexcept { return m_capacity; }
+
+        auto&& at(this auto&& self, std::size_t pos);
+        auto&& front(this auto&& self) { return self.at(0); };
+        auto&& back(this auto&& self) { return self.at(self.size() - 1); };
+
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.size()) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
+        // the records as at most two contiguous spans in order
+        auto segments(this auto&& self) noexcept;
+
+        auto begin(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, 0uz); }
+        auto end(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, self.size()); }
+
+        Iterator<true> cbegin() const noexcept { return begin(); }
+        Iterator<true> cend() const noexcept { return end(); }
+
+    private:
+        struct Header
+        {
+            std::uint64_t m_magic;
+            std::uint32_t m_version;
+            std::uint32_t m_recordSize;
+            std::uint64_t m_capacity;
+            std::uint64_t m_head;
+            std::uint64_t m_tail;
+        };
+
+        // the records start on their own cache line
+        static constexpr std::size_t s_recordsOffset = std::max({ sizeof(Header), alignof(T), 64uz });
+
+        void*             m_mapping  = nullptr;
+        std::size_t       m_length   = 0;
+        std::size_t       m_capacity = 0;
+        int               m_fd       = -1;
+        BufferStorePolicy m_store    = BufferStorePolicy::ReplaceOnFull;
+
+        Header& header() const noexcept { return *static_cast<Header*>(m_mapping); }
+        T*      records() const noexcept
+        {
+            return reinterpret_cast<T*>(static_cast<std::byte*>(m_mapping) + s_recordsOffset);
+        }
+
+        // the counters are published with release stores so they never get ahead of the records they count
+        std::uint64_t head() const noexcept { return std::atomic_ref{ header().m_head }.load(acquire); }
+        std::uint64_t tail() const noexcept { return std::atomic_ref{ header().m_tail }.load(acquire); }
+        void setHead(std::uint64_t value) noexcept
+        {
+            std::atomic_ref{ header().m_head }.store(value, release);
+        }
+        void setTail(std::uint64_t value) noexcept
+        {
+            std::atomic_ref{ header().m_tail }.store(value, release);
+        }
+
+        // unchecked access, counter is a head or tail counter
+        T& record(std::uint64_t counter) const noexcept { return records()[counter % m_capacity]; }
+
+        void map(std::size_t length);
+        void initialize() noexcept;
+        void close() noexcept;
+
+        static constexpr auto acquire = std::memory_order_acquire;
+        static constexpr auto release = std::memory_order_release;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <PersistentRecord T>
+    PersistentRing<T>::PersistentRing(
+        const std::filesystem::path& path,
+        std::size_t                  capacity,
+        BufferStorePolicy            store
+    )
+        : m_capacity{ capacity }
+        , m_store{ store }
+    {
+        if (capacity == 0) {
+            fail<std::invalid_argument>("PersistentRing capacity must be at least 1");
+        }
+
+        // the file length has to fit both std::size_t for mmap and off_t for ftruncate
+        constexpr auto maxLength = std::min<std::uintmax_t>(
+            std::numeric_limits<std::size_t>::max(), std::numeric_limits<off_t>::max()
+        );
+        if (capacity > (maxLength - s_recordsOffset) / sizeof(T)) {
+            fail<std::length_error>(
+                "PersistentRing capacity is too large: {} records of {} bytes", capacity, sizeof(T)
+            );
+        }
+
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            failSystem(errno, "open {}", path.string());
+        }
+
+        auto length = s_recordsOffset + capacity * sizeof(T);
+
+        struct stat status = {};
+        if (::fstat(m_fd, &status) < 0) {
+            auto error = errno;
+            close();
+            failSystem(error, "fstat {}", path.string());
+        }
+
+        if (status.st_size == 0) {
+            if (::ftruncate(m_fd, static_cast<off_t>(length)) < 0) {
+                auto error = errno;
+                close();
+                failSystem(error, "ftruncate");
+            }
+            map(length);
+            initialize();
+            return;
+        }
+
+        if (static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+            close();
+            fail<std::runtime_error>("{} is not a PersistentRing file", path.string());
+        }
+
+        map(static_cast<std::size_t>(status.st_size));
+
+        const auto& existing = header();
+
+        // a creation that was killed after ftruncate left the file zero filled without the magic, it holds no
+        // records so it is created again if it has the requested length
+        if (existing.m_magic == 0) {
+            if (m_length == length) {
+                initialize();
+                return;
+            }
+            auto fileLength = m_length;    // the length is reset by close()
+            close();
+            fail<std::runtime_error>(
+                "{} is an unfinished PersistentRing file of {} bytes, requested {} bytes",
+                path.string(),
+                fileLength,
+                length
+            );
+        }
+        if (existing.m_magic != s_magic or existing.m_version != s_version) {
+            close();
+            fail<std::runtime_error>("{} is not a PersistentRing file", path.string());
+        }
+        if (existing.m_recordSize != sizeof(T) or existing.m_capacity != capacity or m_length != length) {
+            auto records    = existing.m_capacity;    // the header is unmapped by close()
+            auto recordSize = existing.m_recordSize;
+            close();
+            fail<std::invalid_argument>(
+                "{} holds {} records of {} bytes, requested {} records of {} bytes",
+                path.string(),
+                records,
+                recordSize,
+                capacity,
+                sizeof(T)
+            );
+        }
+        if (tail() < head() or tail() - head() > capacity) {
+            close();
+            fail<std::runtime_error>("{} has corrupt counters", path.string());
+        }
+    }
+
+    template <PersistentRecord T>
+    PersistentRing<T>::PersistentRing(PersistentRing&& other) noexcept
+        : m_mapping{ std::exchange(other.m_mapping, nullptr) }
+        , m_length{ std::exchange(other.m_length, 0) }
+        , m_capacity{ std::exchange(other.m_capacity, 0) }
+        , m_fd{ std::exchange(other.m_fd, -1) }
+        , m_store{ other.m_store }
+    {
+    }
+
+    template <PersistentRecord T>
+    PersistentRing<T>& PersistentRing<T>::operator=(PersistentRing&& other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        close();
+        swap(other);
+        return *this;
+    }
+
+    template <PersistentRecord T>
+    void PersistentRing<T>::swap(PersistentRing& other) noexcept
+    {
+        std::swap(m_mapping, other.m_mapping);
+        std::swap(m_length, other.m_length);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_fd, other.m_fd);
+        std::swap(m_store, other.m_store);
+    }
+
+    template <PersistentRecord T>
+    void PersistentRing<T>::clear() noexcept
+    {
+        setHead(tail());
+    }
+
+    template <PersistentRecord T>
+    T& PersistentRing<T>::push_back(const T& value)
+    {
+        auto first = head();
+        auto last  = tail();
+
+        if (last - first == m_capacity) {
+            if (m_store == BufferStorePolicy::ThrowOnFull) {
+                fail<std::out_of_range>("Buffer is full");
+            }
+            setHead(first + 1);    // drop the oldest record before its slot is overwritten
+
+            // the release store only orders the writes before it, without the fence the compiler may move
+            // the write of the slot above it and a kill in between would leave head on a torn record
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        }
+
+        auto& slot = record(last);
+        slot       = value;
+        setTail(last + 1);
+
+        return slot;
+    }
+
+    template <PersistentRecord T>
+    T PersistentRing<T>::pop_front()
+    {
+        auto first = head();
+        if (first == tail()) {
+            fail<std::out_of_range>("Buffer is empty");
+        }
+
+        auto value = record(first);
+        setHead(first + 1);
+        return value;
+    }
+
+    template <PersistentRecord T>
+    T PersistentRing<T>::pop_back()
+    {
+        auto last = tail();
+        if (head() == last) {
+            fail<std::out_of_range>("Buffer is empty");
+        }
+
+        auto value = record(last - 1);
+        setTail(last - 1);
+        return value;
+    }
+
+    template <PersistentRecord T>
+    void PersistentRing<T>::sync()
+    {
+        if (::msync(m_mapping, m_length, MS_SYNC) < 0) {
+            failSystem(errno, "msync");
+        }
+    }
+
+    template <PersistentRecord T>
+    Result<T&> PersistentRing<T>::try_push_back(const T& value)
+    {
+        if (size() == m_capacity and m_store == BufferStorePolicy::ThrowOnFull) {
+            return std::unexpected{ Error::Full };
+        }
+        return push_back(value);
+    }
+
+    template <PersistentRecord T>
+    std::optional<T> PersistentRing<T>::try_pop_front()
+    {
+        if (size() == 0) {
+            return std::nullopt;
+        }
+        return pop_front();
+    }
+
+    template <PersistentRecord T>
+    auto&& PersistentRing<T>::at(this auto&& self, std::size_t pos)
+    {
+        if (pos >= self.size()) {
+            fail<std::out_of_range>("Index is out of range: index {} on size {}", pos, self.size());
+        }
+
+        auto& value = self.record(self.head() + pos);
+        if constexpr (std::is_const_v<std::remove_reference_t<decltype(self)>>) {
+            return std::as_const(value);
+        } else {
+            return value;
+        }
+    }
+
+    template <PersistentRecord T>
+    auto PersistentRing<T>::segments(this auto&& self) noexcept
+    {
+        constexpr auto isConst = std::is_const_v<std::remove_reference_t<decltype(self)>>;
+
+        using Element = std::conditional_t<isConst, const T, T>;
+        using Segment = std::span<Element>;
+
+        auto* data  = self.records();
+        auto  count = self.size();
+        auto  start = static_cast<std::size_t>(self.head() % self.m_capacity);
+        auto  first = std::min(count, self.m_capacity - start);
+
+        return std::array{ Segment{ data + start, first }, Segment{ data, count - first } };
+    }
+
+    template <PersistentRecord T>
+    void PersistentRing<T>::map(std::size_t length)
+    {
+        m_mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (m_mapping == MAP_FAILED) {
+            auto error = errno;
+            m_mapping  = nullptr;
+            close();
+            failSystem(error, "mmap");
+        }
+        m_length = length;
+    }
+
+    template <PersistentRecord T>
+    void PersistentRing<T>::initialize() noexcept
+    {
+        // the magic is written last, a file without it is an unfinished creation
+        auto& created        = header();
+        created.m_version    = s_version;
+        created.m_recordSize = sizeof(T);
+        created.m_capacity   = m_capacity;
+        setHead(0);
+        setTail(0);
+        std::atomic_ref{ created.m_magic }.store(s_magic, release);
+    }
+
+    template <PersistentRecord T>
+    void PersistentRing<T>::close() noexcept
+    {
+        if (m_mapping != nullptr) {
+            ::munmap(m_mapping, m_length);
+            m_mapping = nullptr;
+            m_length  = 0;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    template <PersistentRecord T>
+    template <bool IsConst>
+    class PersistentRing<T>::Iterator
+    {
+    public:
+        // STL compatibility
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = typename PersistentRing::Element;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        using RingPtr = std::conditional_t<IsConst, const PersistentRing*, PersistentRing*>;
+
+        Iterator() noexcept                      = default;
+        Iterator(const Iterator&)                = default;
+        Iterator& operator=(const Iterator&)     = default;
+        Iterator(Iterator&&) noexcept            = default;
+        Iterator& operator=(Iterator&&) noexcept = default;
+
+        Iterator(RingPtr ring, std::size_t index) noexcept
+            : m_ring{ ring }
+            , m_index{ index }
+        {
+        }
+
+        // for const iterator construction from iterator
+        Iterator(const Iterator<false>& other)
+            requires IsConst
+            : m_ring{ other.m_ring }
+            , m_index{ other.m_index }
+        {
+        }
+
+        auto operator<=>(const Iterator& other) const { return m_index <=> other.m_index; }
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+
+        Iterator& operator+=(difference_type n)
+        {
+            m_index += static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) { return (*this) += -n; }
+
+        Iterator& operator++() { return (*this) += 1; }
+        Iterator& operator--() { return (*this) -= 1; }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --(*this);
+            return copy;
+        }
+
+        reference operator*() const { return m_ring->at(m_index); }
+        pointer   operator->() const { return &m_ring->at(m_index); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        friend Iterator operator+(const Iterator& lhs, difference_type n) { return auto{ lhs } += n; }
+        friend Iterator operator+(difference_type n, const Iterator& rhs) { return rhs + n; }
+        friend Iterator operator-(const Iterator& lhs, difference_type n) { return auto{ lhs } -= n; }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+    private:
+        friend class Iterator<not IsConst>;
+
+        RingPtr     m_ring  = nullptr;
+        std::size_t m_index = 0;
+    };
+}
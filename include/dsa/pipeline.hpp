@@ -0,0 +1,556 @@
+#pragma once
+
+// NOTE: Pipeline runs a chain of stages, each on its own thread, connected by bounded single-producer
+//       single-consumer rings (SpscRing). the calling thread feeds the input into the first ring, every
+//       stage pops a batch from its input ring, applies its function to each item and pushes the results to
+//       the next ring as one batch, and the sink drains the last ring on its own thread. a batch costs one
+//       acquire/release handoff (and a notify) on each ring instead of one per item.
+//
+//       a full ring makes its producer wait (backpressure), an empty one makes its consumer wait; both spin
+//       for a short while first, then block on the index with std::atomic::wait. the end of the input is
+//       passed down the chain by closing the rings in order, the closed flag is the top bit of the tail index
+//       so a blocked consumer wakes up on it. a stage must not throw: an exception on a stage thread
+//       terminates. the input may throw (while iterating it or constructing In): the first ring is closed
+//       anyway, the stages finish what they already got, and run() rethrows once they are joined.
+//
+//       run() returns the counters of every stage: items and batches processed, how many times it waited on
+//       its input (starved) or its output (backpressure), and the depth of its input ring at each pop.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+#include "dsa/raw_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    template <typename T>
+    class SpscRing
+    {
+    public:
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        // the capacity is rounded up to a power of two
+        explicit SpscRing(std::size_t capacity);
+        ~SpscRing();
+
+        SpscRing(SpscRing&&)            = delete;
+        SpscRing& operator=(SpscRing&&) = delete;
+
+        // producer side. try_push moves the values that fit and returns how many, push waits for room until
+        // every value is moved. if a move throws the values moved before it stay in the ring. close() must be
+        // the last call of the producer
+        std::size_t try_push(std::span<T> values);
+        void        push(std::span<T> values);
+        void        close() noexcept;
+
+        // consumer side, append at most max values to out. try_pop returns 0 when the ring is empty, pop
+        // waits for a value and returns 0 only once the ring is closed and drained
+        std::size_t try_pop(ArrayList<T>& out, std::size_t max);
+        std::size_t pop(ArrayList<T>& out, std::size_t max);
+
+        // approximate while both sides run
+        std::size_t size() const noexcept;
+        std::size_t capacity() const noexcept { return m_mask + 1; }
+        bool        isClosed() const noexcept { return m_tail.load(std::memory_order_acquire) & s_closed; }
+
+        // the number of times push and pop had to wait, owned by their side
+        std::uint64_t pushWaits() const noexcept { return m_pushWaits; }
+        std::uint64_t popWaits() const noexcept { return m_popWaits; }
+
+    private:
+        static constexpr std::size_t s_closed = std::size_t{ 1 } << 63;
+        static constexpr int         s_spins  = 128;
+
+        RawBuffer<T> m_buffer;
+        std::size_t  m_mask;
+
+        // each side writes its own line: the index it publishes, its cached copy of the other index and its
+        // counter
+        alignas(64) std::atomic<std::size_t> m_head       = 0;
+        std::size_t                          m_cachedTail = 0;
+        std::uint64_t                        m_popWaits   = 0;
+
+        alignas(64) std::atomic<std::size_t> m_tail       = 0;
+        std::size_t                          m_cachedHead = 0;
+        std::uint64_t                        m_pushWaits  = 0;
+
+        // spin, then block until the index is no longer old
+        static void waitChange(const std::atomic<std::size_t>& index, std::size_t old, std::uint64_t& waits);
+    };
+
+    struct PipelineConfig
+    {
+        std::size_t m_capacity = 1024;    // of every ring
+        std::size_t m_batch    = 64;      // the most items a stage pops and pushes at once
+    };
+
+    struct StageStats
+    {
+        std::string              m_name;
+        std::uint64_t            m_items       = 0;
+        std::uint64_t            m_batches     = 0;
+        std::uint64_t            m_inputWaits  = 0;    // starved: the input ring was empty
+        std::uint64_t            m_outputWaits = 0;    // backpressure: the output ring was full
+        std::size_t              m_maxDepth    = 0;    // of the input ring, sampled at each pop
+        std::uint64_t            m_sumDepth    = 0;
+        std::chrono::nanoseconds m_elapsed     = {};
+
+        double meanDepth() const noexcept;
+        double throughput() const noexcept;    // items per second
+    };
+
+    struct PipelineStats
+    {
+        ArrayList<StageStats>    m_stages;     // "source", the stages in order, then "sink"
+        std::chrono::nanoseconds m_elapsed;
+    };
+
+    template <typename Fn>
+    struct PipelineStage
+    {
+        std::string m_name;
+        Fn          m_fn;
+    };
+
+    // the type an item has after going through the first N stages
+    template <std::size_t N, typename In, typename... Stages>
+    struct StageOutput
+    {
+        using Type = In;
+    };
+
+    template <std::size_t N, typename In, typename Fn, typename... Stages>
+        requires (N > 0)
+    struct StageOutput<N, In, PipelineStage<Fn>, Stages...>
+    {
+        using Type = typename StageOutput<N - 1, std::invoke_result_t<Fn&, In&&>, Stages...>::Type;
+    };
+
+    template <typename In, typename... Stages>
+    class Pipeline
+    {
+    public:
+        using Input  = In;
+        using Output = typename StageOutput<sizeof...(Stages), In, Stages...>::Type;
+
+        explicit Pipeline(PipelineConfig config = {})
+            requires (sizeof...(Stages) == 0);
+
+        Pipeline(PipelineConfig config, std::tuple<Stages...>&& stages);
+
+        // add a stage running fn(Output&&) on its own thread
+        template <typename Fn>
+            requires std::invocable<Fn&, Output&&>
+                 and std::movable<std::invoke_result_t<Fn&, Output&&>>
+        auto stage(std::string name, Fn fn) && -> Pipeline<In, Stages..., PipelineStage<Fn>>;
+
+        // feed every item of input through the stages, sink(Output&&) is called on its own thread. returns
+        // once the sink has taken the last item
+        template <std::ranges::input_range R, typename Sink>
+            requires std::constructible_from<In, std::ranges::range_reference_t<R>>
+                 and std::invocable<Sink&, Output&&>
+        PipelineStats run(R&& input, Sink&& sink);
+
+        const PipelineConfig& config() const noexcept { return m_config; }
+
+    private:
+        static constexpr std::size_t s_stages = sizeof...(Stages);
+
+        // the type of the items in the ring before the stage I, the ring s_stages feeds the sink
+        template <std::size_t I>
+        using Link = typename StageOutput<I, In, Stages...>::Type;
+
+        PipelineConfig        m_config;
+        std::tuple<Stages...> m_stages;
+
+        template <typename From, typename To, typename Fn>
+        static void runStage(
+            SpscRing<From>&       input,
+            SpscRing<To>&         output,
+            Fn&                   fn,
+            const PipelineConfig& config,
+            StageStats&           stats
+        );
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <typename T>
+    SpscRing<T>::SpscRing(std::size_t capacity)
+        : m_buffer{ std::bit_ceil(capacity) }
+        , m_mask{ std::bit_ceil(capacity) - 1 }
+    {
+        if (capacity == 0 or capacity > s_closed / 2) {
+            fail<std::invalid_argument>("Invalid ring capacity: {}", capacity);
+        }
+    }
+
+    template <typename T>
+    SpscRing<T>::~SpscRing()
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed) & ~s_closed;
+        for (auto i = m_head.load(std::memory_order_relaxed); i != tail; ++i) {
+            m_buffer.destroy(i & m_mask);
+        }
+    }
+
+    template <typename T>
+    std::size_t SpscRing<T>::try_push(std::span<T> values)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        assert(not(tail & s_closed) and "push after close");
+
+        // the cached head is refreshed only when it does not leave enough room
+        if (capacity() - (tail - m_cachedHead) < values.size()) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+        }
+
+        auto count  = std::min(values.size(), capacity() - (tail - m_cachedHead));
+        auto pushed = 0uz;
+
+        auto move = [&] {
+            for (; pushed < count; ++pushed) {
+                m_buffer.construct((tail + pushed) & m_mask, std::move(values[pushed]));
+            }
+        };
+
+        auto publish = [&] {
+            if (pushed > 0) {
+                m_tail.store(tail + pushed, std::memory_order_release);
+                m_tail.notify_one();
+            }
+        };
+
+        // the slots constructed so far are published when a move throws, otherwise the next push would
+        // construct over them
+#if defined(__cpp_exceptions)
+        try {
+            move();
+        } catch (...) {
+            publish();
+            throw;
+        }
+#else
+        move();
+#endif
+        publish();
+
+        return count;
+    }
+
+    template <typename T>
+    void SpscRing<T>::push(std::span<T> values)
+    {
+        while (true) {
+            values = values.subspan(try_push(values));
+            if (values.empty()) {
+                return;
+            }
+            // try_push has just loaded the head: full
+            waitChange(m_head, m_cachedHead, m_pushWaits);
+        }
+    }
+
+    template <typename T>
+    void SpscRing<T>::close() noexcept
+    {
+        m_tail.fetch_or(s_closed, std::memory_order_release);
+        m_tail.notify_one();
+    }
+
+    template <typename T>
+    std::size_t SpscRing<T>::try_pop(ArrayList<T>& out, std::size_t max)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+
+        // the cached tail is refreshed only when it does not have enough values
+        if ((m_cachedTail & ~s_closed) - head < max) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        }
+
+        auto count  = std::min((m_cachedTail & ~s_closed) - head, max);
+        auto popped = 0uz;
+
+        auto move = [&] {
+            for (; popped < count; ++popped) {
+                out.push_back(std::move(m_buffer.at((head + popped) & m_mask)));
+                m_buffer.destroy((head + popped) & m_mask);
+            }
+        };
+
+        auto publish = [&] {
+            if (popped > 0) {
+                m_head.store(head + popped, std::memory_order_release);
+                m_head.notify_one();
+            }
+        };
+
+        // the slots destroyed so far are published when push_back throws, the slot it was moving from is
+        // left in the ring, so no slot is destroyed twice
+#if defined(__cpp_exceptions)
+        try {
+            move();
+        } catch (...) {
+            publish();
+            throw;
+        }
+#else
+        move();
+#endif
+        publish();
+
+        return count;
+    }
+
+    template <typename T>
+    std::size_t SpscRing<T>::pop(ArrayList<T>& out, std::size_t max)
+    {
+        assert(max > 0 and "pop of zero values would never return");
+
+        while (true) {
+            if (auto count = try_pop(out, max); count > 0) {
+                return count;
+            }
+            // try_pop has just loaded the tail: closed and empty
+            if (m_cachedTail & s_closed) {
+                return 0;
+            }
+            waitChange(m_tail, m_cachedTail, m_popWaits);
+        }
+    }
+
+    template <typename T>
+    std::size_t SpscRing<T>::size() const noexcept
+    {
+        auto head = m_head.load(std::memory_order_acquire);
+        auto tail = m_tail.load(std::memory_order_acquire) & ~s_closed;
+        return tail - head;
+    }
+
+    template <typename T>
+    void SpscRing<T>::waitChange(const std::atomic<std::size_t>& index, std::size_t old, std::uint64_t& waits)
+    {
+        ++waits;
+        for (auto i = 0; i < s_spins; ++i) {
+            if (index.load(std::memory_order_acquire) != old) {
+                return;
+            }
+        }
+        index.wait(old, std::memory_order_acquire);
+    }
+
+    inline double StageStats::meanDepth() const noexcept
+    {
+        return m_batches == 0 ? 0.0 : static_cast<double>(m_sumDepth) / static_cast<double>(m_batches);
+    }
+
+    inline double StageStats::throughput() const noexcept
+    {
+        auto seconds = std::chrono::duration<double>{ m_elapsed }.count();
+        return seconds == 0 ? 0.0 : static_cast<double>(m_items) / seconds;
+    }
+
+    template <typename In, typename... Stages>
+    Pipeline<In, Stages...>::Pipeline(PipelineConfig config)
+        requires (sizeof...(Stages) == 0)
+        : Pipeline{ config, std::tuple<>{} }
+    {
+    }
+
+    template <typename In, typename... Stages>
+    Pipeline<In, Stages...>::Pipeline(PipelineConfig config, std::tuple<Stages...>&& stages)
+        : m_config{ config }
+        , m_stages{ std::move(stages) }
+    {
+        if (config.m_capacity == 0 or config.m_batch == 0) {
+            fail<std::invalid_argument>(
+                "Invalid pipeline config: capacity {}, batch {}", config.m_capacity, config.m_batch
+            );
+        }
+    }
+
+    template <typename In, typename... Stages>
+    template <typename Fn>
+        requires std::invocable<Fn&, typename Pipeline<In, Stages...>::Output&&>
+             and std::movable<std::invoke_result_t<Fn&, typename Pipeline<In, Stages...>::Output&&>>
+    auto Pipeline<In, Stages...>::stage(std::string name, Fn fn) &&
+        -> Pipeline<In, Stages..., PipelineStage<Fn>>
+    {
+        auto stages = std::tuple_cat(
+            std::move(m_stages), std::tuple{ PipelineStage<Fn>{ std::move(name), std::move(fn) } }
+        );
+        return { m_config, std::move(stages) };
+    }
+
+    template <typename In, typename... Stages>
+    template <std::ranges::input_range R, typename Sink>
+        requires std::constructible_from<In, std::ranges::range_reference_t<R>>
+             and std::invocable<Sink&, typename Pipeline<In, Stages...>::Output&&>
+    PipelineStats Pipeline<In, Stages...>::run(R&& input, Sink&& sink)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        auto rings = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::tuple{ std::make_unique<SpscRing<Link<I>>>(m_config.m_capacity)... };
+        }(std::make_index_sequence<s_stages + 1>{});
+
+        auto stats = ArrayList<StageStats>{};
+        stats.reserve(s_stages + 2);
+        stats.push_back(StageStats{ .m_name = "source" });
+        std::apply(
+            [&](auto&... stage) { (stats.push_back(StageStats{ .m_name = stage.m_name }), ...); }, m_stages
+        );
+        stats.push_back(StageStats{ .m_name = "sink" });
+
+        {
+            auto threads = ArrayList<std::jthread>{};
+            threads.reserve(s_stages + 1);
+
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (threads.push_back(std::jthread{ [&] {
+                     runStage(
+                         *std::get<I>(rings),
+                         *std::get<I + 1>(rings),
+                         std::get<I>(m_stages).m_fn,
+                         m_config,
+                         stats.at(I + 1)
+                     );
+                 } }),
+                 ...);
+            }(std::make_index_sequence<s_stages>{});
+
+            // the sink is a stage whose output is a call
+            threads.push_back(std::jthread{ [&] {
+                auto& ring  = *std::get<s_stages>(rings);
+                auto& local = stats.back();
+                auto  begin = std::chrono::steady_clock::now();
+                auto  items = ArrayList<Output>{};
+                items.reserve(m_config.m_batch);
+
+                while (true) {
+                    auto depth = ring.size();
+                    if (ring.pop(items, m_config.m_batch) == 0) {
+                        break;
+                    }
+                    for (auto& item : items) {
+                        std::invoke(sink, std::move(item));
+                    }
+                    local.m_items    += items.size();
+                    local.m_batches  += 1;
+                    local.m_sumDepth += depth;
+                    local.m_maxDepth  = std::max(local.m_maxDepth, depth);
+                    items.clear();
+                }
+
+                local.m_inputWaits = ring.popWaits();
+                local.m_elapsed    = std::chrono::steady_clock::now() - begin;
+            } });
+
+            // the calling thread is the source
+            auto& first  = *std::get<0>(rings);
+            auto& source = stats.at(0);
+            auto  batch  = ArrayList<In>{};
+            batch.reserve(m_config.m_batch);
+
+            auto feed = [&] {
+                for (auto&& item : input) {
+                    batch.push_back(In(std::forward<decltype(item)>(item)));
+                    if (batch.size() == m_config.m_batch) {
+                        first.push(std::span{ batch });
+                        source.m_items   += batch.size();
+                        source.m_batches += 1;
+                        batch.clear();
+                    }
+                }
+                if (batch.size() > 0) {
+                    first.push(std::span{ batch });
+                    source.m_items   += batch.size();
+                    source.m_batches += 1;
+                }
+            };
+
+            // the ring is closed on every exit, otherwise the stages wait forever and the joins deadlock
+#if defined(__cpp_exceptions)
+            try {
+                feed();
+            } catch (...) {
+                first.close();
+                throw;
+            }
+#else
+            feed();
+#endif
+            first.close();
+
+            source.m_outputWaits = first.pushWaits();
+            source.m_elapsed     = std::chrono::steady_clock::now() - start;
+        }
+
+        return { std::move(stats), std::chrono::steady_clock::now() - start };
+    }
+
+    template <typename In, typename... Stages>
+    template <typename From, typename To, typename Fn>
+    void Pipeline<In, Stages...>::runStage(
+        SpscRing<From>&       input,
+        SpscRing<To>&         output,
+        Fn&                   fn,
+        const PipelineConfig& config,
+        StageStats&           stats
+    )
+    {
+        auto begin   = std::chrono::steady_clock::now();
+        auto inputs  = ArrayList<From>{};
+        auto outputs = ArrayList<To>{};
+        inputs.reserve(config.m_batch);
+        outputs.reserve(config.m_batch);
+
+        while (true) {
+            auto depth = input.size();
+            if (input.pop(inputs, config.m_batch) == 0) {
+                break;
+            }
+
+            for (auto& item : inputs) {
+                outputs.push_back(std::invoke(fn, std::move(item)));
+            }
+            output.push(std::span{ outputs });
+
+            stats.m_items    += inputs.size();
+            stats.m_batches  += 1;
+            stats.m_sumDepth += depth;
+            stats.m_maxDepth  = std::max(stats.m_maxDepth, depth);
+
+            inputs.clear();
+            outputs.clear();
+        }
+        output.close();
+
+        stats.m_inputWaits  = input.popWaits();
+        stats.m_outputWaits = output.pushWaits();
+        stats.m_elapsed     = std::chrono::steady_clock::now() - begin;
+    }
+}
@@ -3,6 +3,7 @@
 // NOTE: Queue implementation based on reference 1
 
 #include <concepts>
+#include <optional>
 #include <utility>
 
 #include "common.hpp"
@@ -64,6 +65,19 @@ namespace dsa
             }
         }
 
+        // push each element in order, the first element of the range is popped first
+        template <ContainerCompatibleRange<T> R>
+        void push_range(R&& range)
+        {
+            if constexpr (HasPushBackAndPopFront<C, T> and requires { m_container.append_range(range); }) {
+                m_container.append_range(std::forward<R>(range));
+            } else {
+                for (auto&& value : range) {
+                    push(T(std::forward<decltype(value)>(value)));
+                }
+            }
+        }
+
         T pop()
         {
             if constexpr (HasPushBackAndPopFront<C, T>) {
@@ -73,6 +87,15 @@ namespace dsa
             }
         }
 
+        // pop() returning std::nullopt when empty instead of throwing, see dsa/error.hpp
+        std::optional<T> try_pop()
+        {
+            if (empty()) {
+                return std::nullopt;
+            }
+            return pop();
+        }
+
     private:
         Container m_container;
     };
@@ -0,0 +1,475 @@
+#pragma once
+
+// NOTE: LSD radix sort. the keys of all digits are counted in a single pass over the input, digits that are
+//       the same for every element are skipped, then each remaining digit scatters the elements between the
+//       range and a scratch RawBuffer. the sort is stable.
+//
+//       keys are mapped to unsigned integers that preserve the order: the sign bit of signed integers is
+//       flipped, negative floats have all their bits flipped and positive floats only their sign bit. thus
+//       -0.0 sorts before +0.0 and NaNs sort at the ends depending on their sign bit.
+//
+//       the key function must be noexcept, like the moves of the elements: it is called again while the
+//       elements are split between the range and the scratch, where a throw could not put them back.
+
+#include "dsa/array_list.hpp"
+#include "dsa/raw_buffer.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    template <typename K>
+    concept RadixKey = (std::integral<K> and not std::same_as<K, bool>)
+                    or (std::floating_point<K> and (sizeof(K) == 4 or sizeof(K) == 8));
+
+    // unsigned integer with the same order as the key
+    template <RadixKey K>
+    constexpr auto toRadixKey(K key) noexcept
+    {
+        if constexpr (std::unsigned_integral<K>) {
+            return key;
+        } else if constexpr (std::signed_integral<K>) {
+            using U = std::make_unsigned_t<K>;
+            return static_cast<U>(static_cast<U>(key) ^ (U{ 1 } << (sizeof(K) * CHAR_BIT - 1)));
+        } else {
+            using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+
+            auto bits = std::bit_cast<U>(key);
+            auto sign = U{ 1 } << (sizeof(K) * CHAR_BIT - 1);
+            return static_cast<U>((bits & sign) ? ~bits : (bits | sign));
+        }
+    }
+
+    template <typename R, typename KeyFn>
+    concept RadixSortable = std::ranges::random_access_range<R>
+                        and std::ranges::sized_range<R>
+                        and std::ranges::output_range<R, std::ranges::range_value_t<R>>
+                        and std::is_nothrow_move_constructible_v<std::ranges::range_value_t<R>>
+                        and std::is_nothrow_move_assignable_v<std::ranges::range_value_t<R>>
+                        and std::is_nothrow_invocable_v<KeyFn&, const std::ranges::range_value_t<R>&>
+                        and RadixKey<std::remove_cvref_t<
+                                std::invoke_result_t<KeyFn&, const std::ranges::range_value_t<R>&>>>;
+
+    // digits are 8, 11, or 16 bits wide. wider digits mean fewer passes but bigger histograms, 11-bit digits
+    // sort 32-bit keys in 3 passes with histograms that still fit in L1.
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    class RadixSort
+    {
+    public:
+        static constexpr std::size_t s_digitBits = DigitBits;
+        static constexpr std::size_t s_buckets   = 1uz << DigitBits;
+
+        // below this size a comparison sort on the mapped keys is faster than touching the histograms
+        static constexpr std::size_t s_smallSize = 256;
+
+        // below this size the parallel variant falls back to the sequential one
+        static constexpr std::size_t s_parallelSize = 1uz << 16;
+
+        // scratch is grown to the size of the range if it is smaller, so it can be reused between calls
+        template <typename R, typename KeyFn>
+            requires RadixSortable<R, KeyFn>
+        static void sort(R&& range, KeyFn key, RawBuffer<std::ranges::range_value_t<R>>& scratch);
+
+        // each thread counts and scatters its own chunk, the chunks' histograms are combined into disjoint
+        // output offsets so no locking is needed within a pass. threads = 0 uses all hardware threads.
+        template <typename R, typename KeyFn>
+            requires RadixSortable<R, KeyFn>
+        static void sortParallel(
+            R&&                                        range,
+            KeyFn                                      key,
+            RawBuffer<std::ranges::range_value_t<R>>& scratch,
+            std::size_t                                threads
+        );
+
+    private:
+        template <typename KeyFn, typename T>
+        using Key = decltype(toRadixKey(std::invoke(std::declval<KeyFn&>(), std::declval<const T&>())));
+
+        template <typename KeyFn, typename T>
+        static constexpr std::size_t s_digits = (sizeof(Key<KeyFn, T>) * CHAR_BIT + DigitBits - 1)
+                                              / DigitBits;
+
+        static std::size_t digitOf(std::unsigned_integral auto key, std::size_t digit) noexcept
+        {
+            return static_cast<std::size_t>(key >> (digit * DigitBits)) & (s_buckets - 1);
+        }
+
+        // count every digit of the elements in [first, last) into counts[digit * s_buckets + bucket]
+        template <typename It, typename KeyFn>
+        static void countAll(It first, It last, KeyFn& key, std::size_t* counts);
+
+        // digits whose histogram has every element in a single bucket don't change the order
+        static std::size_t activeDigits(
+            const std::size_t* counts,
+            std::size_t        digits,
+            std::size_t        size,
+            std::size_t*       active
+        ) noexcept;
+
+        // move [begin, end) of the range into the scratch, or back, at the positions given by the offsets
+        template <typename It, typename KeyFn, typename T>
+        static void scatterToScratch(
+            It            first,
+            std::size_t   begin,
+            std::size_t   end,
+            KeyFn&        key,
+            std::size_t   digit,
+            std::size_t*  offsets,
+            RawBuffer<T>& scratch
+        ) noexcept;
+
+        template <typename It, typename KeyFn, typename T>
+        static void scatterFromScratch(
+            It            first,
+            std::size_t   begin,
+            std::size_t   end,
+            KeyFn&        key,
+            std::size_t   digit,
+            std::size_t*  offsets,
+            RawBuffer<T>& scratch
+        ) noexcept;
+
+        template <typename It, typename T>
+        static void moveBack(It first, std::size_t begin, std::size_t end, RawBuffer<T>& scratch) noexcept;
+
+        template <typename R, typename KeyFn>
+        static void smallSort(R&& range, KeyFn& key);
+    };
+
+    template <std::size_t DigitBits = 8, typename R, typename KeyFn = std::identity>
+        requires RadixSortable<R, KeyFn>
+    void radix_sort(R&& range, KeyFn key = {})
+    {
+        auto scratch = RawBuffer<std::ranges::range_value_t<R>>{};
+        RadixSort<DigitBits>::sort(std::forward<R>(range), std::move(key), scratch);
+    }
+
+    template <std::size_t DigitBits = 8, typename R, typename KeyFn>
+        requires RadixSortable<R, KeyFn>
+    void radix_sort(R&& range, KeyFn key, RawBuffer<std::ranges::range_value_t<R>>& scratch)
+    {
+        RadixSort<DigitBits>::sort(std::forward<R>(range), std::move(key), scratch);
+    }
+
+    template <std::size_t DigitBits = 8, typename R, typename KeyFn = std::identity>
+        requires RadixSortable<R, KeyFn>
+    void parallel_radix_sort(R&& range, KeyFn key = {}, std::size_t threads = 0)
+    {
+        auto scratch = RawBuffer<std::ranges::range_value_t<R>>{};
+        RadixSort<DigitBits>::sortParallel(std::forward<R>(range), std::move(key), scratch, threads);
+    }
+
+    template <std::size_t DigitBits = 8, typename R, typename KeyFn>
+        requires RadixSortable<R, KeyFn>
+    void parallel_radix_sort(
+        R&&                                        range,
+        KeyFn                                      key,
+        RawBuffer<std::ranges::range_value_t<R>>& scratch,
+        std::size_t                                threads = 0
+    )
+    {
+        RadixSort<DigitBits>::sortParallel(std::forward<R>(range), std::move(key), scratch, threads);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename R, typename KeyFn>
+        requires RadixSortable<R, KeyFn>
+    void RadixSort<DigitBits>::sort(R&& range, KeyFn key, RawBuffer<std::ranges::range_value_t<R>>& scratch)
+    {
+        using T = std::ranges::range_value_t<R>;
+
+        constexpr auto digits = s_digits<KeyFn, T>;
+
+        auto size = static_cast<std::size_t>(std::ranges::size(range));
+        if (size <= s_smallSize) {
+            smallSort(range, key);
+            return;
+        }
+
+        if (scratch.size() < size) {
+            scratch = RawBuffer<T>{ size };
+        }
+
+        auto first  = std::ranges::begin(range);
+        auto counts = ArrayList<std::size_t>(digits * s_buckets);
+        countAll(first, first + static_cast<std::ptrdiff_t>(size), key, counts.data());
+
+        std::size_t active[digits];
+        auto        passes    = activeDigits(counts.data(), digits, size, active);
+        auto        inScratch = false;
+
+        for (auto pass = 0uz; pass < passes; ++pass) {
+            auto  digit   = active[pass];
+            auto* offsets = counts.data() + digit * s_buckets;
+
+            for (auto bucket = 0uz, sum = 0uz; bucket < s_buckets; ++bucket) {
+                sum = std::exchange(offsets[bucket], sum) + sum;
+            }
+
+            if (inScratch) {
+                scatterFromScratch(first, 0, size, key, digit, offsets, scratch);
+            } else {
+                scatterToScratch(first, 0, size, key, digit, offsets, scratch);
+            }
+            inScratch = not inScratch;
+        }
+
+        if (inScratch) {
+            moveBack(first, 0, size, scratch);
+        }
+    }
+
+    // the threads run the passes in lockstep: count -> barrier (offsets) -> scatter -> barrier (swap). the
+    // barrier completion step runs on a single thread while the others wait.
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename R, typename KeyFn>
+        requires RadixSortable<R, KeyFn>
+    void RadixSort<DigitBits>::sortParallel(
+        R&&                                        range,
+        KeyFn                                      key,
+        RawBuffer<std::ranges::range_value_t<R>>& scratch,
+        std::size_t                                threads
+    )
+    {
+        using T = std::ranges::range_value_t<R>;
+
+        constexpr auto digits = s_digits<KeyFn, T>;
+
+        auto size = static_cast<std::size_t>(std::ranges::size(range));
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, size / s_parallelSize);
+
+        if (threads <= 1) {
+            sort(range, std::move(key), scratch);
+            return;
+        }
+
+        if (scratch.size() < size) {
+            scratch = RawBuffer<T>{ size };
+        }
+
+        auto first = std::ranges::begin(range);
+        auto chunk = [&](std::size_t t) { return t * size / threads; };
+
+        // per-thread histograms of every digit, laid out as [thread][digit][bucket]
+        auto counts = ArrayList<std::size_t>(threads * digits * s_buckets);
+        auto count  = [&](std::size_t t, std::size_t d) {
+            return counts.data() + (t * digits + d) * s_buckets;
+        };
+
+        std::size_t active[digits];
+        auto        passes    = 0uz;
+        auto        pass      = 0uz;
+        auto        inScratch = false;
+
+        // the first barrier sums the histograms to find the constant digits, the per-thread histograms of the
+        // first active digit are still valid since nothing has moved yet. the sums are allocated up front,
+        // a completion step must not throw
+        auto total      = ArrayList<std::size_t>(digits * s_buckets);
+        auto findActive = [&]() noexcept {
+            for (auto t = 0uz; t < threads; ++t) {
+                for (auto i = 0uz; i < digits * s_buckets; ++i) {
+                    total.data()[i] += count(t, 0)[i];
+                }
+            }
+            passes = activeDigits(total.data(), digits, size, active);
+        };
+
+        // output offset of (thread, bucket) is the number of elements in smaller buckets plus the elements
+        // of the same bucket in the previous chunks, this keeps the sort stable
+        auto computeOffsets = [&]() noexcept {
+            auto digit = active[pass];
+            for (auto bucket = 0uz, sum = 0uz; bucket < s_buckets; ++bucket) {
+                for (auto t = 0uz; t < threads; ++t) {
+                    sum = std::exchange(count(t, digit)[bucket], sum) + sum;
+                }
+            }
+        };
+
+        auto nextPass = [&]() noexcept {
+            inScratch = not inScratch;
+            ++pass;
+        };
+
+        auto setup   = std::barrier{ static_cast<std::ptrdiff_t>(threads), findActive };
+        auto offsets = std::barrier{ static_cast<std::ptrdiff_t>(threads), computeOffsets };
+        auto swap    = std::barrier{ static_cast<std::ptrdiff_t>(threads), nextPass };
+
+        auto worker = [&](std::size_t t) {
+            auto begin = chunk(t);
+            auto end   = chunk(t + 1);
+
+            auto from = first + static_cast<std::ptrdiff_t>(begin);
+            auto to   = first + static_cast<std::ptrdiff_t>(end);
+
+            countAll(from, to, key, count(t, 0));
+            setup.arrive_and_wait();
+
+            for (auto p = 0uz; p < passes; ++p) {
+                auto  digit = active[p];
+                auto* row   = count(t, digit);
+
+                if (p > 0) {
+                    std::fill_n(row, s_buckets, 0uz);
+                    for (auto i = begin; i < end; ++i) {
+                        auto& value = inScratch ? scratch.at(i) : first[static_cast<std::ptrdiff_t>(i)];
+                        ++row[digitOf(toRadixKey(std::invoke(key, std::as_const(value))), digit)];
+                    }
+                }
+                offsets.arrive_and_wait();
+
+                if (inScratch) {
+                    scatterFromScratch(first, begin, end, key, digit, row, scratch);
+                } else {
+                    scatterToScratch(first, begin, end, key, digit, row, scratch);
+                }
+                swap.arrive_and_wait();
+            }
+
+            if (inScratch) {
+                moveBack(first, begin, end, scratch);
+            }
+        };
+
+        {
+            auto pool = ArrayList<std::jthread>{};
+            pool.reserve(threads - 1);
+            for (auto t = 1uz; t < threads; ++t) {
+                pool.push_back(std::jthread{ worker, t });
+            }
+            worker(0);
+        }
+    }
+
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename It, typename KeyFn>
+    void RadixSort<DigitBits>::countAll(It first, It last, KeyFn& key, std::size_t* counts)
+    {
+        using T = std::iter_value_t<It>;
+
+        constexpr auto digits = s_digits<KeyFn, T>;
+
+        for (; first != last; ++first) {
+            auto radix = toRadixKey(std::invoke(key, std::as_const(*first)));
+            for (auto digit = 0uz; digit < digits; ++digit) {
+                ++counts[digit * s_buckets + digitOf(radix, digit)];
+            }
+        }
+    }
+
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    std::size_t RadixSort<DigitBits>::activeDigits(
+        const std::size_t* counts,
+        std::size_t        digits,
+        std::size_t        size,
+        std::size_t*       active
+    ) noexcept
+    {
+        auto passes = 0uz;
+        for (auto digit = 0uz; digit < digits; ++digit) {
+            auto row = std::span{ counts + digit * s_buckets, s_buckets };
+            if (std::ranges::find(row, size) == row.end()) {
+                active[passes++] = digit;
+            }
+        }
+        return passes;
+    }
+
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename It, typename KeyFn, typename T>
+    void RadixSort<DigitBits>::scatterToScratch(
+        It            first,
+        std::size_t   begin,
+        std::size_t   end,
+        KeyFn&        key,
+        std::size_t   digit,
+        std::size_t*  offsets,
+        RawBuffer<T>& scratch
+    ) noexcept
+    {
+        for (auto i = begin; i < end; ++i) {
+            auto& value  = first[static_cast<std::ptrdiff_t>(i)];
+            auto  bucket = digitOf(toRadixKey(std::invoke(key, std::as_const(value))), digit);
+            scratch.construct(offsets[bucket]++, std::move(value));
+        }
+    }
+
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename It, typename KeyFn, typename T>
+    void RadixSort<DigitBits>::scatterFromScratch(
+        It            first,
+        std::size_t   begin,
+        std::size_t   end,
+        KeyFn&        key,
+        std::size_t   digit,
+        std::size_t*  offsets,
+        RawBuffer<T>& scratch
+    ) noexcept
+    {
+        for (auto i = begin; i < end; ++i) {
+            auto& value  = scratch.at(i);
+            auto  bucket = digitOf(toRadixKey(std::invoke(key, std::as_const(value))), digit);
+
+            first[static_cast<std::ptrdiff_t>(offsets[bucket]++)] = std::move(value);
+            scratch.destroy(i);
+        }
+    }
+
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename It, typename T>
+    void RadixSort<DigitBits>::moveBack(
+        It            first,
+        std::size_t   begin,
+        std::size_t   end,
+        RawBuffer<T>& scratch
+    ) noexcept
+    {
+        for (auto i = begin; i < end; ++i) {
+            first[static_cast<std::ptrdiff_t>(i)] = std::move(scratch.at(i));
+            scratch.destroy(i);
+        }
+    }
+
+    template <std::size_t DigitBits>
+        requires(DigitBits == 8 or DigitBits == 11 or DigitBits == 16)
+    template <typename R, typename KeyFn>
+    void RadixSort<DigitBits>::smallSort(R&& range, KeyFn& key)
+    {
+        using T = std::ranges::range_value_t<R>;
+
+        std::ignore = std::ranges::stable_sort(range, std::less{}, [&](const T& value) {
+            return toRadixKey(std::invoke(key, value));
+        });
+    }
+}
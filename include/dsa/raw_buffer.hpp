@@ -5,7 +5,11 @@
 #include <cassert>
 #include <cstddef>
 #include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #ifndef DSA_RAW_BUFFER_DEBUG
@@ -39,7 +43,15 @@ namespace dsa
 
         void destroy(std::size_t offset) noexcept;
 
-        auto*  data(this auto&& self) noexcept { return &self.at(0); }
+        // copy construct [offset, offset + count) from [first, first + count) that must not overlap with this
+        // buffer. a single memcpy for trivially copyable T
+        void constructRange(std::size_t offset, const T* first, std::size_t count)
+            requires std::copy_constructible<T>;
+
+        // destroy [offset, offset + count), only the debug flags are touched for trivially destructible T
+        void destroyRange(std::size_t offset, std::size_t count) noexcept;
+
+        auto*  data(this auto&& self) noexcept { return static_cast<decltype(&self.at(0))>(self.m_data); }
         auto&& at(this auto&& self, std::size_t pos) noexcept { return deref<T>(self.m_data, pos); }
 
         std::size_t size() const noexcept { return m_size; }
@@ -134,9 +146,12 @@ namespace dsa
     {
 #if DSA_RAW_BUFFER_DEBUG
         assert(!m_constructed[offset] && "Element not constructed");
-        m_constructed[offset] = true;
 #endif
-        return *std::construct_at(m_data + offset, std::forward<Ts>(args)...);
+        auto& element = *std::construct_at(m_data + offset, std::forward<Ts>(args)...);
+#if DSA_RAW_BUFFER_DEBUG
+        m_constructed[offset] = true;    // only once the constructor did not throw
+#endif
+        return element;
     }
 
     template <typename T>
@@ -148,4 +163,58 @@ namespace dsa
 #endif
         std::destroy_at(m_data + offset);
     }
+
+    template <typename T>
+    void RawBuffer<T>::constructRange(std::size_t offset, const T* first, std::size_t count)
+        requires std::copy_constructible<T>
+    {
+        if (count == 0) {
+            return;
+        }
+
+        assert(offset + count <= m_size && "Range is out of bound");
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+#if DSA_RAW_BUFFER_DEBUG
+            auto* flags = m_constructed.get() + offset;
+            assert(std::none_of(flags, flags + count, std::identity{}) && "Element already constructed");
+            std::fill_n(flags, count, true);
+#endif
+            std::memcpy(static_cast<void*>(m_data + offset), first, count * sizeof(T));
+        } else {
+#if defined(__cpp_exceptions)
+            auto i = 0uz;
+            try {
+                for (; i < count; ++i) {
+                    construct(offset + i, first[i]);
+                }
+            } catch (...) {
+                destroyRange(offset, i);
+                throw;
+            }
+#else
+            for (auto i = 0uz; i < count; ++i) {
+                construct(offset + i, first[i]);
+            }
+#endif
+        }
+    }
+
+    template <typename T>
+    void RawBuffer<T>::destroyRange(std::size_t offset, std::size_t count) noexcept
+    {
+        assert(offset + count <= m_size && "Range is out of bound");
+
+        if constexpr (std::is_trivially_destructible_v<T>) {
+#if DSA_RAW_BUFFER_DEBUG
+            auto* flags = m_constructed.get() + offset;
+            assert(std::all_of(flags, flags + count, std::identity{}) && "Element not constructed");
+            std::fill_n(flags, count, false);
+#endif
+        } else {
+            for (auto i = 0uz; i < count; ++i) {
+                destroy(offset + i);
+            }
+        }
+    }
 }
@@ -4,11 +4,13 @@
 
 #include "dsa/array_list.hpp"
 #include "dsa/common.hpp"
+#include "dsa/error.hpp"
 
 #include <cmath>
 #include <concepts>
 #include <iterator>
-#include <stdexcept>
+#include <ranges>
+#include <span>
 
 namespace dsa
 {
@@ -44,6 +46,10 @@ namespace dsa
         RootishArray(const RootishArray&)            = default;
         RootishArray& operator=(const RootishArray&) = default;
 
+        // all the blocks are allocated up front when the size of the range is known
+        template <ContainerCompatibleRange<T> R>
+        RootishArray(std::from_range_t, R&& range);
+
         void swap(RootishArray& other) noexcept;
         void clear() noexcept;
 
@@ -53,15 +59,33 @@ namespace dsa
         T& push_back(T&& value) { return insert(size(), std::move(value)); }
         T  pop_back() { return remove(size() - 1); }
 
+        // the same operations returning the error instead of throwing, see dsa/error.hpp
+        Result<T&> try_insert(std::size_t pos, T&& value);
+        Result<T&> try_push_back(T&& value) { return push_back(std::move(value)); }
+
+        template <ContainerCompatibleRange<T> R>
+        void append_range(R&& range);
+
         auto&& at(this auto&& self, std::size_t pos);
         auto&& block(this auto&& self, std::size_t pos) { return self.m_blocks.at(pos); }
 
+        auto try_at(this auto&& self, std::size_t pos) -> Result<ElementRef<decltype(self), T>>
+        {
+            if (pos >= self.size()) {
+                return std::unexpected{ Error::OutOfRange };
+            }
+            return self.at(pos);
+        }
+
         auto&& front(this auto&& self) { return self.at(0); }
         auto&& back(this auto&& self) { return self.at(self.size() - 1); }
 
         std::size_t size() const noexcept;
         const auto& blocks() const noexcept { return m_blocks; }
 
+        // every block as a contiguous span, the trailing blocks may be empty
+        auto segments(this auto&& self) noexcept;
+
         auto begin(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, 0uz); }
         auto end(this auto&& self) noexcept { return makeIter<Iterator, decltype(self)>(&self, npos); }
 
@@ -84,6 +108,7 @@ namespace dsa
 
         void grow();
         void shrink();
+        void reserveBlocks(std::size_t count);
     };
 }
 
@@ -93,6 +118,13 @@ namespace dsa
 
 namespace dsa
 {
+    template <RootishArrayElement T>
+    template <ContainerCompatibleRange<T> R>
+    RootishArray<T>::RootishArray(std::from_range_t, R&& range)
+    {
+        append_range(std::forward<R>(range));
+    }
+
     template <RootishArrayElement T>
     void RootishArray<T>::swap(RootishArray& other) noexcept
     {
@@ -109,9 +141,9 @@ namespace dsa
     T& RootishArray<T>::insert(std::size_t pos, T&& value)
     {
         if (pos > size()) {
-            throw std::out_of_range{
-                std::format("Cannot insert element at position greater than size ({} > {})", pos, size())
-            };
+            fail<std::out_of_range>(
+                "Cannot insert element at position greater than size ({} > {})", pos, size()
+            );
         }
 
         // NOTE: 3rd invariant
@@ -142,7 +174,7 @@ namespace dsa
     T RootishArray<T>::remove(std::size_t pos)
     {
         if (pos >= size()) {
-            throw std::out_of_range{ "Cannot remove element at position greater than or equal to size" };
+            fail<std::out_of_range>("Cannot remove element at position greater than or equal to size");
         }
 
         auto [blockIdx, localIdx] = elementIndex(pos);
@@ -163,6 +195,42 @@ namespace dsa
         return value;
     }
 
+    template <RootishArrayElement T>
+    template <ContainerCompatibleRange<T> R>
+    void RootishArray<T>::append_range(R&& range)
+    {
+        if constexpr (not KnownSizeRange<R>) {
+            for (auto&& value : range) {
+                push_back(T(std::forward<decltype(value)>(value)));
+            }
+        } else {
+            auto count = rangeSize(range);
+            if (count == 0) {
+                return;
+            }
+
+            auto blockIdx = size() == 0 ? 0 : m_blocks.size() - 2;
+            reserveBlocks(size() + count);
+
+            // the blocks before the near empty one are full, fill the rest in order
+            for (auto&& value : range) {
+                while (block(blockIdx).size() == block(blockIdx).capacity()) {
+                    ++blockIdx;
+                }
+                block(blockIdx).push_back(T(std::forward<decltype(value)>(value)));
+            }
+        }
+    }
+
+    template <RootishArrayElement T>
+    Result<T&> RootishArray<T>::try_insert(std::size_t pos, T&& value)
+    {
+        if (pos > size()) {
+            return std::unexpected{ Error::OutOfRange };
+        }
+        return insert(pos, std::move(value));
+    }
+
     template <RootishArrayElement T>
     auto&& RootishArray<T>::at(this auto&& self, std::size_t pos)
     {
@@ -170,6 +238,14 @@ namespace dsa
         return self.block(block).at(local);
     }
 
+    template <RootishArrayElement T>
+    auto RootishArray<T>::segments(this auto&& self) noexcept
+    {
+        return self.m_blocks | std::views::transform([](auto& block) {
+                   return std::span{ block.data(), block.size() };
+               });
+    }
+
     template <RootishArrayElement T>
     std::size_t RootishArray<T>::size() const noexcept
     {
@@ -208,6 +284,21 @@ namespace dsa
         std::ignore = m_blocks.pop_back();
     }
 
+    // make room for count elements: r blocks where r(r + 1) / 2 >= count plus the empty block at the end
+    template <RootishArrayElement T>
+    void RootishArray<T>::reserveBlocks(std::size_t count)
+    {
+        auto numBlocks = 1uz;
+        while (numBlocks * (numBlocks + 1) / 2 < count) {
+            ++numBlocks;
+        }
+
+        m_blocks.reserve(numBlocks + 1);
+        while (m_blocks.size() < numBlocks + 1) {
+            grow();
+        }
+    }
+
     template <RootishArrayElement T>
     template <bool IsConst>
     class RootishArray<T>::Iterator
@@ -230,7 +321,7 @@ namespace dsa
 
         Iterator(ArrayPtr array, std::size_t pos) noexcept
             : m_array{ array }
-            , m_pos{ pos }
+            , m_pos{ pos < array->size() ? pos : RootishArray::npos }    // empty: begin == end
             , m_size{ array->size() }
         {
         }
@@ -290,7 +381,7 @@ namespace dsa
         reference operator*() const
         {
             if (m_array == nullptr || m_pos == RootishArray::npos) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
             return m_array->at(m_pos);
         }
@@ -298,7 +389,7 @@ namespace dsa
         pointer operator->() const
         {
             if (m_array == nullptr || m_pos == RootishArray::npos) {
-                throw std::out_of_range{ "Iterator is out of range" };
+                fail<std::out_of_range>("Iterator is out of range");
             }
             return &m_array->at(m_pos);
         }
@@ -0,0 +1,368 @@
+#pragma once
+
+// NOTE: iterative (bottom-up) SegmentTree with lazy propagation over an ArrayList. the number of leaves is
+//       rounded up to a power of two so every internal node covers exactly 2^height leaves, the extra leaves
+//       hold the identity. node 1 is the root and node p has children 2p and 2p + 1.
+//
+//       query is const and doesn't write: with a lazy action it composes the pending updates on the way down
+//       from the root and applies them on the fly instead of pushing them down, so concurrent queries are
+//       safe like on the other containers.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+#include "dsa/monoid.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+
+namespace dsa
+{
+    template <typename T>
+    concept SegmentTreeElement = std::copyable<T> and std::default_initializable<T>;
+
+    // an update that can be applied to a whole segment at once without visiting its elements.
+    // - compose(newer, older) must behave as applying older then newer.
+    // - apply(value, update, length) is the new value of a segment of `length` elements combined as `value`.
+    template <typename Lazy, typename T>
+    concept LazyAction = requires { typename Lazy::Update; }
+                     and std::equality_comparable<typename Lazy::Update>
+                     and requires(
+                             const Lazy                   lazy,
+                             const T&                     value,
+                             const typename Lazy::Update& update,
+                             std::size_t                  length
+                     ) {
+                             { Lazy::identity() } -> std::convertible_to<typename Lazy::Update>;
+                             { lazy.compose(update, update) } -> std::convertible_to<typename Lazy::Update>;
+                             { lazy.apply(value, update, length) } -> std::convertible_to<T>;
+                         };
+
+    // disables range update, only point assignment is possible
+    struct NoLazy
+    {
+        struct Update
+        {
+        };
+    };
+
+    // add a value to every element in a range
+    template <typename T, Monoid<T> Op = Sum<T>>
+    struct RangeAdd
+    {
+        using Update = T;
+
+        static constexpr Update identity() { return T{}; }
+
+        constexpr Update compose(const Update& newer, const Update& older) const { return newer + older; }
+
+        constexpr T apply(const T& value, const Update& update, std::size_t length) const
+        {
+            if constexpr (std::same_as<Op, Sum<T>>) {
+                return value + update * static_cast<T>(length);
+            } else {
+                return value + update;    // min and max are shifted by the same amount
+            }
+        }
+    };
+
+    // assign a value to every element in a range
+    template <typename T, Monoid<T> Op = Sum<T>>
+    struct RangeAssign
+    {
+        using Update = std::optional<T>;
+
+        static constexpr Update identity() { return std::nullopt; }
+
+        constexpr Update compose(const Update& newer, const Update& older) const
+        {
+            return newer.has_value() ? newer : older;
+        }
+
+        constexpr T apply(const T& value, const Update& update, std::size_t length) const
+        {
+            if (not update.has_value()) {
+                return value;
+            }
+
+            if constexpr (std::same_as<Op, Sum<T>>) {
+                return *update * static_cast<T>(length);
+            } else {
+                return *update;
+            }
+        }
+    };
+
+    template <SegmentTreeElement T, Monoid<T> Op = Sum<T>, typename Lazy = NoLazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    class SegmentTree
+    {
+    public:
+        using Element    = T;
+        using Operation  = Op;
+        using Action     = Lazy;
+        using Update     = typename Lazy::Update;
+        using value_type = Element;    // STL compliance
+
+        static constexpr bool s_lazy = not std::same_as<Lazy, NoLazy>;
+
+        SegmentTree() = default;
+
+        // all elements start as the identity
+        explicit SegmentTree(std::size_t size);
+
+        // O(n) build
+        template <std::ranges::forward_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+        explicit SegmentTree(R&& range);
+
+        void set(std::size_t pos, T value);
+
+        // apply update to every element in [first, last)
+        void update(std::size_t first, std::size_t last, const Update& update)
+            requires s_lazy;
+
+        // op over [first, last)
+        T query(std::size_t first, std::size_t last) const;
+
+        T at(std::size_t pos) const { return query(pos, pos + 1); }
+
+        std::size_t size() const noexcept { return m_size; }
+
+    private:
+        [[no_unique_address]] Op   m_op     = {};
+        [[no_unique_address]] Lazy m_action = {};
+
+        std::size_t m_size   = 0;
+        std::size_t m_leaves = 0;
+        std::size_t m_height = 0;
+
+        ArrayList<T>      m_tree = {};    // [1, 2 * leaves)
+        ArrayList<Update> m_lazy = {};    // [1, leaves), empty when there is no lazy action
+
+        // unchecked access
+        auto& tree(this auto&& self, std::size_t p) noexcept { return self.m_tree.data()[p]; }
+        auto& lazy(this auto&& self, std::size_t p) noexcept { return self.m_lazy.data()[p]; }
+
+        void init(std::size_t size);
+        void checkRange(std::size_t first, std::size_t last) const;
+
+        void applyNode(std::size_t p, const Update& update, std::size_t length);
+        void rebuild(std::size_t p);    // recompute the ancestors of p
+        void push(std::size_t p);       // push down the pending updates of the ancestors of p
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    SegmentTree<T, Op, Lazy>::SegmentTree(std::size_t size)
+    {
+        init(size);
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    template <std::ranges::forward_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    SegmentTree<T, Op, Lazy>::SegmentTree(R&& range)
+    {
+        init(static_cast<std::size_t>(std::ranges::distance(range)));
+
+        auto leaf = m_leaves;
+        for (auto&& value : range) {
+            tree(leaf++) = static_cast<T>(value);
+        }
+
+        for (auto p = m_leaves; p-- > 1;) {
+            tree(p) = m_op(tree(2 * p), tree(2 * p + 1));
+        }
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::set(std::size_t pos, T value)
+    {
+        checkRange(pos, pos + 1);
+
+        auto p = pos + m_leaves;
+        push(p);
+        tree(p) = std::move(value);
+        rebuild(p);
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::update(std::size_t first, std::size_t last, const Update& update)
+        requires s_lazy
+    {
+        checkRange(first, last);
+        if (first == last) {
+            return;
+        }
+
+        auto l = first + m_leaves;
+        auto r = last + m_leaves;
+
+        // the boundary paths must be clean so that updates stay in order for non-commutative actions
+        push(l);
+        push(r - 1);
+
+        for (auto length = 1uz, lo = l, hi = r; lo < hi; lo /= 2, hi /= 2, length *= 2) {
+            if (lo & 1) {
+                applyNode(lo++, update, length);
+            }
+            if (hi & 1) {
+                applyNode(--hi, update, length);
+            }
+        }
+
+        rebuild(l);
+        rebuild(r - 1);
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    T SegmentTree<T, Op, Lazy>::query(std::size_t first, std::size_t last) const
+    {
+        checkRange(first, last);
+
+        auto left  = static_cast<T>(Op::identity());
+        auto right = static_cast<T>(Op::identity());
+
+        if (first == last) {
+            return left;
+        }
+
+        auto l = first + m_leaves;
+        auto r = last + m_leaves;
+
+        // the nodes of the loop below are visited level by level from the root instead. the parent of a node
+        // taken on the left side is an ancestor of l, on the right side of r - 1, so the pending updates on
+        // those two paths are all there is to apply. an update waiting at a node is newer than the ones below
+        if constexpr (s_lazy) {
+            auto pendingLeft  = static_cast<Update>(Lazy::identity());
+            auto pendingRight = static_cast<Update>(Lazy::identity());
+
+            auto value = [&](std::size_t p, const Update& pending, std::size_t length) {
+                return pending == Lazy::identity() ? tree(p) : m_action.apply(tree(p), pending, length);
+            };
+
+            for (auto k = m_height + 1; k-- > 0;) {
+                if (k < m_height) {
+                    pendingLeft  = m_action.compose(pendingLeft, lazy(l >> (k + 1)));
+                    pendingRight = m_action.compose(pendingRight, lazy((r - 1) >> (k + 1)));
+                }
+
+                auto lo = ((l - 1) >> k) + 1;
+                auto hi = r >> k;
+                if (lo >= hi) {
+                    continue;
+                }
+                if (lo & 1) {
+                    left = m_op(value(lo, pendingLeft, 1uz << k), left);
+                }
+                if (hi & 1) {
+                    right = m_op(right, value(hi - 1, pendingRight, 1uz << k));
+                }
+            }
+
+            return m_op(left, right);
+        }
+
+        // left and right are accumulated separately to keep the order for non-commutative operations
+        for (; l < r; l /= 2, r /= 2) {
+            if (l & 1) {
+                left = m_op(left, tree(l++));
+            }
+            if (r & 1) {
+                right = m_op(tree(--r), right);
+            }
+        }
+
+        return m_op(left, right);
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::init(std::size_t size)
+    {
+        m_size   = size;
+        m_leaves = std::bit_ceil(std::max(size, 1uz));
+        m_height = static_cast<std::size_t>(std::countr_zero(m_leaves));
+
+        m_tree.reserve(2 * m_leaves);
+        for (auto i = 0uz; i < 2 * m_leaves; ++i) {
+            m_tree.push_back(Op::identity());
+        }
+
+        if constexpr (s_lazy) {
+            m_lazy.reserve(m_leaves);
+            for (auto i = 0uz; i < m_leaves; ++i) {
+                m_lazy.push_back(Lazy::identity());
+            }
+        }
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::checkRange(std::size_t first, std::size_t last) const
+    {
+        if (first > last or last > m_size) {
+            fail<std::out_of_range>("Range is out of range: [{}, {}) on size {}", first, last, m_size);
+        }
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::applyNode(std::size_t p, const Update& update, std::size_t length)
+    {
+        tree(p) = m_action.apply(tree(p), update, length);
+        if (p < m_leaves) {
+            lazy(p) = m_action.compose(update, lazy(p));
+        }
+    }
+
+    // the pending update of a node is already applied to the node itself but not to its children, so it must
+    // be re-applied after combining the children
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::rebuild(std::size_t p)
+    {
+        for (auto length = 2uz; p > 1; length *= 2) {
+            p /= 2;
+            tree(p) = m_op(tree(2 * p), tree(2 * p + 1));
+
+            if constexpr (s_lazy) {
+                if (lazy(p) != Lazy::identity()) {
+                    tree(p) = m_action.apply(tree(p), lazy(p), length);
+                }
+            }
+        }
+    }
+
+    template <SegmentTreeElement T, Monoid<T> Op, typename Lazy>
+        requires std::same_as<Lazy, NoLazy> or LazyAction<Lazy, T>
+    void SegmentTree<T, Op, Lazy>::push(std::size_t p)
+    {
+        if constexpr (s_lazy) {
+            for (auto s = m_height; s > 0; --s) {
+                auto i = p >> s;
+                if (lazy(i) != Lazy::identity()) {
+                    auto length = 1uz << (s - 1);
+                    applyNode(2 * i, lazy(i), length);
+                    applyNode(2 * i + 1, lazy(i), length);
+                    lazy(i) = Lazy::identity();
+                }
+            }
+        }
+    }
+}
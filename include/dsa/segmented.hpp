@@ -0,0 +1,232 @@
+#pragma once
+
+// NOTE: segmented iteration (Austern, "Segmented Iterators and Hierarchical Algorithms"). a segmented range
+//       is the concatenation of contiguous segments, dsa::segments(range) returns those segments in order:
+//       - a member segments() is used when there is one: CircularBuffer (its two ring segments), RootishArray
+//         (one segment per block) and BlockyLinkedList (the two ring segments of every block),
+//       - otherwise a segments(range) function found by argument dependent lookup,
+//       - otherwise a contiguous range is its own single segment.
+//
+//       the algorithms in dsa::segmented run a plain loop over the pointer and size of each segment instead
+//       of going through the container iterator, so the inner loop can be vectorized. segments may be empty.
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    namespace segments_cpo
+    {
+        void segments() = delete;
+
+        template <typename R>
+        concept HasMember = requires(R& range) {
+            { range.segments() } -> std::ranges::input_range;
+        };
+
+        template <typename R>
+        concept HasAdl = requires(R& range) {
+            { segments(range) } -> std::ranges::input_range;
+        };
+
+        struct Fn
+        {
+            template <typename R>
+                requires HasMember<R> or HasAdl<R> or std::ranges::contiguous_range<R>
+            auto operator()(R&& range) const
+            {
+                if constexpr (HasMember<R>) {
+                    return range.segments();
+                } else if constexpr (HasAdl<R>) {
+                    return segments(range);
+                } else {
+                    return std::array{ std::span{ std::ranges::data(range), std::ranges::size(range) } };
+                }
+            }
+        };
+    }
+
+    inline namespace cpo
+    {
+        inline constexpr segments_cpo::Fn segments = {};
+    }
+
+    template <typename R>
+    using segments_t = decltype(dsa::segments(std::declval<R&>()));
+
+    template <typename R>
+    using segment_t = std::ranges::range_value_t<segments_t<R>>;
+
+    template <typename R>
+    concept segmented_range = std::ranges::input_range<R>
+                          and requires(R& range) { dsa::segments(range); }
+                          and std::ranges::input_range<segments_t<R>>
+                          and std::ranges::contiguous_range<segment_t<R>>
+                          and std::ranges::sized_range<segment_t<R>>
+                          and std::same_as<
+                                  std::ranges::range_value_t<segment_t<R>>,
+                                  std::ranges::range_value_t<R>>;
+
+    // a segmented range whose elements can be assigned through its segments
+    template <typename R, typename T>
+    concept output_segmented_range = segmented_range<R>
+                                 and std::indirectly_writable<std::ranges::iterator_t<segment_t<R>>, T>;
+}
+
+namespace dsa::segmented
+{
+    // fn is called on every element in order, returns fn
+    template <segmented_range R, typename Fn>
+        requires std::invocable<Fn&, std::ranges::range_reference_t<segment_t<R>>>
+    Fn for_each(R&& range, Fn fn);
+
+    // copy to an output iterator, returns the iterator past the last element written
+    template <segmented_range R, std::weakly_incrementable Out>
+        requires std::indirectly_copyable<std::ranges::iterator_t<segment_t<R>>, Out>
+    Out copy(R&& range, Out out);
+
+    // copy to another segmented range segment by segment, stops when either runs out.
+    // returns the number of elements copied
+    template <segmented_range R, output_segmented_range<std::ranges::range_reference_t<segment_t<R>>> O>
+    std::size_t copy(R&& range, O&& out);
+
+    template <typename T, output_segmented_range<const T&> R>
+    void fill(R&& range, const T& value);
+
+    // position of the first element equal to value, or the size of the range if there is none
+    template <segmented_range R, typename T>
+        requires std::equality_comparable_with<std::ranges::range_reference_t<segment_t<R>>, const T&>
+    std::size_t find(R&& range, const T& value);
+
+    // left fold: op(op(op(init, e0), e1), ...)
+    template <segmented_range R, typename T, typename Op = std::plus<>>
+        requires std::convertible_to<
+            std::invoke_result_t<Op&, T, std::ranges::range_reference_t<segment_t<R>>>,
+            T>
+    T accumulate(R&& range, T init, Op op = {});
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa::segmented
+{
+    template <segmented_range R, typename Fn>
+        requires std::invocable<Fn&, std::ranges::range_reference_t<segment_t<R>>>
+    Fn for_each(R&& range, Fn fn)
+    {
+        for (auto&& segment : dsa::segments(range)) {
+            auto* data = std::ranges::data(segment);
+            auto  size = std::ranges::size(segment);
+
+            for (auto i = 0uz; i < size; ++i) {
+                std::invoke(fn, data[i]);
+            }
+        }
+        return fn;
+    }
+
+    template <segmented_range R, std::weakly_incrementable Out>
+        requires std::indirectly_copyable<std::ranges::iterator_t<segment_t<R>>, Out>
+    Out copy(R&& range, Out out)
+    {
+        for (auto&& segment : dsa::segments(range)) {
+            auto* data = std::ranges::data(segment);
+            out        = std::copy_n(data, std::ranges::size(segment), std::move(out));
+        }
+        return out;
+    }
+
+    template <segmented_range R, output_segmented_range<std::ranges::range_reference_t<segment_t<R>>> O>
+    std::size_t copy(R&& range, O&& out)
+    {
+        auto outSegments = dsa::segments(out);
+        auto outIt       = std::ranges::begin(outSegments);
+        auto outEnd      = std::ranges::end(outSegments);
+
+        auto copied  = 0uz;
+        auto outData = decltype(std::ranges::data(*outIt)){};
+        auto outLeft = 0uz;
+
+        for (auto&& segment : dsa::segments(range)) {
+            auto* data = std::ranges::data(segment);
+            auto  left = std::ranges::size(segment);
+
+            while (left > 0) {
+                while (outLeft == 0) {
+                    if (outIt == outEnd) {
+                        return copied;
+                    }
+                    auto outSegment = *outIt;
+                    outData         = std::ranges::data(outSegment);
+                    outLeft         = std::ranges::size(outSegment);
+                    ++outIt;
+                }
+
+                auto count = std::min(left, outLeft);
+                std::copy_n(data, count, outData);
+
+                data    += count;
+                outData += count;
+                left    -= count;
+                outLeft -= count;
+                copied  += count;
+            }
+        }
+
+        return copied;
+    }
+
+    template <typename T, output_segmented_range<const T&> R>
+    void fill(R&& range, const T& value)
+    {
+        for (auto&& segment : dsa::segments(range)) {
+            std::fill_n(std::ranges::data(segment), std::ranges::size(segment), value);
+        }
+    }
+
+    template <segmented_range R, typename T>
+        requires std::equality_comparable_with<std::ranges::range_reference_t<segment_t<R>>, const T&>
+    std::size_t find(R&& range, const T& value)
+    {
+        auto offset = 0uz;
+        for (auto&& segment : dsa::segments(range)) {
+            auto* data = std::ranges::data(segment);
+            auto  size = std::ranges::size(segment);
+
+            for (auto i = 0uz; i < size; ++i) {
+                if (data[i] == value) {
+                    return offset + i;
+                }
+            }
+            offset += size;
+        }
+        return offset;
+    }
+
+    template <segmented_range R, typename T, typename Op>
+        requires std::convertible_to<
+            std::invoke_result_t<Op&, T, std::ranges::range_reference_t<segment_t<R>>>,
+            T>
+    T accumulate(R&& range, T init, Op op)
+    {
+        for (auto&& segment : dsa::segments(range)) {
+            auto* data = std::ranges::data(segment);
+            auto  size = std::ranges::size(segment);
+
+            for (auto i = 0uz; i < size; ++i) {
+                init = std::invoke(op, std::move(init), data[i]);
+            }
+        }
+        return init;
+    }
+}
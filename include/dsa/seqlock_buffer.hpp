@@ -0,0 +1,192 @@
+#pragma once
+
+// NOTE: SeqlockBuffer is a fixed capacity circular buffer of trivially copyable values with a single
+//       writer and any number of readers, the seqlock mode of a CircularBuffer with
+//       BufferStorePolicy::ReplaceOnFull. it is meant for monitoring: one thread pushes samples at a high
+//       rate, other threads read the latest ones. the writer never waits for the readers.
+//
+//       a single sequence counter guards the buffer: 2 * n while n values are written, 2 * n + 1 while the
+//       value n is being written over the oldest slot. a reader loads the sequence, copies the last values
+//       from the live segments (at most two contiguous runs of slots, like CircularBuffer::segments) and
+//       loads the sequence again: a value it copied is consistent unless the writer has started to overwrite
+//       its slot since, which the second load tells. unlike a plain seqlock a conflict only costs the values
+//       actually overwritten: a snapshot of fewer values than the capacity leaves the writer room to run.
+//       on a conflict the reader retries, and after s_retries keeps the consistent newer part only.
+//
+//       the values are stored as atomic words with release stores and acquire loads, the technique of
+//       ConcurrentOverwriteRing: the racy copy is well-defined and ThreadSanitizer understands it, where the
+//       fences of a textbook seqlock would be reported. the stores and loads are plain moves on x86.
+
+#include "dsa/array_list.hpp"
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+namespace dsa
+{
+    template <typename T>
+    concept SeqlockElement = std::is_trivially_copyable_v<T> and std::is_default_constructible_v<T>;
+
+    template <SeqlockElement T>
+    class SeqlockBuffer
+    {
+    public:
+        using Element    = T;
+        using value_type = Element;    // STL compliance
+
+        static constexpr int s_retries = 8;
+
+        explicit SeqlockBuffer(std::size_t capacity);
+
+        SeqlockBuffer(SeqlockBuffer&&)            = delete;
+        SeqlockBuffer& operator=(SeqlockBuffer&&) = delete;
+
+        // the writer, overwrites the oldest value once full. only one thread may push
+        void push_back(const T& value) noexcept;
+
+        // copy the last out.size() values (fewer if not written yet) to the front of out, oldest first, and
+        // return how many were copied. fewer are copied if the writer overwrote some of them in every retry
+        std::size_t snapshot(std::span<T> out) const noexcept;
+
+        ArrayList<T>     snapshot(std::size_t count) const;
+        std::optional<T> latest() const noexcept;
+
+        // number of values ever written, and number of snapshot retries, both approximate while writing
+        std::uint64_t written() const noexcept { return m_sequence.load(std::memory_order_acquire) / 2; }
+        std::uint64_t retries() const noexcept { return m_retries.load(std::memory_order_relaxed); }
+
+        std::size_t size() const noexcept { return std::min<std::uint64_t>(written(), m_capacity); }
+        std::size_t capacity() const noexcept { return m_capacity; }
+
+    private:
+        using Word = std::uint64_t;
+
+        static constexpr std::size_t s_words = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+        using Slot = std::array<std::atomic<Word>, s_words>;
+
+        std::unique_ptr<Slot[]> m_slots    = nullptr;
+        std::size_t             m_capacity = 0;
+        std::size_t             m_next     = 0;    // the slot of the next value, owned by the writer
+
+        alignas(64) std::atomic<std::uint64_t>         m_sequence = 0;
+        alignas(64) mutable std::atomic<std::uint64_t> m_retries  = 0;
+
+        // copy the values [first, last) to out, acquire loads of every word
+        void copy(std::uint64_t first, std::uint64_t last, T* out) const noexcept;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <SeqlockElement T>
+    SeqlockBuffer<T>::SeqlockBuffer(std::size_t capacity)
+    {
+        if (capacity == 0) {
+            fail<std::invalid_argument>("Invalid buffer capacity: {}", capacity);
+        }
+
+        m_slots    = std::make_unique<Slot[]>(capacity);
+        m_capacity = capacity;
+    }
+
+    template <SeqlockElement T>
+    void SeqlockBuffer<T>::push_back(const T& value) noexcept
+    {
+        // the odd sequence is a release store too, so the claim is published the same way as the words
+        auto sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_release);
+
+        // release: a reader that loads any of these words also sees the odd sequence when it checks again
+        auto words = std::array<Word, s_words>{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (auto i = 0uz; i < s_words; ++i) {
+            m_slots[m_next][i].store(words[i], std::memory_order_release);
+        }
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+        m_next = m_next + 1 == m_capacity ? 0 : m_next + 1;
+    }
+
+    template <SeqlockElement T>
+    std::size_t SeqlockBuffer<T>::snapshot(std::span<T> out) const noexcept
+    {
+        auto count = 0uz;
+        auto first = std::uint64_t{ 0 };
+
+        for (auto attempt = 0; attempt <= s_retries; ++attempt) {
+            auto end = m_sequence.load(std::memory_order_acquire) / 2;
+            count    = std::min<std::uint64_t>({ out.size(), end, m_capacity });
+            first    = end - count;
+
+            copy(first, end, out.data());
+
+            // the values whose slot the writer has started to overwrite since: first + capacity and later
+            auto started = (m_sequence.load(std::memory_order_relaxed) + 1) / 2;
+            auto valid   = started > m_capacity ? started - m_capacity : 0;
+            if (valid <= first) {
+                return count;
+            }
+
+            m_retries.fetch_add(1, std::memory_order_relaxed);
+            if (attempt == s_retries) {
+                // keep the newer values that were not overwritten
+                auto torn = std::min<std::uint64_t>(valid - first, count);
+                std::memmove(out.data(), out.data() + torn, (count - torn) * sizeof(T));
+                return count - torn;
+            }
+        }
+
+        return count;
+    }
+
+    template <SeqlockElement T>
+    ArrayList<T> SeqlockBuffer<T>::snapshot(std::size_t count) const
+    {
+        auto values = ArrayList<T>(std::min(count, m_capacity));
+        auto copied = snapshot(std::span{ values });
+        while (values.size() > copied) {
+            values.pop_back();
+        }
+        return values;
+    }
+
+    template <SeqlockElement T>
+    std::optional<T> SeqlockBuffer<T>::latest() const noexcept
+    {
+        auto value = T{};
+        if (snapshot(std::span{ &value, 1 }) == 0) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    template <SeqlockElement T>
+    void SeqlockBuffer<T>::copy(std::uint64_t first, std::uint64_t last, T* out) const noexcept
+    {
+        auto slot  = static_cast<std::size_t>(first % m_capacity);
+        auto words = std::array<Word, s_words>{};
+
+        // the live segments: [slot, capacity) then [0, ...)
+        for (auto ticket = first; ticket < last; ++ticket) {
+            for (auto i = 0uz; i < s_words; ++i) {
+                words[i] = m_slots[slot][i].load(std::memory_order_acquire);
+            }
+            std::memcpy(out++, words.data(), sizeof(T));
+            slot = slot + 1 == m_capacity ? 0 : slot + 1;
+        }
+    }
+}
@@ -0,0 +1,621 @@
+#pragma once
+
+// NOTE: vectorized find/count/minmax/sum over contiguous spans. the containers are consumed segment by
+//       segment through dsa::segments (dsa/segmented.hpp): ArrayList and FixedArray as one span,
+//       CircularBuffer as its two ring segments, and RootishArray block by block, so no iterator arithmetic
+//       or modulo is done per element.
+//
+//       int32_t and float have AVX2 and SSE2 kernels selected at runtime from the cpu features (x86 with
+//       GCC or Clang only), every other arithmetic type and every other platform uses the scalar loop.
+//       the result of minmax on floats containing NaN is unspecified. sum of floats is accumulated in double
+//       and may differ from the scalar loop in the last bits since the additions are reordered.
+
+#include "dsa/segmented.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+#    define DSA_SIMD_X86 1
+#    include <immintrin.h>
+// compiles a function for an instruction set the build does not enable, callers must check it at runtime. part
+// of the interface: the kernels of other headers (BitVector popcount) use it too
+#    define DSA_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#    define DSA_SIMD_X86 0
+#endif
+
+namespace dsa::simd
+{
+    enum class Isa
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+    };
+
+    // best instruction set supported by the cpu
+    Isa detectIsa() noexcept;
+
+    // instruction set used by the kernels, defaults to detectIsa()
+    Isa activeIsa() noexcept;
+
+    // force a narrower instruction set (for testing or benchmarking), clamped to what the cpu supports
+    void setIsa(Isa isa) noexcept;
+
+    template <typename T>
+    concept Element = std::is_arithmetic_v<T> and not std::same_as<T, bool>;
+
+    // types that have vectorized kernels
+    template <typename T>
+    concept Vectorized = std::same_as<T, std::int32_t> or std::same_as<T, float>;
+
+    template <Element T>
+    using Accumulator = std::conditional_t<
+        std::floating_point<T>,
+        double,
+        std::conditional_t<std::signed_integral<T>, std::int64_t, std::uint64_t>>;
+
+    template <Element T>
+    struct MinMax
+    {
+        T min;
+        T max;
+
+        bool operator==(const MinMax&) const = default;
+    };
+
+    // position of the first element equal to value, or span.size() if there is none
+    template <Element T>
+    std::size_t find(std::span<const T> span, T value) noexcept;
+
+    template <Element T>
+    std::size_t count(std::span<const T> span, T value) noexcept;
+
+    // std::nullopt if the span is empty
+    template <Element T>
+    std::optional<MinMax<T>> minmax(std::span<const T> span) noexcept;
+
+    template <Element T>
+    Accumulator<T> sum(std::span<const T> span) noexcept;
+
+    // container versions over the segments given by dsa::segments, positions are relative to the start of the
+    // container
+    template <segmented_range C>
+    std::size_t find(const C& container, typename C::value_type value) noexcept;
+
+    template <segmented_range C>
+    std::size_t count(const C& container, typename C::value_type value) noexcept;
+
+    template <segmented_range C>
+    std::optional<MinMax<typename C::value_type>> minmax(const C& container) noexcept;
+
+    template <segmented_range C>
+    Accumulator<typename C::value_type> sum(const C& container) noexcept;
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa::simd
+{
+    inline Isa detectIsa() noexcept
+    {
+#if DSA_SIMD_X86
+        static const auto isa = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return Isa::Avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return Isa::Sse2;
+            }
+            return Isa::Scalar;
+        }();
+        return isa;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    namespace kernel
+    {
+        inline std::atomic<Isa>& isa() noexcept
+        {
+            static auto active = std::atomic<Isa>{ detectIsa() };
+            return active;
+        }
+
+        template <typename T>
+        std::size_t findScalar(const T* data, std::size_t size, T value) noexcept
+        {
+            for (auto i = 0uz; i < size; ++i) {
+                if (data[i] == value) {
+                    return i;
+                }
+            }
+            return size;
+        }
+
+        template <typename T>
+        std::size_t countScalar(const T* data, std::size_t size, T value) noexcept
+        {
+            auto result = 0uz;
+            for (auto i = 0uz; i < size; ++i) {
+                result += data[i] == value;
+            }
+            return result;
+        }
+
+        template <typename T>
+        MinMax<T> minmaxScalar(const T* data, std::size_t size, MinMax<T> init) noexcept
+        {
+            for (auto i = 0uz; i < size; ++i) {
+                init.min = data[i] < init.min ? data[i] : init.min;
+                init.max = init.max < data[i] ? data[i] : init.max;
+            }
+            return init;
+        }
+
+        template <typename T>
+        Accumulator<T> sumScalar(const T* data, std::size_t size) noexcept
+        {
+            auto result = Accumulator<T>{};
+            for (auto i = 0uz; i < size; ++i) {
+                result += static_cast<Accumulator<T>>(data[i]);
+            }
+            return result;
+        }
+
+#if DSA_SIMD_X86
+        // clang-format off
+        // equality mask of 8 (avx2) or 4 (sse2) elements, one bit per element
+        DSA_SIMD_TARGET("avx2") inline int eqMask256(const std::int32_t* p, __m256i needle) noexcept
+        {
+            auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle)));
+        }
+
+        DSA_SIMD_TARGET("avx2") inline int eqMask256(const float* p, __m256 needle) noexcept
+        {
+            return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), needle, _CMP_EQ_OQ));
+        }
+
+        DSA_SIMD_TARGET("sse2") inline int eqMask128(const std::int32_t* p, __m128i needle) noexcept
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, needle)));
+        }
+
+        DSA_SIMD_TARGET("sse2") inline int eqMask128(const float* p, __m128 needle) noexcept
+        {
+            return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), needle));
+        }
+
+        DSA_SIMD_TARGET("avx2") inline auto splat256(std::int32_t v) noexcept { return _mm256_set1_epi32(v); }
+        DSA_SIMD_TARGET("avx2") inline auto splat256(float v) noexcept { return _mm256_set1_ps(v); }
+        DSA_SIMD_TARGET("sse2") inline auto splat128(std::int32_t v) noexcept { return _mm_set1_epi32(v); }
+        DSA_SIMD_TARGET("sse2") inline auto splat128(float v) noexcept { return _mm_set1_ps(v); }
+        // clang-format on
+
+        // 4 vectors per iteration, the masks are only inspected when one of them is non-zero
+        template <Vectorized T>
+        DSA_SIMD_TARGET("avx2")
+        std::size_t findAvx2(const T* data, std::size_t size, T value) noexcept
+        {
+            auto needle = splat256(value);
+            auto i      = 0uz;
+
+            for (; i + 32 <= size; i += 32) {
+                auto m0 = eqMask256(data + i, needle);
+                auto m1 = eqMask256(data + i + 8, needle);
+                auto m2 = eqMask256(data + i + 16, needle);
+                auto m3 = eqMask256(data + i + 24, needle);
+
+                if ((m0 | m1 | m2 | m3) != 0) {
+                    auto mask = static_cast<std::uint32_t>(m0) | static_cast<std::uint32_t>(m1) << 8
+                              | static_cast<std::uint32_t>(m2) << 16 | static_cast<std::uint32_t>(m3) << 24;
+                    return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+
+            for (; i + 8 <= size; i += 8) {
+                if (auto mask = eqMask256(data + i, needle); mask != 0) {
+                    return i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+                }
+            }
+
+            return i + findScalar(data + i, size - i, value);
+        }
+
+        template <Vectorized T>
+        DSA_SIMD_TARGET("sse2")
+        std::size_t findSse2(const T* data, std::size_t size, T value) noexcept
+        {
+            auto needle = splat128(value);
+            auto i      = 0uz;
+
+            for (; i + 16 <= size; i += 16) {
+                auto m0 = eqMask128(data + i, needle);
+                auto m1 = eqMask128(data + i + 4, needle);
+                auto m2 = eqMask128(data + i + 8, needle);
+                auto m3 = eqMask128(data + i + 12, needle);
+
+                if ((m0 | m1 | m2 | m3) != 0) {
+                    auto mask = static_cast<std::uint32_t>(m0) | static_cast<std::uint32_t>(m1) << 4
+                              | static_cast<std::uint32_t>(m2) << 8 | static_cast<std::uint32_t>(m3) << 12;
+                    return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+
+            return i + findScalar(data + i, size - i, value);
+        }
+
+        template <Vectorized T>
+        DSA_SIMD_TARGET("avx2,popcnt")
+        std::size_t countAvx2(const T* data, std::size_t size, T value) noexcept
+        {
+            auto needle = splat256(value);
+            auto result = 0uz;
+            auto i      = 0uz;
+
+            for (; i + 16 <= size; i += 16) {
+                auto mask = static_cast<std::uint32_t>(eqMask256(data + i, needle))
+                          | static_cast<std::uint32_t>(eqMask256(data + i + 8, needle)) << 8;
+                result += static_cast<std::size_t>(std::popcount(mask));
+            }
+
+            return result + countScalar(data + i, size - i, value);
+        }
+
+        template <Vectorized T>
+        DSA_SIMD_TARGET("sse2")
+        std::size_t countSse2(const T* data, std::size_t size, T value) noexcept
+        {
+            auto needle = splat128(value);
+            auto result = 0uz;
+            auto i      = 0uz;
+
+            for (; i + 16 <= size; i += 16) {
+                auto mask = static_cast<std::uint32_t>(eqMask128(data + i, needle))
+                          | static_cast<std::uint32_t>(eqMask128(data + i + 4, needle)) << 4
+                          | static_cast<std::uint32_t>(eqMask128(data + i + 8, needle)) << 8
+                          | static_cast<std::uint32_t>(eqMask128(data + i + 12, needle)) << 12;
+                result += static_cast<std::size_t>(std::popcount(mask));
+            }
+
+            return result + countScalar(data + i, size - i, value);
+        }
+
+        // two independent accumulators per operation hide the latency of min/max
+        DSA_SIMD_TARGET("avx2")
+        inline MinMax<std::int32_t> minmaxAvx2(const std::int32_t* data, std::size_t size) noexcept
+        {
+            auto init = MinMax{ data[0], data[0] };
+            if (size < 16) {
+                return minmaxScalar(data, size, init);
+            }
+
+            // no lambda here, it wouldn't inherit the target attribute
+            auto* vec  = reinterpret_cast<const __m256i*>(data);
+            auto  min0 = _mm256_loadu_si256(vec), min1 = _mm256_loadu_si256(vec + 1);
+            auto  max0 = min0, max1 = min1;
+            auto  i    = 16uz;
+
+            for (; i + 16 <= size; i += 16) {
+                auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8));
+                min0    = _mm256_min_epi32(min0, v0);
+                min1    = _mm256_min_epi32(min1, v1);
+                max0    = _mm256_max_epi32(max0, v0);
+                max1    = _mm256_max_epi32(max1, v1);
+            }
+
+            alignas(32) std::int32_t mins[8];
+            alignas(32) std::int32_t maxs[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(mins), _mm256_min_epi32(min0, min1));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), _mm256_max_epi32(max0, max1));
+
+            init = minmaxScalar(mins, 8, init);
+            init = minmaxScalar(maxs, 8, init);
+            return minmaxScalar(data + i, size - i, init);
+        }
+
+        DSA_SIMD_TARGET("avx2")
+        inline MinMax<float> minmaxAvx2(const float* data, std::size_t size) noexcept
+        {
+            auto init = MinMax{ data[0], data[0] };
+            if (size < 16) {
+                return minmaxScalar(data, size, init);
+            }
+
+            auto min0 = _mm256_loadu_ps(data), min1 = _mm256_loadu_ps(data + 8), max0 = min0, max1 = min1;
+            auto i    = 16uz;
+
+            for (; i + 16 <= size; i += 16) {
+                auto v0 = _mm256_loadu_ps(data + i);
+                auto v1 = _mm256_loadu_ps(data + i + 8);
+                min0    = _mm256_min_ps(min0, v0);
+                min1    = _mm256_min_ps(min1, v1);
+                max0    = _mm256_max_ps(max0, v0);
+                max1    = _mm256_max_ps(max1, v1);
+            }
+
+            alignas(32) float mins[8];
+            alignas(32) float maxs[8];
+            _mm256_store_ps(mins, _mm256_min_ps(min0, min1));
+            _mm256_store_ps(maxs, _mm256_max_ps(max0, max1));
+
+            init = minmaxScalar(mins, 8, init);
+            init = minmaxScalar(maxs, 8, init);
+            return minmaxScalar(data + i, size - i, init);
+        }
+
+        // sse2 has no 32-bit integer min/max, they are emulated with a compare and a select
+        DSA_SIMD_TARGET("sse2")
+        inline MinMax<std::int32_t> minmaxSse2(const std::int32_t* data, std::size_t size) noexcept
+        {
+            auto init = MinMax{ data[0], data[0] };
+            if (size < 8) {
+                return minmaxScalar(data, size, init);
+            }
+
+            auto min = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), max = min;
+            auto i   = 4uz;
+
+            for (; i + 4 <= size; i += 4) {
+                auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                auto less = _mm_cmplt_epi32(v, min);
+                auto more = _mm_cmpgt_epi32(v, max);
+                min       = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, min));
+                max       = _mm_or_si128(_mm_and_si128(more, v), _mm_andnot_si128(more, max));
+            }
+
+            alignas(16) std::int32_t mins[4];
+            alignas(16) std::int32_t maxs[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(mins), min);
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxs), max);
+
+            init = minmaxScalar(mins, 4, init);
+            init = minmaxScalar(maxs, 4, init);
+            return minmaxScalar(data + i, size - i, init);
+        }
+
+        DSA_SIMD_TARGET("sse2")
+        inline MinMax<float> minmaxSse2(const float* data, std::size_t size) noexcept
+        {
+            auto init = MinMax{ data[0], data[0] };
+            if (size < 8) {
+                return minmaxScalar(data, size, init);
+            }
+
+            auto min = _mm_loadu_ps(data), max = min;
+            auto i   = 4uz;
+
+            for (; i + 4 <= size; i += 4) {
+                auto v = _mm_loadu_ps(data + i);
+                min    = _mm_min_ps(min, v);
+                max    = _mm_max_ps(max, v);
+            }
+
+            alignas(16) float mins[4];
+            alignas(16) float maxs[4];
+            _mm_store_ps(mins, min);
+            _mm_store_ps(maxs, max);
+
+            init = minmaxScalar(mins, 4, init);
+            init = minmaxScalar(maxs, 4, init);
+            return minmaxScalar(data + i, size - i, init);
+        }
+
+        // int32 lanes are sign extended to int64 so the sum can't overflow
+        DSA_SIMD_TARGET("avx2")
+        inline std::int64_t sumAvx2(const std::int32_t* data, std::size_t size) noexcept
+        {
+            auto acc0 = _mm256_setzero_si256();
+            auto acc1 = _mm256_setzero_si256();
+            auto i    = 0uz;
+
+            for (; i + 8 <= size; i += 8) {
+                auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                acc0   = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+                acc1   = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+            }
+
+            alignas(32) std::int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar(data + i, size - i);
+        }
+
+        DSA_SIMD_TARGET("avx2")
+        inline double sumAvx2(const float* data, std::size_t size) noexcept
+        {
+            auto acc0 = _mm256_setzero_pd();
+            auto acc1 = _mm256_setzero_pd();
+            auto i    = 0uz;
+
+            for (; i + 8 <= size; i += 8) {
+                acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(data + i)));
+                acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(data + i + 4)));
+            }
+
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar(data + i, size - i);
+        }
+
+        DSA_SIMD_TARGET("sse2")
+        inline std::int64_t sumSse2(const std::int32_t* data, std::size_t size) noexcept
+        {
+            auto acc = _mm_setzero_si128();
+            auto i   = 0uz;
+
+            for (; i + 4 <= size; i += 4) {
+                auto v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                auto sign = _mm_srai_epi32(v, 31);
+                acc       = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+                acc       = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+            }
+
+            alignas(16) std::int64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+
+            return lanes[0] + lanes[1] + sumScalar(data + i, size - i);
+        }
+
+        DSA_SIMD_TARGET("sse2")
+        inline double sumSse2(const float* data, std::size_t size) noexcept
+        {
+            auto acc0 = _mm_setzero_pd();
+            auto acc1 = _mm_setzero_pd();
+            auto i    = 0uz;
+
+            for (; i + 4 <= size; i += 4) {
+                auto v = _mm_loadu_ps(data + i);
+                acc0   = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+                acc1   = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+
+            alignas(16) double lanes[2];
+            _mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+
+            return lanes[0] + lanes[1] + sumScalar(data + i, size - i);
+        }
+#endif
+    }
+
+    inline Isa activeIsa() noexcept
+    {
+        return kernel::isa().load(std::memory_order_relaxed);
+    }
+
+    inline void setIsa(Isa isa) noexcept
+    {
+        kernel::isa().store(std::min(isa, detectIsa()), std::memory_order_relaxed);
+    }
+
+    template <Element T>
+    std::size_t find(std::span<const T> span, T value) noexcept
+    {
+#if DSA_SIMD_X86
+        if constexpr (Vectorized<T>) {
+            switch (activeIsa()) {
+            case Isa::Avx2: return kernel::findAvx2(span.data(), span.size(), value);
+            case Isa::Sse2: return kernel::findSse2(span.data(), span.size(), value);
+            case Isa::Scalar: break;
+            }
+        }
+#endif
+        return kernel::findScalar(span.data(), span.size(), value);
+    }
+
+    template <Element T>
+    std::size_t count(std::span<const T> span, T value) noexcept
+    {
+#if DSA_SIMD_X86
+        if constexpr (Vectorized<T>) {
+            switch (activeIsa()) {
+            case Isa::Avx2: return kernel::countAvx2(span.data(), span.size(), value);
+            case Isa::Sse2: return kernel::countSse2(span.data(), span.size(), value);
+            case Isa::Scalar: break;
+            }
+        }
+#endif
+        return kernel::countScalar(span.data(), span.size(), value);
+    }
+
+    template <Element T>
+    std::optional<MinMax<T>> minmax(std::span<const T> span) noexcept
+    {
+        if (span.empty()) {
+            return std::nullopt;
+        }
+
+#if DSA_SIMD_X86
+        if constexpr (Vectorized<T>) {
+            switch (activeIsa()) {
+            case Isa::Avx2: return kernel::minmaxAvx2(span.data(), span.size());
+            case Isa::Sse2: return kernel::minmaxSse2(span.data(), span.size());
+            case Isa::Scalar: break;
+            }
+        }
+#endif
+        return kernel::minmaxScalar(span.data(), span.size(), MinMax{ span[0], span[0] });
+    }
+
+    template <Element T>
+    Accumulator<T> sum(std::span<const T> span) noexcept
+    {
+#if DSA_SIMD_X86
+        if constexpr (Vectorized<T>) {
+            switch (activeIsa()) {
+            case Isa::Avx2: return kernel::sumAvx2(span.data(), span.size());
+            case Isa::Sse2: return kernel::sumSse2(span.data(), span.size());
+            case Isa::Scalar: break;
+            }
+        }
+#endif
+        return kernel::sumScalar(span.data(), span.size());
+    }
+
+    template <segmented_range C>
+    std::size_t find(const C& container, typename C::value_type value) noexcept
+    {
+        auto offset = 0uz;
+        for (auto segment : dsa::segments(container)) {
+            if (auto pos = simd::find(segment, value); pos != segment.size()) {
+                return offset + pos;
+            }
+            offset += segment.size();
+        }
+        return offset;
+    }
+
+    template <segmented_range C>
+    std::size_t count(const C& container, typename C::value_type value) noexcept
+    {
+        auto result = 0uz;
+        for (auto segment : dsa::segments(container)) {
+            result += simd::count(segment, value);
+        }
+        return result;
+    }
+
+    template <segmented_range C>
+    std::optional<MinMax<typename C::value_type>> minmax(const C& container) noexcept
+    {
+        auto result = std::optional<MinMax<typename C::value_type>>{};
+        for (auto segment : dsa::segments(container)) {
+            if (auto current = simd::minmax(segment); not current.has_value()) {
+                continue;
+            } else if (not result.has_value()) {
+                result = current;
+            } else {
+                result->min = current->min < result->min ? current->min : result->min;
+                result->max = result->max < current->max ? current->max : result->max;
+            }
+        }
+        return result;
+    }
+
+    template <segmented_range C>
+    Accumulator<typename C::value_type> sum(const C& container) noexcept
+    {
+        auto result = Accumulator<typename C::value_type>{};
+        for (auto segment : dsa::segments(container)) {
+            result += simd::sum(segment);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,822 @@
+#pragma once
+
+// NOTE: comparison sorts over random access iterators. they only use iterator arithmetic, so containers
+//       with non-contiguous storage like RootishArray and CircularBuffer are sorted in place.
+//
+//       - pdq_sort: pattern-defeating quicksort (Orson Peters). unstable, O(n log n) worst case by falling
+//         back to heapsort, O(n) on sorted, reversed, and few-unique inputs. the partition is branchless
+//         (block partition) for arithmetic elements in contiguous storage compared with less/greater.
+//       - merge_sort: top-down stable merge sort that only moves the left half of each merge into the
+//         scratch, so the scratch only needs n / 2 elements.
+//       - parallel_merge_sort: each thread merge sorts a chunk, then the runs are merged pairwise, ping-pong
+//         between the range and a full size scratch. every merge round is split evenly between the threads
+//         at the merge path (co-rank) so the last rounds are parallel too.
+//
+//       the comparison must not throw, elements in the scratch would be leaked otherwise.
+
+#include "dsa/array_list.hpp"
+#include "dsa/raw_buffer.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+    class PdqSort
+    {
+    public:
+        static constexpr std::ptrdiff_t s_insertionSortSize    = 24;
+        static constexpr std::ptrdiff_t s_nintherSize          = 128;
+        static constexpr std::ptrdiff_t s_partialInsertionMove = 8;
+        static constexpr std::size_t    s_blockSize            = 64;
+
+        template <std::random_access_iterator It, typename Comp>
+            requires std::sortable<It, Comp>
+        static void sort(It first, It last, Comp& comp);
+
+    private:
+        template <typename It, typename Comp>
+        static constexpr bool s_branchless = std::contiguous_iterator<It>
+                                         and std::is_arithmetic_v<std::iter_value_t<It>>
+                                         and (std::same_as<Comp, std::ranges::less>
+                                              or std::same_as<Comp, std::ranges::greater>
+                                              or std::same_as<Comp, std::less<>>
+                                              or std::same_as<Comp, std::greater<>>
+                                              or std::same_as<Comp, std::less<std::iter_value_t<It>>>
+                                              or std::same_as<Comp, std::greater<std::iter_value_t<It>>>);
+
+        template <typename It, typename Comp>
+        static void loop(It first, It last, Comp& comp, int badAllowed, bool leftmost);
+
+        // unguarded assumes there is an element before first that is not greater than any in the range
+        template <bool Unguarded, typename It, typename Comp>
+        static void insertionSort(It first, It last, Comp& comp);
+
+        // gives up after s_partialInsertionMove moves, returns whether the range got sorted
+        template <typename It, typename Comp>
+        static bool partialInsertionSort(It first, It last, Comp& comp);
+
+        template <typename It, typename Comp>
+        static void sort3(It a, It b, It c, Comp& comp);
+
+        // elements equal to the pivot go to the right, returns the pivot position and whether the range was
+        // already partitioned
+        template <typename It, typename Comp>
+        static std::pair<It, bool> partitionRight(It first, It last, Comp& comp);
+
+        template <typename It, typename Comp>
+        static std::pair<It, bool> partitionRightBranchless(It first, It last, Comp& comp);
+
+        // elements equal to the pivot go to the left, used when the pivot equals the predecessor of the range
+        template <typename It, typename Comp>
+        static It partitionLeft(It first, It last, Comp& comp);
+
+        template <typename It>
+        static void swapOffsets(
+            It                  first,
+            It                  last,
+            const std::uint8_t* offsetsLeft,
+            const std::uint8_t* offsetsRight,
+            std::size_t         count,
+            bool                useSwaps
+        );
+    };
+
+    class MergeSort
+    {
+    public:
+        // runs shorter than this are insertion sorted
+        static constexpr std::ptrdiff_t s_runSize = 32;
+
+        // below this size per thread the parallel variant falls back to the sequential one
+        static constexpr std::size_t s_parallelSize = 1uz << 14;
+
+        // scratch is grown to n / 2 + 1 if it is smaller, so it can be reused between calls
+        template <std::random_access_iterator It, typename Comp>
+            requires std::sortable<It, Comp>
+        static void sort(It first, It last, Comp& comp, RawBuffer<std::iter_value_t<It>>& scratch);
+
+        // scratch is grown to n if it is smaller. threads = 0 uses all hardware threads.
+        template <std::random_access_iterator It, typename Comp>
+            requires std::sortable<It, Comp>
+        static void sortParallel(
+            It                                 first,
+            It                                 last,
+            Comp&                              comp,
+            RawBuffer<std::iter_value_t<It>>& scratch,
+            std::size_t                        threads
+        );
+
+    private:
+        // sort [first, last) using scratch[offset, offset + (last - first) / 2 + 1)
+        template <typename It, typename Comp, typename T>
+        static void sortRun(It first, It last, Comp& comp, RawBuffer<T>& scratch, std::size_t offset);
+
+        // merge [first, mid) and [mid, last) moving only the left half out of the range
+        template <typename It, typename Comp, typename T>
+        static void mergeHalf(
+            It            first,
+            It            mid,
+            It            last,
+            Comp&         comp,
+            RawBuffer<T>& scratch,
+            std::size_t   offset
+        );
+
+        // number of elements taken from the left run among the first k of the stable merge of left and right
+        template <typename Left, typename Right, typename Comp>
+        static std::size_t coRank(
+            std::size_t k,
+            Left&&      left,
+            std::size_t leftSize,
+            Right&&     right,
+            std::size_t rightSize,
+            Comp&       comp
+        );
+    };
+
+    template <std::random_access_iterator It, typename Comp = std::ranges::less>
+        requires std::sortable<It, Comp>
+    void pdq_sort(It first, It last, Comp comp = {})
+    {
+        PdqSort::sort(first, last, comp);
+    }
+
+    template <std::ranges::random_access_range R, typename Comp = std::ranges::less>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp>
+    void pdq_sort(R&& range, Comp comp = {})
+    {
+        PdqSort::sort(std::ranges::begin(range), std::ranges::end(range), comp);
+    }
+
+    template <std::ranges::random_access_range R, typename Comp = std::ranges::less>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp>
+    void merge_sort(R&& range, Comp comp = {})
+    {
+        auto scratch = RawBuffer<std::ranges::range_value_t<R>>{};
+        MergeSort::sort(std::ranges::begin(range), std::ranges::end(range), comp, scratch);
+    }
+
+    template <std::ranges::random_access_range R, typename Comp>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp>
+    void merge_sort(R&& range, Comp comp, RawBuffer<std::ranges::range_value_t<R>>& scratch)
+    {
+        MergeSort::sort(std::ranges::begin(range), std::ranges::end(range), comp, scratch);
+    }
+
+    template <std::ranges::random_access_range R, typename Comp = std::ranges::less>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp>
+    void parallel_merge_sort(R&& range, Comp comp = {}, std::size_t threads = 0)
+    {
+        auto scratch = RawBuffer<std::ranges::range_value_t<R>>{};
+        MergeSort::sortParallel(std::ranges::begin(range), std::ranges::end(range), comp, scratch, threads);
+    }
+
+    template <std::ranges::random_access_range R, typename Comp>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp>
+    void parallel_merge_sort(
+        R&&                                        range,
+        Comp                                       comp,
+        RawBuffer<std::ranges::range_value_t<R>>& scratch,
+        std::size_t                                threads = 0
+    )
+    {
+        MergeSort::sortParallel(std::ranges::begin(range), std::ranges::end(range), comp, scratch, threads);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <std::random_access_iterator It, typename Comp>
+        requires std::sortable<It, Comp>
+    void PdqSort::sort(It first, It last, Comp& comp)
+    {
+        auto size = last - first;
+        if (size < 2) {
+            return;
+        }
+        loop(first, last, comp, static_cast<int>(std::bit_width(static_cast<std::size_t>(size))), true);
+    }
+
+    template <typename It, typename Comp>
+    void PdqSort::loop(It first, It last, Comp& comp, int badAllowed, bool leftmost)
+    {
+        while (true) {
+            auto size = last - first;
+
+            if (size < s_insertionSortSize) {
+                if (leftmost) {
+                    insertionSort<false>(first, last, comp);
+                } else {
+                    insertionSort<true>(first, last, comp);
+                }
+                return;
+            }
+
+            // the pivot is moved to first
+            auto half = size / 2;
+            if (size > s_nintherSize) {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                std::iter_swap(first, first + half);
+            } else {
+                sort3(first + half, first, last - 1, comp);
+            }
+
+            // the pivot equals the predecessor (which is the pivot of a previous partition) so every element
+            // equal to it can be put in place at once. this is what makes many duplicates linear.
+            if (not leftmost and not std::invoke(comp, *(first - 1), *first)) {
+                first = partitionLeft(first, last, comp) + 1;
+                continue;
+            }
+
+            auto [pivot, partitioned] = [&] {
+                if constexpr (s_branchless<It, Comp>) {
+                    return partitionRightBranchless(first, last, comp);
+                } else {
+                    return partitionRight(first, last, comp);
+                }
+            }();
+
+            auto leftSize  = pivot - first;
+            auto rightSize = last - (pivot + 1);
+
+            if (leftSize < size / 8 or rightSize < size / 8) {
+                if (--badAllowed == 0) {
+                    std::make_heap(first, last, comp);
+                    std::sort_heap(first, last, comp);
+                    return;
+                }
+
+                // break the patterns that made the partition unbalanced
+                if (leftSize >= s_insertionSortSize) {
+                    std::iter_swap(first, first + leftSize / 4);
+                    std::iter_swap(pivot - 1, pivot - leftSize / 4);
+
+                    if (leftSize > s_nintherSize) {
+                        std::iter_swap(first + 1, first + (leftSize / 4 + 1));
+                        std::iter_swap(first + 2, first + (leftSize / 4 + 2));
+                        std::iter_swap(pivot - 2, pivot - (leftSize / 4 + 1));
+                        std::iter_swap(pivot - 3, pivot - (leftSize / 4 + 2));
+                    }
+                }
+
+                if (rightSize >= s_insertionSortSize) {
+                    std::iter_swap(pivot + 1, pivot + (1 + rightSize / 4));
+                    std::iter_swap(last - 1, last - rightSize / 4);
+
+                    if (rightSize > s_nintherSize) {
+                        std::iter_swap(pivot + 2, pivot + (2 + rightSize / 4));
+                        std::iter_swap(pivot + 3, pivot + (3 + rightSize / 4));
+                        std::iter_swap(last - 2, last - (1 + rightSize / 4));
+                        std::iter_swap(last - 3, last - (2 + rightSize / 4));
+                    }
+                }
+            } else if (partitioned) {
+                // no swap was needed, the input is likely (almost) sorted
+                auto leftSorted = partialInsertionSort(first, pivot, comp);
+                if (leftSorted and partialInsertionSort(pivot + 1, last, comp)) {
+                    return;
+                }
+            }
+
+            // recurse into the left and loop on the right
+            loop(first, pivot, comp, badAllowed, leftmost);
+            first    = pivot + 1;
+            leftmost = false;
+        }
+    }
+
+    template <bool Unguarded, typename It, typename Comp>
+    void PdqSort::insertionSort(It first, It last, Comp& comp)
+    {
+        if (first == last) {
+            return;
+        }
+
+        for (auto current = first + 1; current != last; ++current) {
+            auto sift = current;
+            auto prev = current - 1;
+
+            if (std::invoke(comp, *sift, *prev)) {
+                auto value = std::ranges::iter_move(sift);
+                do {
+                    *sift-- = std::ranges::iter_move(prev);
+                } while ((Unguarded or sift != first) and std::invoke(comp, value, *--prev));
+                *sift = std::move(value);
+            }
+        }
+    }
+
+    template <typename It, typename Comp>
+    bool PdqSort::partialInsertionSort(It first, It last, Comp& comp)
+    {
+        if (first == last) {
+            return true;
+        }
+
+        auto moves = std::ptrdiff_t{ 0 };
+        for (auto current = first + 1; current != last; ++current) {
+            if (moves > s_partialInsertionMove) {
+                return false;
+            }
+
+            auto sift = current;
+            auto prev = current - 1;
+
+            if (std::invoke(comp, *sift, *prev)) {
+                auto value = std::ranges::iter_move(sift);
+                do {
+                    *sift-- = std::ranges::iter_move(prev);
+                } while (sift != first and std::invoke(comp, value, *--prev));
+                *sift = std::move(value);
+
+                moves += current - sift;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename It, typename Comp>
+    void PdqSort::sort3(It a, It b, It c, Comp& comp)
+    {
+        auto sort2 = [&](It x, It y) {
+            if (std::invoke(comp, *y, *x)) {
+                std::iter_swap(x, y);
+            }
+        };
+
+        sort2(a, b);
+        sort2(b, c);
+        sort2(a, b);
+    }
+
+    // the loops are unguarded: the median of 3 guarantees an element not less than the pivot on the right
+    // and the pivot itself stops the scan on the left
+    template <typename It, typename Comp>
+    std::pair<It, bool> PdqSort::partitionRight(It first, It last, Comp& comp)
+    {
+        auto pivot = std::ranges::iter_move(first);
+        auto left  = first;
+        auto right = last;
+
+        while (std::invoke(comp, *++left, pivot)) { }
+
+        if (left - 1 == first) {
+            while (left < right and not std::invoke(comp, *--right, pivot)) { }
+        } else {
+            while (not std::invoke(comp, *--right, pivot)) { }
+        }
+
+        auto partitioned = left >= right;
+
+        while (left < right) {
+            std::iter_swap(left, right);
+            while (std::invoke(comp, *++left, pivot)) { }
+            while (not std::invoke(comp, *--right, pivot)) { }
+        }
+
+        auto pivotPos = left - 1;
+        *first        = std::ranges::iter_move(pivotPos);
+        *pivotPos     = std::move(pivot);
+
+        return { pivotPos, partitioned };
+    }
+
+    // the comparisons are stored as offsets into small blocks and the misplaced elements are swapped in bulk,
+    // so there is no branch that depends on the result of a comparison
+    template <typename It, typename Comp>
+    std::pair<It, bool> PdqSort::partitionRightBranchless(It first, It last, Comp& comp)
+    {
+        auto pivot = std::ranges::iter_move(first);
+        auto left  = first;
+        auto right = last;
+
+        while (std::invoke(comp, *++left, pivot)) { }
+
+        if (left - 1 == first) {
+            while (left < right and not std::invoke(comp, *--right, pivot)) { }
+        } else {
+            while (not std::invoke(comp, *--right, pivot)) { }
+        }
+
+        auto partitioned = left >= right;
+
+        if (not partitioned) {
+            std::iter_swap(left, right);
+            ++left;
+
+            alignas(64) std::uint8_t offsetsLeft[s_blockSize];
+            alignas(64) std::uint8_t offsetsRight[s_blockSize];
+
+            auto baseLeft   = left;
+            auto baseRight  = right;
+            auto countLeft  = 0uz;
+            auto countRight = 0uz;
+            auto startLeft  = 0uz;
+            auto startRight = 0uz;
+
+            while (left < right) {
+                // fill the empty side(s) with as many elements as possible, split evenly if both are empty
+                auto unknown    = static_cast<std::size_t>(right - left);
+                auto splitLeft  = countLeft == 0 ? (countRight == 0 ? unknown / 2 : unknown) : 0;
+                auto splitRight = countRight == 0 ? (unknown - splitLeft) : 0;
+
+                for (auto i = 0uz, n = std::min(splitLeft, s_blockSize); i < n; ++i) {
+                    offsetsLeft[countLeft] = static_cast<std::uint8_t>(i);
+                    countLeft += not std::invoke(comp, *left, pivot);
+                    ++left;
+                }
+
+                for (auto i = 0uz, n = std::min(splitRight, s_blockSize); i < n;) {
+                    offsetsRight[countRight] = static_cast<std::uint8_t>(++i);
+                    countRight += std::invoke(comp, *--right, pivot);
+                }
+
+                auto count = std::min(countLeft, countRight);
+                swapOffsets(
+                    baseLeft,
+                    baseRight,
+                    offsetsLeft + startLeft,
+                    offsetsRight + startRight,
+                    count,
+                    countLeft == countRight
+                );
+
+                countLeft  -= count;
+                countRight -= count;
+                startLeft  += count;
+                startRight += count;
+
+                if (countLeft == 0) {
+                    startLeft = 0;
+                    baseLeft  = left;
+                }
+                if (countRight == 0) {
+                    startRight = 0;
+                    baseRight  = right;
+                }
+            }
+
+            // the remaining misplaced elements of one side are swapped to the boundary
+            if (countLeft > 0) {
+                while (countLeft-- > 0) {
+                    std::iter_swap(baseLeft + offsetsLeft[startLeft + countLeft], --right);
+                }
+                left = right;
+            }
+            if (countRight > 0) {
+                while (countRight-- > 0) {
+                    std::iter_swap(baseRight - offsetsRight[startRight + countRight], left);
+                    ++left;
+                }
+                right = left;
+            }
+        }
+
+        auto pivotPos = left - 1;
+        *first        = std::ranges::iter_move(pivotPos);
+        *pivotPos     = std::move(pivot);
+
+        return { pivotPos, partitioned };
+    }
+
+    template <typename It, typename Comp>
+    It PdqSort::partitionLeft(It first, It last, Comp& comp)
+    {
+        auto pivot = std::ranges::iter_move(first);
+        auto left  = first;
+        auto right = last;
+
+        while (std::invoke(comp, pivot, *--right)) { }
+
+        if (right + 1 == last) {
+            while (left < right and not std::invoke(comp, pivot, *++left)) { }
+        } else {
+            while (not std::invoke(comp, pivot, *++left)) { }
+        }
+
+        while (left < right) {
+            std::iter_swap(left, right);
+            while (std::invoke(comp, pivot, *--right)) { }
+            while (not std::invoke(comp, pivot, *++left)) { }
+        }
+
+        *first = std::ranges::iter_move(right);
+        *right = std::move(pivot);
+
+        return right;
+    }
+
+    // with the same number of elements on both sides a cyclic permutation needs fewer moves than swaps
+    template <typename It>
+    void PdqSort::swapOffsets(
+        It                  first,
+        It                  last,
+        const std::uint8_t* offsetsLeft,
+        const std::uint8_t* offsetsRight,
+        std::size_t         count,
+        bool                useSwaps
+    )
+    {
+        if (useSwaps) {
+            for (auto i = 0uz; i < count; ++i) {
+                std::iter_swap(first + offsetsLeft[i], last - offsetsRight[i]);
+            }
+        } else if (count > 0) {
+            auto left  = first + offsetsLeft[0];
+            auto right = last - offsetsRight[0];
+            auto temp  = std::ranges::iter_move(left);
+
+            *left = std::ranges::iter_move(right);
+            for (auto i = 1uz; i < count; ++i) {
+                left   = first + offsetsLeft[i];
+                *right = std::ranges::iter_move(left);
+                right  = last - offsetsRight[i];
+                *left  = std::ranges::iter_move(right);
+            }
+            *right = std::move(temp);
+        }
+    }
+
+    template <std::random_access_iterator It, typename Comp>
+        requires std::sortable<It, Comp>
+    void MergeSort::sort(It first, It last, Comp& comp, RawBuffer<std::iter_value_t<It>>& scratch)
+    {
+        auto size = static_cast<std::size_t>(last - first);
+        if (size < 2) {
+            return;
+        }
+
+        if (scratch.size() < size / 2 + 1) {
+            scratch = RawBuffer<std::iter_value_t<It>>{ size / 2 + 1 };
+        }
+
+        sortRun(first, last, comp, scratch, 0);
+    }
+
+    // the threads run in lockstep: sort own chunk -> barrier -> [find own share of the output -> barrier ->
+    // merge the share -> barrier (next round)]*. the completion step runs on a single thread.
+    template <std::random_access_iterator It, typename Comp>
+        requires std::sortable<It, Comp>
+    void MergeSort::sortParallel(
+        It                                 first,
+        It                                 last,
+        Comp&                              comp,
+        RawBuffer<std::iter_value_t<It>>& scratch,
+        std::size_t                        threads
+    )
+    {
+        using T = std::iter_value_t<It>;
+
+        auto size = static_cast<std::size_t>(last - first);
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, size / s_parallelSize);
+
+        if (threads <= 1) {
+            sort(first, last, comp, scratch);
+            return;
+        }
+
+        if (scratch.size() < size) {
+            scratch = RawBuffer<T>{ size };
+        }
+
+        auto at = [&](std::size_t i) { return first + static_cast<std::ptrdiff_t>(i); };
+
+        // boundaries of the sorted runs, the number of runs halves every round
+        auto bounds = ArrayList<std::size_t>{};
+        for (auto t = 0uz; t <= threads; ++t) {
+            bounds.push_back(t * size / threads);
+        }
+
+        // the boundaries of the next round, reserved up front since a completion step must not throw and
+        // reused every round
+        auto next = ArrayList<std::size_t>{};
+        next.reserve(bounds.size());
+
+        auto inScratch = false;
+
+        auto nextRound = [&]() noexcept {
+            next.clear();
+            for (auto i = 0uz; i < bounds.size(); i += 2) {
+                next.push_back(auto{ bounds.data()[i] });
+            }
+            if (bounds.size() % 2 == 0) {
+                next.push_back(auto{ bounds.data()[bounds.size() - 1] });
+            }
+
+            bounds.swap(next);
+            inScratch = not inScratch;
+        };
+
+        auto sync  = std::barrier{ static_cast<std::ptrdiff_t>(threads) };
+        auto round = std::barrier{ static_cast<std::ptrdiff_t>(threads), nextRound };
+
+        // the part of a pair of runs that is merged into [outBegin, outEnd) of the output: [i, iEnd) of the
+        // left run and [j, jEnd) of the right run
+        struct Share
+        {
+            std::size_t begin, mid, outBegin, outEnd, i, j, iEnd, jEnd;
+        };
+
+        auto source = [&](std::size_t index) -> T& { return inScratch ? scratch.at(index) : *at(index); };
+
+        // the co-rank search reads elements of other threads' shares so it must be done for every thread
+        // before any element is moved
+        auto planShares = [&](std::size_t outBegin, std::size_t outEnd, ArrayList<Share>& shares) {
+            shares.clear();
+
+            for (auto pair = 0uz; pair + 1 < bounds.size(); pair += 2) {
+                auto begin = bounds.data()[pair];
+                auto mid   = bounds.data()[pair + 1];
+                auto end   = bounds.data()[std::min(pair + 2, bounds.size() - 1)];
+
+                auto lo = std::max(outBegin, begin);
+                auto hi = std::min(outEnd, end);
+                if (lo >= hi) {
+                    continue;
+                }
+
+                auto left  = [&](std::size_t i) -> T& { return source(begin + i); };
+                auto right = [&](std::size_t i) -> T& { return source(mid + i); };
+
+                auto i    = coRank(lo - begin, left, mid - begin, right, end - mid, comp);
+                auto iEnd = coRank(hi - begin, left, mid - begin, right, end - mid, comp);
+
+                shares.push_back({ begin, mid, lo, hi, i, lo - begin - i, iEnd, hi - begin - iEnd });
+            }
+        };
+
+        auto mergeShare = [&](const Share& share) {
+            auto [begin, mid, outBegin, outEnd, i, j, iEnd, jEnd] = share;
+
+            for (auto out = outBegin; out < outEnd; ++out) {
+                auto takeRight = i == iEnd
+                              or (j < jEnd and std::invoke(comp, source(mid + j), source(begin + i)));
+                auto index = takeRight ? mid + j++ : begin + i++;
+
+                if (inScratch) {
+                    *at(out) = std::move(scratch.at(index));
+                    scratch.destroy(index);
+                } else {
+                    scratch.construct(out, std::ranges::iter_move(at(index)));
+                }
+            }
+        };
+
+        auto worker = [&](std::size_t t) {
+            auto begin  = t * size / threads;
+            auto end    = (t + 1) * size / threads;
+            auto shares = ArrayList<Share>{};
+
+            sortRun(at(begin), at(end), comp, scratch, begin);
+            sync.arrive_and_wait();
+
+            while (bounds.size() > 2) {
+                planShares(begin, end, shares);
+                sync.arrive_and_wait();
+
+                for (const auto& share : shares) {
+                    mergeShare(share);
+                }
+                round.arrive_and_wait();
+            }
+
+            if (inScratch) {
+                for (auto i = begin; i < end; ++i) {
+                    *at(i) = std::move(scratch.at(i));
+                    scratch.destroy(i);
+                }
+            }
+        };
+
+        {
+            auto pool = ArrayList<std::jthread>{};
+            pool.reserve(threads - 1);
+            for (auto t = 1uz; t < threads; ++t) {
+                pool.push_back(std::jthread{ worker, t });
+            }
+            worker(0);
+        }
+    }
+
+    template <typename It, typename Comp, typename T>
+    void MergeSort::sortRun(It first, It last, Comp& comp, RawBuffer<T>& scratch, std::size_t offset)
+    {
+        auto size = last - first;
+
+        if (size <= s_runSize) {
+            for (auto current = first + 1; current < last; ++current) {
+                auto sift = current;
+                auto prev = current - 1;
+
+                if (std::invoke(comp, *sift, *prev)) {
+                    auto value = std::ranges::iter_move(sift);
+                    do {
+                        *sift-- = std::ranges::iter_move(prev);
+                    } while (sift != first and std::invoke(comp, value, *--prev));
+                    *sift = std::move(value);
+                }
+            }
+            return;
+        }
+
+        auto mid = first + size / 2;
+        sortRun(first, mid, comp, scratch, offset);
+        sortRun(mid, last, comp, scratch, offset);
+
+        // already in order, common for sorted and reversed-then-sorted runs
+        if (not std::invoke(comp, *mid, *(mid - 1))) {
+            return;
+        }
+
+        mergeHalf(first, mid, last, comp, scratch, offset);
+    }
+
+    // the output never overtakes the right half, so only the left half needs to be moved out
+    template <typename It, typename Comp, typename T>
+    void MergeSort::mergeHalf(
+        It            first,
+        It            mid,
+        It            last,
+        Comp&         comp,
+        RawBuffer<T>& scratch,
+        std::size_t   offset
+    )
+    {
+        auto leftSize = static_cast<std::size_t>(mid - first);
+        for (auto i = 0uz; i < leftSize; ++i) {
+            scratch.construct(offset + i, std::ranges::iter_move(first + static_cast<std::ptrdiff_t>(i)));
+        }
+
+        auto out   = first;
+        auto left  = 0uz;
+        auto right = mid;
+
+        while (left < leftSize and right != last) {
+            if (std::invoke(comp, *right, scratch.at(offset + left))) {
+                *out = std::ranges::iter_move(right);
+                ++right;
+            } else {
+                *out = std::move(scratch.at(offset + left));
+                scratch.destroy(offset + left++);
+            }
+            ++out;
+        }
+
+        for (; left < leftSize; ++left, ++out) {
+            *out = std::move(scratch.at(offset + left));
+            scratch.destroy(offset + left);
+        }
+    }
+
+    // binary search for i such that left[0, i) and right[0, k - i) are exactly the first k elements of the
+    // merge, ties are taken from the left to keep the merge stable
+    template <typename Left, typename Right, typename Comp>
+    std::size_t MergeSort::coRank(
+        std::size_t k,
+        Left&&      left,
+        std::size_t leftSize,
+        Right&&     right,
+        std::size_t rightSize,
+        Comp&       comp
+    )
+    {
+        auto lo = k > rightSize ? k - rightSize : 0uz;
+        auto hi = std::min(k, leftSize);
+
+        while (lo < hi) {
+            auto i = lo + (hi - lo) / 2;
+            auto j = k - i;
+
+            // right[j - 1] is not less than left[i], so left[i] comes first and must be taken
+            if (j > 0 and not std::invoke(comp, right(j - 1), left(i))) {
+                lo = i + 1;
+            } else {
+                hi = i;
+            }
+        }
+
+        return lo;
+    }
+}
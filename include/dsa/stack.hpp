@@ -3,6 +3,7 @@
 // NOTE: Stack implementation based on reference 1
 
 #include <concepts>
+#include <optional>
 #include <utility>
 
 #include "common.hpp"
@@ -82,6 +83,19 @@ namespace dsa
             }
         }
 
+        // push each element in order, the last element of the range ends up on top
+        template <ContainerCompatibleRange<T> R>
+        void push_range(R&& range)
+        {
+            if constexpr (not FrontStackCompatible<C, T> and requires { m_container.append_range(range); }) {
+                m_container.append_range(std::forward<R>(range));
+            } else {
+                for (auto&& value : range) {
+                    push(T(std::forward<decltype(value)>(value)));
+                }
+            }
+        }
+
         T pop()
         {
             if constexpr (FrontStackCompatible<C, T>) {
@@ -91,6 +105,15 @@ namespace dsa
             }
         }
 
+        // pop() returning std::nullopt when empty instead of throwing, see dsa/error.hpp
+        std::optional<T> try_pop()
+        {
+            if (empty()) {
+                return std::nullopt;
+            }
+            return pop();
+        }
+
     private:
         Container m_container;
     };
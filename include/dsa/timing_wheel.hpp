@@ -0,0 +1,376 @@
+#pragma once
+
+// NOTE: hierarchical TimingWheel (Varghese and Lauck, "Hashed and Hierarchical Timing Wheels"). there are
+//       `levels` wheels of 2^slotBits buckets each, a bucket of level k covers 2^(k * slotBits) ticks. every
+//       wheel is a CircularBuffer of buckets whose front is the current slot, so turning a wheel is a
+//       pop_front/push_back of one bucket. a timer is put into the lowest level that can hold its deadline
+//       and moved down (cascaded) when the bucket it is in becomes the current slot of its level.
+//
+//       the buckets are circular doubly linked lists of nodes from a pool, each bucket is the index of its
+//       sentinel node so turning a wheel doesn't touch the timers and cancel is an O(1) unlink. the pool
+//       reuses freed nodes, a TimerId carries a generation so stale ids are rejected.
+//
+//       deadlines past the last level are parked in the farthest bucket of the last level and re-placed each
+//       time they come around. advance() skips over ticks while the lower levels are empty.
+
+#include "dsa/array_list.hpp"
+#include "dsa/circular_buffer.hpp"
+#include "dsa/error.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace dsa
+{
+    template <typename T>
+    concept TimingWheelPayload = std::movable<T>;
+
+    template <TimingWheelPayload Payload>
+    class TimingWheel
+    {
+    public:
+        using Tick = std::uint64_t;
+
+        struct TimerId
+        {
+            std::uint32_t m_index      = std::numeric_limits<std::uint32_t>::max();
+            std::uint32_t m_generation = 0;
+
+            bool operator==(const TimerId&) const = default;
+        };
+
+        static constexpr std::size_t s_defaultSlotBits = 8;
+        static constexpr std::size_t s_defaultLevels   = 4;
+        static constexpr std::size_t s_maxSlotBits     = 24;
+
+        // slotBits must not exceed s_maxSlotBits and slotBits * levels must not exceed 64
+        explicit TimingWheel(
+            Tick        now      = 0,
+            std::size_t slotBits = s_defaultSlotBits,
+            std::size_t levels   = s_defaultLevels
+        );
+
+        // a deadline that is not after now() fires on the next tick
+        TimerId schedule(Tick deadline, Payload payload);
+        TimerId scheduleAfter(Tick delay, Payload payload)
+        {
+            return schedule(m_now + delay, std::move(payload));
+        }
+
+        // returns false if the timer has already fired or been cancelled
+        bool cancel(TimerId id);
+
+        // fire every timer whose deadline is not after now in deadline order, the order of timers with the
+        // same deadline is unspecified. fn may schedule and cancel timers. returns the number of timers fired
+        template <typename Fn>
+            requires std::invocable<Fn&, Payload&&>
+        std::size_t advance(Tick now, Fn&& fn);
+
+        void clear() noexcept;
+
+        bool contains(TimerId id) const noexcept;
+
+        Tick        now() const noexcept { return m_now; }
+        std::size_t size() const noexcept { return m_size; }
+        std::size_t levels() const noexcept { return m_wheels.size(); }
+        std::size_t slots() const noexcept { return std::size_t{ 1 } << m_slotBits; }
+
+    private:
+        using Index  = std::uint32_t;
+        using Bucket = Index;    // sentinel node of the bucket list
+
+        static constexpr Index s_null = std::numeric_limits<Index>::max();
+
+        struct Node
+        {
+            std::optional<Payload> m_payload    = std::nullopt;    // empty for sentinels and free nodes
+            Tick                   m_deadline   = 0;
+            Index                  m_prev       = s_null;
+            Index                  m_next       = s_null;
+            std::uint32_t          m_generation = 0;
+            std::uint32_t          m_level      = 0;
+        };
+
+        ArrayList<Node>                   m_nodes      = {};
+        ArrayList<CircularBuffer<Bucket>> m_wheels     = {};
+        ArrayList<std::size_t>            m_levelSizes = {};
+
+        Tick        m_now      = 0;
+        std::size_t m_slotBits = 0;
+        std::size_t m_size     = 0;
+        Index       m_free     = s_null;
+
+        // unchecked access
+        Node&       node(Index index) noexcept { return m_nodes.data()[index]; }
+        const Node& node(Index index) const noexcept { return m_nodes.data()[index]; }
+
+        Index acquire();
+        void  release(Index index) noexcept;
+
+        void append(Bucket bucket, Index index) noexcept;
+        void unlink(Index index) noexcept;
+        bool empty(Bucket bucket) const noexcept { return node(bucket).m_next == bucket; }
+
+        void place(Index index) noexcept;    // into the lowest level that can hold its deadline
+        void turn();                         // next tick: turn the wheels and cascade
+
+        template <typename Fn>
+        std::size_t fire(Fn& fn);    // the current slot of the lowest level
+    };
+}
+
+// -----------------------------------------------------------------------------
+// implementation detail
+// -----------------------------------------------------------------------------
+
+namespace dsa
+{
+    template <TimingWheelPayload Payload>
+    TimingWheel<Payload>::TimingWheel(Tick now, std::size_t slotBits, std::size_t levels)
+        : m_now{ now }
+        , m_slotBits{ slotBits }
+    {
+        if (slotBits == 0 or slotBits > s_maxSlotBits or levels == 0 or slotBits * levels > 64) {
+            fail<std::invalid_argument>("Invalid wheel shape: {} levels of 2^{} slots", levels, slotBits);
+        }
+
+        auto policy = BufferPolicy{
+            .m_capacity = BufferCapacityPolicy::FixedCapacity,
+            .m_store    = BufferStorePolicy::ThrowOnFull,
+        };
+
+        for (auto level = 0uz; level < levels; ++level) {
+            auto& wheel = m_wheels.push_back(CircularBuffer<Bucket>{ slots(), policy });
+            for (auto slot = 0uz; slot < slots(); ++slot) {
+                auto sentinel = acquire();
+                node(sentinel).m_prev = node(sentinel).m_next = sentinel;
+                wheel.push_back(auto{ sentinel });
+            }
+            m_levelSizes.push_back(0);
+        }
+    }
+
+    template <TimingWheelPayload Payload>
+    auto TimingWheel<Payload>::schedule(Tick deadline, Payload payload) -> TimerId
+    {
+        auto  index      = acquire();
+        auto& timer      = node(index);
+        timer.m_payload  = std::move(payload);
+        timer.m_deadline = std::max(deadline, m_now + 1);    // the current slot has already fired
+
+        place(index);
+        ++m_size;
+
+        return { index, timer.m_generation };
+    }
+
+    template <TimingWheelPayload Payload>
+    bool TimingWheel<Payload>::cancel(TimerId id)
+    {
+        if (not contains(id)) {
+            return false;
+        }
+
+        unlink(id.m_index);
+        --m_levelSizes.data()[node(id.m_index).m_level];
+        --m_size;
+        release(id.m_index);
+
+        return true;
+    }
+
+    template <TimingWheelPayload Payload>
+    template <typename Fn>
+        requires std::invocable<Fn&, Payload&&>
+    std::size_t TimingWheel<Payload>::advance(Tick now, Fn&& fn)
+    {
+        if (now < m_now) {
+            fail<std::invalid_argument>("Cannot advance back in time: {} -> {}", m_now, now);
+        }
+
+        // leftover of an earlier advance interrupted by an exception from fn
+        auto fired = fire(fn);
+
+        while (m_now < now) {
+            auto lowest = 0uz;
+            while (lowest < levels() and m_levelSizes.data()[lowest] == 0) {
+                ++lowest;
+            }
+
+            if (lowest == levels()) {
+                m_now = now;
+                break;
+            }
+
+            // the wheels below the lowest non-empty level are empty so they don't have to be turned until the
+            // lowest level turns
+            if (lowest > 0) {
+                auto shift    = lowest * m_slotBits;
+                auto boundary = ((m_now >> shift) + 1) << shift;
+                m_now         = std::min(now, boundary - 1);
+                if (m_now == now) {
+                    break;
+                }
+            }
+
+            turn();
+            fired += fire(fn);
+        }
+
+        return fired;
+    }
+
+    template <TimingWheelPayload Payload>
+    void TimingWheel<Payload>::clear() noexcept
+    {
+        for (auto& wheel : m_wheels) {
+            for (auto bucket : wheel) {
+                while (not empty(bucket)) {
+                    auto index = node(bucket).m_next;
+                    unlink(index);
+                    release(index);
+                }
+            }
+        }
+
+        std::ranges::fill(m_levelSizes, 0uz);
+        m_size = 0;
+    }
+
+    template <TimingWheelPayload Payload>
+    bool TimingWheel<Payload>::contains(TimerId id) const noexcept
+    {
+        return id.m_index < m_nodes.size()
+           and node(id.m_index).m_generation == id.m_generation
+           and node(id.m_index).m_payload.has_value();
+    }
+
+    template <TimingWheelPayload Payload>
+    auto TimingWheel<Payload>::acquire() -> Index
+    {
+        if (m_free != s_null) {
+            auto index = m_free;
+            m_free     = node(index).m_next;
+            return index;
+        }
+
+        if (m_nodes.size() >= s_null) {
+            fail<std::length_error>("TimingWheel node pool is exhausted");
+        }
+
+        m_nodes.push_back(Node{});
+        return static_cast<Index>(m_nodes.size() - 1);
+    }
+
+    template <TimingWheelPayload Payload>
+    void TimingWheel<Payload>::release(Index index) noexcept
+    {
+        auto& free = node(index);
+        free.m_payload.reset();
+        free.m_next = m_free;
+        ++free.m_generation;
+
+        m_free = index;
+    }
+
+    template <TimingWheelPayload Payload>
+    void TimingWheel<Payload>::append(Bucket bucket, Index index) noexcept
+    {
+        auto last = node(bucket).m_prev;
+
+        node(index).m_prev  = last;
+        node(index).m_next  = bucket;
+        node(last).m_next   = index;
+        node(bucket).m_prev = index;
+    }
+
+    template <TimingWheelPayload Payload>
+    void TimingWheel<Payload>::unlink(Index index) noexcept
+    {
+        auto& timer = node(index);
+
+        node(timer.m_prev).m_next = timer.m_next;
+        node(timer.m_next).m_prev = timer.m_prev;
+    }
+
+    template <TimingWheelPayload Payload>
+    void TimingWheel<Payload>::place(Index index) noexcept
+    {
+        auto& timer = node(index);
+
+        for (auto level = 0uz; level < levels(); ++level) {
+            auto shift  = level * m_slotBits;
+            auto offset = (timer.m_deadline >> shift) - (m_now >> shift);
+
+            if (offset < slots() or level + 1 == levels()) {
+                auto slot = std::min(static_cast<std::size_t>(offset), slots() - 1);
+                append(m_wheels.data()[level].at(slot), index);
+
+                timer.m_level = static_cast<std::uint32_t>(level);
+                ++m_levelSizes.data()[level];
+                return;
+            }
+        }
+    }
+
+    template <TimingWheelPayload Payload>
+    void TimingWheel<Payload>::turn()
+    {
+        ++m_now;
+
+        // level k turns every 2^(k * slotBits) ticks. the bucket moved to the back is always empty: the
+        // lowest level has just fired it and the higher levels have cascaded it when it became current
+        auto turned = 0uz;
+        while (turned < levels()) {
+            auto mask = (Tick{ 1 } << (turned * m_slotBits)) - 1;
+            if (turned > 0 and (m_now & mask) != 0) {
+                break;
+            }
+
+            auto& wheel = m_wheels.data()[turned++];
+            wheel.push_back(wheel.pop_front());
+        }
+
+        // the timers in the current slot of a higher level are due within its window, so they belong to the
+        // lower levels now
+        for (auto level = turned; level-- > 1;) {
+            auto bucket = m_wheels.data()[level].front();
+            while (not empty(bucket)) {
+                auto index = node(bucket).m_next;
+                unlink(index);
+                --m_levelSizes.data()[level];
+                place(index);
+            }
+        }
+    }
+
+    template <TimingWheelPayload Payload>
+    template <typename Fn>
+    std::size_t TimingWheel<Payload>::fire(Fn& fn)
+    {
+        auto bucket = m_wheels.data()[0].front();
+        auto fired  = 0uz;
+
+        // fn may reallocate the pool, so no reference to a node is kept across the call
+        while (not empty(bucket)) {
+            auto index   = node(bucket).m_next;
+            auto payload = std::move(*node(index).m_payload);
+
+            unlink(index);
+            --m_levelSizes.data()[0];
+            --m_size;
+            release(index);
+            ++fired;
+
+            std::invoke(fn, std::move(payload));
+        }
+
+        return fired;
+    }
+}
@@ -5,7 +5,10 @@
 #include <boost/ut.hpp>
 
 #include <cassert>
+#include <map>
 #include <ranges>
+#include <stdexcept>
+#include <vector>
 
 namespace ut = boost::ut;
 namespace rr = std::ranges;
@@ -13,6 +16,7 @@ namespace rv = rr::views;
 
 using test_util::equalUnderlying;
 using test_util::populateContainer;
+using test_util::relocations;
 
 // TODO: check whether copy happens on operations that should not copy (unless type is not movable, then copy
 // should happen)
@@ -213,12 +217,175 @@ void test()
         };
     }
 
+    "from_range constructor and append_range should keep the order of the range"_test = [] {
+        auto list = dsa::ArrayList<Type>(std::from_range, rv::iota(0, 10));
+        expect(list.size() == 10_i);
+        expect(list.capacity() == 10_i) << "sized range should allocate exactly once";
+        expect(equalUnderlying<Type>(list, rv::iota(0, 10)));
+
+        list.append_range(rv::iota(10, 25));
+        expect(equalUnderlying<Type>(list, rv::iota(0, 25)));
+
+        auto list2 = rv::iota(0, 5) | rr::to<dsa::ArrayList<Type>>();
+        expect(equalUnderlying<Type>(list2, rv::iota(0, 5)));
+
+        auto empty = dsa::ArrayList<Type>(std::from_range, rv::empty<int>);
+        expect(empty.size() == 0_i);
+    };
+
+    "apply_batch should apply the ops against the positions before the batch"_test = [] {
+        using Op = dsa::BatchOp<Type>;
+
+        auto list = dsa::ArrayList<Type>(std::from_range, rv::iota(0, 10));
+        auto ops  = test_util::toBatchOps<Op>({
+            { 10, 100 }, { 3, {} }, { 0, 101 }, { 3, 102 }, { 3, 103 }, { 9, {} }, { 0, {} }, { 5, 104 },
+        });
+
+        list.apply_batch(ops);
+        expect(equalUnderlying<Type>(list, std::array{ 101, 1, 2, 102, 103, 4, 104, 5, 6, 7, 8, 100 }));
+
+        auto invalid = std::vector<test_util::Batch>{
+            { { 13, 1 } },              // insert past the end
+            { { 12, {} } },             // remove past the end
+            { { 2, {} }, { 2, {} } },    // remove twice
+        };
+        for (const auto& batch : invalid) {
+            auto bad = test_util::toBatchOps<Op>(batch);
+            expect(throws([&] { list.apply_batch(bad); })) << "invalid batch should throw";
+        }
+        expect(that % list.size() == 12uz) << "invalid batch should leave the list untouched";
+    };
+
+    "apply_batch should move every element at most once"_test = [](std::size_t size) {
+        for (auto count : { 1uz, size / 10 + 1, size, 3 * size }) {
+            for (auto reserve : { false, true }) {
+                auto list = dsa::ArrayList<Type>(std::from_range, rv::iota(0, static_cast<int>(size)));
+                if (reserve) {
+                    list.reserve(4 * size + 1);    // applied in place instead of into a new buffer
+                }
+
+                auto batch = test_util::randomBatch(size, count, 1'000'000);
+                auto ops   = test_util::toBatchOps<dsa::BatchOp<Type>>(batch);
+
+                auto before = std::map<int, std::size_t>{};
+                for (const auto& value : list) {
+                    before[value.value()] = relocations(value);
+                }
+                for (const auto& op : ops | rv::filter(&dsa::BatchOp<Type>::isInsert)) {
+                    before[op.m_value->value()] = relocations(*op.m_value);
+                }
+
+                list.apply_batch(ops);
+                expect(equalUnderlying<Type>(list, test_util::applyBatchNaive(size, batch)));
+                expect(rr::all_of(list, [&](const Type& value) {
+                    return relocations(value) <= before[value.value()] + 1;
+                })) << "size" << size << "count" << count;
+            }
+        }
+    } | std::vector{ 0uz, 1uz, 10uz, 100uz, 1000uz };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
 
+// trivially copyable elements are copied with memcpy
+void testTriviallyCopyable()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "copy of trivially copyable elements should copy the whole list"_test = [] {
+        dsa::ArrayList<int> list{};
+        for (auto i : rv::iota(0, 1000)) {
+            list.push_back(auto{ i });
+        }
+
+        auto list2 = list;
+        expect(list2.size() == 1000_i);
+        expect(list2.capacity() == list.capacity());
+        expect(rr::equal(list2, list));
+
+        list2.front() = -1;
+        expect(list.front() == 0_i) << "copy should not share the storage";
+
+        dsa::ArrayList<int> list3{ 5 };
+        list3 = list2;
+        expect(list3.size() == 1000_i);
+        expect(rr::equal(list3, list2));
+
+        list3 = dsa::ArrayList<int>{};
+        expect(list3.size() == 0_i);
+    };
+}
+
+// the move constructor throws on one value, the live instances are counted to catch leaks
+struct ThrowingMove
+{
+    static inline int s_live    = 0;
+    static inline int s_throwOn = -1;
+
+    int m_value;
+
+    ThrowingMove(int value)
+        : m_value{ value }
+    {
+        ++s_live;
+    }
+
+    ThrowingMove(ThrowingMove&& other)
+        : m_value{ other.m_value }
+    {
+        if (m_value == s_throwOn) {
+            throw std::runtime_error{ "move" };
+        }
+        ++s_live;
+    }
+
+    ThrowingMove& operator=(ThrowingMove&& other)
+    {
+        m_value = other.m_value;
+        return *this;
+    }
+
+    ~ThrowingMove() { --s_live; }
+};
+
+void testThrowingMove()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "apply_batch with a throwing move should not leak nor change the list"_test = [](int throwOn) {
+        {
+            auto list = dsa::ArrayList<ThrowingMove>{};
+            list.reserve(1000);    // the capacity is enough, only the throwing move forbids the in place path
+            for (auto i : rv::iota(0, 100)) {
+                list.push_back(ThrowingMove{ i });
+            }
+
+            auto ops = std::vector<dsa::BatchOp<ThrowingMove>>{};
+            ops.push_back(dsa::BatchOp<ThrowingMove>::insert(50, ThrowingMove{ 1000 }));
+            ops.push_back(dsa::BatchOp<ThrowingMove>::remove(10));
+            ops.push_back(dsa::BatchOp<ThrowingMove>::insert(100, ThrowingMove{ 1001 }));
+
+            ThrowingMove::s_throwOn = throwOn;
+            expect(throws([&] { list.apply_batch(ops); }));
+            ThrowingMove::s_throwOn = -1;
+
+            expect(that % list.size() == 100uz);
+            expect(rr::equal(list | rv::transform(&ThrowingMove::m_value), rv::iota(0, 100)));
+        }
+        expect(that % ThrowingMove::s_live == 0);
+    } | std::vector{ 0, 70, 1000, 1001 };
+}
+
 int main()
 {
+    testTriviallyCopyable();
+    testThrowingMove();
+
 #ifdef DSA_TEST_EXTRA_TYPES
     test_util::forEach<test_util::NonTrivialPermutations>([]<typename T>() {
         if constexpr (dsa::ArrayElement<T>) {
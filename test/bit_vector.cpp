@@ -0,0 +1,167 @@
+#include "test_util.hpp"
+
+#include <dsa/bit_vector.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+// sizes around word, block, and superblock boundaries
+constexpr auto g_sizes = std::array{ 0uz, 1uz, 63uz, 64uz, 65uz, 511uz, 512uz, 513uz, 70'000uz, 200'000uz };
+
+// compare every rank and select against a naive vector<bool>
+bool matches(const dsa::BitVector& bits, const std::vector<bool>& expected)
+{
+    auto ones = 0uz;
+    for (auto pos : rv::iota(0uz, expected.size())) {
+        if (bits.at(pos) != expected[pos] or bits.rank1(pos) != ones) {
+            return false;
+        }
+        if (expected[pos]) {
+            if (bits.select1(ones) != pos) {
+                return false;
+            }
+            ++ones;
+        }
+    }
+    return bits.rank1(expected.size()) == ones and bits.count() == ones;
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "constructed bit vector should be filled with the given value"_test = [](std::size_t size) {
+        dsa::BitVector zeros{ size };
+        dsa::BitVector ones{ size, true };
+
+        expect(that % zeros.size() == size);
+        expect(that % zeros.count() == 0);
+        expect(that % ones.count() == size);
+        expect(that % ones.rank0(size) == 0);
+
+        if (size > 0) {
+            expect(that % ones.select1(size - 1) == size - 1);
+        }
+        expect(throws([&] { zeros.select1(0); })) << "no one to select";
+        expect(throws([&] { ones.at(size); })) << "out of bound access should throw";
+    } | g_sizes;
+
+    "rank and select should match naive computation"_test = [](std::size_t size) {
+        for (auto density : { 0.001, 0.3, 0.999 }) {
+            auto           expected = std::vector<bool>(size);
+            dsa::BitVector bits{ size };
+
+            for (auto pos : rv::iota(0uz, size)) {
+                auto value    = test_util::random(0.0, 1.0) < density;
+                expected[pos] = value;
+                bits.set(pos, value);
+            }
+
+            bits.buildIndex();
+            expect(matches(bits, expected)) << "size" << size << "density" << density;
+        }
+    } | g_sizes;
+
+    "bulk set and clear should only touch the given range"_test = [](std::size_t size) {
+        auto           expected = std::vector<bool>(size);
+        dsa::BitVector bits{ size };
+
+        for (auto i : rv::iota(0, 50)) {
+            auto first = test_util::random<std::size_t>(0, size);
+            auto last  = test_util::random<std::size_t>(first, size);
+            auto value = i % 3 != 0;
+
+            bits.setRange(first, last, value);
+            for (auto pos : rv::iota(first, last)) {
+                expected[pos] = value;
+            }
+        }
+
+        bits.buildIndex();
+        expect(matches(bits, expected)) << "size" << size;
+        expect(throws([&] { bits.setRange(0, size + 1); })) << "out of bound range should throw";
+        expect(throws([&] { bits.clearRange(1, 0); })) << "reversed range should throw";
+    } | g_sizes;
+
+    "push_back should extend the vector, the index should be rebuilt after it"_test = [] {
+        auto           expected = std::vector<bool>{};
+        dsa::BitVector bits{};
+
+        for (auto i : rv::iota(0, 2000)) {
+            bits.push_back(i % 3 == 0);
+            expected.push_back(i % 3 == 0);
+
+            if (i % 500 == 0) {
+                bits.buildIndex();
+                expect(matches(bits, expected));
+            }
+        }
+        bits.buildIndex();
+        expect(matches(bits, expected));
+
+        bits.clear();
+        expect(bits.size() == 0_u);
+        expect(bits.count() == 0_u);
+    };
+
+    "queries on a stale index should throw, built queries should be safe from many threads"_test = [] {
+        auto bits = dsa::BitVector{ 100'000 };
+        expect(bits.isIndexed()) << "the constructor should build the index";
+
+        bits.set(10);
+        expect(not bits.isIndexed());
+        expect(throws([&] { bits.rank1(5); }));
+        expect(throws([&] { bits.count(); }));
+
+        auto expected = std::vector<bool>(bits.size());
+        for (auto pos : rv::iota(0uz, bits.size())) {
+            expected[pos] = pos % 7 == 0;
+            bits.set(pos, expected[pos]);
+        }
+        bits.buildIndex();
+
+        const auto& shared  = bits;
+        auto        results = std::array<bool, 4>{};
+        {
+            auto threads = std::vector<std::jthread>{};
+            for (auto t : rv::iota(0uz, results.size())) {
+                threads.emplace_back([&, t] { results[t] = matches(shared, expected); });
+            }
+        }
+        expect(rr::all_of(results, std::identity{}));
+    };
+
+    "popcount over words should match std::popcount"_test = [](dsa::simd::Isa isa) {
+        dsa::simd::setIsa(isa);
+
+        auto words = std::vector<std::uint64_t>(dsa::s_popcountVectorWords * 2 + 3);
+        for (auto& word : words) {
+            word = test_util::random<std::uint64_t>(0, std::numeric_limits<std::uint64_t>::max());
+        }
+
+        for (auto count : rv::iota(0uz, words.size() + 1)) {
+            auto expected = 0uz;
+            for (auto word : words | rv::take(count)) {
+                expected += static_cast<std::size_t>(std::popcount(word));
+            }
+            expect(that % dsa::popcountWords({ words.data(), count }) == expected);
+        }
+
+        dsa::simd::setIsa(dsa::simd::detectIsa());
+    } | std::vector{ dsa::simd::Isa::Scalar, dsa::simd::Isa::Avx2 };
+}
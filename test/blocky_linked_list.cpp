@@ -9,8 +9,11 @@
 
 #include <cassert>
 #include <iterator>
+#include <map>
 #include <ranges>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace ut = boost::ut;
 namespace rr = std::ranges;
@@ -18,6 +21,7 @@ namespace rv = rr::views;
 
 using test_util::equalUnderlying;
 using test_util::populateContainer;
+using test_util::relocations;
 using test_util::subrange;
 
 template <test_util::TestClass T>
@@ -351,10 +355,299 @@ void test()
         }
     };
 
+    "from_range constructor and append_range should pack the blocks"_test = [] {
+        auto list = dsa::BlockyLinkedList<Type>(std::from_range, rv::iota(0, 20), 4);
+        expect(list.size() == 20_i);
+        expect(equalUnderlying<Type>(list, rv::iota(0, 20)));
+        expect(rr::all_of(list.blocks() | rv::take(3), [](auto& block) { return block.size() == 5; }));
+
+        list.append_range(rv::iota(20, 42));
+        expect(equalUnderlying<Type>(list, rv::iota(0, 42)));
+
+        list.insert(0, -1);
+        expect(that % list.front().value() == -1);
+        expect(that % list.remove(0).value() == -1);
+        expect(equalUnderlying<Type>(list, rv::iota(0, 42)));
+    };
+
+    "apply_batch should apply the ops against the positions before the batch"_test = [] {
+        using Op = dsa::BatchOp<Type>;
+
+        auto list = dsa::BlockyLinkedList<Type>(std::from_range, rv::iota(0, 10));
+        auto ops  = test_util::toBatchOps<Op>({
+            { 10, 100 }, { 3, {} }, { 0, 101 }, { 3, 102 }, { 3, 103 }, { 9, {} }, { 0, {} }, { 5, 104 },
+        });
+
+        list.apply_batch(ops);
+        expect(equalUnderlying<Type>(list, std::array{ 101, 1, 2, 102, 103, 4, 104, 5, 6, 7, 8, 100 }));
+
+        auto invalid = std::vector<test_util::Batch>{
+            { { 13, 1 } },              // insert past the end
+            { { 12, {} } },             // remove past the end
+            { { 2, {} }, { 2, {} } },    // remove twice
+        };
+        for (const auto& batch : invalid) {
+            auto bad = test_util::toBatchOps<Op>(batch);
+            expect(throws([&] { list.apply_batch(bad); })) << "invalid batch should throw";
+        }
+        expect(that % list.size() == 12uz) << "invalid batch should leave the list untouched";
+
+        auto all = test_util::Batch{};
+        for (auto pos : rv::iota(0uz, 12uz)) {
+            all.emplace_back(pos, std::nullopt);
+        }
+        auto removeAll = test_util::toBatchOps<Op>(all);
+        list.apply_batch(removeAll);
+        expect(list.size() == 0_i) << "removing everything should leave an empty list";
+        expect(nothrow([&] { list.push_back(1); }));
+    };
+
+    "apply_batch should move every element at most once and keep the blocks balanced"_test = [](auto size) {
+        for (auto count : { 1uz, size / 10 + 1, size, 3 * size }) {
+            auto list = dsa::BlockyLinkedList<Type>(std::from_range, rv::iota(0, static_cast<int>(size)), 8);
+
+            // the ops start in the middle, the first half of the list stays where it is
+            auto batch = test_util::randomBatch(size - size / 2, count, 1'000'000);
+            for (auto& [pos, value] : batch) {
+                pos += size / 2;
+            }
+            auto ops = test_util::toBatchOps<dsa::BatchOp<Type>>(batch);
+
+            auto before = std::map<int, std::size_t>{};
+            for (const auto& value : list) {
+                before[value.value()] = relocations(value);
+            }
+            for (const auto& op : ops | rv::filter(&dsa::BatchOp<Type>::isInsert)) {
+                before[op.m_value->value()] = relocations(*op.m_value);
+            }
+
+            list.apply_batch(ops);
+
+            auto expected = test_util::applyBatchNaive(size, batch);
+            expect(equalUnderlying<Type>(list, expected));
+            expect(rr::all_of(list, [&](const Type& value) {
+                return relocations(value) <= before[value.value()] + 1;
+            })) << "size" << size << "count" << count;
+
+            // the blocks before the block of the first op are not touched
+            auto untouched = size / 2 > list.blockSize() + 1 ? size / 2 - list.blockSize() - 1 : 0uz;
+            expect(rr::all_of(list | rv::take(untouched), [&](const Type& value) {
+                return relocations(value) == before[value.value()];
+            }));
+
+            // each block but the last should have b - 1 to b + 1 elements
+            for (const auto& block : list.blocks()) {
+                auto blockSize = list.blockSize();
+                if (&block != &*list.tail()) {
+                    expect(that % block.size() >= blockSize - 1 and block.size() <= blockSize + 1);
+                }
+            }
+        }
+    } | std::vector{ 0uz, 1uz, 10uz, 100uz, 1000uz };
+
+    // unbalanced constructor/destructor means there is a bug in the code
+    assert(Type::activeInstanceCount() == 0);
+}
+
+// a list with the block size as a template argument should keep exactly the same blocks as one with the same
+// runtime block size
+template <test_util::TestClass Type, std::size_t B>
+void testStatic()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    using Static = dsa::StaticBlockyLinkedList<Type, B>;
+
+    Type::resetActiveInstanceCount();
+
+    static_assert(Static::s_staticBlockSize);
+    static_assert(sizeof(Static) < sizeof(dsa::BlockyLinkedList<Type>), "static block size takes no storage");
+    static_assert(std::bidirectional_iterator<typename Static::template Iterator<false>>);
+    static_assert(std::same_as<typename Static::Node::Block, dsa::BlockyLinkedListBlock<Type, B + 1>>);
+
+    "inline block should shift the shorter side and wrap around"_test = [] {
+        auto block = dsa::BlockyLinkedListBlock<Type, B + 1>{};
+        for (auto i : rv::iota(0, static_cast<int>(B) - 2)) {
+            block.push_back(Type{ i });
+        }
+        expect(throws([&] { block.insert(B, Type{ -1 }); })) << "insert past the size should throw";
+
+        auto initial  = rv::iota(0, static_cast<int>(B) - 2);
+        auto expected = std::vector<int>(initial.begin(), initial.end());
+        auto check    = [&] {
+            expect(that % block.size() == expected.size());
+            for (auto i : rv::iota(0uz, expected.size())) {
+                expect(that % block.at(i).value() == expected[i]);
+            }
+
+            auto total = 0uz;
+            for (auto segment : block.segments()) {
+                total += segment.size();
+            }
+            expect(that % total == expected.size());
+        };
+
+        block.insert(1, Type{ 100 });    // front side for larger blocks
+        expected.insert(expected.begin() + 1, 100);
+        check();
+
+        block.push_front(Type{ 99 });    // the head wraps around
+        expected.insert(expected.begin(), 99);
+        check();
+        expect(rr::all_of(block.segments(), [](auto segment) { return segment.size() > 0; }));
+
+        block.insert(block.size() - 1, Type{ 101 });    // back side
+        expected.insert(expected.end() - 1, 101);
+        check();
+        expect(block.size() == block.capacity());
+        expect(throws([&] { block.push_front(Type{ -1 }); })) << "push to a full block should throw";
+
+        for (auto value : { 100, 101 }) {
+            auto pos = rr::find(expected, value) - expected.begin();
+            expect(that % block.remove(static_cast<std::size_t>(pos)).value() == value);
+            expected.erase(expected.begin() + pos);
+            check();
+        }
+
+        expect(that % block.pop_front().value() == expected.front());
+        expect(that % block.pop_back().value() == expected.back());
+        expected = std::vector(expected.begin() + 1, expected.end() - 1);
+        check();
+
+        block.clear();
+        expect(throws([&] { block.pop_back(); })) << "pop from an empty block should throw";
+    };
+
+    "static block size should keep the same blocks as the same runtime block size"_test = [] {
+        auto runtime = dsa::BlockyLinkedList<Type>{ B };
+        auto fixed   = Static{};
+        expect(that % fixed.blockSize() == B);
+
+        auto blockSizes = [](const auto& list) {
+            return list.blocks() | rv::transform([](const auto& block) { return block.size(); });
+        };
+        auto sameBlocks = [&] {
+            return rr::equal(runtime, fixed, {}, &Type::value, &Type::value)
+               and rr::equal(blockSizes(runtime), blockSizes(fixed));
+        };
+
+        for (auto i : rv::iota(0, 3000)) {
+            // biased towards inserts for the first half and towards removes for the second half
+            auto op = i < 1500 ? test_util::random(0, 3) : test_util::random(0, 5);
+            if (runtime.size() == 0) {
+                op = 0;
+            }
+
+            switch (op) {
+            case 0:
+            case 1: {
+                auto pos = test_util::random(0uz, runtime.size());
+                runtime.insert(pos, Type{ i });
+                fixed.insert(pos, Type{ i });
+            } break;
+            case 2:
+                runtime.push_front(Type{ i });
+                fixed.push_front(Type{ i });
+                break;
+            case 3: expect(that % runtime.pop_back().value() == fixed.pop_back().value()); break;
+            default: {
+                auto pos = test_util::random(0uz, runtime.size() - 1);
+                expect(that % runtime.remove(pos).value() == fixed.remove(pos).value());
+            } break;
+            }
+
+            expect(that % runtime.size() == fixed.size());
+            expect(sameBlocks()) << "op" << op << "at" << i;
+        }
+    };
+
+    "static block size should support range construction, batches and moves"_test = [] {
+        auto fixed = Static(std::from_range, rv::iota(0, 50));
+        expect(equalUnderlying<Type>(fixed, rv::iota(0, 50)));
+        expect(rr::all_of(fixed.blocks() | rv::take(3), [](auto& block) { return block.size() == B + 1; }));
+
+        auto batch = test_util::randomBatch(50, 20, 1'000);
+        auto ops   = test_util::toBatchOps<dsa::BatchOp<Type>>(batch);
+        fixed.apply_batch(ops);
+        expect(equalUnderlying<Type>(fixed, test_util::applyBatchNaive(50, batch)));
+
+        auto moved = std::move(fixed);
+        expect(fixed.size() == 0_i);
+        expect(equalUnderlying<Type>(moved, test_util::applyBatchNaive(50, batch)));
+
+        fixed.push_back(Type{ 1 });
+        expect(fixed.front().value() == 1_i);
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
 
+// the move constructor throws on one value, the live instances are counted to catch leaks
+struct ThrowingMove
+{
+    static inline int s_live    = 0;
+    static inline int s_throwOn = -1;
+
+    int m_value;
+
+    ThrowingMove(int value)
+        : m_value{ value }
+    {
+        ++s_live;
+    }
+
+    ThrowingMove(ThrowingMove&& other)
+        : m_value{ other.m_value }
+    {
+        if (m_value == s_throwOn) {
+            throw std::runtime_error{ "move" };
+        }
+        ++s_live;
+    }
+
+    ThrowingMove& operator=(ThrowingMove&& other)
+    {
+        m_value = other.m_value;
+        return *this;
+    }
+
+    ~ThrowingMove() { --s_live; }
+};
+
+void testThrowingMove()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    "apply_batch with a throwing move should not leak nor change the list"_test = [](int throwOn) {
+        {
+            auto list = dsa::BlockyLinkedList<ThrowingMove>{ 8 };
+            for (auto i : rv::iota(0, 100)) {
+                list.push_back(ThrowingMove{ i });
+            }
+
+            auto ops = std::vector<dsa::BatchOp<ThrowingMove>>{};
+            ops.push_back(dsa::BatchOp<ThrowingMove>::insert(50, ThrowingMove{ 1000 }));
+            ops.push_back(dsa::BatchOp<ThrowingMove>::remove(10));
+            ops.push_back(dsa::BatchOp<ThrowingMove>::insert(100, ThrowingMove{ 1001 }));
+
+            ThrowingMove::s_throwOn = throwOn;
+            expect(throws([&] { list.apply_batch(ops); }));
+            ThrowingMove::s_throwOn = -1;
+
+            expect(that % list.size() == 100uz);
+            expect(rr::equal(list | rv::transform(&ThrowingMove::m_value), rv::iota(0, 100)));
+            expect(nothrow([&] { list.push_back(ThrowingMove{ 100 }); })) << "the blocks should be linked";
+            expect(that % list.back().m_value == 100);
+        }
+        expect(that % ThrowingMove::s_live == 0);
+    } | std::vector{ 15, 70, 99, 1000, 1001 };
+}
+
 int main()
 {
 #ifdef DSA_TEST_EXTRA_TYPES
@@ -368,4 +661,11 @@ int main()
     test<test_util::MovableOnly<>>();
     test<test_util::CopyableOnly<>>();
 #endif
+
+    // b + 1 a power of two and not
+    testStatic<test_util::Regular, 3>();
+    testStatic<test_util::Regular, 6>();
+    testStatic<test_util::MovableOnly<>, 7>();
+
+    testThrowingMove();
 }
@@ -0,0 +1,253 @@
+#include "test_util.hpp"
+
+#include <dsa/channel.hpp>
+
+#include <boost/ut.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using dsa::Error;
+
+using Channel = dsa::Channel<int>;
+
+// sends first .. last - 1 then closes the channel if asked to, the results of the sends are recorded
+dsa::Task produce(Channel& channel, int first, int last, std::vector<Error>& errors, bool close)
+{
+    for (auto i = first; i < last; ++i) {
+        if (auto sent = co_await channel.send(auto{ i }); not sent) {
+            errors.push_back(sent.error());
+        }
+    }
+    if (close) {
+        channel.close();
+    }
+}
+
+// receives until the channel is closed and drained, the size of the buffer is recorded after every receive
+dsa::Task consume(Channel& channel, std::vector<int>& received, std::vector<std::size_t>& sizes)
+{
+    while (auto value = co_await channel.receive()) {
+        received.push_back(*value);
+        sizes.push_back(channel.size());
+    }
+}
+
+dsa::Task consumeBatches(Channel& channel, std::size_t max, std::vector<std::size_t>& batches, int& sum)
+{
+    auto batch = dsa::ArrayList<int>{};
+    while (auto count = co_await channel.receiveBatch(batch, max)) {
+        batches.push_back(count);
+        for (auto value : batch) {
+            sum += value;
+        }
+        batch.clear();
+    }
+}
+
+// sets the flag when the frame is destroyed, finished or not
+struct Guard
+{
+    bool& m_destroyed;
+
+    ~Guard() { m_destroyed = true; }
+};
+
+dsa::Task receiveOne(Channel& channel, bool& destroyed)
+{
+    auto guard = Guard{ destroyed };
+    co_await channel.receive();
+}
+
+template <typename T>
+dsa::Task forward(dsa::Channel<T>& from, dsa::Channel<T>& to)
+{
+    while (auto value = co_await from.receive()) {
+        co_await to.send(std::move(*value));
+    }
+    to.close();
+}
+
+template <typename T>
+dsa::Task collect(dsa::Channel<T>& channel, std::vector<int>& values)
+{
+    while (auto value = co_await channel.receive()) {
+        values.push_back(value->value());
+    }
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "a zero capacity should throw"_test = [] {
+        auto executor = dsa::Executor{};
+        expect(throws([&] { Channel{ executor, 0 }; }));
+    };
+
+    "values should arrive in order and the buffer should never exceed the capacity"_test = [] {
+        for (auto capacity : { 1uz, 3uz, 64uz }) {
+            auto executor = dsa::Executor{};
+            auto channel  = Channel{ executor, capacity };
+            auto errors   = std::vector<Error>{};
+            auto received = std::vector<int>{};
+            auto sizes    = std::vector<std::size_t>{};
+
+            executor.spawn(produce(channel, 0, 100, errors, true));
+            executor.spawn(consume(channel, received, sizes));
+            expect(that % executor.pending() == 2uz);
+
+            executor.run();
+
+            expect(that % executor.pending() == 0uz) << "both tasks should have finished";
+            expect(errors.empty());
+            expect(rr::equal(received, rv::iota(0, 100)));
+            expect(rr::all_of(sizes, [&](auto size) { return size <= capacity; }));
+        }
+    };
+
+    "a receiver waiting first should get the value handed over"_test = [] {
+        auto executor = dsa::Executor{};
+        auto channel  = Channel{ executor, 4 };
+        auto received = std::vector<int>{};
+        auto sizes    = std::vector<std::size_t>{};
+
+        executor.spawn(consume(channel, received, sizes));
+        executor.run();
+        expect(received.empty() and executor.pending() == 1uz) << "the receiver should be suspended";
+
+        expect(channel.try_send(42).has_value());
+        expect(that % channel.size() == 0uz) << "the value should not go through the buffer";
+
+        executor.run();
+        expect(received == std::vector{ 42 });
+
+        channel.close();
+        executor.run();
+        expect(that % executor.pending() == 0uz);
+    };
+
+    "senders should wait on a full buffer and resume in order"_test = [] {
+        auto executor = dsa::Executor{};
+        auto channel  = Channel{ executor, 2 };
+        auto errors   = std::vector<Error>{};
+
+        executor.spawn(produce(channel, 0, 4, errors, false));
+        executor.spawn(produce(channel, 10, 12, errors, false));
+        executor.run();
+
+        expect(that % channel.size() == 2uz);
+        expect(that % executor.pending() == 2uz);
+        expect(channel.try_send(99).error() == Error::Full);
+
+        auto received = std::vector<int>{};
+        while (executor.pending() > 0 or channel.size() > 0) {
+            if (auto value = channel.try_receive()) {
+                received.push_back(*value);
+            }
+            executor.run();
+        }
+
+        expect(received == std::vector{ 0, 1, 2, 10, 3, 11 });
+        expect(errors.empty());
+    };
+
+    "batch receive should take up to max values"_test = [] {
+        auto executor = dsa::Executor{};
+        auto channel  = Channel{ executor, 8 };
+        auto errors   = std::vector<Error>{};
+        auto batches  = std::vector<std::size_t>{};
+        auto sum      = 0;
+
+        executor.spawn(produce(channel, 0, 100, errors, true));
+        executor.spawn(consumeBatches(channel, 5, batches, sum));
+        executor.run();
+
+        expect(that % sum == 4950);
+        expect(rr::all_of(batches, [](auto count) { return count >= 1 and count <= 5; }));
+        expect(rr::any_of(batches, [](auto count) { return count == 5; })) << "the buffer fills up first";
+        expect(that % executor.pending() == 0uz);
+    };
+
+    "close should wake up the waiters and let the receivers drain the buffer"_test = [] {
+        auto executor = dsa::Executor{};
+        auto channel  = Channel{ executor, 2 };
+        auto errors   = std::vector<Error>{};
+
+        executor.spawn(produce(channel, 0, 5, errors, false));
+        executor.run();
+        expect(that % channel.size() == 2uz);
+
+        channel.close();
+        executor.run();
+        expect(that % executor.pending() == 0uz);
+        expect(errors == std::vector{ Error::Closed, Error::Closed, Error::Closed })
+            << "the waiting send and the later ones should fail";
+
+        expect(channel.isClosed());
+        expect(channel.try_send(5).error() == Error::Closed);
+
+        auto received = std::vector<int>{};
+        auto sizes    = std::vector<std::size_t>{};
+        executor.spawn(consume(channel, received, sizes));
+        executor.run();
+        expect(received == std::vector{ 0, 1 });
+        expect(that % executor.pending() == 0uz);
+    };
+
+    "the executor should destroy the tasks still suspended"_test = [] {
+        auto destroyed = std::array{ false, false, false };
+        {
+            auto executor = dsa::Executor{};
+            auto channel  = Channel{ executor, 1 };
+
+            for (auto& flag : destroyed) {
+                executor.spawn(receiveOne(channel, flag));
+            }
+            executor.run();
+            expect(that % executor.pending() == 3uz);
+
+            // finish the first one, the last one takes its place in the executor
+            expect(channel.try_send(1).has_value());
+            executor.run();
+            expect(that % executor.pending() == 2uz);
+            expect(destroyed[0] and not destroyed[1] and not destroyed[2]);
+        }
+        expect(rr::all_of(destroyed, std::identity{}));
+    };
+
+    "non-trivial values should be moved through a pipeline of channels"_test = [] {
+        using Type = test_util::MovableOnly<>;
+        {
+            auto executor = dsa::Executor{};
+            auto first    = dsa::Channel<Type>{ executor, 3 };
+            auto second   = dsa::Channel<Type>{ executor, 1 };
+            auto values   = std::vector<int>{};
+
+            executor.spawn(forward(first, second));
+            executor.spawn(collect(second, values));
+
+            for (auto i : rv::iota(0, 20)) {
+                while (not first.try_send(Type{ i })) {
+                    executor.runOne();
+                }
+            }
+            first.close();
+            executor.run();
+
+            expect(rr::equal(values, rv::iota(0, 20)));
+            expect(that % executor.pending() == 0uz);
+        }
+        assert(Type::activeInstanceCount() == 0);
+    };
+}
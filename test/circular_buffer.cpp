@@ -10,6 +10,10 @@
 #include <cassert>
 #include <ranges>
 #include <concepts>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 namespace ut = boost::ut;
@@ -390,14 +394,160 @@ void test()
             expect(buffer3.size() == 10_i);
             expect(rr::equal(buffer3, buffer));
         };
+
+        "copy of a wrapped around buffer should keep the elements in order"_test = [] {
+            dsa::CircularBuffer<Type> buffer{ 10 };
+            populateContainer(buffer, rv::iota(0, 17));    // head is in the middle of the buffer
+            buffer.pop_back();
+
+            expect(buffer.size() == 9_i);
+            expect(equalUnderlying<Type>(buffer, rv::iota(7, 16)));
+
+            auto buffer2 = buffer;
+            expect(buffer2.size() == 9_i);
+            expect(rr::equal(buffer2, buffer));
+
+            auto buffer3 = buffer.linearizeCopy(std::nullopt);
+            expect(buffer3.size() == 9_i);
+            expect(rr::equal(buffer3, buffer));
+            expect(rr::equal(std::span{ buffer3.data(), buffer3.size() }, buffer));
+        };
     }
 
+    "from_range constructor and append_range should keep the order of the range"_test = [] {
+        auto buffer = dsa::CircularBuffer<Type>(std::from_range, rv::iota(0, 10));
+        expect(buffer.size() == 10_i);
+        expect(buffer.capacity() == 10_i) << "the capacity should be the size of the range";
+        expect(equalUnderlying<Type>(buffer, rv::iota(0, 10)));
+
+        // fixed capacity replace on full keeps the last elements
+        buffer.append_range(rv::iota(10, 15));
+        expect(buffer.capacity() == 10_i);
+        expect(equalUnderlying<Type>(buffer, rv::iota(5, 15)));
+
+        auto dynamic = dsa::CircularBuffer<Type>{ 4, { dsa::BufferCapacityPolicy::DynamicCapacity } };
+        populateContainer(dynamic, rv::iota(0, 4));
+        std::ignore = dynamic.pop_front();
+        dynamic.append_range(rv::iota(4, 20));    // wrapped around before growing
+        expect(dynamic.capacity() == 19_i) << "the capacity should only grow once";
+        expect(equalUnderlying<Type>(dynamic, rv::iota(1, 20)));
+
+        auto empty = rv::empty<int> | rr::to<dsa::CircularBuffer<Type>>();
+        expect(empty.size() == 0_i);
+        expect(rr::distance(empty) == 0_i);
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
 
+// trivially copyable elements are copied with memcpy
+void testTriviallyCopyable()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "copy of trivially copyable elements should copy the two runs of the ring"_test = [] {
+        dsa::CircularBuffer<int> buffer{ 100 };
+        for (auto i : rv::iota(0, 150)) {
+            buffer.push_back(auto{ i });
+        }
+        buffer.pop_front();
+
+        auto buffer2 = buffer;
+        expect(buffer2.size() == 99_i);
+        expect(rr::equal(buffer2, rv::iota(51, 150)));
+
+        buffer2.push_back(150);
+        expect(buffer2.back() == 150_i);
+        expect(buffer.back() == 149_i) << "copy should not share the storage";
+
+        buffer = buffer2;
+        expect(rr::equal(buffer, rv::iota(51, 151)));
+
+        auto linear = buffer.linearizeCopy(std::nullopt);
+        expect(rr::equal(std::span{ linear.data(), linear.size() }, rv::iota(51, 151)));
+    };
+}
+
+// a buffer with the policy as a template argument should behave exactly as one with the same runtime policy
+template <dsa::BufferPolicy Policy>
+void testStaticPolicy()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    using Static = dsa::CircularBuffer<int, Policy>;
+
+    static_assert(Static::s_staticPolicy);
+    static_assert(sizeof(Static) < sizeof(dsa::CircularBuffer<int>), "static policy should take no storage");
+    static_assert(not requires(Static buffer) { buffer.setPolicy(std::nullopt, std::nullopt); });
+    static_assert(std::random_access_iterator<typename Static::template Iterator<false>>);
+
+    "static policy should behave as the same runtime policy"_test = [] {
+        auto runtime = dsa::CircularBuffer<int>{ 8, Policy };
+        auto fixed   = Static{ 8 };
+        expect(fixed.getPolicy() == Policy);
+
+        // a failed operation returns the smallest int
+        auto apply = [](auto& buffer, int op, int value, std::size_t pos) -> std::optional<int> {
+            try {
+                switch (op) {
+                case 0: buffer.push_back(auto{ value }); return std::nullopt;
+                case 1: buffer.push_front(auto{ value }); return std::nullopt;
+                case 2: buffer.insert(pos, auto{ value }); return std::nullopt;
+                case 3: return buffer.pop_front();
+                case 4: return buffer.pop_back();
+                default: return buffer.remove(pos);
+                }
+            } catch (const std::exception&) {
+                return std::numeric_limits<int>::min();
+            }
+        };
+
+        for (auto i : rv::iota(0, 2000)) {
+            // biased towards pushes for the first half and towards pops for the second half
+            auto op  = i < 1000 ? test_util::random(0, 4) : test_util::random(2, 5);
+            auto pos = test_util::random(0uz, runtime.size());
+
+            expect(apply(runtime, op, i, pos) == apply(fixed, op, i, pos)) << "op" << op << "at" << i;
+            expect(that % runtime.capacity() == fixed.capacity());
+            expect(rr::equal(runtime, fixed));
+        }
+    };
+
+    "static policy should be kept by the constructors and copies"_test = [] {
+        auto sized = Static{ std::from_range, rv::iota(0, 20) };
+        expect(sized.capacity() == 20_i);
+        expect(rr::equal(sized, rv::iota(0, 20)));
+
+        auto stream   = std::istringstream{ "1 2 3 4 5" };
+        auto unsized  = Static{ std::from_range, rv::istream<int>(stream) };
+        auto expected = Policy.m_capacity == dsa::BufferCapacityPolicy::FixedCapacity ? 5uz : 8uz;
+        expect(that % unsized.capacity() == expected);
+        expect(rr::equal(unsized, rv::iota(1, 6)));
+
+        std::ignore = sized.pop_front();
+        sized.push_back(20);
+        auto linear = sized.linearizeCopy(std::nullopt);
+        expect(rr::equal(std::span{ linear.data(), linear.size() }, rv::iota(1, 21)));
+        expect(linear.getPolicy() == Policy);
+
+        auto moved = std::move(linear);
+        expect(rr::equal(moved, rv::iota(1, 21)));
+    };
+}
+
 int main()
 {
+    testTriviallyCopyable();
+
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (testStaticPolicy<std::get<I>(g_policyPermutations)>(), ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(g_policyPermutations)>>{});
+
 #ifdef DSA_TEST_EXTRA_TYPES
     test_util::forEach<test_util::NonTrivialPermutations>([]<typename T>() {
         if constexpr (dsa::CircularBufferElement<T>) {
@@ -0,0 +1,165 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/compressed_int_list.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using dsa::CompressedIntList;
+using Value = CompressedIntList::Value;
+
+constexpr auto g_block = CompressedIntList::s_blockSize;
+constexpr auto g_max   = std::numeric_limits<Value>::max();
+
+// sizes around the block boundaries
+constexpr auto g_sizes = std::array{ 0uz, 1uz, 127uz, 128uz, 129uz, 256uz, 1000uz, 10'000uz };
+
+std::vector<Value> sortedIds(std::size_t size, Value maxGap)
+{
+    auto values = std::vector<Value>{};
+    auto value  = test_util::random<Value>(0, 1'000'000);
+    for (auto i = 0uz; i < size; ++i) {
+        value += test_util::random<Value>(0, maxGap);
+        values.push_back(value);
+    }
+    return values;
+}
+
+std::vector<Value> randomValues(std::size_t size)
+{
+    auto values = std::vector<Value>{};
+    for (auto i = 0uz; i < size; ++i) {
+        values.push_back(test_util::random<Value>(0, g_max));
+    }
+    return values;
+}
+
+void expectSame(const CompressedIntList& list, const std::vector<Value>& values)
+{
+    using namespace ut::operators;
+    using ut::expect, ut::that;
+
+    expect(that % list.size() == values.size());
+
+    auto decoded = std::vector<Value>(values.size());
+    list.decode(decoded);
+    expect(decoded == values);
+
+    auto visited = std::vector<Value>{};
+    list.forEach([&](Value value) { visited.push_back(value); });
+    expect(visited == values);
+
+    for (auto i = 0uz; i < values.size(); i += 1 + values.size() / 50) {
+        expect(that % list.at(i) == values[i]);
+    }
+    if (not values.empty()) {
+        expect(that % list.at(values.size() - 1) == values.back());
+    }
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    "sorted ids should round trip"_test = [](std::size_t size) {
+        for (auto gap : { Value{ 0 }, Value{ 1 }, Value{ 1000 }, Value{ 1 } << 40 }) {
+            auto values = sortedIds(size, gap);
+            auto list   = CompressedIntList{ std::from_range, values };
+            expectSame(list, values);
+        }
+    } | g_sizes;
+
+    "unsorted and extreme values should round trip"_test = [](std::size_t size) {
+        auto values = randomValues(size);
+        expectSame(CompressedIntList{ std::from_range, values }, values);
+
+        // deltas that wrap around in both directions
+        auto extremes = std::vector<Value>{};
+        for (auto i = 0uz; i < size; ++i) {
+            extremes.push_back(i % 3 == 0 ? g_max : i % 3 == 1 ? 0 : g_max / 2);
+        }
+        expectSame(CompressedIntList{ std::from_range, extremes }, extremes);
+    } | g_sizes;
+
+    "push_back onto the open tail should keep the list readable"_test = [] {
+        auto list   = CompressedIntList{};
+        auto values = sortedIds(1000, 50);
+
+        for (auto i = 0uz; i < values.size(); ++i) {
+            list.push_back(values[i]);
+            expect(that % list.size() == i + 1);
+            expect(that % list.at(i) == values[i]);
+            expect(that % list.blockCount() == (i + g_block) / g_block);
+        }
+        expectSame(list, values);
+
+        list.clear();
+        expect(list.empty());
+        expect(that % list.blockCount() == 0uz);
+        list.push_back(42);
+        expect(that % list.at(0) == 42u);
+    };
+
+    "decodeBlock should give every block in order"_test = [] {
+        auto values = sortedIds(1000, 10);
+        auto list   = CompressedIntList{ std::from_range, values };
+        auto block  = std::array<Value, g_block>{};
+
+        auto decoded = std::vector<Value>{};
+        for (auto i = 0uz; i < list.blockCount(); ++i) {
+            auto count = list.decodeBlock(i, block);
+            decoded.insert(decoded.end(), block.begin(), block.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+        expect(decoded == values);
+
+        expect(throws([&] { list.decodeBlock(list.blockCount(), block); }));
+        expect(throws([&] { list.decodeBlock(0, std::span{ block }.first(10)); }));
+        expect(throws([&] { list.at(list.size()); }));
+        expect(throws([&] {
+            auto small = std::vector<Value>(list.size() - 1);
+            list.decode(small);
+        }));
+    };
+
+    "lowerBound should match std::lower_bound on sorted lists"_test = [](std::size_t size) {
+        // small gaps make runs of equal values that may cross block boundaries
+        for (auto gap : { Value{ 0 }, Value{ 2 }, Value{ 1000 } }) {
+            auto values = sortedIds(size, gap);
+            auto list   = CompressedIntList{ std::from_range, values };
+
+            auto probes = std::vector<Value>{ 0, g_max };
+            for (auto i = 0uz; i < values.size(); i += 1 + values.size() / 100) {
+                probes.push_back(values[i]);
+                probes.push_back(values[i] - 1);
+                probes.push_back(values[i] + 1);
+            }
+
+            for (auto probe : probes) {
+                auto expected = static_cast<std::size_t>(rr::lower_bound(values, probe) - values.begin());
+                expect(that % list.lowerBound(probe) == expected) << "probe" << probe;
+            }
+        }
+    } | g_sizes;
+
+    "sorted ids with small gaps should take a few bits per value"_test = [] {
+        auto values = sortedIds(100'000, 15);
+        auto list   = CompressedIntList{ std::from_range, values };
+
+        // 4 bits of delta plus the skip table, against 64 bits uncompressed
+        auto bitsPerValue = static_cast<double>(list.bytes()) * 8 / static_cast<double>(values.size());
+        expect(bitsPerValue < 6.0) << bitsPerValue;
+    };
+}
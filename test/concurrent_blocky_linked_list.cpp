@@ -0,0 +1,200 @@
+#include "test_util.hpp"
+
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/concurrent_blocky_linked_list.hpp>
+
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using List = dsa::ConcurrentBlockyLinkedList<std::uint64_t>;
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "too small block size should throw"_test = [] {
+        expect(throws([] { List{ 2 }; }));
+        expect(that % List{ 3 }.blockSize() == 3uz);
+    };
+
+    "out of range positions should throw or return an error"_test = [] {
+        auto list = List{ 4 };
+        expect(throws([&] { list.at(0); }));
+        expect(throws([&] { list.remove(0); }));
+        expect(throws([&] { list.insert(1, 1); }));
+        expect(not list.try_at(0).has_value());
+
+        list.insert(0, 1);
+        list.push_back(2);
+        expect(that % list.size() == 2uz);
+        expect(that % list.at(1) == 2u);
+        expect(not list.try_insert(3, 3).has_value());
+        expect(not list.try_remove(2).has_value());
+        expect(that % list.try_remove(0).value() == 1u);
+        expect(that % list.snapshot().size() == 1uz);
+    };
+
+    "a single thread should behave like BlockyLinkedList"_test = [](std::size_t blockSize) {
+        auto list      = List{ blockSize };
+        auto reference = dsa::BlockyLinkedList<std::uint64_t>{ blockSize };
+        auto rng       = std::mt19937_64{ blockSize };
+
+        for (auto i : rv::iota(0u, 4'000u)) {
+            auto size = reference.size();
+            auto op   = rng() % 10;
+            if (op < 5 or size == 0) {
+                auto pos = rng() % (size + 1);
+                list.insert(pos, std::uint64_t{ i });
+                reference.insert(pos, std::uint64_t{ i });
+            } else if (op < 8) {
+                auto pos = rng() % size;
+                expect(that % list.remove(pos) == reference.remove(pos));
+            } else if (op < 9) {
+                list.push_back(std::uint64_t{ i });
+                reference.push_back(std::uint64_t{ i });
+            } else {
+                auto pos = rng() % size;
+                expect(that % list.at(pos) == reference.at(pos));
+            }
+        }
+
+        expect(that % list.size() == reference.size());
+        expect(rr::equal(list.snapshot(), reference));
+
+        while (reference.size() > 0) {
+            auto pos = rng() % reference.size();
+            expect(that % list.remove(pos) == reference.remove(pos));
+        }
+        expect(that % list.size() == 0uz);
+        expect(that % list.snapshot().size() == 0uz);
+
+        auto stats = list.stats();
+        expect(that % stats.m_retries == 0u) << "no writer to conflict with";
+        expect(that % stats.m_lockedReads == 0u);
+    } | std::vector{ 3uz, 4uz, 8uz, 32uz };
+
+    "non-trivial elements should be moved around and destroyed"_test = [] {
+        auto list = dsa::ConcurrentBlockyLinkedList<std::string>{ 3 };
+        for (auto i : rv::iota(0, 200)) {
+            list.insert(static_cast<std::size_t>(i / 2), std::to_string(i));
+        }
+        auto removed = list.remove(10);
+        expect(that % list.size() == 199uz);
+        expect(list.at(10) != removed);
+    };
+
+    "concurrent inserts and removes should keep every element exactly once"_test = [](std::size_t blockSize) {
+        constexpr auto threads   = 4u;
+        constexpr auto perThread = 2'000u;
+
+        auto list = List{ blockSize };
+        for (auto i : rv::iota(0u, 500u)) {
+            list.push_back(std::uint64_t{ i });
+        }
+
+        // every thread inserts its own values and removes some, the removed values are recorded
+        auto removed = std::vector<std::vector<std::uint64_t>>(threads);
+        {
+            auto workers = std::vector<std::jthread>{};
+            for (auto t : rv::iota(0u, threads)) {
+                workers.emplace_back([&, t] {
+                    auto rng = std::mt19937_64{ t };
+                    for (auto i : rv::iota(0u, perThread)) {
+                        auto value = 1'000 + t * perThread + i;
+                        auto size  = list.size();
+                        if (rng() % 4 == 0) {
+                            if (auto got = list.try_remove(rng() % (size + 1))) {
+                                removed[t].push_back(*got);
+                            }
+                        } else if (not list.try_insert(rng() % (size + 1), std::uint64_t{ value })) {
+                            list.push_back(std::uint64_t{ value });
+                        }
+                    }
+                });
+            }
+        }
+
+        auto expected = std::vector<std::uint64_t>{};
+        for (auto i : rv::iota(0u, 500u)) {
+            expected.push_back(i);
+        }
+        for (auto t : rv::iota(0u, threads)) {
+            auto rng = std::mt19937_64{ t };
+            for (auto i : rv::iota(0u, perThread)) {
+                auto remove = rng() % 4 == 0;
+                rng();
+                if (not remove) {
+                    expected.push_back(1'000 + t * perThread + i);
+                }
+            }
+        }
+        for (const auto& values : removed) {
+            for (auto value : values) {
+                auto found = rr::find(expected, value);
+                expect(found != expected.end()) << "removed twice or never inserted:" << value;
+                if (found != expected.end()) {
+                    expected.erase(found);
+                }
+            }
+        }
+
+        auto values = list.snapshot();
+        auto sorted = std::vector<std::uint64_t>{ values.begin(), values.end() };
+        rr::sort(sorted);
+        rr::sort(expected);
+        expect(that % list.size() == expected.size());
+        expect(sorted == expected);
+    } | std::vector{ 3uz, 8uz };
+
+    "readers next to writers should only see values that are in the list"_test = [] {
+        constexpr auto size = 2'000u;
+
+        // the writers move values around, every value stays a multiple of 3
+        auto list = List{ 4 };
+        for (auto i : rv::iota(0u, size)) {
+            list.push_back(std::uint64_t{ i } * 3);
+        }
+
+        auto done = std::atomic<bool>{ false };
+        auto bad  = std::atomic<int>{ 0 };
+        {
+            auto readers = std::vector<std::jthread>{};
+            for (auto r : rv::iota(0u, 3u)) {
+                readers.emplace_back([&, r] {
+                    auto rng = std::mt19937_64{ r };
+                    while (not done.load()) {
+                        // a writer holds one value out of the list between its remove and insert
+                        if (list.at(rng() % (size - 1)) % 3 != 0) {
+                            ++bad;
+                        }
+                    }
+                });
+            }
+
+            auto rng = std::mt19937_64{ 42 };
+            for (auto i [[maybe_unused]] : rv::iota(0, 20'000)) {
+                auto value = list.remove(rng() % size);
+                list.insert(rng() % size, std::move(value));
+            }
+            done = true;
+        }
+
+        expect(that % bad.load() == 0);
+        expect(that % list.size() == std::size_t{ size });
+    };
+}
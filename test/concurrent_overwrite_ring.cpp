@@ -0,0 +1,149 @@
+#include "test_util.hpp"
+
+#include <dsa/concurrent_overwrite_ring.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+// larger than a word so a torn copy can mix two writes, the checksum detects that
+struct Event
+{
+    std::uint32_t m_writer;
+    std::uint32_t m_counter;
+    std::uint64_t m_payload[3];
+    std::uint64_t m_checksum;
+
+    static Event make(std::uint32_t writer, std::uint32_t counter)
+    {
+        auto event = Event{ writer, counter, {}, 0 };
+        for (auto i = 0u; i < 3; ++i) {
+            event.m_payload[i] = (std::uint64_t{ writer } << 32 | counter) * (i + 0x9e37'79b9ull);
+        }
+        event.m_checksum = event.sum();
+        return event;
+    }
+
+    std::uint64_t sum() const
+    {
+        return m_writer ^ (std::uint64_t{ m_counter } << 20) ^ m_payload[0] ^ m_payload[2];
+    }
+
+    bool intact() const { return m_checksum == sum(); }
+};
+
+using Ring = dsa::ConcurrentOverwriteRing<Event>;
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    "invalid capacity should throw, capacity should be rounded up"_test = [] {
+        expect(throws([] { Ring{ 0 }; }));
+        expect(that % Ring{ 1 }.capacity() == 1uz);
+        expect(that % Ring{ 100 }.capacity() == 128uz);
+        expect(that % Ring{ 128 }.capacity() == 128uz);
+    };
+
+    "single writer should overwrite the oldest entries"_test = [](std::uint32_t count) {
+        auto ring = Ring{ 64 };
+        for (auto i : rv::iota(0u, count)) {
+            expect(ring.push_back(Event::make(0, i)));
+        }
+
+        auto entries = ring.snapshot();
+        auto first   = count > 64 ? count - 64 : 0u;
+
+        expect(that % entries.size() == std::min(count, 64u));
+        for (auto i = 0uz; i < entries.size(); ++i) {
+            expect(that % entries.at(i).m_sequence == first + i);
+            expect(that % entries.at(i).m_value.m_counter == first + i);
+            expect(entries.at(i).m_value.intact());
+        }
+
+        expect(that % ring.written() == count);
+        expect(that % ring.dropped() == 0u);
+    } | std::vector{ 0u, 1u, 63u, 64u, 65u, 1'000u };
+
+    "snapshot should visit entries in write order"_test = [] {
+        auto ring = Ring{ 8 };
+        for (auto i : rv::iota(0u, 20u)) {
+            ring.push_back(Event::make(1, i));
+        }
+
+        auto sequences = std::vector<std::uint64_t>{};
+        auto visited   = ring.snapshot([&](std::uint64_t sequence, const Event&) {
+            sequences.push_back(sequence);
+        });
+
+        expect(that % visited == 8uz);
+        expect(rr::equal(sequences, rv::iota(12u, 20u)));
+    };
+
+    "concurrent writers and readers should only ever see intact entries"_test = [](std::size_t writers) {
+        constexpr auto perWriter = 20'000u;
+
+        auto ring = Ring{ 256 };
+        auto done = std::atomic<bool>{ false };
+        auto bad  = std::atomic<int>{ 0 };
+
+        // within a snapshot the counters of each writer must increase: a writer's tickets are taken in order
+        auto check = [&] {
+            auto last = std::vector<std::int64_t>(writers, -1);
+            auto prev = std::int64_t{ -1 };
+            ring.snapshot([&](std::uint64_t sequence, const Event& event) {
+                auto& seen = last[event.m_writer];
+                if (not event.intact() or static_cast<std::int64_t>(event.m_counter) <= seen
+                    or static_cast<std::int64_t>(sequence) <= prev) {
+                    ++bad;
+                }
+                seen = event.m_counter;
+                prev = static_cast<std::int64_t>(sequence);
+            });
+        };
+
+        {
+            auto readers = std::vector<std::jthread>{};
+            for (auto r [[maybe_unused]] : rv::iota(0, 2)) {
+                readers.emplace_back([&] {
+                    while (not done.load()) {
+                        check();
+                    }
+                });
+            }
+
+            {
+                auto threads = std::vector<std::jthread>{};
+                for (auto w : rv::iota(0u, static_cast<std::uint32_t>(writers))) {
+                    threads.emplace_back([&, w] {
+                        for (auto i : rv::iota(0u, perWriter)) {
+                            ring.push_back(Event::make(w, i));
+                        }
+                    });
+                }
+            }
+
+            done = true;
+        }
+
+        expect(that % bad.load() == 0);
+        expect(that % ring.written() == writers * perWriter);
+
+        // quiescent: every slot holds the latest ticket for it unless that write was dropped
+        auto entries = ring.snapshot();
+        expect(that % entries.size() + ring.dropped() >= ring.capacity());
+        check();
+        expect(that % bad.load() == 0);
+    } | std::vector{ 1uz, 2uz, 4uz, 8uz };
+}
@@ -94,6 +94,20 @@ void test()
 
     // TODO: add tests for exceptional cases (e.g. pop from empty deque, push to full deque, etc.)
 
+    "from_range constructor and append_range should keep the order of the range"_test = [] {
+        auto deque = dsa::Deque<Type>(std::from_range, rv::iota(0, 10));
+        expect(deque.size() == 10_i);
+        for (auto i : rv::iota(0, 10)) {
+            expect(that % deque.at(static_cast<std::size_t>(i)).value() == i);
+        }
+
+        deque.append_range(rv::iota(10, 30));
+        expect(deque.size() == 30_i);
+        for (auto i : rv::iota(0, 30)) {
+            expect(that % deque.pop_front().value() == i);
+        }
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
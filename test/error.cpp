@@ -0,0 +1,294 @@
+// built with -fno-exceptions (see CMakeLists.txt): every header must compile without exceptions and the try_
+// functions must report the misuses the plain operations would throw for
+
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/batch.hpp>
+#include <dsa/bit_vector.hpp>
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/channel.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/common.hpp>
+#include <dsa/compressed_int_list.hpp>
+#include <dsa/concurrent_blocky_linked_list.hpp>
+#include <dsa/concurrent_overwrite_ring.hpp>
+#include <dsa/deque.hpp>
+#include <dsa/doubly_linked_list.hpp>
+#include <dsa/error.hpp>
+#include <dsa/fenwick_tree.hpp>
+#include <dsa/fixed_array.hpp>
+#include <dsa/gap_buffer.hpp>
+#include <dsa/growth_policy.hpp>
+#include <dsa/linked_list.hpp>
+#include <dsa/lru_cache.hpp>
+#include <dsa/monoid.hpp>
+#include <dsa/parallel_algorithm.hpp>
+#include <dsa/persistent_ring.hpp>
+#include <dsa/pipeline.hpp>
+#include <dsa/queue.hpp>
+#include <dsa/radix_sort.hpp>
+#include <dsa/raw_buffer.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/segment_tree.hpp>
+#include <dsa/segmented.hpp>
+#include <dsa/seqlock_buffer.hpp>
+#include <dsa/simd.hpp>
+#include <dsa/sort.hpp>
+#include <dsa/stack.hpp>
+#include <dsa/timing_wheel.hpp>
+
+#include <boost/ut.hpp>
+
+#include <array>
+#include <csignal>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using dsa::Error;
+
+constexpr auto g_dynamic = dsa::BufferPolicy{ .m_capacity = dsa::BufferCapacityPolicy::DynamicCapacity };
+
+#if defined(__cpp_exceptions)
+#    error "this test is meant to be built with -fno-exceptions"
+#endif
+
+// the try_ functions a sequence container has, on a container holding 0 .. 9
+template <typename Container>
+void testSequence(Container container)
+{
+    using namespace ut::operators;
+    using ut::expect, ut::that;
+
+    for (auto i : rv::iota(0, 10)) {
+        if constexpr (requires { container.try_push_back(0); }) {
+            expect(container.try_push_back(auto{ i }).has_value());
+        } else {
+            container.push_back(auto{ i });
+        }
+    }
+
+    auto element = container.try_at(3);
+    expect(element.has_value() and element->get() == 3);
+    element->get() = 30;
+    expect(that % container.at(3) == 30);
+
+    expect(container.try_at(10).error() == Error::OutOfRange);
+    expect(std::as_const(container).try_at(10).error() == Error::OutOfRange);
+    static_assert(std::same_as<decltype(std::as_const(container).try_at(0)->get()), const int&>);
+
+    if constexpr (requires { container.try_insert(0, 0); }) {
+        expect(container.try_insert(11, 42).error() == Error::OutOfRange);
+        expect(that % container.size() == 10uz) << "a failed insert should not change the container";
+
+        auto inserted = container.try_insert(10, 42);
+        expect(inserted.has_value() and inserted->get() == 42);
+        expect(that % container.try_insert(0, 7)->get() == 7);
+        expect(that % container.at(0) == 7);
+        expect(that % container.at(11) == 42);
+    }
+
+    if constexpr (requires { container.try_pop_front(); }) {
+        auto front = container.at(0);
+        expect(container.try_pop_front() == front);
+        while (container.size() > 0) {
+            expect(container.try_pop_front().has_value());
+        }
+        expect(container.try_pop_front() == std::nullopt);
+    }
+}
+
+// fork and run fn in the child, whose stderr is returned if it was killed by SIGABRT
+template <typename Fn>
+std::optional<std::string> abortMessage(Fn fn)
+{
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        return std::nullopt;
+    }
+
+    auto pid = ::fork();
+    if (pid == 0) {
+        ::dup2(fds[1], STDERR_FILENO);
+        ::close(fds[0]);
+        fn();
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+
+    auto message = std::string{};
+    auto buffer  = std::array<char, 256>{};
+    for (auto read = 0z; (read = ::read(fds[0], buffer.data(), buffer.size())) > 0;) {
+        message.append(buffer.data(), static_cast<std::size_t>(read));
+    }
+    ::close(fds[0]);
+
+    auto status = 0;
+    ::waitpid(pid, &status, 0);
+    if (not WIFSIGNALED(status) or WTERMSIG(status) != SIGABRT) {
+        return std::nullopt;
+    }
+    return message;
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "every error should have a name"_test = [] {
+        expect(dsa::toString(Error::OutOfRange) == "out of range");
+        expect(dsa::toString(Error::Full) == "full");
+        expect(dsa::toString(Error::Closed) == "closed");
+    };
+
+    "sequence containers should report misuses through the try_ functions"_test = [] {
+        testSequence(dsa::ArrayList<int>{});
+        testSequence(dsa::CircularBuffer<int>{ 0, g_dynamic });
+        testSequence(dsa::BlockyLinkedList<int>{ 3 });
+        testSequence(dsa::StaticBlockyLinkedList<int, 4>{});
+        testSequence(dsa::Deque<int>{});
+        testSequence(dsa::LinkedList<int>{});
+        testSequence(dsa::DoublyLinkedList<int>{});
+        testSequence(dsa::GapBuffer<int>{});
+        testSequence(dsa::RootishArray<int>{});
+    };
+
+    "try_push_back and try_insert should fail on a full buffer only where push_back throws"_test = [] {
+        using enum dsa::BufferCapacityPolicy;
+        using enum dsa::BufferStorePolicy;
+
+        auto throwOnFull   = dsa::BufferPolicy{ .m_capacity = FixedCapacity, .m_store = ThrowOnFull };
+        auto replaceOnFull = dsa::BufferPolicy{ .m_capacity = FixedCapacity, .m_store = ReplaceOnFull };
+
+        auto throwing = dsa::CircularBuffer<int>{ 2, throwOnFull };
+        expect(throwing.try_push_back(1).has_value());
+        expect(throwing.try_push_back(2).has_value());
+        expect(throwing.try_push_back(3).error() == Error::Full);
+        expect(throwing.try_insert(0, 3).error() == Error::Full);
+        expect(throwing.try_insert(5, 3).error() == Error::OutOfRange) << "the position is checked first";
+        expect(rr::equal(throwing, std::array{ 1, 2 }));
+
+        auto replacing = dsa::CircularBuffer<int>{ 2, replaceOnFull };
+        replacing.push_back(1);
+        replacing.push_back(2);
+        expect(that % replacing.try_push_back(3)->get() == 3);
+        expect(rr::equal(replacing, std::array{ 2, 3 }));
+
+        auto empty = dsa::CircularBuffer<int>{ 0, replaceOnFull };
+        expect(empty.try_push_back(1).error() == Error::Full) << "a zero fixed capacity can't hold anything";
+
+        constexpr auto policy = dsa::BufferPolicy{ .m_capacity = FixedCapacity, .m_store = ThrowOnFull };
+        auto           fixed  = dsa::CircularBuffer<int, policy>{ 1 };
+        expect(fixed.try_push_back(1).has_value());
+        expect(fixed.try_push_back(2).error() == Error::Full);
+    };
+
+    "a failed push should not move from the value"_test = [] {
+        using enum dsa::BufferCapacityPolicy;
+        using enum dsa::BufferStorePolicy;
+
+        auto buffer = dsa::CircularBuffer<std::string>{ 0, { .m_capacity = FixedCapacity } };
+        auto value  = std::string(100, 'x');
+        expect(not buffer.try_push_back(std::move(value)).has_value());
+        expect(that % value.size() == 100uz);
+    };
+
+    "FixedArray::try_at should check the bound at() does not"_test = [] {
+        auto array = dsa::FixedArray<int>{ 1, 2, 3 };
+        expect(that % array.try_at(2)->get() == 3);
+        expect(array.try_at(3).error() == Error::OutOfRange);
+    };
+
+    "PersistentRing should report a full ring and an empty one"_test = [] {
+        auto path = std::filesystem::temp_directory_path() / "dsa_error_test.ring";
+        std::filesystem::remove(path);
+        {
+            auto ring = dsa::PersistentRing<int>{ path, 2, dsa::BufferStorePolicy::ThrowOnFull };
+            expect(ring.try_push_back(1).has_value());
+            expect(ring.try_push_back(2).has_value());
+            expect(ring.try_push_back(3).error() == Error::Full);
+            expect(ring.try_at(2).error() == Error::OutOfRange);
+            expect(ring.try_pop_front() == 1);
+            expect(ring.try_pop_front() == 2);
+            expect(ring.try_pop_front() == std::nullopt);
+        }
+        std::filesystem::remove(path);
+    };
+
+    "ConcurrentBlockyLinkedList should report positions out of range"_test = [] {
+        auto list  = dsa::ConcurrentBlockyLinkedList<std::string>{ 3 };
+        auto value = std::string(100, 'x');
+        expect(list.try_insert(1, std::move(value)).error() == Error::OutOfRange);
+        expect(that % value.size() == 100uz) << "a failed insert should not move from the value";
+        expect(list.try_insert(0, std::move(value)).has_value());
+        expect(list.try_at(1).error() == Error::OutOfRange);
+        expect(list.try_remove(1).error() == Error::OutOfRange);
+        expect(that % list.try_remove(0)->size() == 100uz);
+    };
+
+    "Queue and Stack try_pop should return nothing when empty"_test = [] {
+        auto queue = dsa::Queue<dsa::LinkedList, int>{};
+        queue.push(1);
+        expect(queue.try_pop() == 1);
+        expect(queue.try_pop() == std::nullopt);
+
+        auto stack = dsa::Stack<dsa::ArrayList, int>{};
+        stack.push(1);
+        stack.push(2);
+        expect(stack.try_pop() == 2);
+        expect(stack.try_pop() == 1);
+        expect(stack.try_pop() == std::nullopt);
+    };
+
+    "the plain operations should print the message and abort"_test = [] {
+        auto outOfRange = abortMessage([] {
+            auto list = dsa::ArrayList<int>{};
+            list.push_back(1);
+            list.insert(5, 2);
+        });
+        auto expected = "Cannot insert at position greater than size (5 > 1)";
+        expect(outOfRange.has_value() and outOfRange->contains(expected)) << outOfRange.value_or("");
+
+        auto full = abortMessage([] {
+            auto buffer = dsa::CircularBuffer<int>{ 1 };
+            buffer.push_back(1);
+            buffer.setPolicy(std::nullopt, dsa::BufferStorePolicy::ThrowOnFull);
+            buffer.push_back(2);
+        });
+        expect(full.has_value() and full->contains("Buffer is full")) << full.value_or("");
+
+        auto system = abortMessage([] {
+            auto ring = dsa::PersistentRing<int>{ "/nonexistent/dsa.ring", 4 };
+        });
+        expect(system.has_value() and system->contains("open /nonexistent/dsa.ring")) << system.value_or("");
+    };
+
+    "a pipeline should abort on an invalid config and on a failing stage"_test = [] {
+        auto config = abortMessage([] { dsa::Pipeline<int>{ { .m_capacity = 0 } }; });
+        expect(config.has_value() and config->contains("Invalid pipeline config")) << config.value_or("");
+
+        auto stage = abortMessage([] {
+            dsa::Pipeline<int>{}
+                .stage("check", [](int value) {
+                    if (value == 42) {
+                        dsa::fail<std::invalid_argument>("Bad value: {}", value);
+                    }
+                    return value;
+                })
+                .run(rv::iota(0, 100), [](int) {});
+        });
+        expect(stage.has_value() and stage->contains("Bad value: 42")) << stage.value_or("");
+    };
+}
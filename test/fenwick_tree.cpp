@@ -0,0 +1,146 @@
+#include "test_util.hpp"
+
+#include <dsa/fenwick_tree.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+std::int64_t naiveSum(const std::vector<std::int64_t>& values, std::size_t first, std::size_t last)
+{
+    auto begin = values.begin() + static_cast<std::ptrdiff_t>(first);
+    auto end   = values.begin() + static_cast<std::ptrdiff_t>(last);
+    return std::accumulate(begin, end, std::int64_t{ 0 });
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "default constructed fenwick tree holds the identity"_test = [] {
+        dsa::FenwickTree<int> tree{ 10 };
+        expect(tree.size() == 10_u);
+        expect(tree.prefix(10) == 0_i);
+
+        dsa::FenwickTree<int, dsa::Min<int>> minTree{ 10 };
+        expect(that % minTree.prefix(10) == std::numeric_limits<int>::max());
+    };
+
+    "build from range should give correct prefix and range queries"_test = [] {
+        auto values = std::vector<std::int64_t>(100);
+        rr::generate(values, [] { return test_util::random<std::int64_t>(-1000, 1000); });
+
+        dsa::FenwickTree<std::int64_t> tree{ values };
+        expect(that % tree.size() == values.size());
+
+        for (auto count : rv::iota(0uz, values.size() + 1)) {
+            expect(that % tree.prefix(count) == naiveSum(values, 0, count));
+        }
+        for (auto first : rv::iota(0uz, values.size())) {
+            for (auto last : rv::iota(first, values.size() + 1)) {
+                expect(that % tree.query(first, last) == naiveSum(values, first, last));
+            }
+        }
+        for (auto pos : rv::iota(0uz, values.size())) {
+            expect(that % tree.at(pos) == values[pos]);
+        }
+    };
+
+    "point update should be reflected on queries"_test = [] {
+        auto                           values = std::vector<std::int64_t>(37, 1);
+        dsa::FenwickTree<std::int64_t> tree{ values };
+
+        for (auto i : rv::iota(0uz, 200uz)) {
+            auto pos   = (i * 7) % values.size();
+            auto delta = static_cast<std::int64_t>(i % 5) - 2;
+
+            tree.update(pos, delta);
+            values[pos] += delta;
+
+            expect(that % tree.prefix(values.size()) == naiveSum(values, 0, values.size()));
+            expect(that % tree.query(pos / 2, pos + 1) == naiveSum(values, pos / 2, pos + 1));
+        }
+
+        expect(throws([&] { tree.update(values.size(), 1); })) << "out of bound update should throw";
+        expect(throws([&] { tree.prefix(values.size() + 1); })) << "out of bound query should throw";
+        expect(throws([&] { tree.query(2, 1); })) << "reversed range should throw";
+    };
+
+    "batch update should match individual updates on both small and large batches"_test = [] {
+        auto values = std::vector<std::int64_t>(64, 0);
+
+        dsa::FenwickTree<std::int64_t> single{ values };
+        dsa::FenwickTree<std::int64_t> batch{ values };
+
+        for (auto batchSize : { 2uz, 500uz }) {
+            auto updates = std::vector<std::pair<std::size_t, std::int64_t>>{};
+            for (auto i : rv::iota(0uz, batchSize)) {
+                updates.emplace_back((i * 13) % values.size(), static_cast<std::int64_t>(i % 7) - 3);
+            }
+
+            for (auto [pos, delta] : updates) {
+                single.update(pos, delta);
+                values[pos] += delta;
+            }
+            batch.updateBatch(updates);
+
+            for (auto count : rv::iota(0uz, values.size() + 1)) {
+                expect(that % batch.prefix(count) == single.prefix(count));
+                expect(that % batch.prefix(count) == naiveSum(values, 0, count));
+            }
+        }
+    };
+
+    "batch with an out of range position should throw and leave the tree untouched"_test = [] {
+        auto values = std::vector<std::int64_t>(64, 1);
+        auto tree   = dsa::FenwickTree<std::int64_t>{ values };
+
+        for (auto batchSize : { 2uz, 500uz }) {
+            auto updates = std::vector<std::pair<std::size_t, std::int64_t>>(batchSize, { 3, 5 });
+            updates.back().first = values.size();
+
+            expect(throws([&] { tree.updateBatch(updates); }));
+            for (auto count : rv::iota(0uz, values.size() + 1)) {
+                expect(that % tree.prefix(count) == static_cast<std::int64_t>(count));
+            }
+        }
+    };
+
+    "batch from a single pass range should be read once"_test = [] {
+        auto tree   = dsa::FenwickTree<std::int64_t>{ 8uz };
+        auto stream = std::istringstream{ "1 3 3 7" };
+        auto input  = rv::istream<std::size_t>(stream)
+                   | rv::transform([](std::size_t pos) { return std::pair{ pos, std::int64_t{ 2 } }; });
+        static_assert(not rr::forward_range<decltype(input)>);
+
+        tree.updateBatch(input);
+        expect(that % tree.query(3, 4) == 4);
+        expect(that % tree.prefix(8) == 8);
+    };
+
+    "non-invertible operation should support prefix queries"_test = [] {
+        auto values = std::vector<int>{ 5, 3, 8, 1, 9, 2, 7 };
+
+        dsa::FenwickTree<int, dsa::Max<int>> tree{ values };
+        expect(tree.prefix(1) == 5_i);
+        expect(tree.prefix(3) == 8_i);
+        expect(tree.prefix(7) == 9_i);
+
+        tree.update(1, 10);
+        expect(tree.prefix(1) == 5_i);
+        expect(tree.prefix(2) == 10_i);
+    };
+}
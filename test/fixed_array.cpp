@@ -49,6 +49,16 @@ void test()
         }
     };
 
+    if constexpr (std::default_initializable<Type> and std::assignable_from<Type&, int>) {
+        "fixed_array from_range construction"_test = [] {
+            auto array = dsa::FixedArray<Type>(std::from_range, rv::iota(0, 10));
+            expect(array.size() == 10_u);
+            for (auto i : rv::iota(0uz, array.size())) {
+                expect(that % array.at(i).value() == static_cast<int>(i));
+            }
+        };
+    }
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
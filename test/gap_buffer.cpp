@@ -0,0 +1,226 @@
+#include "test_util.hpp"
+
+#include <dsa/gap_buffer.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <cassert>
+#include <ranges>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using test_util::equalUnderlying;
+using test_util::populateContainer;
+
+template <test_util::TestClass Type>
+void test()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    Type::resetActiveInstanceCount();
+
+    "iterator should be a random access iterator"_test = [] {
+        using Iter = dsa::GapBuffer<Type>::template Iterator<false>;
+        static_assert(std::random_access_iterator<Iter>);
+
+        using ConstIter = dsa::GapBuffer<Type>::template Iterator<true>;
+        static_assert(std::random_access_iterator<ConstIter>);
+    };
+
+    "gap_buffer with 0 capacity is usable"_test = [] {
+        dsa::GapBuffer<int> buffer{};
+        expect(buffer.size() == 0_i);
+        expect(buffer.capacity() == 0_i);
+
+        expect(nothrow([&] { buffer.push_back(42); })) << "pushing to an empty buffer should grow the capacity";
+        expect(that % buffer.size() == 1_i);
+        expect(that % buffer.capacity() > 0);
+
+        expect(nothrow([&] { buffer.pop_back(); })) << "pop from a buffer with 1 element";
+        expect(throws([&] { buffer.pop_back(); })) << "pop from an empty buffer should throw";
+    };
+
+    "push_back and push_front should add elements at both ends"_test = [] {
+        dsa::GapBuffer<Type> buffer{};
+
+        populateContainer(buffer, rv::iota(0, 10));
+        expect(buffer.size() == 10_i);
+        expect(equalUnderlying<Type>(buffer, rv::iota(0, 10)));
+
+        buffer.push_front(-1);
+        expect(buffer.size() == 11_i);
+        expect(buffer.front().value() == -1_i);
+        expect(buffer.back().value() == 9_i);
+        expect(buffer.cursor() == 1_i);
+
+        std::vector<int> expected = { -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        expect(equalUnderlying<Type>(buffer, expected));
+    };
+
+    "insertion at the cursor should not move the other elements"_test = [] {
+        dsa::GapBuffer<Type> buffer{};
+        populateContainer(buffer, rv::iota(0, 10));
+        buffer.reserve(64);
+
+        buffer.moveCursor(5);
+        expect(buffer.cursor() == 5_i);
+
+        auto statBefore = buffer.afterGap() | rv::transform([](const Type& v) { return v.stat(); })
+                        | rr::to<std::vector>();
+
+        for (auto i : rv::iota(100, 110)) {
+            auto& value = buffer.insertAtCursor(i);
+            expect(that % value.value() == i);
+        }
+        expect(buffer.cursor() == 15_i);
+        expect(buffer.size() == 20_i);
+
+        // elements after the gap are untouched: neither moved nor copied by insertion at the cursor
+        auto statAfter = buffer.afterGap() | rv::transform([](const Type& v) { return v.stat(); });
+        for (auto [before, after] : rv::zip(statBefore, statAfter)) {
+            expect(that % before.movecount() == after.movecount());
+            expect(that % before.copycount() == after.copycount());
+        }
+
+        std::vector<int> values = { 0, 1, 2, 3, 4 };
+        for (auto i : rv::iota(100, 110)) {
+            values.push_back(i);
+        }
+        for (auto i : rv::iota(5, 10)) {
+            values.push_back(i);
+        }
+        expect(equalUnderlying<Type>(buffer, values));
+    };
+
+    "removal around the cursor should behave like backspace and delete"_test = [] {
+        dsa::GapBuffer<Type> buffer{};
+        populateContainer(buffer, rv::iota(0, 10));
+
+        buffer.moveCursor(5);
+        expect(buffer.removeBeforeCursor().value() == 4_i);
+        expect(buffer.removeAfterCursor().value() == 5_i);
+        expect(buffer.cursor() == 4_i);
+        expect(buffer.size() == 8_i);
+
+        std::vector<int> expected = { 0, 1, 2, 3, 6, 7, 8, 9 };
+        expect(equalUnderlying<Type>(buffer, expected));
+
+        buffer.moveCursor(0);
+        expect(throws([&] { buffer.removeBeforeCursor(); })) << "nothing before the cursor";
+
+        buffer.moveCursor(buffer.size());
+        expect(throws([&] { buffer.removeAfterCursor(); })) << "nothing after the cursor";
+        expect(throws([&] { buffer.moveCursor(buffer.size() + 1); })) << "cursor out of range";
+    };
+
+    "insert and remove should work at arbitrary positions"_test = [] {
+        dsa::GapBuffer<Type> buffer{};
+        std::vector<int>     expected{};
+
+        for (auto i : rv::iota(0, 50)) {
+            auto pos = static_cast<std::size_t>((i * 7) % (i + 1));
+            buffer.insert(pos, i);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), i);
+        }
+        expect(equalUnderlying<Type>(buffer, expected));
+
+        for (auto i : rv::iota(0, 25)) {
+            auto pos   = static_cast<std::size_t>((i * 13) % static_cast<int>(expected.size()));
+            auto value = buffer.remove(pos);
+            expect(that % value.value() == expected[pos]);
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+        expect(equalUnderlying<Type>(buffer, expected));
+
+        expect(throws([&] { buffer.insert(buffer.size() + 1, 0); })) << "out of bound insert should throw";
+        expect(throws([&] { buffer.remove(buffer.size()); })) << "out of bound remove should throw";
+        expect(throws([&] { buffer.at(buffer.size()); })) << "out of bound access should throw";
+    };
+
+    "iteration should skip the gap"_test = [] {
+        dsa::GapBuffer<Type> buffer{ 32 };
+        populateContainer(buffer, rv::iota(0, 10));
+        buffer.moveCursor(3);
+
+        expect(that % buffer.gapSize() == buffer.capacity() - 10);
+        expect(that % (buffer.end() - buffer.begin()) == 10);
+        expect(equalUnderlying<Type>(buffer | rv::reverse, rv::iota(0, 10) | rv::reverse));
+
+        expect(equalUnderlying<Type>(buffer.beforeGap(), rv::iota(0, 3)));
+        expect(equalUnderlying<Type>(buffer.afterGap(), rv::iota(3, 10)));
+
+        auto begin = buffer.begin();
+        expect(begin[2].value() == 2_i);
+        expect(begin[3].value() == 3_i);
+        expect((begin + 7)->value() == 7_i);
+    };
+
+    "move should leave buffer into an empty state that is usable"_test = [] {
+        dsa::GapBuffer<Type> buffer{};
+        populateContainer(buffer, rv::iota(0, 10));
+        buffer.moveCursor(4);
+
+        auto buffer2 = std::move(buffer);
+        expect(buffer.size() == 0_i);
+        expect(buffer.capacity() == 0_i);
+        expect(buffer2.cursor() == 4_i);
+        expect(equalUnderlying<Type>(buffer2, rv::iota(0, 10)));
+
+        expect(nothrow([&] { buffer.push_back(42); })) << "should not throw when push to empty buffer";
+        expect(that % buffer.size() == 1_i);
+    };
+
+    if constexpr (std::copyable<Type>) {
+        "copy should copy each element exactly"_test = [] {
+            dsa::GapBuffer<Type> buffer{};
+            populateContainer(buffer, rv::iota(0, 10));
+            buffer.moveCursor(6);
+
+            auto buffer2 = buffer;
+            expect(buffer2.size() == 10_i);
+            expect(buffer2.cursor() == 6_i);
+            expect(rr::equal(buffer2, buffer));
+
+            dsa::GapBuffer<Type> buffer3{};
+            buffer3 = buffer2;
+            expect(buffer3.size() == 10_i);
+            expect(rr::equal(buffer3, buffer));
+        };
+    }
+
+    "from_range constructor and append_range should keep the order of the range"_test = [] {
+        auto buffer = dsa::GapBuffer<Type>(std::from_range, rv::iota(0, 10));
+        expect(buffer.size() == 10_i);
+        expect(buffer.capacity() == 10_i);
+        expect(equalUnderlying<Type>(buffer, rv::iota(0, 10)));
+
+        buffer.moveCursor(3);
+        buffer.append_range(rv::iota(10, 20));
+        expect(buffer.cursor() == 20_i) << "the cursor should be after the appended elements";
+        expect(equalUnderlying<Type>(buffer, rv::iota(0, 20)));
+    };
+
+    // unbalanced constructor/destructor means there is a bug in the code
+    assert(Type::activeInstanceCount() == 0);
+}
+
+int main()
+{
+#ifdef DSA_TEST_EXTRA_TYPES
+    test_util::forEach<test_util::NonTrivialPermutations>([]<typename T>() {
+        if constexpr (dsa::GapBufferElement<T>) {
+            test<T>();
+        }
+    });
+#else
+    test<test_util::Regular>();
+    test<test_util::MovableOnly<>>();
+    test<test_util::CopyableOnly<>>();
+#endif
+}
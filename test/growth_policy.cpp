@@ -0,0 +1,222 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/growth_policy.hpp>
+
+#include <boost/ut.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using dsa::GrowthFactor;
+using dsa::GrowthPolicy;
+
+// the capacities a container goes through when it grows one element at a time up to count
+std::vector<std::size_t> capacities(GrowthPolicy policy, std::size_t count, std::size_t elementSize)
+{
+    auto result   = std::vector<std::size_t>{};
+    auto capacity = 0uz;
+    while (capacity < count) {
+        capacity = policy.grow(capacity, capacity + 1, elementSize);
+        result.push_back(capacity);
+    }
+    return result;
+}
+
+// the capacities seen by the container while pushing count elements one at a time
+template <typename Container>
+std::vector<std::size_t> observedCapacities(Container& container, std::size_t count)
+{
+    auto result = std::vector<std::size_t>{};
+    for (auto i : rv::iota(0uz, count)) {
+        container.push_back(static_cast<int>(i));
+        if (result.empty() or result.back() != container.capacity()) {
+            result.push_back(container.capacity());
+        }
+    }
+    return result;
+}
+
+constexpr auto g_growthPolicies = std::tuple{
+    GrowthPolicy{ .m_factor = GrowthFactor::Double },
+    GrowthPolicy{ .m_factor = GrowthFactor::OneAndHalf },
+    GrowthPolicy{ .m_factor = GrowthFactor::FixedIncrement, .m_increment = 10 },
+    GrowthPolicy{ .m_factor = GrowthFactor::SizeClass },
+    GrowthPolicy{ .m_factor = GrowthFactor::OneAndHalf, .m_shrinkDivisor = 3 },
+    GrowthPolicy{ .m_factor = GrowthFactor::SizeClass, .m_shrinkDivisor = 8 },
+};
+
+template <GrowthPolicy Growth>
+void testContainers()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "ArrayList should grow and shrink as the policy says"_test = [] {
+        auto list = dsa::ArrayList<int, Growth>{};
+        expect(observedCapacities(list, 1000) == capacities(Growth, 1000, sizeof(int)));
+        expect(rr::equal(list, rv::iota(0, 1000)));
+
+        auto full = list.capacity();
+        while (list.size() > 100) {
+            list.pop_back();
+        }
+
+        if constexpr (Growth.m_shrinkDivisor == 0) {
+            expect(that % list.capacity() == full) << "a list that never shrinks should keep its capacity";
+            return;
+        }
+        expect(that % list.capacity() < full) << "a shrinking list should give the memory back";
+
+        // pop until the next shrink, then pushes and pops around that point should not reallocate
+        for (auto capacity = list.capacity(); capacity == list.capacity();) {
+            list.pop_back();
+        }
+
+        auto capacity = list.capacity();
+        for (auto i : rv::iota(0, 100)) {
+            list.push_back(auto{ i });
+            list.pop_back();
+            expect(that % list.capacity() == capacity) << "shrinking should not thrash";
+        }
+    };
+
+    "CircularBuffer with DynamicCapacity should grow and shrink as the policy says"_test = [] {
+        constexpr auto policy = dsa::BufferPolicy{
+            .m_capacity = dsa::BufferCapacityPolicy::DynamicCapacity,
+            .m_store    = dsa::BufferStorePolicy::ThrowOnFull,
+            .m_growth   = Growth,
+        };
+
+        auto runtime = dsa::CircularBuffer<int>{ 0, policy };
+        auto fixed   = dsa::CircularBuffer<int, policy>{ 0 };
+        expect(observedCapacities(runtime, 1000) == capacities(Growth, 1000, sizeof(int)));
+        expect(observedCapacities(fixed, 1000) == capacities(Growth, 1000, sizeof(int)));
+
+        for (auto i : rv::iota(0, 995)) {
+            expect(that % runtime.pop_front() == i);
+            expect(that % fixed.pop_front() == i);
+            expect(that % runtime.capacity() == fixed.capacity());
+        }
+        expect(rr::equal(runtime, rv::iota(995, 1000)));
+
+        if (Growth.m_shrinkDivisor == 0) {
+            expect(that % runtime.capacity() >= 1000uz);
+        } else {
+            expect(that % runtime.capacity() <= 5uz * Growth.m_shrinkDivisor) << "should have shrunk";
+        }
+    };
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "each factor should give its capacity sequence"_test = [] {
+        auto double_    = GrowthPolicy{ .m_factor = GrowthFactor::Double };
+        auto oneAndHalf = GrowthPolicy{ .m_factor = GrowthFactor::OneAndHalf };
+        auto increment  = GrowthPolicy{ .m_factor = GrowthFactor::FixedIncrement, .m_increment = 64 };
+
+        expect(capacities(double_, 16, 8) == std::vector{ 1uz, 2uz, 4uz, 8uz, 16uz });
+        expect(capacities(oneAndHalf, 13, 8) == std::vector{ 1uz, 2uz, 3uz, 4uz, 6uz, 9uz, 13uz });
+        expect(capacities(increment, 200, 8) == std::vector{ 64uz, 128uz, 192uz, 256uz });
+
+        // the required count wins when it is more than the factor gives
+        expect(that % double_.grow(4, 100, 8) == 100uz);
+        expect(that % oneAndHalf.grow(4, 100, 8) == 100uz);
+        expect(that % increment.grow(4, 100, 8) == 100uz);
+    };
+
+    "size classes should be four per power of two"_test = [] {
+        expect(that % GrowthPolicy::sizeClass(1) == 16uz);
+        expect(that % GrowthPolicy::sizeClass(16) == 16uz);
+        expect(that % GrowthPolicy::sizeClass(17) == 32uz);
+        expect(that % GrowthPolicy::sizeClass(100) == 112uz);
+        expect(that % GrowthPolicy::sizeClass(1024) == 1024uz);
+        expect(that % GrowthPolicy::sizeClass(1025) == 1280uz);
+        expect(that % GrowthPolicy::sizeClass(1281) == 1536uz);
+        expect(that % GrowthPolicy::sizeClass(1 << 20) == 1uz << 20);
+
+        for (auto bytes : rv::iota(1uz, 100'000uz)) {
+            auto size = GrowthPolicy::sizeClass(bytes);
+            if (size < bytes or size > bytes + bytes / 4 + 16) {
+                expect(false) << "class" << size << "for" << bytes;
+                break;
+            }
+        }
+    };
+
+    "SizeClass growth should fill whole size classes"_test = [] {
+        auto policy = GrowthPolicy{ .m_factor = GrowthFactor::SizeClass };
+        for (auto elementSize : { 4uz, 8uz, 24uz }) {
+            for (auto capacity : capacities(policy, 100'000, elementSize)) {
+                auto bytes = capacity * elementSize;
+                expect(GrowthPolicy::sizeClass(bytes) - bytes < elementSize) << "capacity" << capacity;
+            }
+        }
+        expect(that % policy.grow(0, 1, 8) == 2uz) << "the smallest class holds two 8 byte elements";
+    };
+
+    "growth near the maximum should saturate instead of wrapping around"_test = [] {
+        constexpr auto max = std::numeric_limits<std::size_t>::max();
+
+        for (auto elementSize : { 1uz, 8uz, 24uz }) {
+            auto limit = max / elementSize;
+            for (auto factor : { GrowthFactor::Double, GrowthFactor::OneAndHalf, GrowthFactor::SizeClass }) {
+                auto policy = GrowthPolicy{ .m_factor = factor };
+                for (auto capacity : { limit / 2 + 1, limit - 1 }) {
+                    auto next = policy.grow(capacity, capacity + 1, elementSize);
+                    expect(next > capacity and next <= limit) << "capacity" << capacity;
+                }
+            }
+            auto increment = GrowthPolicy{ .m_factor = GrowthFactor::FixedIncrement, .m_increment = 64 };
+            expect(that % increment.grow(limit - 1, limit, elementSize) == limit);
+
+            if (elementSize > 1) {
+                expect(throws([&] { GrowthPolicy{}.grow(limit, limit + 1, elementSize); }))
+                    << "a count whose size can't be represented should throw";
+            }
+        }
+        expect(that % GrowthPolicy::sizeClass(max - 1) == max - 1) << "no size class past the last one";
+    };
+
+    "shrink should halve when the size drops to capacity / divisor"_test = [] {
+        auto never  = GrowthPolicy{};
+        auto policy = GrowthPolicy{ .m_shrinkDivisor = 4 };
+
+        expect(not never.shouldShrink(0, 100));
+        expect(policy.shouldShrink(25, 100));
+        expect(not policy.shouldShrink(26, 100));
+        expect(not policy.shouldShrink(24, 100)) << "only when the size crosses the threshold";
+        expect(that % policy.shrink(100, 8) == 50uz);
+
+        auto sized = GrowthPolicy{ .m_factor = GrowthFactor::SizeClass, .m_shrinkDivisor = 4 };
+        expect(that % sized.shrink(160, 8) == 80uz);
+        expect(that % sized.shrink(2, 8) == 2uz) << "no smaller class than the capacity";
+    };
+
+    "invalid policies should be rejected"_test = [] {
+        expect(not GrowthPolicy{ .m_shrinkDivisor = 2 }.isValid()) << "halving at half full would thrash";
+        expect(not GrowthPolicy{ .m_factor = GrowthFactor::FixedIncrement, .m_increment = 0 }.isValid());
+        expect(GrowthPolicy{ .m_shrinkDivisor = 3 }.isValid());
+
+        auto invalid = dsa::BufferPolicy{ .m_growth = { .m_shrinkDivisor = 1 } };
+        expect(throws([&] { dsa::CircularBuffer<int>{ 4, invalid }; }));
+    };
+
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (testContainers<std::get<I>(g_growthPolicies)>(), ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(g_growthPolicies)>>{});
+}
@@ -235,6 +235,16 @@ void test()
         };
     }
 
+    "from_range constructor and append_range should keep the order of the range"_test = [] {
+        auto list = dsa::LinkedList<Type>(std::from_range, rv::iota(0, 10));
+        expect(list.size() == 10_i);
+        expect(equalUnderlying<Type>(list, rv::iota(0, 10)));
+
+        list.append_range(rv::iota(10, 20));
+        expect(equalUnderlying<Type>(list, rv::iota(0, 20)));
+        expect(that % list.back().value() == 19);
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
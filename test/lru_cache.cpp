@@ -0,0 +1,355 @@
+#include "test_util.hpp"
+
+#include <dsa/lru_cache.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+// few distinct hashes so the index has long probe runs, exercises the backward shift on erase
+struct CollidingHash
+{
+    std::size_t operator()(int key) const noexcept { return static_cast<std::size_t>(key % 5); }
+};
+
+// straightforward LRU: a list with the most recently used key in front and a map into it
+class ReferenceLru
+{
+public:
+    ReferenceLru(std::size_t capacity)
+        : m_capacity{ capacity }
+    {
+    }
+
+    std::optional<int> get(int key)
+    {
+        auto it = m_map.find(key);
+        if (it == m_map.end()) {
+            return std::nullopt;
+        }
+        m_list.splice(m_list.begin(), m_list, it->second);
+        return it->second->second;
+    }
+
+    std::optional<std::pair<int, int>> put(int key, int value)
+    {
+        if (auto it = m_map.find(key); it != m_map.end()) {
+            it->second->second = value;
+            m_list.splice(m_list.begin(), m_list, it->second);
+            return std::nullopt;
+        }
+
+        auto evicted = std::optional<std::pair<int, int>>{};
+        if (m_list.size() == m_capacity) {
+            evicted = m_list.back();
+            m_map.erase(m_list.back().first);
+            m_list.pop_back();
+        }
+
+        m_list.emplace_front(key, value);
+        m_map[key] = m_list.begin();
+        return evicted;
+    }
+
+    bool erase(int key)
+    {
+        auto it = m_map.find(key);
+        if (it == m_map.end()) {
+            return false;
+        }
+        m_list.erase(it->second);
+        m_map.erase(it);
+        return true;
+    }
+
+    std::vector<int> keys() const
+    {
+        return m_list | rv::keys | rr::to<std::vector>();
+    }
+
+    std::size_t size() const { return m_list.size(); }
+
+private:
+    using List = std::list<std::pair<int, int>>;
+
+    std::size_t                             m_capacity;
+    List                                    m_list;
+    std::unordered_map<int, List::iterator> m_map;
+};
+
+template <typename Cache>
+std::vector<int> keysOf(const Cache& cache)
+{
+    auto keys = std::vector<int>{};
+    cache.forEach([&](int key, auto&&) { keys.push_back(key); });
+    return keys;
+}
+
+template <typename Hash>
+void lruModelTest(std::size_t capacity)
+{
+    using namespace ut::operators;
+    using ut::expect, ut::that;
+
+    auto cache     = dsa::LruCache<int, int, Hash>{ capacity };
+    auto reference = ReferenceLru{ capacity };
+
+    auto range = static_cast<int>(capacity * 2);
+    for (auto step [[maybe_unused]] : rv::iota(0, 20'000)) {
+        auto op  = test_util::random(0, 9);
+        auto key = test_util::random(0, range);
+
+        if (op < 4) {
+            auto* value    = cache.get(key);
+            auto  expected = reference.get(key);
+            expect(that % (value != nullptr) == expected.has_value());
+            if (value != nullptr and expected) {
+                expect(that % *value == *expected);
+            }
+        } else if (op < 8) {
+            auto value    = test_util::random(0, 1'000'000);
+            auto evicted  = cache.put(key, value);
+            auto expected = reference.put(key, value);
+            expect(that % evicted.has_value() == expected.has_value());
+            if (evicted and expected) {
+                expect(that % evicted->m_key == expected->first);
+                expect(that % evicted->m_value == expected->second);
+            }
+        } else {
+            expect(that % cache.erase(key) == reference.erase(key));
+        }
+
+        expect(that % cache.size() == reference.size());
+    }
+
+    expect(keysOf(cache) == reference.keys());
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    "zero capacity should throw"_test = [] {
+        expect(throws([] { dsa::LruCache<int, int>{ 0 }; }));
+        expect(throws([] { dsa::ClockCache<int, int>{ 0 }; }));
+        expect(throws([] { dsa::ShardedCache<dsa::LruCache<int, int>>{ 2, 4 }; }));
+        expect(nothrow([] { dsa::LruCache<int, int>{ 1 }; }));
+    };
+
+    "lru cache should evict the least recently used entry"_test = [] {
+        auto cache = dsa::LruCache<int, int>{ 3 };
+
+        expect(not cache.put(1, 10).has_value());
+        expect(not cache.put(2, 20).has_value());
+        expect(not cache.put(3, 30).has_value());
+        expect(keysOf(cache) == std::vector{ 3, 2, 1 });
+
+        expect(that % *cache.get(1) == 10);
+        expect(keysOf(cache) == std::vector{ 1, 3, 2 });
+
+        // peek doesn't change the recency
+        expect(that % *cache.peek(2) == 20);
+
+        auto evicted = cache.put(4, 40);
+        expect(evicted.has_value() and evicted->m_key == 2 and evicted->m_value == 20);
+        expect(not cache.contains(2));
+        expect(cache.get(2) == nullptr);
+
+        // assigning an existing key refreshes it without evicting
+        expect(not cache.put(3, 33).has_value());
+        expect(keysOf(cache) == std::vector{ 3, 4, 1 });
+        expect(that % *cache.get(3) == 33);
+
+        expect(cache.erase(4));
+        expect(not cache.erase(4));
+        expect(that % cache.size() == 2uz);
+
+        // the erased node is reused, nothing is evicted until the cache is full again
+        expect(not cache.put(5, 50).has_value());
+        expect(keysOf(cache) == std::vector{ 5, 3, 1 });
+        expect(that % cache.put(6, 60)->m_key == 1);
+
+        cache.clear();
+        expect(that % cache.size() == 0uz);
+        expect(keysOf(cache).empty());
+        expect(not cache.put(1, 1).has_value());
+    };
+
+    "lru cache random operations should match a reference model"_test = [](std::size_t capacity) {
+        lruModelTest<std::hash<int>>(capacity);
+        lruModelTest<CollidingHash>(capacity);
+    } | std::vector{ 1uz, 2uz, 7uz, 64uz, 1000uz };
+
+    "clock cache should give referenced entries a second chance"_test = [] {
+        auto cache = dsa::ClockCache<int, int>{ 3 };
+
+        cache.put(1, 10);
+        cache.put(2, 20);
+        cache.put(3, 30);
+
+        // nothing is referenced, the hand is at 1
+        auto evicted = cache.put(4, 40);
+        expect(evicted.has_value() and evicted->m_key == 1);
+
+        // 2 is referenced so the hand passes over it and clears its bit
+        expect(that % *cache.get(2) == 20);
+        evicted = cache.put(5, 50);
+        expect(evicted.has_value() and evicted->m_key == 3);
+
+        // the hand is back at 4, then 2 has lost its second chance
+        expect(that % cache.put(6, 60)->m_key == 4);
+        expect(that % cache.put(7, 70)->m_key == 2);
+
+        // peek doesn't set the referenced bit
+        expect(that % *cache.peek(5) == 50);
+        expect(that % cache.put(8, 80)->m_key == 5);
+
+        expect(cache.contains(6) and cache.contains(7) and cache.contains(8));
+        expect(that % cache.size() == 3uz);
+    };
+
+    "clock cache random operations should keep the entries consistent"_test = [](std::size_t capacity) {
+        auto cache    = dsa::ClockCache<int, int, CollidingHash>{ capacity };
+        auto expected = std::unordered_map<int, int>{};
+
+        auto range = static_cast<int>(capacity * 2);
+        for (auto step [[maybe_unused]] : rv::iota(0, 20'000)) {
+            auto op  = test_util::random(0, 9);
+            auto key = test_util::random(0, range);
+
+            if (op < 4) {
+                auto* value = cache.get(key);
+                if (value != nullptr) {
+                    expect(that % *value == expected.at(key));
+                }
+            } else if (op < 8) {
+                auto value   = test_util::random(0, 1'000'000);
+                auto evicted = cache.put(key, value);
+
+                if (evicted) {
+                    expect(that % evicted->m_value == expected.at(evicted->m_key));
+                    expected.erase(evicted->m_key);
+                } else {
+                    expect(expected.contains(key) or expected.size() < capacity);
+                }
+                expected[key] = value;
+            } else {
+                expect(that % cache.erase(key) == (expected.erase(key) == 1));
+            }
+
+            expect(that % cache.size() == expected.size());
+        }
+
+        // every entry the cache claims to have is the one that was put last
+        for (auto [key, value] : expected) {
+            expect(cache.peek(key) != nullptr and *cache.peek(key) == value);
+        }
+    } | std::vector{ 1uz, 2uz, 7uz, 64uz, 1000uz };
+
+    "non-trivial values should be destroyed exactly once"_test = [] {
+        using Type = test_util::MovableOnly<>;
+        Type::resetActiveInstanceCount();
+        {
+            auto lru   = dsa::LruCache<int, Type>{ 16 };
+            auto clock = dsa::ClockCache<int, Type>{ 16 };
+
+            for (auto i : rv::iota(0, 200)) {
+                auto key = test_util::random(0, 40);
+                lru.put(key, Type{ i });
+                clock.put(key, Type{ i });
+
+                if (i % 7 == 0) {
+                    lru.erase(test_util::random(0, 40));
+                    clock.erase(test_util::random(0, 40));
+                }
+                if (i % 5 == 0) {
+                    lru.get(key);
+                    clock.get(key);
+                }
+            }
+
+            auto evicted = lru.put(1'000, Type{ -1 });
+            expect(evicted.has_value() and evicted->m_value.value() >= 0);
+
+            lru.clear();
+            for (auto i : rv::iota(0, 10)) {
+                lru.put(i, Type{ i });
+            }
+        }
+
+        // unbalanced constructor/destructor means there is a bug in the code
+        assert(Type::activeInstanceCount() == 0);
+    };
+
+    "sharded cache should be usable from multiple threads"_test = [] {
+        constexpr auto threads = 8;
+        constexpr auto keys    = 4'000;
+
+        auto cache = dsa::ShardedCache<dsa::LruCache<int, int>>{ keys, 4 };
+        expect(that % cache.shards() == 4uz);
+
+        auto wrong   = std::atomic<int>{ 0 };
+        auto workers = std::vector<std::jthread>{};
+
+        // every value written for a key is derived from the key, a reader can check whatever it gets
+        for (auto t : rv::iota(0, threads)) {
+            workers.emplace_back([&, t] {
+                for (auto i : rv::iota(0, 50'000)) {
+                    auto key = (i * 31 + t * 7) % (keys * 2);
+                    if (i % 3 == 0) {
+                        cache.put(key, key * 2);
+                    } else if (auto value = cache.get(key); value and *value != key * 2) {
+                        ++wrong;
+                    }
+                    if (i % 101 == 0) {
+                        cache.erase(key);
+                    }
+                }
+            });
+        }
+        workers.clear();
+
+        expect(that % wrong.load() == 0);
+        expect(that % cache.size() <= keys + 0uz);
+
+        cache.put(-1, 7);
+        expect(cache.visit(-1, [](int& value) { value += 1; }));
+        expect(that % cache.get(-1).value() == 8);
+        expect(not cache.visit(-2, [](int&) { }));
+    };
+
+    "sharded clock cache should be usable"_test = [] {
+        auto cache = dsa::ShardedCache<dsa::ClockCache<int, int>>{ 64, 2 };
+        for (auto i : rv::iota(0, 1000)) {
+            cache.put(i, i);
+        }
+        expect(that % cache.size() == 64uz);
+        expect(that % cache.get(999).value() == 999);
+    };
+
+    "sharded cache should hold exactly its capacity when it does not divide evenly"_test = [] {
+        auto cache = dsa::ShardedCache<dsa::ClockCache<int, int>>{ 10, 4 };
+        expect(that % cache.capacity() == 10uz);
+
+        for (auto i : rv::iota(0, 1000)) {
+            cache.put(i, i);
+        }
+        expect(that % cache.size() == 10uz);
+    };
+}
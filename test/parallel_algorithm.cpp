@@ -0,0 +1,194 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/fixed_array.hpp>
+#include <dsa/parallel_algorithm.hpp>
+#include <dsa/rootish_array.hpp>
+
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+// below and above the per-thread parallel threshold for 1, 3 and 8 threads
+constexpr auto g_sizes   = std::array{ 0uz, 1uz, 1'000uz, 600'000uz };
+constexpr auto g_threads = std::array{ 1uz, 3uz, 8uz };
+
+template <typename C>
+C makeContainer(const std::vector<int>& values)
+{
+    return C{ std::from_range, values };
+}
+
+// a pre-sized output, filled with a value the algorithms never write
+template <typename C>
+C makeOutput(std::size_t size)
+{
+    return makeContainer<C>(std::vector<int>(size, -1));
+}
+
+std::vector<int> randomValues(std::size_t size, int max)
+{
+    auto values = std::vector<int>(size);
+    for (auto& value : values) {
+        value = test_util::random(0, max);
+    }
+    return values;
+}
+
+template <typename In, typename Out>
+void test()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    auto isEven = [](int value) { return value % 2 == 0; };
+
+    for (auto size : g_sizes) {
+        for (auto threads : g_threads) {
+            auto values = randomValues(size, 99);
+            auto in     = makeContainer<In>(values);
+
+            auto out = makeOutput<Out>(size);
+            dsa::parallel_inclusive_scan(in, out, std::plus<>{}, threads);
+            auto expected = std::vector<int>(size);
+            std::inclusive_scan(values.begin(), values.end(), expected.begin());
+            expect(rr::equal(out, expected)) << "inclusive_scan" << size << threads;
+
+            out = makeOutput<Out>(size);
+            dsa::parallel_exclusive_scan(in, out, 10, std::plus<>{}, threads);
+            std::exclusive_scan(values.begin(), values.end(), expected.begin(), 10);
+            expect(rr::equal(out, expected)) << "exclusive_scan" << size << threads;
+
+            out         = makeOutput<Out>(size);
+            auto copied = dsa::parallel_copy_if(in, out, isEven, threads);
+            expected.clear();
+            rr::copy_if(values, std::back_inserter(expected), isEven);
+            expect(that % copied == expected.size());
+            expect(rr::equal(out | rv::take(copied), expected)) << "copy_if" << size << threads;
+            expect(rr::all_of(out | rv::drop(copied), [](int value) { return value == -1; }));
+
+            // few distinct values so there are runs to collapse, also across the chunk boundaries
+            auto runs   = randomValues(size, 1);
+            auto runsIn = makeContainer<In>(runs);
+            out         = makeOutput<Out>(size);
+            auto unique = dsa::parallel_unique_copy(runsIn, out, rr::equal_to{}, threads);
+            expected.clear();
+            rr::unique_copy(runs, std::back_inserter(expected));
+            expect(that % unique == expected.size());
+            expect(rr::equal(out | rv::take(unique), expected)) << "unique_copy" << size << threads;
+
+            out         = makeOutput<Out>(size);
+            auto trues  = dsa::parallel_stable_partition(in, out, isEven, threads);
+            expected    = values;
+            auto middle = rr::stable_partition(expected, isEven).begin();
+            expect(that % trues == static_cast<std::size_t>(middle - expected.begin()));
+            expect(rr::equal(out, expected)) << "stable_partition" << size << threads;
+
+            auto inPlace = makeContainer<In>(values);
+            auto point   = dsa::parallel_partition(inPlace, isEven, threads);
+            expect(that % point == trues);
+            expect(rr::is_partitioned(inPlace, isEven)) << "partition" << size << threads;
+            expect(rr::all_of(inPlace | rv::take(point), isEven));
+
+            auto sorted = std::vector<int>(inPlace.begin(), inPlace.end());
+            rr::sort(sorted);
+            expected = values;
+            rr::sort(expected);
+            expect(sorted == expected) << "partition should be a permutation";
+        }
+    }
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "every algorithm should match its sequential std counterpart"_test = [] {
+        test<dsa::ArrayList<int>, dsa::ArrayList<int>>();
+        test<dsa::FixedArray<int>, dsa::FixedArray<int>>();
+        test<dsa::RootishArray<int>, dsa::RootishArray<int>>();
+        test<dsa::RootishArray<int>, dsa::ArrayList<int>>();
+    };
+
+    "a scan should only rely on associativity, not commutativity"_test = [](std::size_t threads) {
+        // affine maps x -> a x + b composed left to right
+        using Affine = std::pair<std::uint64_t, std::uint64_t>;
+        auto compose = [](Affine f, const Affine& g) {
+            return Affine{ f.first * g.first, f.second * g.first + g.second };
+        };
+
+        auto values = dsa::ArrayList<Affine>{};
+        for (auto i : rv::iota(0u, 300'000u)) {
+            values.push_back({ i % 7 + 1, i });
+        }
+
+        auto out = dsa::ArrayList<Affine>(values.size());
+        dsa::parallel_inclusive_scan(values, out, compose, threads);
+
+        auto expected = std::vector<Affine>(values.size());
+        std::inclusive_scan(values.begin(), values.end(), expected.begin(), compose);
+        expect(rr::equal(out, expected));
+    } | std::vector{ 1uz, 2uz, 4uz };
+
+    "a too small output should throw before anything is written"_test = [] {
+        auto in  = dsa::ArrayList<int>{ std::from_range, rv::iota(0, 200'000) };
+        auto out = dsa::ArrayList<int>(100'000);
+
+        expect(throws([&] { dsa::parallel_inclusive_scan(in, out, std::plus<>{}, 2); }));
+        expect(throws([&] { dsa::parallel_stable_partition(in, out, [](int) { return true; }, 2); }));
+        expect(throws([&] { dsa::parallel_copy_if(in, out, [](int value) { return value % 3 != 0; }, 2); }));
+        expect(rr::all_of(out, [](int value) { return value == 0; }));
+
+        auto fits = dsa::parallel_copy_if(in, out, [](int value) { return value % 2 == 0; }, 2);
+        expect(that % fits == 100'000uz) << "an output exactly as large as needed is enough";
+    };
+
+    "an exception from any thread or pass should be rethrown after the join"_test = [](int bad) {
+        auto in  = dsa::ArrayList<int>{ std::from_range, rv::iota(0, 400'000) };
+        auto out = dsa::ArrayList<int>(in.size());
+
+        auto pred = [bad](int value) {
+            if (value == bad) {
+                throw std::runtime_error{ "bad value" };
+            }
+            return value % 2 == 0;
+        };
+        auto op = [bad](int lhs, int rhs) {
+            if (rhs == bad) {
+                throw std::runtime_error{ "bad value" };
+            }
+            return lhs ^ rhs;
+        };
+
+        expect(throws([&] { dsa::parallel_inclusive_scan(in, out, op, 4); }));
+        expect(throws([&] { dsa::parallel_copy_if(in, out, pred, 4); }));
+        expect(throws([&] { dsa::parallel_stable_partition(in, out, pred, 4); }));
+        expect(throws([&] { dsa::parallel_partition(in, pred, 4); }));
+
+        // the second call for the value throws, in the second pass
+        auto calls  = std::atomic<int>{ 0 };
+        auto second = [&](int value) {
+            if (value == bad and calls.fetch_add(1) == 1) {
+                throw std::runtime_error{ "bad value" };
+            }
+            return value % 2 == 0;
+        };
+        expect(throws([&] { dsa::parallel_stable_partition(in, out, second, 4); }));
+    } | std::vector{ 1, 150'000, 399'999 };
+}
@@ -0,0 +1,282 @@
+#include "test_util.hpp"
+
+#include <dsa/circular_buffer.hpp>
+#include <dsa/persistent_ring.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+namespace fs = std::filesystem;
+
+// flight recorder entry, the checksum tells a torn record apart from an intact one
+struct Record
+{
+    std::uint64_t m_sequence;
+    std::uint32_t m_payload[5];
+    std::uint32_t m_checksum;
+
+    static Record make(std::uint64_t sequence)
+    {
+        auto record = Record{ sequence, {}, 0 };
+        for (auto i = 0u; i < 5; ++i) {
+            record.m_payload[i] = static_cast<std::uint32_t>(sequence * 2'654'435'761u + i);
+        }
+        record.m_checksum = record.sum();
+        return record;
+    }
+
+    std::uint32_t sum() const
+    {
+        auto sum = static_cast<std::uint32_t>(m_sequence ^ (m_sequence >> 32));
+        for (auto value : m_payload) {
+            sum = sum * 31 + value;
+        }
+        return sum;
+    }
+
+    bool intact() const { return m_checksum == sum(); }
+    bool operator==(const Record&) const = default;
+};
+
+using Ring = dsa::PersistentRing<Record>;
+
+// a file in the temporary directory that is removed at the end of the scope
+class TempFile
+{
+public:
+    TempFile()
+        : m_path{ fs::temp_directory_path() / fmt::format("dsa-ring-{}-{}", ::getpid(), s_counter++) }
+    {
+        fs::remove(m_path);
+    }
+
+    ~TempFile() { fs::remove(m_path); }
+
+    const fs::path& path() const { return m_path; }
+
+private:
+    static inline int s_counter = 0;
+
+    fs::path m_path;
+};
+
+// the records must be consecutive and intact
+bool consecutive(const Ring& ring)
+{
+    for (auto i = 0uz; i < ring.size(); ++i) {
+        const auto& record = ring.at(i);
+        if (not record.intact() or record.m_sequence != ring.front().m_sequence + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// run fn in a child process that is killed with SIGKILL when fn returns, no destructor runs
+template <typename Fn>
+void inChildKilled(Fn&& fn)
+{
+    auto pid = ::fork();
+    if (pid == 0) {
+        fn();
+        ::kill(::getpid(), SIGKILL);
+    }
+
+    auto status = 0;
+    ::waitpid(pid, &status, 0);
+    ut::expect(WIFSIGNALED(status) and WTERMSIG(status) == SIGKILL);
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    "ring should behave like a fixed capacity CircularBuffer"_test = [](dsa::BufferStorePolicy store) {
+        auto file   = TempFile{};
+        auto ring   = Ring{ file.path(), 37, store };
+        auto buffer = dsa::CircularBuffer<Record>{
+            37,
+            dsa::BufferPolicy{ .m_capacity = dsa::BufferCapacityPolicy::FixedCapacity, .m_store = store },
+        };
+
+        auto sequence = 0ull;
+        for (auto step [[maybe_unused]] : rv::iota(0, 5'000)) {
+            auto op = test_util::random(0, 9);
+
+            if (op < 6) {
+                auto record = Record::make(sequence++);
+                auto full   = buffer.size() == buffer.capacity();
+                if (full and store == dsa::BufferStorePolicy::ThrowOnFull) {
+                    expect(throws([&] { ring.push_back(record); }));
+                    expect(throws([&] { buffer.push_back(auto{ record }); }));
+                } else {
+                    expect(ring.push_back(record) == buffer.push_back(auto{ record }));
+                }
+            } else if (buffer.size() == 0) {
+                expect(throws([&] { ring.pop_front(); }));
+                expect(throws([&] { ring.pop_back(); }));
+            } else if (op < 8) {
+                expect(ring.pop_front() == buffer.pop_front());
+            } else {
+                expect(ring.pop_back() == buffer.pop_back());
+            }
+
+            expect(that % ring.size() == buffer.size());
+        }
+
+        expect(rr::equal(ring, buffer));
+        expect(rr::equal(ring.segments() | rv::join, buffer));
+        expect(throws([&] { ring.at(ring.size()); }));
+    } | std::vector{ dsa::BufferStorePolicy::ReplaceOnFull, dsa::BufferStorePolicy::ThrowOnFull };
+
+    "ring should keep its records across reopening"_test = [] {
+        auto file = TempFile{};
+        {
+            auto ring = Ring{ file.path(), 100 };
+            for (auto i : rv::iota(0u, 250u)) {
+                ring.push_back(Record::make(i));
+            }
+            ring.pop_front();
+            ring.sync();
+        }
+
+        auto ring = Ring{ file.path(), 100 };
+        expect(that % ring.size() == 99uz);
+        expect(that % ring.front().m_sequence == 151u);
+        expect(that % ring.back().m_sequence == 249u);
+        expect(consecutive(ring));
+
+        // the last n records, what a flight recorder reads back
+        auto last = ring | rv::drop(ring.size() - 10) | rv::transform(&Record::m_sequence);
+        expect(rr::equal(last, rv::iota(240u, 250u)));
+
+        ring.clear();
+        expect(that % ring.size() == 0uz);
+        expect(that % Ring{ fs::path{ file.path() }, 100 }.size() == 0uz) << "clear is persistent too";
+    };
+
+    "ring should survive the process being killed after appending"_test = [] {
+        auto file = TempFile{};
+
+        inChildKilled([&] {
+            auto ring = Ring{ file.path(), 64 };
+            for (auto i : rv::iota(0u, 1'000u)) {
+                ring.push_back(Record::make(i));
+            }
+        });
+
+        auto ring = Ring{ file.path(), 64 };
+        expect(that % ring.size() == 64uz);
+        expect(that % ring.back().m_sequence == 999u);
+        expect(consecutive(ring));
+    };
+
+    "ring should be consistent when the process is killed at an arbitrary point"_test = [] {
+        auto file = TempFile{};
+        auto last = 0ull;
+
+        for (auto round : rv::iota(0, 5)) {
+            auto pid = ::fork();
+            if (pid == 0) {
+                auto ring     = Ring{ file.path(), 1000 };
+                auto sequence = ring.size() == 0 ? 0ull : ring.back().m_sequence + 1;
+                while (true) {
+                    ring.push_back(Record::make(sequence++));
+                    if (sequence % 7 == 0) {
+                        ring.pop_front();
+                    }
+                }
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 5 + round * 3 });
+            ::kill(pid, SIGKILL);
+            ::waitpid(pid, nullptr, 0);
+
+            auto ring = Ring{ file.path(), 1000 };
+            expect(consecutive(ring));
+            if (ring.size() > 0) {
+                expect(that % ring.back().m_sequence >= last) << "a record that was published is never lost";
+                last = ring.back().m_sequence;
+            }
+        }
+    };
+
+    "opening a file of another shape or kind should throw"_test = [] {
+        auto file = TempFile{};
+        {
+            auto ring = Ring{ file.path(), 16 };
+            ring.push_back(Record::make(1));
+        }
+
+        expect(throws([&] { Ring{ file.path(), 17 }; }));
+        expect(throws([&] { dsa::PersistentRing<std::uint64_t>{ file.path(), 16 }; }));
+        expect(throws([&] { Ring{ file.path(), 0 }; }));
+        expect(nothrow([&] { Ring{ file.path(), 16 }; }));
+
+        auto garbage = TempFile{};
+        std::ofstream{ garbage.path() } << "definitely not a ring buffer, just some text";
+        expect(throws([&] { Ring{ garbage.path(), 16 }; }));
+
+        expect(throws([&] { Ring{ fs::path{ "/nonexistent/dir/ring" }, 16 }; }));
+        auto huge = std::numeric_limits<std::size_t>::max();
+        expect(throws([&] { Ring{ file.path(), huge }; })) << "the file length would overflow";
+    };
+
+    "file whose creation was killed before the header was written should be created again"_test = [] {
+        auto file = TempFile{};
+        {
+            auto probe = Ring{ file.path(), 16 };
+        }
+        auto length = fs::file_size(file.path());
+
+        // the state left by a kill between ftruncate and the header write
+        fs::resize_file(file.path(), 0);
+        fs::resize_file(file.path(), length);
+        {
+            auto ring = Ring{ file.path(), 16 };
+            expect(that % ring.size() == 0uz);
+            ring.push_back(Record::make(3));
+        }
+        expect(that % Ring{ file.path(), 16 }.front().m_sequence == 3u);
+
+        // an unfinished file of another length is rejected instead of resized
+        fs::resize_file(file.path(), 0);
+        fs::resize_file(file.path(), length);
+        expect(throws([&] { Ring{ file.path(), 32 }; }));
+    };
+
+    "moved ring should own the mapping"_test = [] {
+        auto file  = TempFile{};
+        auto ring  = Ring{ file.path(), 8 };
+        ring.push_back(Record::make(5));
+
+        auto moved = std::move(ring);
+        expect(that % moved.size() == 1uz);
+        expect(that % moved.front().m_sequence == 5u);
+
+        auto other = TempFile{};
+        ring       = Ring{ other.path(), 4 };
+        ring.push_back(Record::make(6));
+        ring.swap(moved);
+        expect(that % ring.front().m_sequence == 5u);
+        expect(that % moved.front().m_sequence == 6u);
+    };
+}
@@ -0,0 +1,252 @@
+#include "test_util.hpp"
+
+#include <dsa/pipeline.hpp>
+
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+// the move constructor throws on one value, the live instances are counted to catch leaks
+struct ThrowingMove
+{
+    static inline int s_live    = 0;
+    static inline int s_throwOn = -1;
+
+    int m_value;
+
+    ThrowingMove(int value)
+        : m_value{ value }
+    {
+        ++s_live;
+    }
+
+    ThrowingMove(ThrowingMove&& other)
+        : m_value{ other.m_value }
+    {
+        if (m_value == s_throwOn) {
+            throw std::runtime_error{ "move" };
+        }
+        ++s_live;
+    }
+
+    ThrowingMove& operator=(ThrowingMove&& other)
+    {
+        m_value = other.m_value;
+        return *this;
+    }
+
+    ~ThrowingMove() { --s_live; }
+};
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "invalid capacity should throw, capacity should be rounded up"_test = [] {
+        expect(throws([] { dsa::SpscRing<int>{ 0 }; }));
+        expect(that % dsa::SpscRing<int>{ 1 }.capacity() == 1uz);
+        expect(that % dsa::SpscRing<int>{ 100 }.capacity() == 128uz);
+    };
+
+    "try_push should move only what fits, pop should drain then report the close"_test = [] {
+        using Type = test_util::MovableOnly<>;
+        {
+            auto ring   = dsa::SpscRing<Type>{ 4 };
+            auto values = std::vector<Type>{};
+            for (auto i : rv::iota(0, 6)) {
+                values.emplace_back(i);
+            }
+
+            expect(that % ring.try_push(values) == 4uz);
+            expect(that % ring.size() == 4uz);
+            expect(that % values[4].value() == 4) << "the values that did not fit should not be moved";
+
+            auto out = dsa::ArrayList<Type>{};
+            expect(that % ring.try_pop(out, 3) == 3uz);
+            expect(that % ring.try_push(std::span{ values }.subspan(4)) == 2uz);
+
+            ring.close();
+            expect(ring.isClosed());
+            expect(that % ring.pop(out, 10) == 3uz);
+            expect(that % ring.pop(out, 10) == 0uz);
+            expect(that % ring.try_pop(out, 10) == 0uz);
+
+            expect(rr::equal(out | rv::transform(&Type::value), rv::iota(0, 6)));
+
+            // left in the ring, destroyed with it
+            auto left = dsa::SpscRing<Type>{ 8 };
+            auto more = std::vector<Type>{};
+            more.emplace_back(1);
+            more.emplace_back(2);
+            left.push(more);
+        }
+        assert(Type::activeInstanceCount() == 0);
+    };
+
+    "try_pop with a throwing move should keep the values it did not pop"_test = [] {
+        {
+            auto ring   = dsa::SpscRing<ThrowingMove>{ 8 };
+            auto values = std::vector<ThrowingMove>{};
+            for (auto i : rv::iota(0, 6)) {
+                values.emplace_back(i);
+            }
+            expect(that % ring.try_push(values) == 6uz);
+
+            auto out                = dsa::ArrayList<ThrowingMove>{};
+            ThrowingMove::s_throwOn = 3;
+            expect(throws([&] { ring.try_pop(out, 6); }));
+            ThrowingMove::s_throwOn = -1;
+
+            expect(that % out.size() == 3uz);
+            expect(that % ring.size() == 3uz) << "the popped values should be released";
+
+            expect(that % ring.try_pop(out, 6) == 3uz);
+            expect(rr::equal(out | rv::transform(&ThrowingMove::m_value), rv::iota(0, 6)));
+        }
+        expect(that % ThrowingMove::s_live == 0) << "every value should be destroyed once";
+    };
+
+    "try_push with a throwing move should keep the values it moved"_test = [] {
+        {
+            auto ring   = dsa::SpscRing<ThrowingMove>{ 8 };
+            auto values = std::vector<ThrowingMove>{};
+            for (auto i : rv::iota(0, 6)) {
+                values.emplace_back(i);
+            }
+
+            ThrowingMove::s_throwOn = 3;
+            expect(throws([&] { ring.try_push(values); }));
+            ThrowingMove::s_throwOn = -1;
+            expect(that % ring.size() == 3uz) << "the moved values should be published";
+
+            expect(that % ring.try_push(std::span{ values }.subspan(3)) == 3uz);
+
+            auto out = dsa::ArrayList<ThrowingMove>{};
+            expect(that % ring.try_pop(out, 8) == 6uz);
+            expect(rr::equal(out | rv::transform(&ThrowingMove::m_value), rv::iota(0, 6)));
+        }
+        expect(that % ThrowingMove::s_live == 0) << "every value should be destroyed once";
+    };
+
+    "a consumer on another thread should see every value in order"_test = [](std::size_t batch) {
+        constexpr auto count = 200'000uz;
+
+        auto ring     = dsa::SpscRing<std::uint64_t>{ 64 };
+        auto received = std::vector<std::uint64_t>{};
+        received.reserve(count);
+
+        auto consumer = std::jthread{ [&] {
+            auto out = dsa::ArrayList<std::uint64_t>{};
+            while (ring.pop(out, batch) > 0) {
+                for (auto value : out) {
+                    received.push_back(value);
+                }
+                out.clear();
+            }
+        } };
+
+        auto values = std::vector<std::uint64_t>{};
+        for (auto i = 0uz; i < count; i += batch) {
+            values.clear();
+            for (auto j = i; j < std::min(i + batch, count); ++j) {
+                values.push_back(j);
+            }
+            ring.push(values);
+        }
+        ring.close();
+        consumer.join();
+
+        expect(that % received.size() == count);
+        expect(rr::equal(received, rv::iota(0uz, count)));
+    } | std::vector{ 1uz, 7uz, 64uz, 100uz };
+
+    "invalid config should throw"_test = [] {
+        expect(throws([] { dsa::Pipeline<int>{ { .m_capacity = 0 } }; }));
+        expect(throws([] { dsa::Pipeline<int>{ { .m_batch = 0 } }; }));
+    };
+
+    "a pipeline should apply every stage in order"_test = [](std::size_t batch) {
+        constexpr auto count = 10'000;
+
+        auto output = std::vector<std::size_t>{};
+        auto stats  = dsa::Pipeline<int>{ { .m_capacity = 16, .m_batch = batch } }
+                         .stage("format", [](int value) { return std::to_string(value); })
+                         .stage("append", [](std::string text) { return text + "!"; })
+                         .stage("length", [](std::string text) { return text.size(); })
+                         .run(rv::iota(0, count), [&](std::size_t length) { output.push_back(length); });
+
+        auto length   = [](int i) { return std::to_string(i).size() + 1; };
+        auto expected = rv::iota(0, count) | rv::transform(length);
+        expect(rr::equal(output, expected));
+
+        expect(that % stats.m_stages.size() == 5uz);
+        auto names = std::vector<std::string>{};
+        for (const auto& stage : stats.m_stages) {
+            names.push_back(stage.m_name);
+            expect(that % stage.m_items == std::uint64_t{ count }) << stage.m_name;
+            expect(stage.m_maxDepth <= 16uz);
+            expect(stage.meanDepth() <= static_cast<double>(stage.m_maxDepth));
+        }
+        expect(names == std::vector<std::string>{ "source", "format", "append", "length", "sink" });
+        expect(that % stats.m_stages.at(0).m_batches == (count + batch - 1) / batch);
+    } | std::vector{ 1uz, 16uz, 64uz };
+
+    "a slow stage should make the stages before it wait"_test = [] {
+        auto sum   = 0;
+        auto stats = dsa::Pipeline<int>{ { .m_capacity = 4, .m_batch = 2 } }
+                         .stage("fast", [](int value) { return value; })
+                         .stage("slow", [](int value) {
+                             std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+                             return value;
+                         })
+                         .run(rv::iota(0, 200), [&](int value) { sum += value; });
+
+        expect(that % sum == 19900);
+        expect(that % stats.m_stages.at(1).m_outputWaits > 0u) << "the fast stage should hit backpressure";
+        expect(that % stats.m_stages.at(3).m_inputWaits > 0u) << "the sink should be starved";
+    };
+
+    "a throwing input should close the pipeline and rethrow"_test = [] {
+        auto output = std::vector<int>{};
+        auto input  = rv::iota(0, 100) | rv::transform([](int value) {
+                         if (value == 50) {
+                             throw std::runtime_error{ "bad input" };
+                         }
+                         return value;
+                     });
+
+        expect(throws([&] {
+            dsa::Pipeline<int>{ { .m_capacity = 4, .m_batch = 8 } }
+                .stage("double", [](int value) { return value * 2; })
+                .run(input, [&](int value) { output.push_back(value); });
+        }));
+        expect(rr::equal(output, rv::iota(0, 48) | rv::transform([](int value) { return value * 2; })))
+            << "the full batches before the throw should reach the sink";
+    };
+
+    "a pipeline without stages should pass the input to the sink"_test = [] {
+        auto input  = std::vector<std::string>{ "a", "b", "c" };
+        auto output = std::vector<std::string>{};
+        auto stats  = dsa::Pipeline<std::string>{}.run(input, [&](std::string value) {
+            output.push_back(std::move(value));
+        });
+        expect(output == input) << "the input should be copied";
+        expect(that % stats.m_stages.size() == 2uz);
+    };
+}
@@ -104,6 +104,19 @@ void test()
         expect(queue.empty());
     };
 
+    "push_range should push the elements in order"_test = [] {
+        auto queue  = dsa::Queue<dsa::DoublyLinkedList, Type>(std::from_range, rv::iota(0, 5));
+        auto queue2 = dsa::Queue<dsa::CircularBuffer, Type>{ 10uz };
+
+        queue.push_range(rv::iota(5, 10));
+        queue2.push_range(rv::iota(0, 10));
+
+        for (auto i : rv::iota(0, 10)) {
+            expect(that % queue.pop().value() == i);
+            expect(that % queue2.pop().value() == i);
+        }
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
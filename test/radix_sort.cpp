@@ -0,0 +1,173 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/radix_sort.hpp>
+#include <dsa/rootish_array.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using test_util::populateContainer;
+
+// sizes below and above the comparison sort threshold and the parallel threshold
+constexpr auto g_sizes = std::array{ 0uz, 1uz, 100uz, 1'000uz, 300'000uz };
+
+template <typename T>
+std::vector<T> randomValues(std::size_t size, T min, T max)
+{
+    auto values = std::vector<T>(size);
+    for (auto& value : values) {
+        value = test_util::random(min, max);
+    }
+    return values;
+}
+
+template <test_util::TestClass Type>
+void test()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    Type::resetActiveInstanceCount();
+
+    "radix_sort should be stable and never copy"_test = [](std::size_t size) {
+        auto values = randomValues(size, 0, 99'999);
+
+        dsa::ArrayList<Type> list{};
+        populateContainer(list, values);
+
+        // sort by the thousands only, the rest of the value must keep the original order
+        auto key = [](const Type& value) noexcept { return value.value() / 1000; };
+        dsa::radix_sort(list, key);
+
+        auto expected = values;
+        rr::stable_sort(expected, {}, [](int value) { return value / 1000; });
+
+        expect(test_util::equalUnderlying<Type>(list, expected));
+        expect(rr::all_of(list, [](const Type& value) { return value.stat().nocopy(); }));
+    } | g_sizes;
+
+    // a key that may throw is rejected: it would throw while the elements are split with the scratch
+    static_assert(dsa::RadixSortable<dsa::ArrayList<Type>&, int (*)(const Type&) noexcept>);
+    static_assert(not dsa::RadixSortable<dsa::ArrayList<Type>&, int (*)(const Type&)>);
+
+    "parallel_radix_sort should give the same result as the sequential one"_test = [](std::size_t size) {
+        auto values = randomValues(size, -50'000, 50'000);
+
+        dsa::ArrayList<Type> list{};
+        populateContainer(list, values);
+
+        dsa::parallel_radix_sort<11>(list, &Type::value, 4);
+
+        auto expected = values;
+        rr::sort(expected);
+        expect(test_util::equalUnderlying<Type>(list, expected));
+    } | g_sizes;
+
+    "radix_sort should work on non-contiguous random access containers"_test = [] {
+        auto values = randomValues(5'000uz, -100, 100);
+
+        dsa::RootishArray<Type> array{};
+        populateContainer(array, values);
+
+        dsa::radix_sort<16>(array, &Type::value);
+
+        auto expected = values;
+        rr::sort(expected);
+        expect(test_util::equalUnderlying<Type>(array, expected));
+    };
+
+    // unbalanced constructor/destructor means there is a bug in the code
+    assert(Type::activeInstanceCount() == 0);
+}
+
+template <typename T, std::size_t DigitBits>
+void testNumeric(T min, T max)
+{
+    using ut::expect;
+
+    for (auto size : g_sizes) {
+        auto values   = randomValues(size, min, max);
+        auto expected = values;
+        rr::stable_sort(expected);
+
+        auto list = dsa::ArrayList<T>{};
+        for (auto value : values) {
+            list.push_back(static_cast<T>(value));
+        }
+
+        auto scratch = dsa::RawBuffer<T>{};
+        dsa::radix_sort<DigitBits>(list, std::identity{}, scratch);
+        expect(rr::equal(list, expected)) << "size" << size << "digit" << DigitBits;
+
+        auto parallel = values;
+        dsa::parallel_radix_sort<DigitBits>(parallel, std::identity{}, scratch, 3);
+        expect(rr::equal(parallel, expected)) << "parallel, size" << size << "digit" << DigitBits;
+    }
+}
+
+int main()
+{
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "radix keys should preserve the order of the original keys"_test = [] {
+        expect(dsa::toRadixKey(-1) < dsa::toRadixKey(0));
+        expect(dsa::toRadixKey(std::numeric_limits<int>::min()) == 0u);
+        expect(dsa::toRadixKey(-1.5) < dsa::toRadixKey(-0.5));
+        expect(dsa::toRadixKey(-0.0f) < dsa::toRadixKey(0.0f));
+        expect(dsa::toRadixKey(-std::numeric_limits<double>::infinity()) < dsa::toRadixKey(-1e308));
+        expect(dsa::toRadixKey(1e308) < dsa::toRadixKey(std::numeric_limits<double>::infinity()));
+    };
+
+    "radix_sort should sort every key type with every digit width"_test = [] {
+        testNumeric<std::uint32_t, 8>(0, std::numeric_limits<std::uint32_t>::max());
+        testNumeric<std::int64_t, 11>(std::numeric_limits<std::int64_t>::min(), 1'000);
+        testNumeric<std::int16_t, 16>(-1'000, 1'000);
+        testNumeric<float, 8>(-1e6f, 1e6f);
+        testNumeric<double, 11>(-1e100, 1e100);
+    };
+
+    "constant digits should be skipped without moving the elements"_test = [] {
+        using Type = test_util::Regular;
+
+        auto values = rv::iota(0, 1000) | rv::transform([](int i) { return 7 + (i % 3) * 0x10000; });
+
+        dsa::ArrayList<Type> list{};
+        populateContainer(list, values);
+
+        auto moves  = [](const Type& value) { return value.stat().movecount(); };
+        auto total  = [&] { return rr::fold_left(list | rv::transform(moves), 0uz, std::plus{}); };
+        auto before = total();
+
+        // only the third byte differs: one pass into the scratch then a move back
+        dsa::radix_sort<8>(list, &Type::value);
+
+        expect(rr::is_sorted(list, {}, &Type::value));
+        expect(that % total() == before + 2 * list.size());
+    };
+
+#ifdef DSA_TEST_EXTRA_TYPES
+    test_util::forEach<test_util::NonTrivialPermutations>([]<typename T>() {
+        if constexpr (dsa::RadixSortable<dsa::ArrayList<T>&, decltype(&T::value)>) {
+            test<T>();
+        }
+    });
+#else
+    test<test_util::Regular>();
+    test<test_util::MovableOnly<>>();
+#endif
+}
@@ -49,6 +49,26 @@ void test()
         }
     };
 
+    if constexpr (Type::s_copyable) {
+        "constructRange should copy construct each element once"_test = [] {
+            dsa::RawBuffer<Type> source{ 10 };
+            for (auto i : rv::iota(0uz, 10uz)) {
+                source.construct(i, static_cast<int>(i));
+            }
+
+            dsa::RawBuffer<Type> buffer{ 20 };
+            buffer.constructRange(5, source.data(), 10);
+
+            for (auto i : rv::iota(0uz, 10uz)) {
+                expect(that % buffer.at(5 + i).value() == static_cast<int>(i));
+                expect(that % buffer.at(5 + i).stat().m_copyCtorCount == 1uz);
+            }
+
+            buffer.destroyRange(5, 10);
+            source.destroyRange(0, 10);
+        };
+    }
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
@@ -257,6 +257,27 @@ void test()
         }
     };
 
+    "from_range constructor and append_range should keep the order of the range"_test = [] {
+        auto array = dsa::RootishArray<Type>(std::from_range, rv::iota(0, 10));
+        expect(array.size() == 10_i);
+        expect(array.blocks().size() == 5_i) << "4 blocks for 10 elements plus the empty one";
+        expect(equalUnderlying<Type>(array, rv::iota(0, 10)));
+
+        array.append_range(rv::iota(10, 100));
+        expect(array.size() == 100_i);
+        expect(equalUnderlying<Type>(array, rv::iota(0, 100)));
+
+        // the invariants still hold
+        populateContainer(array, rv::iota(100, 110));
+        for (auto i : rv::iota(0, 110) | rv::reverse) {
+            expect(that % array.pop_back().value() == i);
+        }
+        expect(array.size() == 0_i);
+
+        auto array2 = rv::iota(0, 3) | rr::to<dsa::RootishArray<Type>>();
+        expect(equalUnderlying<Type>(array2, rv::iota(0, 3)));
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
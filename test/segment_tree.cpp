@@ -0,0 +1,166 @@
+#include "test_util.hpp"
+
+#include <dsa/segment_tree.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+auto slice(const std::vector<std::int64_t>& values, std::size_t first, std::size_t last)
+{
+    auto begin = values.begin() + static_cast<std::ptrdiff_t>(first);
+    auto end   = values.begin() + static_cast<std::ptrdiff_t>(last);
+    return rr::subrange{ begin, end };
+}
+
+std::int64_t naiveSum(const std::vector<std::int64_t>& values, std::size_t first, std::size_t last)
+{
+    auto range = slice(values, first, last);
+    return std::accumulate(range.begin(), range.end(), std::int64_t{ 0 });
+}
+
+std::int64_t naiveMin(const std::vector<std::int64_t>& values, std::size_t first, std::size_t last)
+{
+    auto range = slice(values, first, last);
+    return rr::fold_left(range, dsa::Min<std::int64_t>::identity(), dsa::Min<std::int64_t>{});
+}
+
+// sizes that are and are not a power of two
+constexpr auto g_sizes = std::array{ 1uz, 2uz, 7uz, 16uz, 33uz };
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "point assignment without lazy action"_test = [](std::size_t size) {
+        auto values = std::vector<std::int64_t>(size);
+        rr::iota(values, 1);
+
+        dsa::SegmentTree<std::int64_t> tree{ values };
+        expect(that % tree.size() == size);
+
+        for (auto pos : rv::iota(0uz, size)) {
+            tree.set(pos, values[pos] * 3);
+            values[pos] *= 3;
+
+            for (auto first : rv::iota(0uz, size)) {
+                expect(that % tree.query(first, size) == naiveSum(values, first, size));
+            }
+            expect(that % tree.at(pos) == values[pos]);
+        }
+
+        expect(throws([&] { tree.set(size, 0); })) << "out of bound set should throw";
+        expect(throws([&] { tree.query(0, size + 1); })) << "out of bound query should throw";
+        expect(tree.query(0, 0) == 0_i) << "empty range should return the identity";
+    } | g_sizes;
+
+    "range add on sum"_test = [](std::size_t size) {
+        auto values = std::vector<std::int64_t>(size, 0);
+
+        dsa::SegmentTree<std::int64_t, dsa::Sum<std::int64_t>, dsa::RangeAdd<std::int64_t>> tree{ values };
+
+        for (auto i : rv::iota(0uz, 100uz)) {
+            auto first = (i * 5) % (size + 1);
+            auto last  = std::min(size, first + i % 7);
+            auto delta = static_cast<std::int64_t>(i % 9) - 4;
+
+            tree.update(first, last, delta);
+            for (auto pos : rv::iota(first, last)) {
+                values[pos] += delta;
+            }
+
+            for (auto l : rv::iota(0uz, size + 1)) {
+                for (auto r : rv::iota(l, size + 1)) {
+                    expect(that % tree.query(l, r) == naiveSum(values, l, r));
+                }
+            }
+        }
+    } | g_sizes;
+
+    "range assign and range add on min"_test = [](std::size_t size) {
+        using Min = dsa::Min<std::int64_t>;
+
+        auto values = std::vector<std::int64_t>(size);
+        rr::generate(values, [] { return test_util::random<std::int64_t>(-100, 100); });
+
+        dsa::SegmentTree<std::int64_t, Min, dsa::RangeAssign<std::int64_t, Min>> assign{ values };
+        dsa::SegmentTree<std::int64_t, Min, dsa::RangeAdd<std::int64_t, Min>>    add{ values };
+
+        auto assigned = values;
+        auto added    = values;
+
+        for (auto i : rv::iota(0uz, 100uz)) {
+            auto first = test_util::random<std::size_t>(0, size);
+            auto last  = test_util::random<std::size_t>(first, size);
+            auto value = test_util::random<std::int64_t>(-100, 100);
+
+            assign.update(first, last, value);
+            add.update(first, last, value);
+            for (auto pos : rv::iota(first, last)) {
+                assigned[pos]  = value;
+                added[pos]    += value;
+            }
+
+            auto l = test_util::random<std::size_t>(0, size);
+            auto r = test_util::random<std::size_t>(l, size);
+            expect(that % assign.query(l, r) == naiveMin(assigned, l, r)) << "iteration" << i;
+            expect(that % add.query(l, r) == naiveMin(added, l, r)) << "iteration" << i;
+        }
+    } | g_sizes;
+
+    "point assignment interleaved with pending range updates"_test = [] {
+        auto values = std::vector<std::int64_t>(10, 1);
+
+        dsa::SegmentTree<std::int64_t, dsa::Sum<std::int64_t>, dsa::RangeAssign<std::int64_t>> tree{ values };
+
+        tree.update(0, 10, 5);
+        tree.set(3, 0);
+        tree.update(2, 5, 2);
+        tree.set(4, 7);
+
+        auto expected = std::vector<std::int64_t>{ 5, 5, 2, 2, 7, 5, 5, 5, 5, 5 };
+        for (auto pos : rv::iota(0uz, expected.size())) {
+            expect(that % tree.at(pos) == expected[pos]);
+        }
+        expect(that % tree.query(0, 10) == naiveSum(expected, 0, 10));
+    };
+
+    "const queries with pending updates should be safe from many threads"_test = [] {
+        auto values = std::vector<std::int64_t>(1'000, 1);
+
+        dsa::SegmentTree<std::int64_t, dsa::Sum<std::int64_t>, dsa::RangeAdd<std::int64_t>> tree{ values };
+        for (auto i : rv::iota(0uz, 100uz)) {
+            tree.update(i, values.size() - i, 1);
+            for (auto pos : rv::iota(i, values.size() - i)) {
+                values[pos] += 1;
+            }
+        }
+
+        const auto& shared = tree;
+        auto        bad    = std::vector<int>(4, 0);
+        {
+            auto readers = std::vector<std::jthread>{};
+            for (auto t : rv::iota(0uz, 4uz)) {
+                readers.emplace_back([&, t] {
+                    for (auto first = t; first < values.size(); first += 7) {
+                        auto last  = std::min(first + 50, values.size());
+                        bad[t]    += shared.query(first, last) != naiveSum(values, first, last) ? 1 : 0;
+                    }
+                });
+            }
+        }
+        expect(rr::all_of(bad, [](int count) { return count == 0; }));
+    };
+}
@@ -0,0 +1,235 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/blocky_linked_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/fixed_array.hpp>
+#include <dsa/linked_list.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/segmented.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+namespace seg = dsa::segmented;
+
+static_assert(dsa::segmented_range<dsa::ArrayList<int>>);
+static_assert(dsa::segmented_range<const dsa::ArrayList<int>>);
+static_assert(dsa::segmented_range<dsa::CircularBuffer<int>>);
+static_assert(dsa::segmented_range<dsa::RootishArray<int>>);
+static_assert(dsa::segmented_range<dsa::BlockyLinkedList<int>>);
+static_assert(dsa::segmented_range<std::vector<int>>);
+static_assert(not dsa::segmented_range<dsa::LinkedList<int>>);
+
+static_assert(dsa::output_segmented_range<dsa::CircularBuffer<int>, int>);
+static_assert(not dsa::output_segmented_range<const dsa::CircularBuffer<int>, int>);
+
+// a user type that opts in with a free function found by argument dependent lookup
+namespace user
+{
+    struct Halves
+    {
+        std::vector<int> m_front;
+        std::vector<int> m_back;
+
+        auto begin() const { return m_front.begin(); }    // the segments are what matters here
+        auto end() const { return m_front.end(); }
+    };
+
+    std::array<std::span<const int>, 2> segments(const Halves& halves)
+    {
+        return { std::span{ halves.m_front }, std::span{ halves.m_back } };
+    }
+}
+
+static_assert(dsa::segmented_range<user::Halves>);
+
+constexpr auto g_sizes = std::array{ 0uz, 1uz, 2uz, 5uz, 17uz, 100uz, 1'000uz };
+
+// the head of a circular buffer is moved to the middle so its elements are split into two segments
+template <typename C>
+C makeContainer(std::size_t size)
+{
+    auto values = rv::iota(0, static_cast<int>(size));
+
+    if constexpr (std::same_as<C, dsa::CircularBuffer<int>>) {
+        auto buffer = C{ size + 3 };
+        for (auto i : rv::iota(0, static_cast<int>(size / 2 + 3))) {
+            buffer.push_back(auto{ i });
+            buffer.pop_front();
+        }
+        buffer.append_range(values);
+        return buffer;
+    } else if constexpr (std::same_as<C, dsa::BlockyLinkedList<int>>) {
+        auto list = C{ 4 };
+        for (auto i : values) {
+            list.push_back(auto{ i });
+        }
+        return list;
+    } else if constexpr (std::same_as<C, dsa::FixedArray<int>>) {
+        auto array = C::sized(size);
+        rr::copy(values, array.begin());
+        return array;
+    } else if constexpr (std::same_as<C, std::vector<int>>) {
+        return values | rr::to<std::vector>();
+    } else {
+        return C(std::from_range, values);
+    }
+}
+
+template <typename C>
+std::vector<int> flatten(const C& container)
+{
+    auto result = std::vector<int>{};
+    for (auto segment : dsa::segments(container)) {
+        result.insert(result.end(), segment.begin(), segment.end());
+    }
+    return result;
+}
+
+template <typename C>
+void test()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "segments should concatenate to the container"_test = [](std::size_t size) {
+        const auto container = makeContainer<C>(size);
+        expect(rr::equal(flatten(container), container));
+    } | g_sizes;
+
+    "for_each and accumulate should visit every element in order"_test = [](std::size_t size) {
+        const auto container = makeContainer<C>(size);
+
+        auto visited = std::vector<int>{};
+        seg::for_each(container, [&](int value) { visited.push_back(value); });
+        expect(rr::equal(visited, container));
+
+        auto expected = std::accumulate(container.begin(), container.end(), 0ll);
+        expect(that % seg::accumulate(container, 0ll) == expected);
+
+        // non-commutative operation to check the order
+        auto concat    = [](long long acc, int value) { return acc * 3 + value % 7; };
+        auto expected2 = std::accumulate(container.begin(), container.end(), 1ll, concat);
+        expect(that % seg::accumulate(container, 1ll, concat) == expected2);
+    } | g_sizes;
+
+    "find should return the position of the first match"_test = [](std::size_t size) {
+        auto container = makeContainer<C>(size);
+        for (auto pos : { 0uz, size / 3, size / 2, size - 1 }) {
+            if (pos < size) {
+                expect(that % seg::find(container, static_cast<int>(pos)) == pos);
+            }
+        }
+        expect(that % seg::find(container, -1) == size) << "not found should return the size";
+    } | g_sizes;
+
+    "copy to an output iterator should keep the order"_test = [](std::size_t size) {
+        const auto container = makeContainer<C>(size);
+
+        auto out = std::vector<int>{};
+        seg::copy(container, std::back_inserter(out));
+        expect(rr::equal(out, container));
+    } | g_sizes;
+
+    "fill should assign every element"_test = [](std::size_t size) {
+        auto container = makeContainer<C>(size);
+        seg::fill(container, 42);
+        expect(that % rr::count(container, 42) == static_cast<long>(size));
+    } | g_sizes;
+
+    "copy between segmented ranges should stop at the shorter one"_test = [](std::size_t size) {
+        const auto source = makeContainer<C>(size);
+
+        auto wrapped = makeContainer<dsa::CircularBuffer<int>>(size / 2 + 1);
+        auto copied  = seg::copy(source, wrapped);
+
+        auto expected = std::min(size, wrapped.size());
+        expect(that % copied == expected);
+        expect(rr::equal(wrapped | rv::take(expected), source | rv::take(expected)));
+
+        auto rootish = makeContainer<dsa::RootishArray<int>>(size + 10);
+        std::ignore = rr::fill(rootish, -1);
+        expect(that % seg::copy(source, rootish) == size);
+        expect(rr::equal(rootish | rv::take(size), source));
+        expect(rr::all_of(rootish | rv::drop(size), [](int value) { return value == -1; }));
+    } | g_sizes;
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    test<dsa::ArrayList<int>>();
+    test<dsa::CircularBuffer<int>>();
+    test<dsa::RootishArray<int>>();
+    test<dsa::BlockyLinkedList<int>>();
+    test<dsa::FixedArray<int>>();
+    test<std::vector<int>>();
+
+    "CircularBuffer should expose its two ring segments"_test = [] {
+        auto buffer = makeContainer<dsa::CircularBuffer<int>>(10);
+        auto count  = rr::distance(dsa::segments(buffer));
+        expect(that % count == 2);
+        expect(rr::all_of(dsa::segments(buffer), [](auto segment) { return segment.size() > 0; }));
+    };
+
+    "BlockyLinkedList should expose the segments of every block"_test = [] {
+        auto list  = makeContainer<dsa::BlockyLinkedList<int>>(20);
+        auto total = 0uz;
+        for (auto segment : dsa::segments(list)) {
+            total += segment.size();
+        }
+        expect(that % total == 20uz);
+        expect(that % rr::distance(list.blocks()) == 4) << "blocks of b + 1 = 5 elements";
+    };
+
+    "a type should be able to opt in with an ADL segments function"_test = [] {
+        auto halves = user::Halves{ .m_front = { 1, 2, 3 }, .m_back = { 4, 5 } };
+        expect(that % seg::find(halves, 4) == 3uz);
+        expect(that % seg::accumulate(halves, 0) == 15);
+    };
+
+    "for_each should be able to modify the elements of a non-const range"_test = [] {
+        auto array = makeContainer<dsa::RootishArray<int>>(50);
+        seg::for_each(array, [](int& value) { value *= 2; });
+        expect(rr::equal(array, rv::iota(0, 50) | rv::transform([](int v) { return v * 2; })));
+    };
+
+    "segmented algorithms should work on non-trivial elements"_test = [] {
+        using Type = test_util::Regular;
+        Type::resetActiveInstanceCount();
+        {
+            auto buffer = dsa::CircularBuffer<Type>{ 8 };
+            for (auto i : rv::iota(0, 12)) {
+                buffer.push_back(Type{ i });
+            }
+            seg::fill(buffer, Type{ 7 });
+            expect(that % seg::find(buffer, Type{ 7 }) == 0uz);
+            expect(that % seg::find(buffer, Type{ 8 }) == 8uz);
+
+            auto list = std::vector<Type>{};
+            seg::copy(buffer, std::back_inserter(list));
+            expect(that % list.size() == 8uz);
+        }
+
+        // unbalanced constructor/destructor means there is a bug in the code
+        assert(Type::activeInstanceCount() == 0);
+    };
+}
@@ -0,0 +1,120 @@
+#include "test_util.hpp"
+
+#include <dsa/seqlock_buffer.hpp>
+
+#include <boost/ut.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+// larger than a word so a torn copy can mix two writes, the checksum detects that
+struct Sample
+{
+    std::uint64_t m_counter;
+    std::uint64_t m_payload[2];
+    std::uint64_t m_checksum;
+
+    static Sample make(std::uint64_t counter)
+    {
+        auto sample = Sample{ counter, { counter * 0x9e37'79b9ull, ~counter }, 0 };
+        sample.m_checksum = sample.sum();
+        return sample;
+    }
+
+    std::uint64_t sum() const { return (m_counter << 7) ^ m_payload[0] ^ m_payload[1]; }
+    bool          intact() const { return m_checksum == sum(); }
+};
+
+using Buffer = dsa::SeqlockBuffer<Sample>;
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws;
+
+    "zero capacity should throw, the capacity should not be rounded"_test = [] {
+        expect(throws([] { Buffer{ 0 }; }));
+        expect(that % Buffer{ 100 }.capacity() == 100uz);
+    };
+
+    "snapshot should return the latest values oldest first"_test = [](std::uint64_t count) {
+        auto buffer = Buffer{ 10 };
+
+        for (auto i : rv::iota(0u, count)) {
+            buffer.push_back(Sample::make(i));
+        }
+        expect(that % buffer.written() == count);
+        expect(that % buffer.size() == std::min<std::uint64_t>(count, 10));
+
+        for (auto want : { 1uz, 4uz, 10uz, 20uz }) {
+            auto values   = buffer.snapshot(want);
+            auto expected = std::min<std::uint64_t>({ want, count, 10 });
+            expect(that % values.size() == expected);
+            for (auto i = 0uz; i < values.size(); ++i) {
+                expect(that % values.at(i).m_counter == count - expected + i);
+            }
+        }
+
+        if (count > 0) {
+            expect(that % buffer.latest()->m_counter == count - 1);
+        } else {
+            expect(buffer.latest() == std::nullopt);
+        }
+        expect(that % buffer.retries() == 0u);
+    } | std::vector<std::uint64_t>{ 0, 1, 9, 10, 11, 25, 1'000 };
+
+    "snapshot into a span should fill its front"_test = [] {
+        auto buffer = Buffer{ 4 };
+        buffer.push_back(Sample::make(1));
+        buffer.push_back(Sample::make(2));
+
+        auto out    = std::array<Sample, 3>{};
+        auto copied = buffer.snapshot(out);
+        expect(that % copied == 2uz);
+        expect(that % out[0].m_counter == 1u and that % out[1].m_counter == 2u);
+    };
+
+    "readers under a writer should only ever see consecutive intact values"_test = [](std::size_t want) {
+        constexpr auto writes = 300'000u;
+
+        auto buffer = Buffer{ 64 };
+        auto done   = std::atomic<bool>{ false };
+        auto bad    = std::atomic<int>{ 0 };
+
+        {
+            auto readers = std::vector<std::jthread>{};
+            for (auto r [[maybe_unused]] : rv::iota(0, 3)) {
+                readers.emplace_back([&] {
+                    auto out = std::vector<Sample>(want);
+                    while (not done.load()) {
+                        auto copied = buffer.snapshot(out);
+                        for (auto i = 0uz; i < copied; ++i) {
+                            auto consecutive = i == 0 or out[i].m_counter == out[i - 1].m_counter + 1;
+                            if (not out[i].intact() or not consecutive) {
+                                ++bad;
+                            }
+                        }
+                    }
+                });
+            }
+
+            for (auto i : rv::iota(0u, writes)) {
+                buffer.push_back(Sample::make(i));
+            }
+            done = true;
+        }
+
+        expect(that % bad.load() == 0);
+        expect(that % buffer.written() == writes);
+        expect(that % buffer.snapshot(want).size() == want) << "quiescent: no conflict";
+    } | std::vector{ 1uz, 16uz, 63uz, 64uz };
+}
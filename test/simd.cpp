@@ -0,0 +1,141 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/fixed_array.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/simd.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+namespace simd = dsa::simd;
+
+// sizes around the vector widths and unrolled loop strides
+constexpr auto g_sizes = std::array{
+    0uz, 1uz, 3uz, 4uz, 7uz, 8uz, 15uz, 16uz, 31uz, 32uz, 33uz, 1'000uz, 4'099uz,
+};
+
+constexpr auto g_isas = std::array{ simd::Isa::Scalar, simd::Isa::Sse2, simd::Isa::Avx2 };
+
+template <typename T>
+std::vector<T> makeValues(std::size_t size)
+{
+    auto values = std::vector<T>(size);
+    for (auto& value : values) {
+        value = static_cast<T>(test_util::random(-25, 25)) / static_cast<T>(std::floating_point<T> ? 4 : 1);
+    }
+    return values;
+}
+
+template <typename T>
+void testSpan()
+{
+    using ut::expect, ut::that;
+
+    for (auto size : g_sizes) {
+        auto values = makeValues<T>(size);
+        auto span   = std::span<const T>{ values };
+
+        for (auto value : values | rv::take(10)) {
+            auto pos = static_cast<std::size_t>(rr::find(values, value) - values.begin());
+            expect(that % simd::find(span, value) == pos);
+            expect(that % simd::count(span, value) == static_cast<std::size_t>(rr::count(values, value)));
+        }
+        expect(that % simd::find(span, T{ 100 }) == size) << "not found should return the size";
+        expect(that % simd::count(span, T{ 100 }) == 0uz);
+
+        if (size == 0) {
+            expect(not simd::minmax(span).has_value());
+        } else {
+            auto [min, max] = rr::minmax(values);
+            expect(simd::minmax(span) == simd::MinMax<T>{ min, max });
+        }
+
+        auto expected = std::accumulate(values.begin(), values.end(), simd::Accumulator<T>{});
+        expect(std::abs(static_cast<double>(simd::sum(span) - expected)) < 1e-6);
+    }
+}
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    "setIsa should never go beyond what the cpu supports"_test = [] {
+        simd::setIsa(simd::Isa::Avx2);
+        expect(simd::activeIsa() == simd::detectIsa());
+
+        simd::setIsa(simd::Isa::Scalar);
+        expect(simd::activeIsa() == simd::Isa::Scalar);
+    };
+
+    "span kernels should match the standard algorithms on every instruction set"_test = [](simd::Isa isa) {
+        simd::setIsa(isa);
+        testSpan<std::int32_t>();
+        testSpan<float>();
+        testSpan<std::int64_t>();    // scalar fallback
+    } | g_isas;
+
+    "int32 extremes should not overflow the sum or break min/max"_test = [](simd::Isa isa) {
+        simd::setIsa(isa);
+
+        auto values = std::vector<std::int32_t>(1000, std::numeric_limits<std::int32_t>::max());
+        values[500] = std::numeric_limits<std::int32_t>::min();
+
+        auto span = std::span<const std::int32_t>{ values };
+        expect(simd::sum(span) == 999ll * std::numeric_limits<std::int32_t>::max() + INT32_MIN);
+        expect(simd::minmax(span)->min == std::numeric_limits<std::int32_t>::min());
+        expect(simd::minmax(span)->max == std::numeric_limits<std::int32_t>::max());
+    } | g_isas;
+
+    "container kernels should consume every segment in order"_test = [](simd::Isa isa) {
+        simd::setIsa(isa);
+
+        // the head is in the middle of the buffer so the elements are split into two segments
+        dsa::CircularBuffer<std::int32_t> buffer{ 100 };
+        for (auto i : rv::iota(0, 137)) {
+            buffer.push_back(auto{ i });
+        }
+        auto [first, second] = buffer.segments();
+        expect(first.size() > 0 and second.size() > 0);
+
+        expect(that % simd::find(buffer, 37) == 0uz);
+        expect(that % simd::find(buffer, 136) == 99uz);
+        expect(that % simd::find(buffer, 0) == buffer.size());
+        expect(that % simd::count(buffer, 100) == 1uz);
+        expect(simd::minmax(buffer) == simd::MinMax<std::int32_t>{ 37, 136 });
+        expect(simd::sum(buffer) == (37 + 136) * 100 / 2);
+
+        dsa::RootishArray<float> array{};
+        for (auto i : rv::iota(0, 500)) {
+            array.push_back(static_cast<float>(i % 50));
+        }
+        expect(that % simd::find(array, 49.0f) == 49uz);
+        expect(that % simd::count(array, 7.0f) == 10uz);
+        expect(simd::minmax(array) == simd::MinMax<float>{ 0.0f, 49.0f });
+
+        dsa::ArrayList<std::int32_t> list{};
+        expect(that % simd::find(list, 1) == 0uz);
+        expect(not simd::minmax(list).has_value());
+
+        auto fixed = dsa::FixedArray<std::int32_t>::sized(64);
+        rr::fill(fixed, 3);
+        expect(that % simd::sum(fixed) == 192ll);
+    } | g_isas;
+
+    simd::setIsa(simd::detectIsa());
+}
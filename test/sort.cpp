@@ -0,0 +1,188 @@
+#include "test_util.hpp"
+
+#include <dsa/array_list.hpp>
+#include <dsa/circular_buffer.hpp>
+#include <dsa/rootish_array.hpp>
+#include <dsa/sort.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using test_util::equalUnderlying;
+using test_util::populateContainer;
+
+enum class Input
+{
+    Sorted,
+    Reversed,
+    Random,
+    Duplicates,
+};
+
+constexpr auto g_inputs = std::array{ Input::Sorted, Input::Reversed, Input::Random, Input::Duplicates };
+
+// sizes below and above the insertion sort thresholds and the parallel threshold
+constexpr auto g_sizes = std::array{ 0uz, 1uz, 30uz, 1'000uz, 100'000uz };
+
+std::vector<int> makeInput(Input input, std::size_t size)
+{
+    auto values = std::vector<int>(size);
+    for (auto i = 0uz; i < size; ++i) {
+        auto value = static_cast<int>(i);
+        switch (input) {
+        case Input::Sorted: values[i] = value; break;
+        case Input::Reversed: values[i] = static_cast<int>(size) - value; break;
+        case Input::Random: values[i] = test_util::random(-1'000'000, 1'000'000); break;
+        case Input::Duplicates: values[i] = test_util::random(0, 7); break;
+        }
+    }
+    return values;
+}
+
+template <test_util::TestClass Type>
+void test()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that;
+
+    Type::resetActiveInstanceCount();
+
+    auto less = [](const Type& lhs, const Type& rhs) { return lhs.value() < rhs.value(); };
+
+    "pdq_sort should sort ArrayList"_test = [&](Input input) {
+        for (auto size : g_sizes) {
+            auto values = makeInput(input, size);
+
+            dsa::ArrayList<Type> list{};
+            populateContainer(list, values);
+            dsa::pdq_sort(list, less);
+
+            rr::sort(values);
+            expect(equalUnderlying<Type>(list, values)) << "size" << size;
+        }
+    } | g_inputs;
+
+    "pdq_sort should sort RootishArray in place"_test = [&](Input input) {
+        auto values = makeInput(input, 5'000);
+
+        dsa::RootishArray<Type> array{};
+        populateContainer(array, values);
+
+        // the blocks must stay the same, no linearization
+        auto blocks = array.blocks() | rv::transform([](auto& block) { return block.data(); })
+                    | rr::to<std::vector>();
+
+        dsa::pdq_sort(array, less);
+
+        rr::sort(values);
+        expect(equalUnderlying<Type>(array, values));
+        expect(rr::equal(blocks, array.blocks() | rv::transform([](auto& block) { return block.data(); })));
+    } | g_inputs;
+
+    "pdq_sort should sort CircularBuffer that wraps around"_test = [&](Input input) {
+        auto values = makeInput(input, 5'000);
+
+        // the first elements are discarded so the head is not at the start of the buffer
+        dsa::CircularBuffer<Type> buffer{ values.size() };
+        populateContainer(buffer, rv::iota(0, 123));
+        populateContainer(buffer, values);
+
+        dsa::pdq_sort(buffer, less);
+
+        rr::sort(values);
+        expect(equalUnderlying<Type>(buffer, values));
+    } | g_inputs;
+
+    "merge_sort should be stable"_test = [](Input input) {
+        auto byTens = [](const Type& lhs, const Type& rhs) { return lhs.value() / 10 < rhs.value() / 10; };
+
+        for (auto size : g_sizes) {
+            auto values = makeInput(input, size);
+
+            dsa::ArrayList<Type> list{};
+            populateContainer(list, values);
+
+            auto scratch = dsa::RawBuffer<Type>{};
+            dsa::merge_sort(list, byTens, scratch);
+
+            rr::stable_sort(values, {}, [](int value) { return value / 10; });
+            expect(equalUnderlying<Type>(list, values)) << "size" << size;
+            expect(that % scratch.size() <= size / 2 + 1) << "scratch only needs half of the elements";
+        }
+    } | g_inputs;
+
+    "parallel_merge_sort should be stable and give the same result as merge_sort"_test = [](Input input) {
+        auto byTens = [](const Type& lhs, const Type& rhs) { return lhs.value() / 10 < rhs.value() / 10; };
+
+        for (auto size : g_sizes) {
+            auto values = makeInput(input, size);
+
+            dsa::RootishArray<Type> array{};
+            populateContainer(array, values);
+            dsa::parallel_merge_sort(array, byTens, 3);
+
+            rr::stable_sort(values, {}, [](int value) { return value / 10; });
+            expect(equalUnderlying<Type>(array, values)) << "size" << size;
+        }
+    } | g_inputs;
+
+    // unbalanced constructor/destructor means there is a bug in the code
+    assert(Type::activeInstanceCount() == 0);
+}
+
+int main()
+{
+    using namespace ut::literals;
+    using ut::expect;
+
+    "pdq_sort should handle arithmetic elements with the branchless partition"_test = [] {
+        for (auto input : g_inputs) {
+            for (auto size : g_sizes) {
+                auto values   = makeInput(input, size);
+                auto expected = values;
+                rr::sort(expected, rr::greater{});
+
+                dsa::pdq_sort(values.begin(), values.end(), rr::greater{});
+                expect(values == expected) << "size" << size;
+            }
+        }
+    };
+
+    "pdq_sort should not go quadratic on adversarial patterns"_test = [] {
+        // organ pipe and sawtooth defeat median of 3 quicksorts without the pattern breaking
+        auto values = std::vector<int>(200'000);
+        for (auto i = 0uz; i < values.size(); ++i) {
+            values[i] = static_cast<int>(i < values.size() / 2 ? i : values.size() - i);
+        }
+        dsa::pdq_sort(values);
+        expect(rr::is_sorted(values));
+
+        for (auto i = 0uz; i < values.size(); ++i) {
+            values[i] = static_cast<int>(i % 1000);
+        }
+        dsa::pdq_sort(values);
+        expect(rr::is_sorted(values));
+    };
+
+#ifdef DSA_TEST_EXTRA_TYPES
+    test_util::forEach<test_util::NonTrivialPermutations>([]<typename T>() {
+        if constexpr (std::movable<T>) {
+            test<T>();
+        }
+    });
+#else
+    test<test_util::Regular>();
+    test<test_util::MovableOnly<>>();
+#endif
+}
@@ -102,6 +102,19 @@ void test()
         expect(stack.empty()) << "stack should be empty after popping all elements";
     };
 
+    "push_range should push the elements in order"_test = [] {
+        auto stack  = dsa::Stack<dsa::ArrayList, Type>(std::from_range, rv::iota(0, 5));
+        auto stack2 = dsa::Stack<dsa::LinkedList, Type>{};
+
+        stack.push_range(rv::iota(5, 10));
+        stack2.push_range(rv::iota(0, 10));
+
+        for (auto i : rv::iota(0, 10) | rv::reverse) {
+            expect(that % stack.pop().value() == i);
+            expect(that % stack2.pop().value() == i);
+        }
+    };
+
     // unbalanced constructor/destructor means there is a bug in the code
     assert(Type::activeInstanceCount() == 0);
 }
@@ -4,12 +4,17 @@
 #include <fmt/ranges.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <limits>
+#include <optional>
 #include <ostream>
 #include <random>
 #include <ranges>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace test_util
 {
@@ -119,7 +124,7 @@ namespace test_util
             return *this;
         }
 
-        int              value() const { return m_value; }
+        int              value() const noexcept { return m_value; }
         ClassStatCounter stat() const { return m_stat; }
 
         friend std::ostream& operator<<(std::ostream& os, const NonTrivial& nt) { return os << nt.value(); }
@@ -129,12 +134,14 @@ namespace test_util
         auto operator<=>(const auto& other) const { return value() <=> other.value(); }
         auto operator==(const auto& other) const { return value() == other.value(); }
 
-        static int  activeInstanceCount() { return s_activeInstanceCount; }
+        static int  activeInstanceCount() { return s_activeInstanceCount.load(); }
         static void resetActiveInstanceCount() { s_activeInstanceCount = 0; }
 
     private:
-        static constexpr int npos                  = std::numeric_limits<int>::min();
-        static inline int    s_activeInstanceCount = 0;
+        static constexpr int npos = std::numeric_limits<int>::min();
+
+        // atomic, the parallel algorithms construct and destroy elements from many threads
+        static inline std::atomic<int> s_activeInstanceCount = 0;
 
         int                      m_value = npos;
         mutable ClassStatCounter m_stat  = {};
@@ -259,4 +266,72 @@ namespace test_util
             return dist(rng);
         }
     }
+
+    // (position, value) pairs of a batch, a pair without value is a remove
+    using Batch = std::vector<std::pair<std::size_t, std::optional<int>>>;
+
+    // a random batch on a sequence of the given size, no position is removed twice. inserted values count up
+    // from firstValue so that every element can be told apart
+    inline Batch randomBatch(std::size_t size, std::size_t count, int firstValue)
+    {
+        auto batch   = Batch{};
+        auto removed = std::vector<bool>(size, false);
+
+        for (auto i = 0uz; i < count; ++i) {
+            auto pos = random<std::size_t>(0, size);
+            if (pos < size and not removed[pos] and random(0, 1) == 0) {
+                removed[pos] = true;
+                batch.emplace_back(pos, std::nullopt);
+            } else {
+                batch.emplace_back(pos, firstValue++);
+            }
+        }
+
+        return batch;
+    }
+
+    // the expected result of applying the batch on the sequence 0, 1, ..., size - 1
+    inline std::vector<int> applyBatchNaive(std::size_t size, Batch batch)
+    {
+        auto key = [](const auto& op) { return std::pair{ op.first, not op.second.has_value() }; };
+        std::ranges::stable_sort(batch, {}, key);
+
+        auto result = std::vector<int>{};
+        auto op     = batch.begin();
+
+        for (auto pos = 0uz; pos <= size; ++pos) {
+            auto removed = false;
+            for (; op != batch.end() and op->first == pos; ++op) {
+                if (op->second.has_value()) {
+                    result.push_back(*op->second);
+                } else {
+                    removed = true;
+                }
+            }
+            if (pos < size and not removed) {
+                result.push_back(static_cast<int>(pos));
+            }
+        }
+
+        return result;
+    }
+
+    // Op is a dsa::BatchOp
+    template <typename Op>
+    std::vector<Op> toBatchOps(const Batch& batch)
+    {
+        auto ops = std::vector<Op>{};
+        ops.reserve(batch.size());
+        for (const auto& [pos, value] : batch) {
+            ops.push_back(value.has_value() ? Op::insert(pos, auto{ *value }) : Op::remove(pos));
+        }
+        return ops;
+    }
+
+    // the number of times the element (or the elements it was made from) was moved or copied
+    template <TestClass Type>
+    std::size_t relocations(const Type& value)
+    {
+        return value.stat().movecount() + value.stat().copycount();
+    }
 }
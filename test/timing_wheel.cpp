@@ -0,0 +1,265 @@
+#include "test_util.hpp"
+
+#include <dsa/timing_wheel.hpp>
+
+#include <boost/ut.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <ranges>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace rr = std::ranges;
+namespace rv = rr::views;
+
+using Wheel = dsa::TimingWheel<int>;
+using Tick  = Wheel::Tick;
+
+// (tick, payload) of every timer fired
+using Fired = std::vector<std::pair<Tick, int>>;
+
+auto recordInto(const Wheel& wheel, Fired& fired)
+{
+    return [&](int&& value) { fired.emplace_back(wheel.now(), value); };
+}
+
+// deadlines around the boundaries of the levels of the default wheel (8 bits, 4 levels) and past them
+constexpr auto g_deadlines = std::array<Tick, 12>{
+    1, 3, 255, 256, 257, 1'000, 65'535, 65'536, 70'000, (1 << 24) + 5, (1ull << 32) + 7, (1ull << 40) + 1,
+};
+
+// (slotBits, levels)
+constexpr auto g_shapes = std::array{
+    std::pair{ 1uz, 3uz },
+    std::pair{ 2uz, 3uz },
+    std::pair{ 3uz, 2uz },
+    std::pair{ 8uz, 4uz },
+};
+
+int main()
+{
+    using namespace ut::operators;
+    using namespace ut::literals;
+    using ut::expect, ut::that, ut::throws, ut::nothrow;
+
+    "invalid wheel shape should throw"_test = [] {
+        expect(throws([] { Wheel{ 0, 0, 4 }; }));
+        expect(throws([] { Wheel{ 0, 8, 0 }; }));
+        expect(throws([] { Wheel{ 0, 16, 5 }; }));
+        expect(throws([] { Wheel{ 0, 32, 1 }; }));
+        expect(nothrow([] { Wheel{ 0, 16, 4 }; }));
+    };
+
+    "timer should fire exactly at its deadline"_test = [](Tick deadline) {
+        auto wheel = Wheel{};
+        auto fired = Fired{};
+
+        wheel.schedule(deadline, 42);
+        expect(that % wheel.size() == 1uz);
+
+        expect(that % wheel.advance(deadline - 1, recordInto(wheel, fired)) == 0uz);
+        expect(fired.empty());
+
+        expect(that % wheel.advance(deadline, recordInto(wheel, fired)) == 1uz);
+        expect(fired == Fired{ { deadline, 42 } });
+        expect(that % wheel.size() == 0uz);
+        expect(that % wheel.now() == deadline);
+    } | g_deadlines;
+
+    "timers should fire in deadline order"_test = [] {
+        auto wheel     = Wheel{ 1000 };
+        auto fired     = Fired{};
+        auto deadlines = std::vector<Tick>{};
+
+        for (auto i : rv::iota(0, 2000)) {
+            auto deadline = 1000 + test_util::random<Tick>(1, 100'000);
+            deadlines.push_back(deadline);
+            wheel.schedule(deadline, i);
+        }
+
+        wheel.advance(200'000, recordInto(wheel, fired));
+        expect(that % fired.size() == 2000uz);
+
+        for (auto [tick, value] : fired) {
+            expect(that % tick == deadlines[static_cast<std::size_t>(value)]);
+        }
+        expect(rr::is_sorted(fired | rv::keys));
+    };
+
+    "deadline that is not in the future should fire on the next tick"_test = [] {
+        auto wheel = Wheel{ 100 };
+        auto fired = Fired{};
+
+        wheel.schedule(0, 1);
+        wheel.schedule(100, 2);
+        wheel.advance(100, recordInto(wheel, fired));
+        expect(fired.empty()) << "advancing to the current tick fires nothing";
+
+        wheel.advance(101, recordInto(wheel, fired));
+        expect(fired == Fired{ { 101, 1 }, { 101, 2 } });
+    };
+
+    "cancel should prevent the timer from firing and reject stale ids"_test = [] {
+        auto wheel = Wheel{};
+        auto fired = Fired{};
+
+        auto a = wheel.schedule(10, 1);
+        auto b = wheel.scheduleAfter(70'000, 2);
+        auto c = wheel.schedule(10, 3);
+
+        expect(wheel.contains(a) and wheel.contains(b) and wheel.contains(c));
+        expect(wheel.cancel(a));
+        expect(wheel.cancel(b));
+        expect(not wheel.cancel(a)) << "double cancel";
+        expect(not wheel.contains(b));
+        expect(that % wheel.size() == 1uz);
+
+        // the node of a is reused, the old id must not refer to the new timer
+        auto d = wheel.schedule(20, 4);
+        expect(not wheel.cancel(a));
+        expect(wheel.contains(d));
+
+        wheel.advance(100'000, recordInto(wheel, fired));
+        expect(fired == Fired{ { 10, 3 }, { 20, 4 } });
+        expect(not wheel.cancel(c)) << "fired timer can't be cancelled";
+        expect(not wheel.cancel(Wheel::TimerId{})) << "default id refers to nothing";
+    };
+
+    "fn should be able to schedule and cancel timers"_test = [] {
+        auto wheel = Wheel{};
+        auto fired = Fired{};
+
+        auto victim = wheel.schedule(65, -1);
+
+        // periodic timer that cancels the victim on its 5th period
+        auto fn = [&](int&& value) {
+            fired.emplace_back(wheel.now(), value);
+            if (value < 9) {
+                wheel.scheduleAfter(10, value + 1);
+            }
+            if (value == 5) {
+                wheel.cancel(victim);
+            }
+        };
+
+        wheel.schedule(10, 0);
+        expect(that % wheel.advance(1'000, fn) == 10uz);
+
+        expect(that % fired.size() == 10uz);
+        for (auto i : rv::iota(0uz, fired.size())) {
+            expect(fired[i] == std::pair{ 10 * (i + 1), static_cast<int>(i) });
+        }
+    };
+
+    "advance should throw when going back in time"_test = [] {
+        auto wheel = Wheel{ 10 };
+        expect(throws([&] { wheel.advance(9, [](int&&) { }); }));
+        expect(nothrow([&] { wheel.advance(10, [](int&&) { }); }));
+    };
+
+    "exception from fn should leave the remaining timers of the tick for the next advance"_test = [] {
+        auto wheel = Wheel{};
+        auto fired = Fired{};
+
+        wheel.schedule(5, 1);
+        wheel.schedule(5, 2);
+        wheel.schedule(6, 3);
+
+        expect(throws([&] { wheel.advance(10, [](int&&) { throw 0; }); }));
+        expect(that % wheel.size() == 2uz);
+        expect(that % wheel.now() == 5u);
+
+        wheel.advance(10, recordInto(wheel, fired));
+        expect(fired == Fired{ { 5, 2 }, { 6, 3 } });
+    };
+
+    "random operations should match a reference model"_test = [](std::pair<std::size_t, std::size_t> shape) {
+        auto [slotBits, levels] = shape;
+
+        auto wheel = Wheel{ 7, slotBits, levels };
+        auto fired = Fired{};
+
+        // id -> deadline of the pending timers
+        auto expected = std::map<int, Tick>{};
+        auto ids      = std::map<int, Wheel::TimerId>{};
+        auto nextId   = 0;
+
+        for (auto step [[maybe_unused]] : rv::iota(0, 5'000)) {
+            auto op = test_util::random(0, 9);
+
+            if (op < 5) {
+                auto delay = test_util::random<Tick>(0, 300);
+                auto id    = nextId++;
+
+                ids[id]      = wheel.scheduleAfter(delay, auto{ id });
+                expected[id] = std::max(wheel.now() + delay, wheel.now() + 1);
+            } else if (op < 7 and not expected.empty()) {
+                auto pos = test_util::random(0, static_cast<int>(expected.size()) - 1);
+                auto it  = std::next(expected.begin(), pos);
+                expect(wheel.cancel(ids[it->first]));
+                expect(not wheel.cancel(ids[it->first]));
+                expected.erase(it);
+            } else {
+                auto now = wheel.now() + test_util::random<Tick>(0, 40);
+                fired.clear();
+                wheel.advance(now, recordInto(wheel, fired));
+
+                auto due = Fired{};
+                for (auto it = expected.begin(); it != expected.end();) {
+                    if (it->second <= now) {
+                        due.emplace_back(it->second, it->first);
+                        it = expected.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                rr::sort(due);
+                rr::sort(fired);
+                expect(fired == due);
+            }
+
+            expect(that % wheel.size() == expected.size());
+        }
+
+        fired.clear();
+        wheel.advance(wheel.now() + 100'000, recordInto(wheel, fired));
+        expect(that % fired.size() == expected.size());
+    } | g_shapes;
+
+    "non-trivial payloads should be destroyed exactly once"_test = [] {
+        using Type = test_util::MovableOnly<>;
+        Type::resetActiveInstanceCount();
+        {
+            auto wheel = dsa::TimingWheel<Type>{ 0, 4, 3 };
+            auto ids   = std::vector<dsa::TimingWheel<Type>::TimerId>{};
+            for (auto i : rv::iota(0, 300)) {
+                ids.push_back(wheel.schedule(static_cast<Tick>(i * 7), Type{ i }));
+            }
+
+            for (auto i = 0uz; i < ids.size(); i += 3) {
+                wheel.cancel(ids[i]);
+            }
+
+            auto sum = 0;
+            wheel.advance(1'000, [&](Type&& value) { sum += value.value(); });
+            expect(sum > 0);
+
+            wheel.clear();
+            expect(that % wheel.size() == 0uz);
+
+            for (auto i : rv::iota(0, 100)) {
+                wheel.schedule(static_cast<Tick>(2'000 + i), Type{ i });
+            }
+        }
+
+        // unbalanced constructor/destructor means there is a bug in the code
+        assert(Type::activeInstanceCount() == 0);
+    };
+}